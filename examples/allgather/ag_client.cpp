@@ -6,6 +6,8 @@
 
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/lcos/communicator.hpp>
 #include <hpx/lcos/wait_all.hpp>
 
 #include "ag/server/allgather.hpp"
@@ -13,6 +15,7 @@
 
 #include <cstddef>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <math.h>
 
@@ -123,6 +126,46 @@ void test_allgather_and_gate(std::size_t np)
     std::cout << " compute time: " << computetime << std::endl;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The same computation based on hpx::lcos::communicator, which connects the
+// participants once and gathers all values in log(np) steps.
+double allgather_participant(std::size_t np, std::size_t rank)
+{
+    hpx::lcos::communicator comm("/allgather/communicator", np, rank);
+
+    std::vector<double> values = comm.all_gather(rank * 3.14159);
+
+    double sum = 0.0;
+    for (double value : values)
+        sum += value;
+    return sum;
+}
+HPX_PLAIN_ACTION(allgather_participant, allgather_participant_action);
+
+void test_allgather_communicator(std::size_t np)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    hpx::util::high_resolution_timer computetimer;
+    std::vector<hpx::future<double> > participants;
+    participants.reserve(np);
+    for (std::size_t i = 0; i < np; ++i)
+    {
+        participants.push_back(hpx::async(allgather_participant_action(),
+            localities[i % localities.size()], np, i));
+    }
+    hpx::wait_all(participants);
+    double computetime = computetimer.elapsed();
+
+    for (std::size_t i = 0; i < np; ++i)
+    {
+        std::cout << " participant: " << i
+                  << " sum: " << participants[i].get() << std::endl;
+    }
+
+    std::cout << " communicator time: " << computetime << std::endl;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map &vm)
 {
@@ -139,6 +182,7 @@ int hpx_main(boost::program_options::variables_map &vm)
 
         test_allgather(np);
         //test_allgather_and_gate(np);
+        test_allgather_communicator(np);
 
         std::cout << "Elapsed time: " << t.elapsed() << " [s]" << std::endl;
     } // Ensure things go out of scope before hpx::finalize is called.
@@ -7,32 +7,117 @@
 #define HPX_COMPUTE_HOST_BLOCK_EXECUTOR_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/compute/host/numa_domains.hpp>
 #include <hpx/compute/host/target.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/parallel/executors/execution.hpp>
 #include <hpx/parallel/executors/static_chunk_size.hpp>
 #include <hpx/parallel/executors/thread_pool_attached_executors.hpp>
+#include <hpx/runtime/threads/topology.hpp>
 #include <hpx/traits/executor_traits.hpp>
 #include <hpx/traits/is_executor.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/iterator_range.hpp>
 #include <hpx/util/range.hpp>
+#include <hpx/util/tuple.hpp>
 #include <hpx/util/unwrap.hpp>
+#include <hpx/util/zip_iterator.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <exception>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace compute { namespace host
 {
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Return the address of the element an iterator refers to, if any.
+        template <typename Iter, typename Enable = void>
+        struct refers_to_memory
+          : std::false_type
+        {};
+
+        template <typename Iter>
+        struct refers_to_memory<Iter,
+                typename std::enable_if<
+                    std::is_lvalue_reference<
+                        decltype(*std::declval<Iter const&>())
+                    >::value
+                >::type>
+          : std::true_type
+        {};
+
+        template <typename Iter>
+        void const* get_iterator_address(Iter const& it, std::true_type)
+        {
+            return std::addressof(*it);
+        }
+
+        template <typename Iter>
+        void const* get_iterator_address(Iter const&, std::false_type)
+        {
+            return nullptr;
+        }
+
+        template <typename Iter>
+        void const* get_iterator_address(Iter const& it)
+        {
+            return get_iterator_address(it, refers_to_memory<Iter>());
+        }
+
+        // use the first sequence for algorithms operating on several
+        template <typename ... Iters>
+        void const* get_iterator_address(
+            hpx::util::zip_iterator<Iters...> const& it)
+        {
+            return get_iterator_address(
+                hpx::util::get<0>(it.get_iterator_tuple()));
+        }
+
+        // The partitioners create shapes made of tuples holding the
+        // iterator referring to the beginning of a chunk and its size.
+        template <typename T>
+        void const* get_chunk_address(T const&)
+        {
+            return nullptr;
+        }
+
+        template <typename Iter, typename ... Ts>
+        void const* get_chunk_address(hpx::util::tuple<Iter, Ts...> const& elem)
+        {
+            return get_iterator_address(hpx::util::get<0>(elem));
+        }
+
+        template <typename T>
+        std::size_t get_chunk_size(T const&)
+        {
+            return 1;
+        }
+
+        template <typename Iter, typename ... Ts>
+        std::size_t get_chunk_size(
+            hpx::util::tuple<Iter, std::size_t, Ts...> const& elem)
+        {
+            return hpx::util::get<1>(elem);
+        }
+
+        /// \endcond
+    }
+
     /// The block executor can be used to build NUMA aware programs.
-    /// It will distribute work evenly across the passed targets
+    /// It will distribute work evenly across the passed targets. Work
+    /// referring to memory is run on the target co-located with the NUMA
+    /// domain the memory was placed on.
     ///
     /// \tparam Executor The underlying executor to use
     template <typename Executor =
@@ -61,12 +146,14 @@ namespace hpx { namespace compute { namespace host
           : targets_(other.targets_)
           , current_(0)
           , executors_(other.executors_)
+          , domain_targets_(other.domain_targets_)
         {}
 
         block_executor(block_executor&& other)
           : targets_(std::move(other.targets_))
           , current_(other.current_.load())
           , executors_(std::move(other.executors_))
+          , domain_targets_(std::move(other.domain_targets_))
         {}
 
         block_executor& operator=(block_executor const& other)
@@ -76,6 +163,7 @@ namespace hpx { namespace compute { namespace host
                 targets_ = other.targets_;
                 current_ = 0;
                 executors_ = other.executors_;
+                domain_targets_ = other.domain_targets_;
             }
             return *this;
         }
@@ -87,6 +175,7 @@ namespace hpx { namespace compute { namespace host
                 targets_ = std::move(other.targets_);
                 current_ = other.current_.load();
                 executors_ = std::move(other.executors_);
+                domain_targets_ = std::move(other.domain_targets_);
             }
             return *this;
         }
@@ -143,33 +232,46 @@ namespace hpx { namespace compute { namespace host
         >
         bulk_async_execute(F && f, Shape const& shape, Ts &&... ts)
         {
+            typedef typename std::decay<
+                    decltype(*util::begin(shape))
+                >::type value_type;
+
             std::vector<hpx::future<
                 typename hpx::parallel::v3::detail::bulk_async_execute_result<
                         F, Shape, Ts...
                     >::type
-            > > results;
-            std::size_t cnt = util::size(shape);
-            std::size_t part_size = cnt / executors_.size();
-
-            results.reserve(cnt);
+            > > results(util::size(shape));
 
             try {
-                auto begin = util::begin(shape);
-                for (std::size_t i = 0; i != executors_.size(); ++i)
+                // group the elements of the shape by the target they will
+                // be executed on, while remembering their original position
+                std::vector<std::size_t> chunk_targets =
+                    get_chunk_targets(shape);
+
+                std::vector<std::vector<value_type> > parts(executors_.size());
+                std::vector<std::vector<std::size_t> > positions(
+                    executors_.size());
+
+                std::size_t i = 0;
+                for (auto const& elem : shape)
+                {
+                    std::size_t target = chunk_targets[i];
+                    parts[target].push_back(elem);
+                    positions[target].push_back(i++);
+                }
+
+                for (std::size_t t = 0; t != executors_.size(); ++t)
                 {
-                    auto part_end = begin;
-                    std::advance(part_end, part_size);
+                    if (parts[t].empty())
+                        continue;
+
                     auto futures =
                         parallel::execution::bulk_async_execute(
-                            executors_[i],
-                            std::forward<F>(f),
-                            util::make_iterator_range(begin, part_end),
-                            std::forward<Ts>(ts)...);
-                    results.insert(
-                        results.end(),
-                        std::make_move_iterator(futures.begin()),
-                        std::make_move_iterator(futures.end()));
-                    begin = part_end;
+                            executors_[t], f, parts[t], ts...);
+
+                    HPX_ASSERT(futures.size() == positions[t].size());
+                    for (std::size_t j = 0; j != futures.size(); ++j)
+                        results[positions[t][j]] = std::move(futures[j]);
                 }
                 return results;
             }
@@ -187,33 +289,12 @@ namespace hpx { namespace compute { namespace host
         >::type
         bulk_sync_execute(F && f, Shape const& shape, Ts &&... ts)
         {
-            typename hpx::parallel::v3::detail::bulk_execute_result<
-                    F, Shape, Ts...
-                >::type results;
-            std::size_t cnt = util::size(shape);
-            std::size_t part_size = cnt / executors_.size();
-
-            results.reserve(cnt);
-
             try {
-                auto begin = util::begin(shape);
-                for (std::size_t i = 0; i != executors_.size(); ++i)
-                {
-                    auto part_end = begin;
-                    std::advance(part_end, part_size);
-                    auto part_results =
-                        parallel::execution::bulk_sync_execute(
-                            executors_[i],
-                            std::forward<F>(f),
-                            util::make_iterator_range(begin, part_end),
-                            std::forward<Ts>(ts)...);
-                    results.insert(
-                        results.end(),
-                        std::make_move_iterator(part_results.begin()),
-                        std::make_move_iterator(part_results.end()));
-                    begin = part_end;
-                }
-                return results;
+                // run the parts assigned to the different targets
+                // concurrently
+                auto results = bulk_async_execute(std::forward<F>(f), shape,
+                    std::forward<Ts>(ts)...);
+                return hpx::util::unwrap(results);
             }
             catch (std::bad_alloc const& ba) {
                 throw ba;
@@ -237,10 +318,89 @@ namespace hpx { namespace compute { namespace host
                 auto num_pus = tgt.num_pus();
                 executors_.emplace_back(num_pus.first, num_pus.second);
             }
+
+            // find the targets sharing processing units with each of the
+            // NUMA domains
+            auto const& topo = hpx::threads::get_topology();
+
+            std::size_t numa_nodes = topo.get_number_of_numa_nodes();
+            domain_targets_.resize(numa_nodes);
+            for (std::size_t d = 0; d != numa_nodes; ++d)
+            {
+                hpx::threads::mask_type node_mask =
+                    topo.get_numa_node_affinity_mask_from_numa_node(d);
+
+                for (std::size_t t = 0; t != targets_.size(); ++t)
+                {
+                    if (hpx::threads::bit_and(node_mask,
+                            targets_[t].native_handle().get_device()))
+                    {
+                        domain_targets_[d].push_back(t);
+                    }
+                }
+            }
+        }
+
+        // Determine the target each element of the shape will be executed
+        // on. Elements of the shape referring to memory (as created by the
+        // partitioners) are run on a target co-located with the NUMA domain
+        // holding the first page of that memory. This keeps the affinity
+        // established by first touch placement for all algorithms operating
+        // on the same data, independently of how they are chunked.
+        //
+        // All other elements are distributed over the targets in contiguous
+        // blocks, weighted by the number of elements they refer to. This is
+        // also how the block_allocator places the data initially.
+        template <typename Shape>
+        std::vector<std::size_t> get_chunk_targets(Shape const& shape) const
+        {
+            std::size_t const num_targets = executors_.size();
+
+            std::size_t total = 0;
+            for (auto const& elem : shape)
+                total += detail::get_chunk_size(elem);
+
+            std::vector<std::size_t> result;
+            result.reserve(util::size(shape));
+
+            std::size_t offset = 0;
+            for (auto const& elem : shape)
+            {
+                std::size_t target =
+                    total != 0 ? (offset * num_targets) / total : 0;
+
+                void const* addr = detail::get_chunk_address(elem);
+                if (addr != nullptr)
+                {
+                    std::size_t domain = host::get_numa_domain(addr);
+                    if (domain < domain_targets_.size() &&
+                        !domain_targets_[domain].empty())
+                    {
+                        std::vector<std::size_t> const& candidates =
+                            domain_targets_[domain];
+
+                        // prefer the block target if it is located in the
+                        // domain, otherwise spread the elements over all
+                        // targets of the domain
+                        if (std::find(candidates.begin(), candidates.end(),
+                                target) == candidates.end())
+                        {
+                            target = candidates[result.size() %
+                                candidates.size()];
+                        }
+                    }
+                }
+
+                result.push_back(target);
+                offset += detail::get_chunk_size(elem);
+            }
+            return result;
         }
+
         std::vector<host::target> targets_;
         std::atomic<std::size_t> current_;
         std::vector<Executor> executors_;
+        std::vector<std::vector<std::size_t> > domain_targets_;
     };
 }}}
 
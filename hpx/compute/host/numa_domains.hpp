@@ -10,11 +10,18 @@
 
 #include <hpx/compute/host/target.hpp>
 
+#include <cstddef>
 #include <vector>
 
 namespace hpx { namespace compute { namespace host
 {
     HPX_EXPORT std::vector<target> numa_domains();
+
+    /// Return the index of the NUMA domain holding the memory page the given
+    /// address refers to. Returns std::size_t(-1) if the page has not been
+    /// touched yet or if the location of pages can't be queried on this
+    /// system.
+    HPX_EXPORT std::size_t get_numa_domain(void const* addr);
 }}}
 
 #endif
@@ -184,6 +184,20 @@
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the interval (in milliseconds) after which buffered reference
+/// counting requests are sent to AGAS even if the buffer is not full.
+#if !defined(HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL)
+#  define HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL 10
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal factor by which the credit requested from AGAS is
+/// increased for a gid whose credit is exhausted repeatedly.
+#if !defined(HPX_INITIAL_AGAS_MAX_CREDIT_PREFETCH)
+#  define HPX_INITIAL_AGAS_MAX_CREDIT_PREFETCH 64
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the initial global reference count associated with any created
 /// object.
@@ -390,6 +404,21 @@
 #  define HPX_INITIAL_GID_RANGE 0xFFFFU
 #endif
 
+#if !defined(HPX_MAX_GID_RANGE)
+#  define HPX_MAX_GID_RANGE 0x10000000U
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Size of the slabs managed by the slab allocator (has to be a power of two)
+// and the largest block size served from those slabs
+#if !defined(HPX_SLAB_ALLOCATOR_SLAB_SIZE)
+#  define HPX_SLAB_ALLOCATOR_SLAB_SIZE 0x10000U
+#endif
+
+#if !defined(HPX_SLAB_ALLOCATOR_MAX_SIZE)
+#  define HPX_SLAB_ALLOCATOR_MAX_SIZE 512
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Enable lock verification code which allows to check whether there are locks
 // held while HPX-threads are suspended and/or interrupted.
@@ -16,7 +16,9 @@
 #include <hpx/lcos/packaged_action.hpp>
 
 #include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/buffered_send_channel.hpp>
 #include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/communicator.hpp>
 #include <hpx/lcos/gather.hpp>
 #include <hpx/lcos/latch.hpp>
 #if defined(HPX_HAVE_QUEUE_COMPATIBILITY)
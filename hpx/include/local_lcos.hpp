@@ -10,6 +10,7 @@
 #include <hpx/config.hpp>
 #include <hpx/dataflow.hpp>
 #include <hpx/lcos/local/barrier.hpp>
+#include <hpx/lcos/local/bounded_channel.hpp>
 #include <hpx/lcos/local/channel.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/counting_semaphore.hpp>
@@ -17,6 +18,7 @@
 #include <hpx/lcos/local/latch.hpp>
 #include <hpx/lcos/local/mutex.hpp>
 #include <hpx/lcos/local/no_mutex.hpp>
+#include <hpx/lcos/local/reader_biased_shared_mutex.hpp>
 #include <hpx/lcos/local/recursive_mutex.hpp>
 #include <hpx/lcos/local/shared_mutex.hpp>
 #include <hpx/lcos/local/sliding_semaphore.hpp>
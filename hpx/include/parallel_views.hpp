@@ -0,0 +1,11 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_VIEWS_OCT_19_2017)
+#define HPX_PARALLEL_VIEWS_OCT_19_2017
+
+#include <hpx/parallel/container_algorithms/views.hpp>
+
+#endif
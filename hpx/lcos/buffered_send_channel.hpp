@@ -0,0 +1,330 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_BUFFERED_SEND_CHANNEL_HPP)
+#define HPX_LCOS_BUFFERED_SEND_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/server/channel.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        /// Return a number identifying a buffered sender uniquely in the
+        /// whole system
+        HPX_API_EXPORT std::uint64_t get_buffered_sender_id();
+
+        ///////////////////////////////////////////////////////////////////////
+        // The statistics are updated from the continuations attached to the
+        // credit grants, they have to outlive the sender.
+        struct buffered_send_channel_statistics
+        {
+            buffered_send_channel_statistics()
+              : sent_(0), batches_(0), granted_batches_(0), latency_(0)
+              , start_(util::high_resolution_clock::now())
+            {}
+
+            static std::int64_t get(
+                std::atomic<std::int64_t>& value, bool reset)
+            {
+                return reset ? value.exchange(0, std::memory_order_relaxed) :
+                    value.load(std::memory_order_relaxed);
+            }
+
+            std::atomic<std::int64_t> sent_;
+            std::atomic<std::int64_t> batches_;
+            std::atomic<std::int64_t> granted_batches_;
+            std::atomic<std::int64_t> latency_;
+            std::atomic<std::uint64_t> start_;
+        };
+
+        /// Return the statistics accumulated over all buffered senders of
+        /// this locality, these are exposed as performance counters
+        HPX_API_EXPORT buffered_send_channel_statistics&
+            get_buffered_send_channel_statistics();
+
+        /// Install the performance counter types for the buffered senders
+        HPX_API_EXPORT void register_buffered_send_channel_counter_types();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A buffered_send_channel collects the values sent to a (possibly
+    /// remote) channel and sends them in batches of \a batch_size values,
+    /// each batch using a single parcel. The sender may have up to
+    /// \a credits values in flight which were not requested by any receiver
+    /// yet (at least \a batch_size, the default is 16 batches). The credits
+    /// for a batch are granted back by the channel once all of its values
+    /// have been requested, the sender is suspended only if it runs out of
+    /// credits.
+    ///
+    /// The values sent by one buffered_send_channel are received in the
+    /// order they were sent. Any values still buffered are sent when the
+    /// buffered_send_channel is destroyed, errors occurring while doing so
+    /// are ignored. Use \a close to be notified about those.
+    ///
+    /// \note A buffered_send_channel is meant to be used by a single thread
+    ///       only.
+    template <typename T>
+    class buffered_send_channel
+    {
+        static_assert(!std::is_void<T>::value,
+            "buffered_send_channel requires a non-void value type");
+
+        typedef typename lcos::server::channel<T>::set_values_action
+            set_values_action;
+
+    public:
+        HPX_NON_COPYABLE(buffered_send_channel);
+
+    public:
+        typedef T value_type;
+
+        explicit buffered_send_channel(send_channel<T> const& c,
+                std::size_t batch_size = 64, std::size_t credits = 0)
+          : id_(c.get_id())
+          , sender_(detail::get_buffered_sender_id())
+          , sequence_(0)
+          , batch_size_((std::max)(batch_size, std::size_t(1)))
+          , credits_(credits == 0 ?
+                16 * batch_size_ : (std::max)(credits, batch_size_))
+          , closed_(false)
+          , statistics_(
+                std::make_shared<detail::buffered_send_channel_statistics>())
+        {
+            buffer_.reserve(batch_size_);
+        }
+
+        explicit buffered_send_channel(channel<T> const& c,
+                std::size_t batch_size = 64, std::size_t credits = 0)
+          : buffered_send_channel(send_channel<T>(c), batch_size, credits)
+        {}
+
+        ~buffered_send_channel()
+        {
+            // send the remaining values without waiting for credits
+            if (!closed_ && (sequence_ != 0 || !buffer_.empty()))
+            {
+                try {
+                    hpx::apply(set_values_action(), id_, sender_, sequence_,
+                        std::move(buffer_), true, false);
+                }
+                catch (...) {
+                    // the buffered values are lost, the channel drops the
+                    // state kept for this sender once it is closed
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Add a value to the buffer, sends the buffered values once the
+        /// buffer holds \a batch_size values
+        template <typename U>
+        void set(U && val)
+        {
+            if (closed_)
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "hpx::lcos::buffered_send_channel::set",
+                    "attempting to write to a closed channel");
+                return;
+            }
+
+            buffer_.push_back(T(std::forward<U>(val)));
+            if (buffer_.size() >= batch_size_)
+                send_batch(false, false);
+        }
+
+        /// Send all buffered values
+        void flush()
+        {
+            if (!buffer_.empty())
+                send_batch(false, false);
+        }
+
+        /// Send all buffered values and close the channel once all values
+        /// sent by this sender have been delivered.
+        void close()
+        {
+            if (closed_)
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "hpx::lcos::buffered_send_channel::close",
+                    "attempting to close an already closed channel");
+                return;
+            }
+
+            send_batch(true, true);
+            closed_ = true;
+
+            // closing the channel grants all outstanding credits
+            while (!outstanding_.empty())
+                receive_credits();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t batch_size() const
+        {
+            return batch_size_;
+        }
+
+        /// Return the number of credits currently available to the sender
+        std::size_t credits() const
+        {
+            return credits_;
+        }
+
+        naming::id_type const& get_id() const
+        {
+            return id_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the number of values sent by this sender
+        std::int64_t get_sent_count(bool reset)
+        {
+            return detail::buffered_send_channel_statistics::get(
+                statistics_->sent_, reset);
+        }
+
+        /// Return the number of batches (parcels) sent by this sender
+        std::int64_t get_batch_count(bool reset)
+        {
+            return detail::buffered_send_channel_statistics::get(
+                statistics_->batches_, reset);
+        }
+
+        /// Return the average time between sending a batch and the credits
+        /// for it being granted back (in nanoseconds)
+        std::int64_t get_average_latency(bool reset)
+        {
+            std::int64_t count = detail::buffered_send_channel_statistics::get(
+                statistics_->granted_batches_, reset);
+            std::int64_t latency =
+                detail::buffered_send_channel_statistics::get(
+                    statistics_->latency_, reset);
+            return count != 0 ? latency / count : 0;
+        }
+
+        /// Return the number of values sent per second (since the sender was
+        /// created or the throughput was last reset)
+        std::int64_t get_throughput(bool reset)
+        {
+            std::uint64_t now = util::high_resolution_clock::now();
+            std::uint64_t start = reset ?
+                statistics_->start_.exchange(now) : statistics_->start_.load();
+
+            std::int64_t sent = get_sent_count(reset);
+            if (now == start)
+                return 0;
+
+            return static_cast<std::int64_t>(
+                (double(sent) * 1e9) / double(now - start));
+        }
+
+    private:
+        // wait for the oldest batch to be granted its credits
+        void receive_credits()
+        {
+            HPX_ASSERT(!outstanding_.empty());
+
+            hpx::future<std::size_t> f = std::move(outstanding_.front());
+            outstanding_.pop_front();
+
+            credits_ += f.get();
+        }
+
+        void send_batch(bool last, bool close)
+        {
+            std::size_t const count = buffer_.size();
+
+            // collect the credits which have been granted already
+            while (!outstanding_.empty() && outstanding_.front().is_ready())
+                receive_credits();
+
+            while (credits_ < count)
+                receive_credits();
+
+            credits_ -= count;
+
+            std::vector<T> values;
+            values.reserve(batch_size_);
+            std::swap(values, buffer_);
+
+            std::shared_ptr<detail::buffered_send_channel_statistics>
+                statistics = statistics_;
+            std::uint64_t start = util::high_resolution_clock::now();
+
+            outstanding_.push_back(
+                hpx::async(set_values_action(), id_, sender_, sequence_,
+                    std::move(values), last, close
+                ).then(launch::sync,
+                    [statistics, start](hpx::future<std::size_t> f)
+                    ->  std::size_t
+                    {
+                        std::int64_t latency = static_cast<std::int64_t>(
+                            util::high_resolution_clock::now() - start);
+                        granted(*statistics, latency);
+                        granted(detail::get_buffered_send_channel_statistics(),
+                            latency);
+                        return f.get();
+                    }));
+
+            ++sequence_;
+
+            sent(*statistics_, count);
+            sent(detail::get_buffered_send_channel_statistics(), count);
+        }
+
+        static void sent(detail::buffered_send_channel_statistics& s,
+            std::size_t count)
+        {
+            s.sent_.fetch_add(
+                static_cast<std::int64_t>(count), std::memory_order_relaxed);
+            s.batches_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void granted(detail::buffered_send_channel_statistics& s,
+            std::int64_t latency)
+        {
+            s.latency_.fetch_add(latency, std::memory_order_relaxed);
+            s.granted_batches_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        naming::id_type id_;
+        std::uint64_t sender_;
+        std::uint64_t sequence_;
+
+        std::size_t batch_size_;
+        std::size_t credits_;
+        bool closed_;
+
+        std::vector<T> buffer_;
+        std::deque<hpx::future<std::size_t> > outstanding_;
+
+        std::shared_ptr<detail::buffered_send_channel_statistics> statistics_;
+    };
+}}
+
+#endif
@@ -0,0 +1,263 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/lcos/communicator.hpp
+
+#ifndef HPX_LCOS_COMMUNICATOR_HPP
+#define HPX_LCOS_COMMUNICATOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/detail/communicator_node.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace lcos
+{
+    /// The communicator connects a fixed set of participants which
+    /// repeatedly perform collective operations with each other. The
+    /// participants don't have to be on the same locality.
+    ///
+    /// All peers a participant exchanges messages with are looked up once
+    /// while the communicator is constructed. Every collective operation
+    /// sends a single parcel per step directly to the (already resolved)
+    /// peer, which makes the latency of an operation grow with log(num)
+    /// while not involving AGAS at all.
+    ///
+    /// All participants have to invoke the collective operations in the
+    /// same order.
+    class HPX_EXPORT communicator
+    {
+        /// \cond NOINTERNAL
+        typedef detail::communicator_node node_type;
+        /// \endcond
+
+    public:
+        /// Creates a communicator, rank is locality id, size is number of
+        /// localities
+        ///
+        /// \param base_name The name of the communicator
+        communicator(std::string const& base_name);
+
+        /// Creates a communicator with a given size and rank
+        ///
+        /// \param base_name The name of the communicator
+        /// \param num The number of participants
+        /// \param rank The rank of the calling site
+        ///
+        /// This function returns once all \a num participants have
+        /// constructed their communicator instance.
+        communicator(std::string const& base_name, std::size_t num,
+            std::size_t rank);
+
+        /// \cond NOINTERNAL
+        communicator(communicator&& other);
+        communicator& operator=(communicator&& other);
+
+        ~communicator();
+        /// \endcond
+
+        /// Return the number of participants
+        std::size_t size() const;
+
+        /// Return the rank of this participant
+        std::size_t rank() const;
+
+        /// Wait until each participant entered the barrier (dissemination
+        /// barrier, log(num) steps).
+        void barrier();
+
+        /// \returns a future that becomes ready once all participants have
+        /// entered the barrier.
+        hpx::future<void> barrier(hpx::launch::async_policy);
+
+        /// Combine the values of all participants using the (associative)
+        /// binary operation \a op (recursive doubling, log(num) steps). All
+        /// participants receive the same result.
+        template <typename T, typename F>
+        T all_reduce(T value, F && op)
+        {
+            return node_->all_reduce(node_->next_generation(),
+                std::move(value), std::forward<F>(op));
+        }
+
+        template <typename T, typename F>
+        hpx::future<T> all_reduce(hpx::launch::async_policy, T value, F && op)
+        {
+            std::shared_ptr<node_type> node = node_;
+            std::uint64_t generation = node_->next_generation();
+
+            typedef typename util::decay<F>::type op_type;
+            return hpx::async(
+                [node, generation](T && value, op_type && op) -> T
+                {
+                    return node->all_reduce(
+                        generation, std::move(value), std::move(op));
+                },
+                std::move(value), std::forward<F>(op));
+        }
+
+        /// Collect the values of all participants, the value contributed by
+        /// participant i is stored at position i of the result (Bruck's
+        /// algorithm, log(num) steps).
+        template <typename T>
+        std::vector<T> all_gather(T value)
+        {
+            return node_->all_gather(
+                node_->next_generation(), std::move(value));
+        }
+
+        template <typename T>
+        hpx::future<std::vector<T> > all_gather(
+            hpx::launch::async_policy, T value)
+        {
+            std::shared_ptr<node_type> node = node_;
+            std::uint64_t generation = node_->next_generation();
+
+            return hpx::async(
+                [node, generation](T && value) -> std::vector<T>
+                {
+                    return node->all_gather(generation, std::move(value));
+                },
+                std::move(value));
+        }
+
+        /// Send values[i] to participant i, the value received from
+        /// participant i is stored at position i of the result (log(num)
+        /// steps).
+        template <typename T>
+        std::vector<T> all_to_all(std::vector<T> values)
+        {
+            return node_->all_to_all(
+                node_->next_generation(), std::move(values));
+        }
+
+        template <typename T>
+        hpx::future<std::vector<T> > all_to_all(
+            hpx::launch::async_policy, std::vector<T> values)
+        {
+            std::shared_ptr<node_type> node = node_;
+            std::uint64_t generation = node_->next_generation();
+
+            return hpx::async(
+                [node, generation](std::vector<T> && values) -> std::vector<T>
+                {
+                    return node->all_to_all(generation, std::move(values));
+                },
+                std::move(values));
+        }
+
+        /// Distribute values[i] from participant \a root to participant i
+        /// (binomial tree). The argument \a values is ignored on all other
+        /// participants.
+        template <typename T>
+        T scatter(std::size_t root, std::vector<T> values = std::vector<T>())
+        {
+            return node_->scatter(
+                node_->next_generation(), root, std::move(values));
+        }
+
+        template <typename T>
+        hpx::future<T> scatter(hpx::launch::async_policy, std::size_t root,
+            std::vector<T> values = std::vector<T>())
+        {
+            std::shared_ptr<node_type> node = node_;
+            std::uint64_t generation = node_->next_generation();
+
+            return hpx::async(
+                [node, generation, root](std::vector<T> && values) -> T
+                {
+                    return node->scatter(generation, root, std::move(values));
+                },
+                std::move(values));
+        }
+
+        /// Collect the values of all participants on participant \a root
+        /// (binomial tree). The result is empty on all other participants.
+        template <typename T>
+        std::vector<T> gather(std::size_t root, T value)
+        {
+            return node_->gather(
+                node_->next_generation(), root, std::move(value));
+        }
+
+        template <typename T>
+        hpx::future<std::vector<T> > gather(
+            hpx::launch::async_policy, std::size_t root, T value)
+        {
+            std::shared_ptr<node_type> node = node_;
+            std::uint64_t generation = node_->next_generation();
+
+            return hpx::async(
+                [node, generation, root](T && value) -> std::vector<T>
+                {
+                    return node->gather(generation, root, std::move(value));
+                },
+                std::move(value));
+        }
+
+        /// Combine the vectors contributed by all participants element-wise
+        /// using the (associative and commutative) binary operation \a op.
+        /// The vectors have to have the same size everywhere. Participant i
+        /// receives the i-th of num equally sized blocks of the result only.
+        ///
+        /// The blocks travel around a ring of participants in chunks of
+        /// \a chunk_size elements, a chunk is forwarded as soon as it has
+        /// been combined with the local values.
+        template <typename T, typename F>
+        std::vector<T> reduce_scatter(std::vector<T> values, F && op,
+            std::size_t chunk_size = default_chunk_size)
+        {
+            return node_->reduce_scatter(node_->next_generation(),
+                std::move(values), std::forward<F>(op), chunk_size);
+        }
+
+        template <typename T, typename F>
+        hpx::future<std::vector<T> > reduce_scatter(
+            hpx::launch::async_policy, std::vector<T> values, F && op,
+            std::size_t chunk_size = default_chunk_size)
+        {
+            std::shared_ptr<node_type> node = node_;
+            std::uint64_t generation = node_->next_generation();
+
+            typedef typename util::decay<F>::type op_type;
+            return hpx::async(
+                [node, generation, chunk_size](
+                    std::vector<T> && values, op_type && op) -> std::vector<T>
+                {
+                    return node->reduce_scatter(generation,
+                        std::move(values), std::move(op), chunk_size);
+                },
+                std::move(values), std::forward<F>(op));
+        }
+
+        /// The number of elements sent in one parcel by reduce_scatter
+        HPX_STATIC_CONSTEXPR std::size_t default_chunk_size = 16384;
+
+    private:
+        /// \cond NOINTERNAL
+        void connect();
+        void release();
+
+        naming::id_type id_;
+        std::shared_ptr<node_type> node_;
+        /// \endcond
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -136,6 +136,7 @@ namespace hpx { namespace lcos { namespace detail
           : base_type(init_no_addref{})
           , policy_(std::move(data.policy_))
           , func_(std::move(data.func_))
+          , detach_node_(true)
         {
         }
 
@@ -285,11 +286,14 @@ namespace hpx { namespace lcos { namespace detail
         /// current future was set to be ready.
         template <typename T, typename N>
         auto operator()(util::async_traverse_detach_tag, T&& current, N&& next)
-            -> decltype(async_detach_future(
-                std::forward<T>(current), std::forward<N>(next)))
+            -> decltype(async_detach_future(std::forward<T>(current),
+                std::forward<N>(next), std::declval<
+                    typename base_type::completed_callback_node&>()))
         {
-            return async_detach_future(
-                std::forward<T>(current), std::forward<N>(next));
+            // the traversal waits for one future at a time, the same list
+            // element can be reused for all of them
+            return async_detach_future(std::forward<T>(current),
+                std::forward<N>(next), detach_node_);
         }
 
         /// Finish the dataflow when the traversal has finished
@@ -301,6 +305,10 @@ namespace hpx { namespace lcos { namespace detail
     private:
         Policy policy_;
         Func func_;
+
+        // links the continuation resuming the traversal to the future
+        // currently waited for
+        typename base_type::completed_callback_node detach_node_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
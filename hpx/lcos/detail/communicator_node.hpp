@@ -0,0 +1,499 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_LCOS_DETAIL_COMMUNICATOR_NODE_HPP
+#define HPX_LCOS_DETAIL_COMMUNICATOR_NODE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/receive_buffer.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/server/component_base.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The communicator_node is the per-participant endpoint of a
+    // communicator. The ids of all peers a participant will ever exchange
+    // messages with are resolved once while the communicator is set up,
+    // afterwards each message is a single (direct) parcel sent to one of
+    // those peers.
+    //
+    // Messages are serialized into a byte buffer, which allows for a single
+    // action to serve all collective operations regardless of the type of
+    // the exchanged values. Each message is tagged with the sequence number
+    // of the collective operation it belongs to and the step inside of this
+    // operation.
+    struct HPX_EXPORT communicator_node
+      : components::component_base<communicator_node>
+    {
+        typedef std::vector<char> buffer_type;
+
+        // the steps used by the recursive doubling algorithm to fold in
+        // and to send back the values of the participants beyond the
+        // largest power of two
+        HPX_STATIC_CONSTEXPR std::size_t pre_step = 64;
+        HPX_STATIC_CONSTEXPR std::size_t post_step = 65;
+
+        // the largest number of steps (including chunks) a single
+        // collective operation may use
+        HPX_STATIC_CONSTEXPR std::uint64_t max_steps = std::uint64_t(1) << 32;
+
+        communicator_node();
+        communicator_node(std::string const& base_name, std::size_t num,
+            std::size_t rank);
+
+        ~communicator_node();
+
+        // Return the ranks of all participants the given one exchanges
+        // messages with
+        static std::vector<std::size_t> get_peers(
+            std::size_t num, std::size_t rank);
+
+        // Store the (pre-resolved) ids of the peers of this participant
+        void connect(std::vector<std::size_t> const& ranks,
+            std::vector<naming::id_type> && ids);
+
+        // Receive a message sent by one of the peers
+        void set_data(std::uint64_t tag, buffer_type && data);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(communicator_node, set_data);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return the sequence number of the next collective operation
+        std::uint64_t next_generation()
+        {
+            return generation_++;
+        }
+
+        static std::uint64_t get_tag(std::uint64_t generation, std::size_t step)
+        {
+            return (generation << 32) | step;
+        }
+
+        void send(std::size_t rank, std::uint64_t tag, buffer_type && data);
+        hpx::future<buffer_type> receive(std::uint64_t tag);
+
+        ///////////////////////////////////////////////////////////////////////
+        void barrier(std::uint64_t generation);
+
+        // Combine the values of all participants using recursive doubling,
+        // F has to be associative
+        template <typename T, typename F>
+        T all_reduce(std::uint64_t generation, T value, F && op);
+
+        // Collect the values of all participants (Bruck's algorithm)
+        template <typename T>
+        std::vector<T> all_gather(std::uint64_t generation, T value);
+
+        // Send values[i] to participant i and receive the value participant
+        // i has sent to this one at position i of the result (Bruck's
+        // algorithm, only the peers 2^k ranks away are involved)
+        template <typename T>
+        std::vector<T> all_to_all(
+            std::uint64_t generation, std::vector<T> values);
+
+        // Distribute values[i] from the root to participant i (binomial
+        // tree), values is ignored on all other participants
+        template <typename T>
+        T scatter(std::uint64_t generation, std::size_t root,
+            std::vector<T> values);
+
+        // Collect the values of all participants on the root (binomial
+        // tree), the result is empty on all other participants
+        template <typename T>
+        std::vector<T> gather(
+            std::uint64_t generation, std::size_t root, T value);
+
+        // Combine the (equally sized) vectors of all participants
+        // element-wise, every participant receives its block of the result
+        // only (ring algorithm), F has to be associative and commutative.
+        // Each block is sent in chunks of chunk_size elements which are
+        // forwarded as soon as they have been combined with the local
+        // values.
+        template <typename T, typename F>
+        std::vector<T> reduce_scatter(std::uint64_t generation,
+            std::vector<T> values, F && op, std::size_t chunk_size);
+
+        // Return the range of elements of the given block, if a vector of
+        // the given size is split into num_ blocks
+        std::pair<std::size_t, std::size_t> get_block(
+            std::size_t size, std::size_t block) const
+        {
+            return std::make_pair(
+                block * size / num_, (block + 1) * size / num_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        static buffer_type serialize(T const& value)
+        {
+            buffer_type data;
+            {
+                serialization::output_archive archive(data);
+                archive << value;
+            }
+            return data;
+        }
+
+        template <typename T>
+        static T deserialize(buffer_type const& data)
+        {
+            T value;
+            {
+                serialization::input_archive archive(data, data.size());
+                archive >> value;
+            }
+            return value;
+        }
+
+        std::string base_name_;
+        std::size_t num_;
+        std::size_t rank_;
+
+    private:
+        std::atomic<std::uint64_t> generation_;
+        std::map<std::size_t, naming::id_type> peers_;
+        lcos::local::receive_buffer<buffer_type> buffer_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    T communicator_node::all_reduce(std::uint64_t generation, T value, F && op)
+    {
+        if (num_ == 1)
+            return value;
+
+        std::size_t pof2 = 1;
+        while (2 * pof2 <= num_)
+            pof2 *= 2;
+
+        // The first 2*rem participants pair up, the even ones hand their
+        // value to their odd neighbor and wait for the final result.
+        std::size_t const rem = num_ - pof2;
+        std::size_t new_rank = rank_ - rem;
+        if (rank_ < 2 * rem)
+        {
+            if (rank_ % 2 == 0)
+            {
+                send(rank_ + 1, get_tag(generation, pre_step),
+                    serialize(value));
+                return deserialize<T>(
+                    receive(get_tag(generation, post_step)).get());
+            }
+
+            value = op(deserialize<T>(
+                receive(get_tag(generation, pre_step)).get()), value);
+            new_rank = rank_ / 2;
+        }
+
+        // recursive doubling amongst the remaining pof2 participants
+        std::size_t step = 0;
+        for (std::size_t mask = 1; mask < pof2; mask *= 2, ++step)
+        {
+            std::size_t const new_peer = new_rank ^ mask;
+            std::size_t const peer =
+                new_peer < rem ? 2 * new_peer + 1 : new_peer + rem;
+
+            std::uint64_t const tag = get_tag(generation, step);
+            send(peer, tag, serialize(value));
+
+            T received = deserialize<T>(receive(tag).get());
+            if (peer < rank_)
+                value = op(std::move(received), value);
+            else
+                value = op(value, std::move(received));
+        }
+
+        if (rank_ < 2 * rem)
+        {
+            send(rank_ - 1, get_tag(generation, post_step), serialize(value));
+        }
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> communicator_node::all_gather(
+        std::uint64_t generation, T value)
+    {
+        // after step k every participant holds the values of the 2^(k+1)
+        // participants following it (including its own)
+        std::vector<T> values;
+        values.reserve(num_);
+        values.push_back(std::move(value));
+
+        std::size_t step = 0;
+        for (std::size_t dist = 1; dist < num_; dist *= 2, ++step)
+        {
+            std::size_t const count = (std::min)(dist, num_ - dist);
+            std::uint64_t const tag = get_tag(generation, step);
+
+            send((rank_ + num_ - dist) % num_, tag, serialize(
+                std::vector<T>(values.begin(), values.begin() + count)));
+
+            std::vector<T> received =
+                deserialize<std::vector<T> >(receive(tag).get());
+            HPX_ASSERT(received.size() == count);
+
+            for (T& v : received)
+                values.push_back(std::move(v));
+        }
+
+        // the values are rotated by our rank
+        std::vector<T> result;
+        result.reserve(num_);
+        for (std::size_t i = 0; i != num_; ++i)
+            result.push_back(std::move(values[(i + num_ - rank_) % num_]));
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    std::vector<T> communicator_node::all_to_all(
+        std::uint64_t generation, std::vector<T> values)
+    {
+        HPX_ASSERT(values.size() == num_);
+
+        // blocks[i] is destined for participant rank_ + i
+        std::vector<T> blocks;
+        blocks.reserve(num_);
+        for (std::size_t i = 0; i != num_; ++i)
+            blocks.push_back(std::move(values[(rank_ + i) % num_]));
+
+        // in step k all blocks with bit k set in their index move 2^k ranks
+        // ahead, after the last step block i has travelled i ranks
+        std::size_t step = 0;
+        for (std::size_t dist = 1; dist < num_; dist *= 2, ++step)
+        {
+            std::vector<T> outgoing;
+            outgoing.reserve(num_ / 2 + 1);
+            for (std::size_t i = dist; i < num_; ++i)
+            {
+                if (i & dist)
+                    outgoing.push_back(std::move(blocks[i]));
+            }
+
+            std::uint64_t const tag = get_tag(generation, step);
+            send((rank_ + dist) % num_, tag, serialize(outgoing));
+
+            std::vector<T> incoming =
+                deserialize<std::vector<T> >(receive(tag).get());
+            HPX_ASSERT(incoming.size() == outgoing.size());
+
+            std::size_t j = 0;
+            for (std::size_t i = dist; i < num_; ++i)
+            {
+                if (i & dist)
+                    blocks[i] = std::move(incoming[j++]);
+            }
+        }
+
+        // blocks[i] now holds the value sent by participant rank_ - i
+        std::vector<T> result(num_);
+        for (std::size_t i = 0; i != num_; ++i)
+            result[(rank_ + num_ - i) % num_] = std::move(blocks[i]);
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    T communicator_node::scatter(std::uint64_t generation, std::size_t root,
+        std::vector<T> values)
+    {
+        HPX_ASSERT(root < num_);
+
+        // the tree is built over the ranks relative to the root, each
+        // participant is responsible for the values of its subtree
+        std::size_t const vrank = (rank_ + num_ - root) % num_;
+
+        std::size_t mask = 1;
+        std::vector<T> subtree;
+        if (vrank == 0)
+        {
+            HPX_ASSERT(values.size() == num_);
+
+            while (mask < num_)
+                mask *= 2;
+
+            subtree.reserve(num_);
+            for (std::size_t i = 0; i != num_; ++i)
+                subtree.push_back(std::move(values[(root + i) % num_]));
+        }
+        else
+        {
+            while ((vrank & mask) == 0)
+                mask *= 2;
+
+            subtree = deserialize<std::vector<T> >(
+                receive(get_tag(generation, 0)).get());
+        }
+
+        // hand the upper halves of our subtree to our children
+        for (mask /= 2; mask != 0; mask /= 2)
+        {
+            if (vrank + mask >= num_)
+                continue;
+
+            std::size_t const last =
+                (std::min)(2 * mask, num_ - vrank);
+
+            send((rank_ + mask) % num_, get_tag(generation, 0),
+                serialize(std::vector<T>(
+                    std::make_move_iterator(subtree.begin() + mask),
+                    std::make_move_iterator(subtree.begin() + last))));
+            subtree.erase(subtree.begin() + mask, subtree.end());
+        }
+
+        HPX_ASSERT(!subtree.empty());
+        return std::move(subtree.front());
+    }
+
+    template <typename T>
+    std::vector<T> communicator_node::gather(
+        std::uint64_t generation, std::size_t root, T value)
+    {
+        HPX_ASSERT(root < num_);
+
+        std::size_t const vrank = (rank_ + num_ - root) % num_;
+
+        // collect the values of our subtree, ordered by relative rank
+        std::vector<T> subtree;
+        subtree.push_back(std::move(value));
+
+        std::size_t step = 0;
+        for (std::size_t mask = 1; mask < num_; mask *= 2, ++step)
+        {
+            if (vrank & mask)
+            {
+                send((rank_ + num_ - mask) % num_, get_tag(generation, step),
+                    serialize(subtree));
+                return std::vector<T>();
+            }
+
+            if (vrank + mask < num_)
+            {
+                std::vector<T> received = deserialize<std::vector<T> >(
+                    receive(get_tag(generation, step)).get());
+
+                for (T& v : received)
+                    subtree.push_back(std::move(v));
+            }
+        }
+
+        HPX_ASSERT(vrank == 0 && subtree.size() == num_);
+
+        std::vector<T> result(num_);
+        for (std::size_t i = 0; i != num_; ++i)
+            result[(root + i) % num_] = std::move(subtree[i]);
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    std::vector<T> communicator_node::reduce_scatter(std::uint64_t generation,
+        std::vector<T> values, F && op, std::size_t chunk_size)
+    {
+        if (chunk_size == 0)
+            chunk_size = 1;
+
+        // all blocks are split into the same number of chunks
+        std::size_t const max_block = (values.size() + num_ - 1) / num_;
+        std::size_t const num_chunks =
+            (std::max)((max_block + chunk_size - 1) / chunk_size,
+                std::size_t(1));
+
+        HPX_ASSERT((num_ - 1) * num_chunks < max_steps);
+
+        auto send_chunk =
+            [&](std::size_t step, std::size_t block, std::size_t chunk)
+            {
+                std::pair<std::size_t, std::size_t> r =
+                    get_block(values.size(), block);
+
+                std::size_t const first =
+                    (std::min)(r.first + chunk * chunk_size, r.second);
+                std::size_t const last =
+                    (std::min)(first + chunk_size, r.second);
+
+                send((rank_ + 1) % num_,
+                    get_tag(generation, step * num_chunks + chunk),
+                    serialize(std::vector<T>(
+                        values.begin() + first, values.begin() + last)));
+            };
+
+        // In step s the partial result of block rank_ - s - 1 is sent to
+        // the next participant while the partial result of block
+        // rank_ - s - 2 is received from the previous one and combined with
+        // the local values. A combined chunk is forwarded right away, which
+        // overlaps the communication of later chunks with the reduction of
+        // earlier ones.
+        if (num_ > 1)
+        {
+            for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+                send_chunk(0, (rank_ + num_ - 1) % num_, chunk);
+        }
+
+        for (std::size_t step = 0; step + 1 < num_; ++step)
+        {
+            std::size_t const block = (rank_ + 2 * num_ - step - 2) % num_;
+            std::pair<std::size_t, std::size_t> r =
+                get_block(values.size(), block);
+
+            for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+            {
+                std::vector<T> received = deserialize<std::vector<T> >(
+                    receive(get_tag(generation, step * num_chunks + chunk))
+                        .get());
+
+                std::size_t const first =
+                    (std::min)(r.first + chunk * chunk_size, r.second);
+                HPX_ASSERT(first + received.size() <= r.second);
+
+                for (std::size_t i = 0; i != received.size(); ++i)
+                {
+                    values[first + i] =
+                        op(std::move(received[i]), values[first + i]);
+                }
+
+                if (step + 2 < num_)
+                    send_chunk(step + 1, block, chunk);
+            }
+        }
+
+        std::pair<std::size_t, std::size_t> r =
+            get_block(values.size(), rank_);
+
+        return std::vector<T>(
+            std::make_move_iterator(values.begin() + r.first),
+            std::make_move_iterator(values.begin() + r.second));
+    }
+}}}
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::lcos::detail::communicator_node::set_data_action,
+    communicator_node_set_data_action);
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -23,17 +23,21 @@
 #include <hpx/util/atomic_count.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/decay.hpp>
+#include <hpx/util/slab_allocator.hpp>
 #include <hpx/util/steady_clock.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/unused.hpp>
 
 #include <boost/intrusive_ptr.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -86,6 +90,36 @@ namespace detail
             delete this;
         }
 
+#if defined(HPX_HAVE_SLAB_ALLOCATOR)
+        // shared states are allocated from the slab allocator by default
+        static void* operator new(std::size_t size)
+        {
+            return util::slab_allocate(size);
+        }
+        static void* operator new(std::size_t, void* p) noexcept
+        {
+            return p;
+        }
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            util::slab_deallocate(p, size);
+        }
+        static void operator delete(void*, void*) noexcept {}
+
+#if defined(__cpp_aligned_new)
+        // over-aligned shared states are not served by the slab allocator
+        static void* operator new(std::size_t size, std::align_val_t align)
+        {
+            return ::operator new(size, align);
+        }
+        static void operator delete(void* p, std::size_t size,
+            std::align_val_t align) noexcept
+        {
+            ::operator delete(p, size, align);
+        }
+#endif
+#endif
+
         // This is a tag type used to convey the information that the caller is
         // _not_ going to addref the future_data instance
         struct init_no_addref {};
@@ -194,75 +228,6 @@ namespace detail
         std::size_t& count_;
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename F1, typename F2>
-    struct compose_cb_impl
-    {
-        template <typename A1, typename A2>
-        compose_cb_impl(A1 && f1, A2 && f2)
-          : f1_(std::forward<A1>(f1))
-          , f2_(std::forward<A2>(f2))
-        {}
-
-        compose_cb_impl(compose_cb_impl&& other)
-          : f1_(std::move(other.f1_))
-          , f2_(std::move(other.f2_))
-        {}
-
-        void operator()()
-        {
-            bool recurse_asynchronously = hpx::threads::get_self_ptr() == nullptr;
-#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            recurse_asynchronously =
-                !this_thread::has_sufficient_stack_space();
-#else
-            handle_continuation_recursion_count cnt;
-            recurse_asynchronously = recurse_asynchronously ||
-                cnt.count_ > HPX_CONTINUATION_MAX_RECURSION_DEPTH;
-#endif
-            if (recurse_asynchronously)
-            {
-                error_code ec;
-                threads::thread_id_type id = threads::register_thread_nullary(
-                    compose_cb_impl(std::move(f1_), std::move(f2_)),
-                    "compose_cb",
-                    threads::pending, true, threads::thread_priority_boost,
-                    std::size_t(-1), threads::thread_stacksize_current, ec);
-                return;
-            }
-
-            {
-                hpx::util::annotate_function annotate(f1_);
-                (void)annotate;
-                f1_();
-            }
-            {
-                hpx::util::annotate_function annotate(f2_);
-                (void)annotate;
-                f2_();
-            }
-        }
-
-        F1 f1_;
-        F2 f2_;
-    };
-
-    template <typename F1, typename F2>
-    static HPX_FORCEINLINE util::unique_function_nonser<void()>
-    compose_cb(F1 && f1, F2 && f2)
-    {
-        if (!f1)
-            return std::forward<F2>(f2);
-        else if (!f2)
-            return std::forward<F1>(f1);
-
-        // otherwise create a combined callback
-        typedef compose_cb_impl<
-            typename util::decay<F1>::type, typename util::decay<F2>::type
-        > result_type;
-        return result_type(std::forward<F1>(f1), std::forward<F2>(f2));
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     template <typename Result>
     struct future_data_base;
@@ -272,11 +237,12 @@ namespace detail
       : future_data_refcnt_base
     {
         future_data_base()
-          : state_(empty)
+          : state_(0), first_callback_used_(false)
         {}
 
         future_data_base(init_no_addref no_addref)
-          : future_data_refcnt_base(no_addref), state_(empty)
+          : future_data_refcnt_base(no_addref), state_(0)
+          , first_callback_used_(false)
         {}
 
         typedef lcos::local::spinlock mutex_type;
@@ -294,31 +260,112 @@ namespace detail
             exception = 4 | ready
         };
 
+        // Element of the (intrusive) list of continuations attached to this
+        // shared state. Elements marked as external are owned by the code
+        // attaching the continuation (see attach_on_completed) and are never
+        // deleted by the shared state.
+        struct alignas(8) completed_callback_node
+        {
+            explicit completed_callback_node(bool external = false)
+              : next_(nullptr), external_(external)
+            {}
+
+            explicit completed_callback_node(completed_callback_type && f)
+              : f_(std::move(f)), next_(nullptr), external_(false)
+            {}
+
+            completed_callback_type f_;
+            completed_callback_node* next_;
+            bool const external_;
+        };
+
+    protected:
+
+        // The state of this shared state is kept in a single atomic word:
+        //
+        //  - bits 0-1: empty, being set, holds value, holds exception
+        //  - bit 2:    threads are waiting for this future to become ready
+        //  - other:    pointer to the most recently attached continuation
+        //
+        // The continuation list is detached atomically when the shared
+        // state becomes ready.
+        typedef std::uintptr_t state_word;
+
+        HPX_STATIC_CONSTEXPR state_word state_mask = 0x3;
+        HPX_STATIC_CONSTEXPR state_word state_empty = 0x0;
+        HPX_STATIC_CONSTEXPR state_word state_setting = 0x1;
+        HPX_STATIC_CONSTEXPR state_word state_value = 0x2;
+        HPX_STATIC_CONSTEXPR state_word state_exception = 0x3;
+        HPX_STATIC_CONSTEXPR state_word has_waiters = 0x4;
+        HPX_STATIC_CONSTEXPR state_word callback_mask = ~state_word(0x7);
+
+        static bool is_ready_state(state_word s)
+        {
+            return (s & state_mask) >= state_value;
+        }
+
+        static completed_callback_node* get_callbacks(state_word s)
+        {
+            return reinterpret_cast<completed_callback_node*>(
+                s & callback_mask);
+        }
+
+        static state decode_state(state_word s)
+        {
+            switch (s & state_mask) {
+            case state_value: return value;
+            case state_exception: return exception;
+            default: break;
+            }
+            return empty;
+        }
+
+        // Mark this shared state as being set. Returns false if the shared
+        // state has already been set.
+        bool start_setting_state();
+
+        // Revert a failed attempt to set the shared state
+        void abort_setting_state();
+
+        // Make the value or exception visible, wake up all waiting threads
+        // and invoke all attached continuations.
+        void finish_setting_state(state_word s, error_code& ec);
+
+        // Release all continuations which have not been invoked yet
+        void release_callbacks(completed_callback_node* head);
+
+        // Give back a list element after its continuation has been moved out
+        void release_callback_node(completed_callback_node* node);
+
+        // Add the given list element to the list of continuations, invoke
+        // the continuation right away if the shared state has become ready.
+        void push_callback(completed_callback_node* node, state_word s);
+
+    public:
         /// Return whether or not the data is available for this
         /// \a future.
         bool is_ready() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return is_ready_locked(l);
+            return is_ready_state(state_.load(std::memory_order_acquire));
         }
 
         template <typename Lock>
         bool is_ready_locked(Lock& l) const
         {
             HPX_ASSERT_OWNS_LOCK(l);
-            return (state_ & ready) != 0;
+            return is_ready();
         }
 
         bool has_value() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == value;
+            return (state_.load(std::memory_order_acquire) & state_mask) ==
+                state_value;
         }
 
         bool has_exception() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == exception;
+            return (state_.load(std::memory_order_acquire) & state_mask) ==
+                state_exception;
         }
 
         virtual void execute_deferred(error_code& /*ec*/ = throws) {}
@@ -356,6 +403,13 @@ namespace detail
         /// immediately.
         void set_on_completed(completed_callback_type data_sink) override;
 
+        /// Attach the continuation stored in the given list element which is
+        /// owned by the caller. This does not allocate any memory. The
+        /// element must stay alive and must not be reused until its
+        /// continuation has been invoked (or this shared state has been
+        /// destroyed).
+        void attach_on_completed(completed_callback_node& node);
+
         virtual void wait(error_code& ec = throws);
 
         virtual future_status wait_until(
@@ -378,8 +432,13 @@ namespace detail
 
     protected:
         mutable mutex_type mtx_;
-        state state_;                               // current state
-        completed_callback_type on_completed_;
+        std::atomic<state_word> state_;             // current state
+
+        // storage for the first attached continuation, avoids allocating a
+        // list element for the common case of a single continuation
+        completed_callback_node first_callback_;
+        std::atomic<bool> first_callback_used_;
+
         local::detail::condition_variable cond_;    // threads waiting in read
     };
 
@@ -409,7 +468,7 @@ namespace detail
                 reinterpret_cast<result_type*>(&storage_);
             ::new ((void*)value_ptr) result_type(
                 future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
+            state_.store(base_type::state_value, std::memory_order_relaxed);
         }
 
         future_data_base(std::exception_ptr const& e, init_no_addref no_addref)
@@ -418,7 +477,7 @@ namespace detail
             std::exception_ptr* exception_ptr =
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(e);
-            state_ = exception;
+            state_.store(base_type::state_exception, std::memory_order_relaxed);
         }
         future_data_base(std::exception_ptr && e, init_no_addref no_addref)
           : base_type(no_addref)
@@ -426,7 +485,7 @@ namespace detail
             std::exception_ptr* exception_ptr =
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(std::move(e));
-            state_ = exception;
+            state_.store(base_type::state_exception, std::memory_order_relaxed);
         }
 
         virtual ~future_data_base() noexcept
@@ -466,90 +525,48 @@ namespace detail
         template <typename Target>
         void set_value(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked(l)) {
-                l.unlock();
+            if (!this->start_setting_state()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data_base::set_value",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed = std::move(on_completed_);
-
             // set the data
-            result_type* value_ptr =
-                reinterpret_cast<result_type*>(&storage_);
-            ::new ((void*)value_ptr) result_type(
-                future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
-
-            // handle all threads waiting for the future to become ready
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (cond_.notify_one(std::move(l), threads::thread_priority_boost, ec))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
+            try {
+                result_type* value_ptr =
+                    reinterpret_cast<result_type*>(&storage_);
+                ::new ((void*)value_ptr) result_type(
+                    future_data_result<Result>::set(std::forward<Target>(data)));
+            }
+            catch (...) {
+                this->abort_setting_state();
+                throw;
             }
 
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            // wake up waiting threads and invoke the continuations
+            this->finish_setting_state(base_type::state_value, ec);
         }
 
         void set_exception(
             std::exception_ptr data, error_code& ec = throws) override
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked(l)) {
-                l.unlock();
+            if (!this->start_setting_state()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data_base::set_exception",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed = std::move(on_completed_);
-
             // set the data
             std::exception_ptr* exception_ptr =
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(std::move(data));
-            state_ = exception;
-
-            // handle all threads waiting for the future to become ready
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (cond_.notify_one(std::move(l), threads::thread_priority_boost, ec))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
-            }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
 
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            // wake up waiting threads and invoke the continuations
+            this->finish_setting_state(base_type::state_exception, ec);
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -591,19 +608,22 @@ namespace detail
         /// operation. Allows any subsequent set_data operation to succeed.
         void reset(error_code& /*ec*/ = throws)
         {
-            // no locking is required as semantics guarantee a single writer
-            // and no reader
+            // no synchronization is required as semantics guarantee a single
+            // writer and no reader
+            typename base_type::state_word s =
+                state_.exchange(base_type::state_empty,
+                    std::memory_order_acq_rel);
 
             // release any stored data and callback functions
-            switch (state_) {
-            case value:
+            switch (s & base_type::state_mask) {
+            case base_type::state_value:
             {
                 result_type* value_ptr =
                     reinterpret_cast<result_type*>(&storage_);
                 value_ptr->~result_type();
                 break;
             }
-            case exception:
+            case base_type::state_exception:
             {
                 std::exception_ptr* exception_ptr =
                     reinterpret_cast<std::exception_ptr*>(&storage_);
@@ -613,23 +633,21 @@ namespace detail
             default: break;
             }
 
-            state_ = empty;
-            on_completed_ = completed_callback_type();
+            this->release_callbacks(base_type::get_callbacks(s));
         }
 
         std::exception_ptr get_exception_ptr() const override
         {
-            HPX_ASSERT(state_ == exception);
+            HPX_ASSERT((state_.load(std::memory_order_acquire) &
+                base_type::state_mask) == base_type::state_exception);
             return *reinterpret_cast<std::exception_ptr const*>(&storage_);
         }
 
     protected:
         using base_type::mtx_;
         using base_type::state_;
-        using base_type::on_completed_;
 
     private:
-        using base_type::cond_;
         typename future_data_storage<Result>::type storage_;
     };
 
@@ -1006,31 +1024,6 @@ namespace hpx { namespace traits
             typedef lcos::detail::future_data_allocator<R, Allocator> type;
         };
     }
-
-#if defined(HPX_HAVE_THREAD_DESCRIPTION)
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename F1, typename F2>
-    struct get_function_annotation<lcos::detail::compose_cb_impl<F1, F2> >
-    {
-        static char const*
-            call(lcos::detail::compose_cb_impl<F1, F2> const& f) noexcept
-        {
-            return get_function_annotation<F1>::call(f.f1_);
-        }
-    };
-
-#if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
-    template <typename F1, typename F2>
-    struct get_function_annotation_itt<lcos::detail::compose_cb_impl<F1, F2> >
-    {
-        static util::itt::string_handle
-            call(lcos::detail::compose_cb_impl<F1, F2> const& f) noexcept
-        {
-            return get_function_annotation_itt<F1>::call(f.f1_);
-        }
-    };
-#endif
-#endif
 }}
 
 #include <hpx/config/warnings_suffix.hpp>
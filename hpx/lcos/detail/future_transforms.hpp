@@ -59,6 +59,23 @@ namespace lcos {
             state->set_on_completed(util::deferred_call(std::forward<N>(next)));
         }
 
+        /// Attach the continuation next to the given future, using the given
+        /// list element (owned by the caller) to link the continuation to
+        /// the shared state of the future. This avoids allocating memory
+        /// when attaching the continuation, even if the future has other
+        /// continuations attached already.
+        template <typename T, typename N, typename Node,
+            typename std::enable_if<traits::is_future<
+                typename std::decay<T>::type>::value>::type* = nullptr>
+        void async_detach_future(T&& current, N&& next, Node& node)
+        {
+            auto state =
+                traits::detail::get_shared_state(std::forward<T>(current));
+
+            node.f_ = util::deferred_call(std::forward<N>(next));
+            state->attach_on_completed(node);
+        }
+
         /// Acquire a future range from the given begin and end iterator
         template <typename Iterator,
             typename Container =
@@ -0,0 +1,764 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_LOCAL_BOUNDED_CHANNEL_HPP)
+#define HPX_LCOS_LOCAL_BOUNDED_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/atomic_count.hpp>
+#include <hpx/util/iterator_facade.hpp>
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Lock-free, bounded multi-producer multi-consumer queue (based on the
+        // algorithm published by Dmitry Vyukov).
+        template <typename T>
+        class bounded_ring_buffer
+        {
+        private:
+            struct cell
+            {
+                std::atomic<std::size_t> sequence_;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type
+                    data_;
+            };
+
+            static std::size_t round_up_to_power_of_two(std::size_t size)
+            {
+                std::size_t result = 2;
+                while (result < size)
+                    result <<= 1;
+                return result;
+            }
+
+            static T* get(cell& c)
+            {
+                return reinterpret_cast<T*>(&c.data_);
+            }
+
+        public:
+            HPX_NON_COPYABLE(bounded_ring_buffer);
+
+        public:
+            explicit bounded_ring_buffer(std::size_t capacity)
+              : mask_(round_up_to_power_of_two(capacity) - 1)
+              , buffer_(new cell[mask_ + 1])
+              , enqueue_pos_(0)
+              , dequeue_pos_(0)
+            {
+                for (std::size_t i = 0; i != mask_ + 1; ++i)
+                    buffer_[i].sequence_.store(i, std::memory_order_relaxed);
+            }
+
+            ~bounded_ring_buffer()
+            {
+                T val;
+                while (try_pop(val))
+                    /**/;
+            }
+
+            std::size_t capacity() const
+            {
+                return mask_ + 1;
+            }
+
+            // Return the (approximate) number of elements in the queue
+            std::size_t size() const
+            {
+                std::size_t enqueue_pos =
+                    enqueue_pos_.load(std::memory_order_relaxed);
+                std::size_t dequeue_pos =
+                    dequeue_pos_.load(std::memory_order_relaxed);
+                return enqueue_pos > dequeue_pos ?
+                    enqueue_pos - dequeue_pos : 0;
+            }
+
+            // The value is moved only if the operation succeeds
+            bool try_push(T && val)
+            {
+                cell* c = nullptr;
+                std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    c = &buffer_[pos & mask_];
+                    std::size_t seq =
+                        c->sequence_.load(std::memory_order_acquire);
+                    std::intptr_t diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos);
+
+                    if (diff == 0)
+                    {
+                        if (enqueue_pos_.compare_exchange_weak(
+                                pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;           // the queue is full
+                    }
+                    else
+                    {
+                        pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                ::new (&c->data_) T(std::move(val));
+                c->sequence_.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool try_pop(T& val)
+            {
+                cell* c = nullptr;
+                std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    c = &buffer_[pos & mask_];
+                    std::size_t seq =
+                        c->sequence_.load(std::memory_order_acquire);
+                    std::intptr_t diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos + 1);
+
+                    if (diff == 0)
+                    {
+                        if (dequeue_pos_.compare_exchange_weak(
+                                pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;           // the queue is empty
+                    }
+                    else
+                    {
+                        pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                T* p = get(*c);
+                val = std::move(*p);
+                p->~T();
+                c->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            std::size_t const mask_;
+            std::unique_ptr<cell[]> buffer_;
+
+            // avoid false sharing between producers and consumers
+            char pad0_[64];
+            std::atomic<std::size_t> enqueue_pos_;
+            char pad1_[64 - sizeof(std::atomic<std::size_t>)];
+            std::atomic<std::size_t> dequeue_pos_;
+            char pad2_[64 - sizeof(std::atomic<std::size_t>)];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The values are exchanged through the lock-free ring buffer. The
+        // spinlock protects only the lists of suspended senders and
+        // receivers, it is released while a thread is suspended. A thread
+        // which successfully sent or received a value acquires the spinlock
+        // only if there are threads waiting on the opposite side.
+        template <typename T>
+        class bounded_channel
+        {
+        private:
+            typedef lcos::local::spinlock mutex_type;
+            typedef lcos::local::detail::condition_variable cond_type;
+
+            static_assert(std::is_nothrow_move_constructible<T>::value,
+                "the value type of a bounded channel has to be nothrow "
+                "move constructible");
+
+        public:
+            HPX_NON_COPYABLE(bounded_channel);
+
+        public:
+            explicit bounded_channel(std::size_t capacity)
+              : count_(0)
+              , buffer_(capacity)
+              , senders_waiting_(0)
+              , receivers_waiting_(0)
+              , closed_(false)
+            {}
+
+            std::size_t capacity() const
+            {
+                return buffer_.capacity();
+            }
+
+            std::size_t size() const
+            {
+                return buffer_.size();
+            }
+
+            bool is_closed() const
+            {
+                return closed_.load(std::memory_order_acquire);
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            bool try_set(T && val)
+            {
+                if (!buffer_.try_push(std::move(val)))
+                    return false;
+
+                notify(receivers_waiting_, receivers_);
+                return true;
+            }
+
+            bool try_get(T& val)
+            {
+                if (!buffer_.try_pop(val))
+                    return false;
+
+                notify(senders_waiting_, senders_);
+                return true;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            void set(T && val, error_code& ec = throws)
+            {
+                for (;;)
+                {
+                    if (is_closed())
+                    {
+                        HPX_THROWS_IF(ec, hpx::invalid_status,
+                            "hpx::lcos::local::bounded_channel::set",
+                            "attempting to write to a closed channel");
+                        return;
+                    }
+
+                    if (try_set(std::move(val)))
+                        break;
+
+                    if (!wait(senders_waiting_, senders_,
+                            [&]() { return buffer_.try_push(std::move(val)); },
+                            receivers_waiting_, receivers_,
+                            "hpx::lcos::local::bounded_channel::set", ec))
+                    {
+                        break;
+                    }
+                    if (ec) return;
+                }
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+            }
+
+            T get(error_code& ec = throws)
+            {
+                T val;
+                for (;;)
+                {
+                    if (try_get(val))
+                        break;
+
+                    if (is_closed())
+                    {
+                        // values might have been added before closing
+                        if (try_get(val))
+                            break;
+
+                        HPX_THROWS_IF(ec, hpx::invalid_status,
+                            "hpx::lcos::local::bounded_channel::get",
+                            "this channel is empty and was closed");
+                        return T();
+                    }
+
+                    if (!wait(receivers_waiting_, receivers_,
+                            [&]() { return buffer_.try_pop(val); },
+                            senders_waiting_, senders_,
+                            "hpx::lcos::local::bounded_channel::get", ec))
+                    {
+                        break;
+                    }
+                    if (ec) return T();
+                }
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return val;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Send the given n values, suspend whenever the channel is full.
+            // Returns the number of values sent, which is less than n if the
+            // channel was closed.
+            template <typename InIter>
+            std::size_t send_n(InIter first, std::size_t n)
+            {
+                std::size_t sent = 0;
+                std::size_t pushed = 0;     // values not announced yet
+
+                error_code ec(lightweight);
+                while (sent != n && !is_closed())
+                {
+                    T val(*first);
+                    if (buffer_.try_push(std::move(val)))
+                    {
+                        ++pushed;
+                    }
+                    else
+                    {
+                        // the channel is full, make sure the receivers know
+                        // about the values sent so far before suspending
+                        if (pushed != 0)
+                        {
+                            notify(receivers_waiting_, receivers_, pushed > 1);
+                            pushed = 0;
+                        }
+
+                        bool succeeded = false;
+                        while (!is_closed())
+                        {
+                            if (!wait(senders_waiting_, senders_,
+                                    [&]() {
+                                        return buffer_.try_push(std::move(val));
+                                    },
+                                    receivers_waiting_, receivers_,
+                                    "hpx::lcos::local::bounded_channel::send_n",
+                                    ec))
+                            {
+                                succeeded = true;
+                                break;
+                            }
+                            if (ec) break;
+
+                            if (buffer_.try_push(std::move(val)))
+                            {
+                                ++pushed;
+                                succeeded = true;
+                                break;
+                            }
+                        }
+
+                        if (!succeeded)
+                            break;
+                    }
+
+                    ++first;
+                    ++sent;
+                }
+
+                if (pushed != 0)
+                    notify(receivers_waiting_, receivers_, pushed > 1);
+
+                return sent;
+            }
+
+            // Receive up to n values, suspend only if the channel is empty.
+            // Returns the number of values received, which is zero only if
+            // the channel is empty and was closed.
+            template <typename OutIter>
+            std::size_t receive_n(OutIter dest, std::size_t n)
+            {
+                std::size_t received = 0;
+                T val;
+                while (received != n)
+                {
+                    // pop as many values as available before notifying
+                    std::size_t popped = 0;
+                    while (received != n && buffer_.try_pop(val))
+                    {
+                        *dest++ = std::move(val);
+                        ++received;
+                        ++popped;
+                    }
+
+                    if (popped != 0)
+                        notify(senders_waiting_, senders_, popped > 1);
+
+                    if (received != 0 || n == 0)
+                        break;
+
+                    if (is_closed())
+                    {
+                        // values might have been added before closing
+                        if (try_get(val))
+                        {
+                            *dest++ = std::move(val);
+                            ++received;
+                            continue;
+                        }
+                        break;
+                    }
+
+                    // the channel is empty, wait for a value to arrive
+                    error_code ec(lightweight);
+                    if (!wait(receivers_waiting_, receivers_,
+                            [&]() { return buffer_.try_pop(val); },
+                            senders_waiting_, senders_,
+                            "hpx::lcos::local::bounded_channel::receive_n",
+                            ec))
+                    {
+                        *dest++ = std::move(val);
+                        ++received;
+                        continue;
+                    }
+                    if (ec) break;
+                }
+                return received;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Close the channel and wake up all suspended threads, returns
+            // the number of threads which were waiting.
+            std::size_t close()
+            {
+                if (closed_.exchange(true, std::memory_order_acq_rel))
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_status,
+                        "hpx::lcos::local::bounded_channel::close",
+                        "attempting to close an already closed channel");
+                    return 0;
+                }
+
+                std::unique_lock<mutex_type> l(mtx_);
+                std::size_t count =
+                    senders_.size(l) + receivers_.size(l);
+
+                senders_.notify_all(std::move(l));
+
+                l = std::unique_lock<mutex_type>(mtx_);
+                receivers_.notify_all(std::move(l));
+
+                return count;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            long use_count() const { return count_; }
+            long addref() { return ++count_; }
+            long release() { return --count_; }
+
+        private:
+            // Wake up one (or all) threads waiting on the given condition, if
+            // any. The fence pairs with the one in wait() ensuring that either
+            // the waiting thread observes the change of the buffer or this
+            // thread observes the waiting thread.
+            void notify(std::atomic<std::size_t>& waiting, cond_type& cond,
+                bool all = false)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiting.load(std::memory_order_relaxed) == 0)
+                    return;
+
+                std::unique_lock<mutex_type> l(mtx_);
+                if (all)
+                    cond.notify_all(std::move(l));
+                else
+                    cond.notify_one(std::move(l));
+            }
+
+            // Announce a waiting thread and suspend it unless the given
+            // operation succeeds after the announcement. The operation is
+            // performed while holding the lock, which guarantees that a
+            // concurrent notification can't get lost. Returns false if the
+            // operation succeeded (after notifying the opposite side) and
+            // true if the thread was suspended, in which case the operation
+            // has to be retried.
+            template <typename F>
+            bool wait(std::atomic<std::size_t>& waiting, cond_type& cond,
+                F && f, std::atomic<std::size_t>& other_waiting,
+                cond_type& other, char const* description, error_code& ec)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+
+                waiting.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                bool succeeded = f();
+                if (!succeeded && !is_closed())
+                    cond.wait(l, description, ec);
+
+                waiting.fetch_sub(1, std::memory_order_relaxed);
+                l.unlock();
+
+                if (!succeeded)
+                    return true;
+
+                notify(other_waiting, other);
+                return false;
+            }
+
+        private:
+            hpx::util::atomic_count count_;
+
+            bounded_ring_buffer<T> buffer_;
+
+            mutable mutex_type mtx_;
+            cond_type senders_;
+            cond_type receivers_;
+            std::atomic<std::size_t> senders_waiting_;
+            std::atomic<std::size_t> receivers_waiting_;
+
+            std::atomic<bool> closed_;
+        };
+
+        // support functions for boost::intrusive_ptr
+        template <typename T>
+        void intrusive_ptr_add_ref(bounded_channel<T>* p)
+        {
+            p->addref();
+        }
+
+        template <typename T>
+        void intrusive_ptr_release(bounded_channel<T>* p)
+        {
+            if (0 == p->release())
+                delete p;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T> class bounded_channel;
+
+    /// Input iterator draining a bounded channel. Values are received in
+    /// batches of up to \a batch_size elements, iteration ends once the
+    /// channel is closed and empty.
+    template <typename T>
+    class bounded_channel_iterator
+      : public hpx::util::iterator_facade<
+            bounded_channel_iterator<T>, T const, std::input_iterator_tag>
+    {
+        typedef hpx::util::iterator_facade<
+                bounded_channel_iterator<T>, T const, std::input_iterator_tag
+            > base_type;
+
+    public:
+        bounded_channel_iterator()
+          : channel_(nullptr), batch_size_(0), pos_(0)
+        {}
+
+        explicit bounded_channel_iterator(
+                detail::bounded_channel<T>* c, std::size_t batch_size)
+          : channel_(c), batch_size_(batch_size != 0 ? batch_size : 1)
+          , pos_(0)
+        {
+            batch_.reserve(batch_size_);
+            receive_batch();
+        }
+
+    private:
+        void receive_batch()
+        {
+            batch_.clear();
+            pos_ = 0;
+            if (channel_->receive_n(std::back_inserter(batch_),
+                    batch_size_) == 0)
+            {
+                channel_.reset();       // the channel was closed
+            }
+        }
+
+        friend class hpx::util::iterator_core_access;
+
+        bool equal(bounded_channel_iterator const& rhs) const
+        {
+            return channel_ == rhs.channel_ &&
+                (channel_ == nullptr || pos_ == rhs.pos_);
+        }
+
+        void increment()
+        {
+            if (channel_ && ++pos_ == batch_.size())
+                receive_batch();
+        }
+
+        typename base_type::reference dereference() const
+        {
+            HPX_ASSERT(channel_ && pos_ < batch_.size());
+            return batch_[pos_];
+        }
+
+    private:
+        boost::intrusive_ptr<detail::bounded_channel<T> > channel_;
+        std::vector<T> batch_;
+        std::size_t batch_size_;
+        std::size_t pos_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A channel holding at most a fixed number of values. Senders are
+    /// suspended while the channel is full, receivers are suspended while
+    /// the channel is empty. The values are exchanged through a lock-free
+    /// ring buffer, the capacity is rounded up to the next power of two.
+    ///
+    /// \note Blocking operations have to be invoked from an HPX thread.
+    template <typename T>
+    class bounded_channel
+    {
+    public:
+        typedef T value_type;
+        typedef bounded_channel_iterator<T> iterator;
+
+        explicit bounded_channel(std::size_t capacity)
+          : channel_(new detail::bounded_channel<T>(capacity))
+        {}
+
+        std::size_t capacity() const
+        {
+            return channel_->capacity();
+        }
+
+        /// Return the (approximate) number of values held by the channel
+        std::size_t size() const
+        {
+            return channel_->size();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        T get(launch::sync_policy, error_code& ec = throws) const
+        {
+            return channel_->get(ec);
+        }
+        hpx::future<T> get(launch::async_policy) const
+        {
+            T val;
+            if (channel_->try_get(val))
+                return hpx::make_ready_future(std::move(val));
+
+            boost::intrusive_ptr<detail::bounded_channel<T> > c = channel_;
+            return hpx::async(
+                [c]() -> T
+                {
+                    return c->get();
+                });
+        }
+        hpx::future<T> get() const
+        {
+            return get(launch::async);
+        }
+
+        /// Receive a value if one is available without suspending
+        bool try_get(T& val) const
+        {
+            return channel_->try_get(val);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void set(T val)
+        {
+            channel_->set(std::move(val));
+        }
+        void set(launch::sync_policy, T val, error_code& ec = throws)
+        {
+            channel_->set(std::move(val), ec);
+        }
+        hpx::future<void> set(launch::async_policy, T val)
+        {
+            if (channel_->is_closed())
+            {
+                return hpx::make_exceptional_future<void>(
+                    HPX_GET_EXCEPTION(hpx::invalid_status,
+                        "hpx::lcos::local::bounded_channel::set",
+                        "attempting to write to a closed channel"));
+            }
+
+            if (channel_->try_set(std::move(val)))
+                return hpx::make_ready_future();
+
+            boost::intrusive_ptr<detail::bounded_channel<T> > c = channel_;
+            return hpx::async(
+                [c](T && val)
+                {
+                    c->set(std::move(val));
+                },
+                std::move(val));
+        }
+
+        /// Send a value if there is space available without suspending
+        bool try_set(T val)
+        {
+            return !channel_->is_closed() && channel_->try_set(std::move(val));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Send the n values starting at \a first, suspending whenever the
+        /// channel is full. Returns the number of values sent, which is less
+        /// than \a n only if the channel was closed.
+        template <typename InIter>
+        std::size_t send_n(InIter first, std::size_t n)
+        {
+            return channel_->send_n(first, n);
+        }
+
+        /// Receive up to \a n values into \a dest, suspending only while the
+        /// channel is empty. Returns the number of values received, which is
+        /// zero only if the channel is empty and was closed.
+        template <typename OutIter>
+        std::size_t receive_n(OutIter dest, std::size_t n) const
+        {
+            return channel_->receive_n(dest, n);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Close the channel, threads waiting to send values will return
+        /// with an error, threads waiting for values will receive the
+        /// remaining values (if any). Returns the number of threads which
+        /// were suspended.
+        std::size_t close()
+        {
+            return channel_->close();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        iterator begin(std::size_t batch_size = 0) const
+        {
+            return iterator(channel_.get(), batch_size != 0 ?
+                batch_size : default_batch_size());
+        }
+        iterator end() const
+        {
+            return iterator();
+        }
+
+        bounded_channel const& range() const
+        {
+            return *this;
+        }
+
+    private:
+        std::size_t default_batch_size() const
+        {
+            std::size_t capacity = channel_->capacity();
+            return capacity < 64 ? capacity : 64;
+        }
+
+        boost::intrusive_ptr<detail::bounded_channel<T> > channel_;
+    };
+}}}
+
+#endif
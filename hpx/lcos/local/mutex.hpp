@@ -14,9 +14,29 @@
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/util/steady_clock.hpp>
 
+#include <atomic>
+#include <cstdint>
+
 namespace hpx { namespace lcos { namespace local
 {
     ///////////////////////////////////////////////////////////////////////////
+    enum class mutex_policy
+    {
+        throughput,     ///< a released mutex can be acquired by any thread
+        fair            ///< a released mutex is handed to the thread which
+                        ///< has been waiting the longest
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The mutex is acquired and released through a single atomic state word
+    // if it is not contended. A thread trying to acquire a locked mutex
+    // spins for a bounded number of iterations first, the bound adapts to
+    // the time it took to acquire the mutex recently. Only after that the
+    // thread is suspended.
+    //
+    // If the mutex uses the fair policy, a released mutex is handed over
+    // directly to the first suspended thread, which then does not have to
+    // compete with other threads after being resumed.
     class mutex
     {
     public:
@@ -26,7 +46,8 @@ namespace hpx { namespace lcos { namespace local
         typedef lcos::local::spinlock mutex_type;
 
     public:
-        HPX_EXPORT mutex(char const* const description = "");
+        HPX_EXPORT mutex(char const* const description = "",
+            mutex_policy policy = mutex_policy::throughput);
 
         HPX_EXPORT ~mutex();
 
@@ -47,9 +68,20 @@ namespace hpx { namespace lcos { namespace local
         HPX_EXPORT void unlock(error_code& ec = throws);
 
     protected:
+        bool try_lock_state();
+        bool try_lock_spin();
+        bool wait_for_lock(util::steady_time_point const* abs_time,
+            error_code& ec);
+
+        std::atomic<std::uint32_t> state_;
+        std::atomic<threads::thread_id_repr_type> owner_id_;
+        std::atomic<std::int32_t> spin_count_;
+        mutex_policy const policy_;
+
+        // protects the suspended threads and the hand-off flag
         mutable mutex_type mtx_;
-        threads::thread_id_repr_type owner_id_;
         detail::condition_variable cond_;
+        bool handoff_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -59,7 +91,8 @@ namespace hpx { namespace lcos { namespace local
         HPX_NON_COPYABLE(timed_mutex);
 
     public:
-        HPX_EXPORT timed_mutex(char const* const description = "");
+        HPX_EXPORT timed_mutex(char const* const description = "",
+            mutex_policy policy = mutex_policy::throughput);
 
         HPX_EXPORT ~timed_mutex();
 
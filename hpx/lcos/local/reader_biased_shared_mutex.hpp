@@ -0,0 +1,190 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_LOCAL_READER_BIASED_SHARED_MUTEX_HPP)
+#define HPX_LCOS_LOCAL_READER_BIASED_SHARED_MUTEX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/shared_mutex.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/per_worker_counter.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // A reader-biased shared mutex (following the BRAVO design). While
+        // the mutex is biased towards readers, a reader announces itself by
+        // incrementing the counter assigned to the current worker thread
+        // only, readers running on different cores never touch the same
+        // cache line. A writer revokes the bias and waits for all announced
+        // readers to leave. While the bias is revoked readers go through the
+        // underlying shared mutex, which suspends the waiting HPX threads.
+        //
+        // As revoking the bias is expensive, the bias is restored by a reader
+        // only after a period proportional to the time the last revocation
+        // took (inhibit_multiplier times as long).
+        //
+        // HPX threads may be migrated between worker threads while holding a
+        // shared lock, therefore a reader may be released through a counter
+        // different from the one it was announced on (see
+        // util::per_worker_counter).
+        template <typename Mutex = lcos::local::mutex>
+        class reader_biased_shared_mutex
+        {
+        private:
+            typedef detail::shared_mutex<Mutex> shared_mutex_type;
+
+            HPX_STATIC_CONSTEXPR std::uint64_t inhibit_multiplier = 9;
+
+        public:
+            HPX_NON_COPYABLE(reader_biased_shared_mutex);
+
+        public:
+            reader_biased_shared_mutex()
+              : reader_bias_(true)
+              , inhibit_until_(0)
+            {}
+
+            ///////////////////////////////////////////////////////////////////
+            void lock_shared()
+            {
+                if (try_lock_shared_fast())
+                    return;
+
+                central_.lock_shared();
+                announce_reader();
+                central_.unlock_shared();
+            }
+
+            bool try_lock_shared()
+            {
+                if (try_lock_shared_fast())
+                    return true;
+
+                if (!central_.try_lock_shared())
+                    return false;
+
+                announce_reader();
+                central_.unlock_shared();
+                return true;
+            }
+
+            void unlock_shared()
+            {
+                readers_.local().fetch_sub(1, std::memory_order_release);
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            void lock()
+            {
+                central_.lock();
+                revoke_bias();
+            }
+
+            bool try_lock()
+            {
+                if (!central_.try_lock())
+                    return false;
+
+                bool const had_bias =
+                    reader_bias_.exchange(false, std::memory_order_seq_cst);
+                if (get_reader_count() != 0)
+                {
+                    if (had_bias)
+                        reader_bias_.store(true, std::memory_order_relaxed);
+                    central_.unlock();
+                    return false;
+                }
+                return true;
+            }
+
+            void unlock()
+            {
+                central_.unlock();
+            }
+
+        private:
+            bool try_lock_shared_fast()
+            {
+                if (!reader_bias_.load(std::memory_order_acquire))
+                    return false;
+
+                std::atomic<std::int64_t>& count = readers_.local();
+                count.fetch_add(1, std::memory_order_seq_cst);
+
+                // a writer might have revoked the bias concurrently
+                if (reader_bias_.load(std::memory_order_seq_cst))
+                    return true;
+
+                count.fetch_sub(1, std::memory_order_release);
+                return false;
+            }
+
+            // this is called while holding the central lock in shared mode,
+            // no writer is active
+            void announce_reader()
+            {
+                readers_.local().fetch_add(1, std::memory_order_relaxed);
+
+                if (!reader_bias_.load(std::memory_order_relaxed) &&
+                    util::high_resolution_clock::now() >=
+                        inhibit_until_.load(std::memory_order_relaxed))
+                {
+                    reader_bias_.store(true, std::memory_order_release);
+                }
+            }
+
+            std::int64_t get_reader_count() const
+            {
+                return readers_.sum(false, std::memory_order_seq_cst);
+            }
+
+            // this is called while holding the central lock in exclusive mode
+            void revoke_bias()
+            {
+                std::uint64_t start = 0;
+                if (reader_bias_.load(std::memory_order_relaxed))
+                {
+                    start = util::high_resolution_clock::now();
+                    reader_bias_.store(false, std::memory_order_seq_cst);
+                }
+
+                for (std::size_t k = 0; get_reader_count() != 0; ++k)
+                {
+                    util::detail::yield_k(k,
+                        "hpx::lcos::local::reader_biased_shared_mutex::lock");
+                }
+
+                if (start != 0)
+                {
+                    std::uint64_t now = util::high_resolution_clock::now();
+                    inhibit_until_.store(
+                        now + (now - start) * inhibit_multiplier,
+                        std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            util::per_worker_counter readers_;
+
+            std::atomic<bool> reader_bias_;
+            std::atomic<std::uint64_t> inhibit_until_;
+
+            shared_mutex_type central_;
+        };
+    }
+
+    typedef detail::reader_biased_shared_mutex<> reader_biased_shared_mutex;
+}}}
+
+#endif
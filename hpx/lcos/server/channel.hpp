@@ -9,21 +9,32 @@
 #include <hpx/config.hpp>
 #include <hpx/lcos/base_lco_with_value.hpp>
 #include <hpx/lcos/local/channel.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/server/component_base.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/traits/get_remote_result.hpp>
 #include <hpx/traits/is_component.hpp>
 #include <hpx/traits/promise_remote_result.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/detail/pp/cat.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/nargs.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
+#include <hpx/util/unlock_guard.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <exception>
+#include <map>
+#include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace lcos { namespace server
@@ -51,8 +62,12 @@ namespace hpx { namespace lcos { namespace server
             std::is_void<T>::value, util::unused_type, T
         >::type result_type;
 
+        typedef lcos::local::spinlock mutex_type;
+
     public:
-        channel() {}
+        channel()
+          : senders_closed_(false), pushed_(0), requested_(0), closed_(false)
+        {}
 
         // disambiguate base classes
         using base_type::finalize;
@@ -73,27 +88,32 @@ namespace hpx { namespace lcos { namespace server
         void set_value (RemoteType && result)
         {
             channel_.set(std::move(result));
+            values_pushed(1);
         }
 
         // Close the channel
         void set_exception(std::exception_ptr const& /*e*/)
         {
             channel_.close();
+            grant_all_credits();
         }
 
         // Retrieve the next value from the channel
         result_type get_value()
         {
+            value_requested();
             return channel_.get(launch::sync);
         }
         result_type get_value(error_code& ec)
         {
+            value_requested();
             return channel_.get(launch::sync, ec);
         }
 
         // Additional functionality exposed by the channel component
         hpx::future<T> get_generation(std::size_t generation)
         {
+            value_requested();
             return channel_.get(generation);
         }
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(channel, get_generation);
@@ -101,17 +121,311 @@ namespace hpx { namespace lcos { namespace server
         void set_generation(RemoteType && value, std::size_t generation)
         {
             channel_.set(std::move(value), generation);
+            values_pushed(1);
         }
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(channel, set_generation);
 
+        // Push a batch of values sent by a buffered sender. The batches of
+        // the same sender are applied in the order of their sequence numbers,
+        // batches arriving early are kept until all of their predecessors
+        // have been applied. The returned future becomes ready once the
+        // receivers have requested all values of the batch, it carries the
+        // number of credits granted back to the sender.
+        //
+        // The last batch of a sender (optionally) closes the channel.
+        hpx::future<std::size_t> set_values(std::uint64_t sender,
+            std::uint64_t sequence, std::vector<RemoteType> && values,
+            bool last, bool close)
+        {
+            lcos::local::promise<std::size_t> credits;
+            hpx::future<std::size_t> result = credits.get_future();
+
+            {
+                std::unique_lock<lcos::local::mutex> l(senders_mtx_);
+
+                // the values can't be delivered anymore, this reports the
+                // error to the sender without keeping track of it
+                if (senders_closed_)
+                {
+                    l.unlock();
+                    apply_batch(std::move(values), false, std::move(credits));
+                    return result;
+                }
+
+                sender_data& s = senders_[sender];
+                HPX_ASSERT(sequence >= s.next_sequence_);
+                s.pending_.insert(std::make_pair(sequence, pending_batch(
+                    std::move(values), last, close, std::move(credits))));
+
+                // the thread currently applying batches of this sender will
+                // pick up this one as well
+                if (s.applying_)
+                    return result;
+                s.applying_ = true;
+            }
+
+            apply_batches(sender);
+            return result;
+        }
+        HPX_DEFINE_COMPONENT_ACTION(channel, set_values);
+
         std::size_t close(bool force_delete_entries)
         {
-            return channel_.close(force_delete_entries);
+            std::size_t result = channel_.close(force_delete_entries);
+            grant_all_credits();
+            release_senders();
+            return result;
         }
         HPX_DEFINE_COMPONENT_ACTION(channel, close);
 
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        struct pending_batch
+        {
+            pending_batch(std::vector<RemoteType> && values, bool last,
+                    bool close, lcos::local::promise<std::size_t> && credits)
+              : values_(std::move(values)), last_(last), close_(close)
+              , credits_(std::move(credits))
+            {}
+
+            std::vector<RemoteType> values_;
+            bool last_;
+            bool close_;
+            lcos::local::promise<std::size_t> credits_;
+        };
+
+        struct sender_data
+        {
+            sender_data()
+              : next_sequence_(0), applying_(false)
+            {}
+
+            std::uint64_t next_sequence_;
+            bool applying_;         // some thread is applying batches
+            std::map<std::uint64_t, pending_batch> pending_;
+        };
+
+        struct credit_grant
+        {
+            credit_grant(std::size_t threshold, std::size_t count,
+                    lcos::local::promise<std::size_t> && credits)
+              : threshold_(threshold), count_(count)
+              , credits_(std::move(credits))
+            {}
+
+            std::size_t threshold_;
+            std::size_t count_;
+            lcos::local::promise<std::size_t> credits_;
+        };
+
+        // Apply the batches of the given sender which are next in sequence.
+        // The batches are taken out of the table while holding the lock, but
+        // are applied after releasing it.
+        void apply_batches(std::uint64_t sender)
+        {
+            typedef typename std::map<
+                    std::uint64_t, pending_batch
+                >::iterator iterator;
+
+            std::unique_lock<lcos::local::mutex> l(senders_mtx_);
+            while (true)
+            {
+                typename std::map<std::uint64_t, sender_data>::iterator sit =
+                    senders_.find(sender);
+                HPX_ASSERT(sit != senders_.end());
+
+                sender_data& s = sit->second;
+
+                std::vector<pending_batch> ready;
+                bool last = false;
+
+                iterator it = s.pending_.begin();
+                while (!last && it != s.pending_.end() &&
+                    it->first == s.next_sequence_)
+                {
+                    last = it->second.last_;
+                    ready.push_back(std::move(it->second));
+
+                    it = s.pending_.erase(it);
+                    ++s.next_sequence_;
+                }
+
+                if (ready.empty())
+                {
+                    s.applying_ = false;
+                    if (!senders_closed_)
+                        return;
+
+                    // the channel was closed while this sender was waiting
+                    // for a missing batch, which will never be delivered
+                    for (auto& p : s.pending_)
+                        ready.push_back(std::move(p.second));
+                    senders_.erase(sit);
+
+                    l.unlock();
+                    fail_batches(ready);
+                    return;
+                }
+
+                if (last)
+                    senders_.erase(sit);
+
+                {
+                    util::unlock_guard<std::unique_lock<lcos::local::mutex> >
+                        ul(l);
+
+                    for (pending_batch& b : ready)
+                    {
+                        apply_batch(std::move(b.values_), b.close_,
+                            std::move(b.credits_));
+                    }
+                }
+
+                if (last)
+                    return;
+            }
+        }
+
+        void apply_batch(std::vector<RemoteType> && values, bool close,
+            lcos::local::promise<std::size_t> && credits)
+        {
+            std::size_t const count = values.size();
+            for (RemoteType& value : values)
+            {
+                hpx::future<void> f =
+                    channel_.set(launch::async, std::move(value));
+                if (f.has_exception())
+                {
+                    credits.set_exception(f.get_exception_ptr());
+                    return;
+                }
+            }
+
+            if (close)
+            {
+                try {
+                    this->close(false);
+                }
+                catch (...) {
+                    credits.set_exception(std::current_exception());
+                    return;
+                }
+            }
+
+            {
+                std::unique_lock<mutex_type> l(credits_mtx_);
+
+                pushed_ += count;
+                if (!closed_ && requested_ < pushed_)
+                {
+                    grants_.push_back(
+                        credit_grant(pushed_, count, std::move(credits)));
+                    return;
+                }
+            }
+            credits.set_value(count);
+        }
+
+        // Senders which never send their last batch (because they were
+        // destroyed while the runtime was shutting down, or because their
+        // locality has failed) would be kept forever. Once the channel is
+        // closed, no values will be delivered anymore and the entries of all
+        // senders are dropped. Batches still waiting for a predecessor fail
+        // as if they had been applied to the closed channel.
+        void release_senders()
+        {
+            std::vector<pending_batch> dropped;
+
+            {
+                std::lock_guard<lcos::local::mutex> l(senders_mtx_);
+
+                senders_closed_ = true;
+
+                typedef typename std::map<
+                        std::uint64_t, sender_data
+                    >::iterator iterator;
+
+                iterator it = senders_.begin();
+                while (it != senders_.end())
+                {
+                    // a thread applying batches of this sender releases
+                    // its entry once it's done
+                    if (it->second.applying_)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    for (auto& p : it->second.pending_)
+                        dropped.push_back(std::move(p.second));
+                    it = senders_.erase(it);
+                }
+            }
+
+            fail_batches(dropped);
+        }
+
+        void fail_batches(std::vector<pending_batch>& batches)
+        {
+            for (pending_batch& b : batches)
+                apply_batch(std::move(b.values_), false, std::move(b.credits_));
+        }
+
+        void values_pushed(std::size_t count)
+        {
+            std::lock_guard<mutex_type> l(credits_mtx_);
+            pushed_ += count;
+        }
+
+        // grant the credits for all batches whose values have been requested
+        void value_requested()
+        {
+            std::deque<credit_grant> granted;
+
+            {
+                std::lock_guard<mutex_type> l(credits_mtx_);
+
+                ++requested_;
+                while (!grants_.empty() &&
+                    grants_.front().threshold_ <= requested_)
+                {
+                    granted.push_back(std::move(grants_.front()));
+                    grants_.pop_front();
+                }
+            }
+
+            for (credit_grant& g : granted)
+                g.credits_.set_value(g.count_);
+        }
+
+        // no more values will be consumed once the channel is closed
+        void grant_all_credits()
+        {
+            std::deque<credit_grant> granted;
+
+            {
+                std::lock_guard<mutex_type> l(credits_mtx_);
+
+                closed_ = true;
+                std::swap(granted, grants_);
+            }
+
+            for (credit_grant& g : granted)
+                g.credits_.set_value(g.count_);
+        }
+
     private:
         lcos::local::channel<result_type> channel_;
+
+        lcos::local::mutex senders_mtx_;
+        std::map<std::uint64_t, sender_data> senders_;
+        bool senders_closed_;
+
+        mutex_type credits_mtx_;
+        std::size_t pushed_;
+        std::size_t requested_;
+        bool closed_;
+        std::deque<credit_grant> grants_;
     };
 }}}
 
@@ -138,6 +452,10 @@ namespace hpx { namespace lcos { namespace server
         hpx::lcos::server::channel< type>::set_generation_action,             \
         HPX_PP_CAT(__channel_set_generation_action,                           \
             HPX_PP_CAT(type, name)));                                         \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::channel< type>::set_values_action,                 \
+        HPX_PP_CAT(__channel_set_values_action,                               \
+            HPX_PP_CAT(type, name)));                                         \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         hpx::lcos::server::channel< type>::close_action,                      \
         HPX_PP_CAT(__channel_close_action,                                    \
@@ -176,6 +494,10 @@ namespace hpx { namespace lcos { namespace server
         hpx::lcos::server::channel< type>::set_generation_action,             \
         HPX_PP_CAT(__channel_set_generation_action,                           \
             HPX_PP_CAT(type, name)));                                         \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::channel< type>::set_values_action,                 \
+        HPX_PP_CAT(__channel_set_values_action,                               \
+            HPX_PP_CAT(type, name)));                                         \
     HPX_REGISTER_ACTION(                                                      \
         hpx::lcos::server::channel< type>::close_action,                      \
         HPX_PP_CAT(__channel_close_action,                                    \
@@ -196,6 +196,7 @@ namespace hpx { namespace lcos
             explicit async_when_all_frame(
                 typename base_type::init_no_addref no_addref)
               : future_data<typename when_all_result<Tuple>::type>(no_addref)
+              , detach_node_(true)
             {
             }
 
@@ -209,11 +210,14 @@ namespace hpx { namespace lcos
             template <typename T, typename N>
             auto operator()(
                 util::async_traverse_detach_tag, T&& current, N&& next)
-                -> decltype(async_detach_future(
-                    std::forward<T>(current), std::forward<N>(next)))
+                -> decltype(async_detach_future(std::forward<T>(current),
+                    std::forward<N>(next), std::declval<
+                        typename base_type::completed_callback_node&>()))
             {
-                return async_detach_future(
-                    std::forward<T>(current), std::forward<N>(next));
+                // the traversal waits for one future at a time, the same
+                // list element can be reused for all of them
+                return async_detach_future(std::forward<T>(current),
+                    std::forward<N>(next), detach_node_);
             }
 
             template <typename T>
@@ -222,6 +226,9 @@ namespace hpx { namespace lcos
                 this->set_value(
                     when_all_result<Tuple>::call(std::forward<T>(pack)));
             }
+
+        private:
+            typename base_type::completed_callback_node detach_node_;
         };
 
         template <typename... T>
@@ -13,6 +13,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 
@@ -26,8 +27,8 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/transfer.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 #include <hpx/util/unused.hpp>
@@ -418,7 +419,7 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
-                typedef util::scan_partitioner<
+                typedef util::lookback_scan_partitioner<
                         ExPolicy, std::pair<FwdIter1, FwdIter2>, std::size_t
                     > scan_partitioner_type;
 
@@ -450,22 +451,21 @@ namespace hpx { namespace parallel { inline namespace v1
                 auto f3 =
                     [dest, flags, policy](
                         zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<std::size_t> curr,
-                        hpx::shared_future<std::size_t> next
-                    ) mutable
+                        std::size_t offset
+                    )
                     {
                         HPX_UNUSED(flags);
                         HPX_UNUSED(policy);
 
-                        next.get();     // rethrow exceptions
-
-                        std::advance(dest, curr.get());
+                        // this is invoked concurrently for all tiles
+                        FwdIter2 dst = dest;
+                        std::advance(dst, offset);
                         util::loop_n<ExPolicy>(
                             part_begin, part_size,
-                            [&dest](zip_iterator it) mutable
+                            [&dst](zip_iterator it) mutable
                             {
                                 if(get<1>(*it))
-                                    *dest++ = get<0>(*it);
+                                    *dst++ = get<0>(*it);
                             });
                     };
 
@@ -474,24 +474,55 @@ namespace hpx { namespace parallel { inline namespace v1
                     make_zip_iterator(first, flags.get()), count, init,
                     // step 1 performs first part of scan algorithm
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(std::plus<std::size_t>()),
-                    // step 3 runs final accumulation on each partition
+                    // step 2 combines the results of adjacent tiles
+                    std::plus<std::size_t>(),
+                    // step 3 runs final accumulation on each tile
                     std::move(f3),
                     // step 4 use this return value
-                    [last, dest, flags](
-                        std::vector<hpx::shared_future<std::size_t> > && items,
-                        std::vector<hpx::future<void> > &&) mutable
+                    [last, dest, flags](std::size_t total) mutable
                     ->  std::pair<FwdIter1, FwdIter2>
                     {
                         HPX_UNUSED(flags);
 
-                        std::advance(dest, items.back().get());
+                        std::advance(dest, total);
                         return std::make_pair(last, dest);
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::copy_if<std::pair<FwdIter1, FwdIter2> >().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, dest, std::forward<F>(f),
+                std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -595,12 +626,6 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_output_iterator<FwdIter2>::value ||
                 hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least output iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -608,15 +633,19 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
+        // the segmented version requires both sequences to be segmented
+        typedef std::integral_constant<bool,
+                hpx::traits::is_segmented_iterator<FwdIter1>::value &&
+                hpx::traits::is_segmented_iterator<FwdIter2>::value
+            > is_segmented;
+
         return hpx::util::make_tagged_pair<tag::in, tag::out>(
-            detail::copy_if<std::pair<FwdIter1, FwdIter2> >().call(
-                std::forward<ExPolicy>(policy), is_seq(),
-                first, last, dest, std::forward<F>(f),
-                std::forward<Proj>(proj)));
+            detail::copy_if_(
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<F>(f), std::forward<Proj>(proj),
+                is_segmented()));
     }
 }}}
 
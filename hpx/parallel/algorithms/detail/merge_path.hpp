@@ -0,0 +1,184 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_MERGE_PATH_HPP)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_MERGE_PATH_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The merge path of two sorted ranges is the sequence of decisions taken
+    // by a sequential (stable) merge. The output position 'diag' of the
+    // merge corresponds to a cross diagonal of the merge matrix, the point
+    // where the merge path crosses this diagonal (the co-rank) can be found
+    // by a binary search. This allows to split the merge into independent
+    // pieces of equal output size regardless of the distribution of the
+    // values.
+    //
+    // Returns the number of elements taken from the first range while
+    // producing the first 'diag' elements of the stable merge of both ranges.
+    // Equivalent elements are taken from the first range first.
+    template <typename RandIter1, typename RandIter2, typename Comp>
+    std::size_t merge_path_partition(RandIter1 first1, std::size_t size1,
+        RandIter2 first2, std::size_t size2, std::size_t diag, Comp && comp)
+    {
+        HPX_ASSERT(diag <= size1 + size2);
+
+        std::size_t low = diag > size2 ? diag - size2 : 0;
+        std::size_t high = (std::min)(diag, size1);
+
+        while (low < high)
+        {
+            std::size_t mid = low + (high - low) / 2;
+
+            // first1[mid] precedes first2[diag - mid - 1] in the output if
+            // the latter is not less than the former
+            if (!comp(first2[diag - mid - 1], first1[mid]))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    }
+
+    // Stable sequential merge moving the elements to the destination.
+    template <typename RandIter1, typename RandIter2, typename RandIter3,
+        typename Comp>
+    RandIter3 merge_path_move(RandIter1 first1, RandIter1 last1,
+        RandIter2 first2, RandIter2 last2, RandIter3 dest, Comp && comp)
+    {
+        if (first1 != last1 && first2 != last2)
+        {
+            while (true)
+            {
+                if (comp(*first2, *first1))
+                {
+                    *dest++ = std::move(*first2++);
+                    if (first2 == last2)
+                        break;
+                }
+                else
+                {
+                    *dest++ = std::move(*first1++);
+                    if (first1 == last1)
+                        break;
+                }
+            }
+        }
+        dest = std::move(first1, last1, dest);
+        return std::move(first2, last2, dest);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Determine the number of elements to be handled by a single task from
+    // the executor parameters of the given execution policy, no task handles
+    // less than min_chunk_size elements.
+    template <typename ExPolicy>
+    std::size_t merge_path_chunk_size(ExPolicy && policy, std::size_t count,
+        std::size_t min_chunk_size)
+    {
+        if (count == 0)
+            return min_chunk_size;
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t max_chunks = execution::maximal_number_of_chunks(
+            policy.parameters(), policy.executor(), cores, count);
+        HPX_ASSERT(0 != max_chunks);
+
+        std::size_t chunk_size = execution::get_chunk_size(
+            policy.parameters(), policy.executor(),
+            []() -> std::size_t { return 0; }, cores, count);
+
+        chunk_size = (std::max)(chunk_size,
+            (count + max_chunks - 1) / max_chunks);
+
+        return (std::max)(chunk_size, min_chunk_size);
+    }
+
+    // Schedule the production of the first 'count' elements of the stable
+    // merge of both ranges. The output is split into blocks of chunk_size
+    // elements each of which is merged by a separate task. The split points
+    // are determined before any of the tasks is started as the tasks move
+    // the elements out of the source ranges.
+    template <typename ExPolicy, typename RandIter1, typename RandIter2,
+        typename RandIter3, typename Comp>
+    void merge_path_async(ExPolicy && policy,
+        std::vector<hpx::future<void> >& workitems,
+        RandIter1 first1, std::size_t size1,
+        RandIter2 first2, std::size_t size2, RandIter3 dest,
+        std::size_t count, std::size_t chunk_size, Comp const& comp)
+    {
+        HPX_ASSERT(count <= size1 + size2);
+        HPX_ASSERT(chunk_size != 0);
+
+        std::vector<std::size_t> splits;
+        splits.reserve(count / chunk_size + 2);
+
+        for (std::size_t diag = 0; diag < count; diag += chunk_size)
+        {
+            splits.push_back(merge_path_partition(
+                first1, size1, first2, size2, diag, comp));
+        }
+        splits.push_back(merge_path_partition(
+            first1, size1, first2, size2, count, comp));
+
+        for (std::size_t i = 0; i != splits.size() - 1; ++i)
+        {
+            std::size_t begin = i * chunk_size;
+            std::size_t end = (std::min)(begin + chunk_size, count);
+
+            RandIter1 block_first1 = first1 + splits[i];
+            RandIter1 block_last1 = first1 + splits[i + 1];
+            RandIter2 block_first2 = first2 + (begin - splits[i]);
+            RandIter2 block_last2 = first2 + (end - splits[i + 1]);
+            RandIter3 block_dest = dest + begin;
+
+            workitems.push_back(execution::async_execute(
+                policy.executor(),
+                [=]() -> void
+                {
+                    merge_path_move(block_first1, block_last1,
+                        block_first2, block_last2, block_dest, comp);
+                }));
+        }
+    }
+
+    // Wait for the given tasks and rethrow their exceptions (if any) as
+    // required by the execution policy.
+    template <typename ExPolicy, typename Result>
+    void merge_path_wait(std::vector<hpx::future<Result> >& workitems)
+    {
+        hpx::wait_all(workitems);
+
+        std::list<std::exception_ptr> errors;
+        util::detail::handle_local_exceptions<ExPolicy>::call(
+            workitems, errors);
+    }
+
+    /// \endcond
+}}}}
+
+#endif
@@ -290,6 +290,8 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
     template <typename Value>
     struct compare_to
     {
+        compare_to() = default;
+
         HPX_HOST_DEVICE HPX_FORCEINLINE
         compare_to(Value && val)
           : value_(std::move(val))
@@ -307,6 +309,12 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
             return value_ == t;
         }
 
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & value_;
+        }
+
         Value value_;
     };
 
@@ -0,0 +1,427 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_HPP)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/always_void.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/result_of.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Maps arithmetic keys onto unsigned integers of the same size such that
+    // the order defined by operator< on the keys is preserved.
+    template <typename T, typename Enable = void>
+    struct radix_key
+    {};
+
+    template <typename T>
+    struct radix_key<T,
+        typename std::enable_if<
+            std::is_integral<T>::value && std::is_unsigned<T>::value &&
+           !std::is_same<T, bool>::value
+        >::type>
+    {
+        typedef T type;
+
+        static type encode(T key)
+        {
+            return key;
+        }
+    };
+
+    // flip the sign bit of signed integers
+    template <typename T>
+    struct radix_key<T,
+        typename std::enable_if<
+            std::is_integral<T>::value && std::is_signed<T>::value
+        >::type>
+    {
+        typedef typename std::make_unsigned<T>::type type;
+
+        static type encode(T key)
+        {
+            return type(key) ^ (type(1) << (sizeof(T) * CHAR_BIT - 1));
+        }
+    };
+
+    // flip all bits of negative IEEE 754 numbers and the sign bit of all
+    // others
+    template <typename T>
+    struct radix_key<T,
+        typename std::enable_if<
+            std::is_floating_point<T>::value &&
+            std::numeric_limits<T>::is_iec559 &&
+            (sizeof(T) == sizeof(std::uint32_t) ||
+                sizeof(T) == sizeof(std::uint64_t))
+        >::type>
+    {
+        typedef typename std::conditional<
+                sizeof(T) == sizeof(std::uint32_t),
+                std::uint32_t, std::uint64_t
+            >::type type;
+
+        static type encode(T key)
+        {
+            type bits;
+            std::memcpy(&bits, &key, sizeof(T));
+
+            type const sign = type(1) << (sizeof(T) * CHAR_BIT - 1);
+            return (bits & sign) ? type(~bits) : type(bits | sign);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The elements are sorted with a radix sort if the (projected) keys are
+    // arithmetic and are compared using operator<.
+    template <typename Compare, typename Key>
+    struct is_radix_compare
+      : std::false_type
+    {};
+
+    template <typename Key>
+    struct is_radix_compare<detail::less, Key>
+      : std::true_type
+    {};
+
+    template <typename Key>
+    struct is_radix_compare<std::less<Key>, Key>
+      : std::true_type
+    {};
+
+    template <typename Compare, typename Proj, typename Iter,
+        typename Enable = void>
+    struct use_radix_sort
+      : std::false_type
+    {};
+
+    template <typename Compare, typename Proj, typename Iter>
+    struct use_radix_sort<Compare, Proj, Iter,
+        typename hpx::util::always_void<
+            typename radix_key<
+                typename hpx::util::decay<
+                    typename hpx::util::invoke_result<Proj,
+                        typename std::iterator_traits<Iter>::reference
+                    >::type
+                >::type
+            >::type
+        >::type>
+      : std::integral_constant<bool,
+            is_radix_compare<
+                typename hpx::util::decay<Compare>::type,
+                typename hpx::util::decay<
+                    typename hpx::util::invoke_result<Proj,
+                        typename std::iterator_traits<Iter>::reference
+                    >::type
+                >::type
+            >::value &&
+            // the elements are moved through a temporary buffer
+            std::is_default_constructible<
+                typename std::iterator_traits<Iter>::value_type
+            >::value>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // smaller sequences are handled by the comparison based sort
+    static const std::size_t radix_sort_limit = 65536ul;
+    static const std::size_t radix_sort_limit_per_task = 16384ul;
+
+    static const std::size_t radix_sort_bits = 8;
+    static const std::size_t radix_sort_buckets = 1ul << radix_sort_bits;
+
+    template <typename Proj, typename Iter>
+    struct radix_sort_key
+    {
+        typedef typename hpx::util::decay<
+                typename hpx::util::invoke_result<Proj,
+                    typename std::iterator_traits<Iter>::reference
+                >::type
+            >::type key_type;
+
+        typedef radix_key<key_type> traits;
+        typedef typename traits::type type;
+
+        static std::size_t const num_passes =
+            sizeof(type) * CHAR_BIT / radix_sort_bits;
+    };
+
+    template <typename Iter, typename Proj>
+    std::size_t radix_sort_digit(Iter it, Proj const& proj, std::size_t shift)
+    {
+        typedef typename radix_sort_key<Proj, Iter>::traits traits;
+        return std::size_t(
+            (traits::encode(hpx::util::invoke(proj, *it)) >> shift) &
+                (radix_sort_buckets - 1));
+    }
+
+    // Wait for the given tasks and rethrow their exceptions (if any) as
+    // required by the execution policy.
+    template <typename ExPolicy>
+    void radix_sort_wait(std::vector<hpx::future<void> >& workitems)
+    {
+        hpx::wait_all(workitems);
+
+        std::list<std::exception_ptr> errors;
+        util::detail::handle_local_exceptions<ExPolicy>::call(
+            workitems, errors);
+
+        workitems.clear();
+    }
+
+    // Each chunk counts the digits of its elements in parallel.
+    template <typename ExPolicy, typename Iter, typename Proj>
+    void radix_sort_histograms(ExPolicy& policy, Iter src,
+        std::vector<std::size_t> const& chunks, std::size_t* histograms,
+        std::size_t shift, Proj const& proj)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+        std::vector<hpx::future<void> > workitems;
+        workitems.reserve(chunks.size());
+
+        for (std::size_t c = 0; c != chunks.size() - 1; ++c)
+        {
+            std::size_t* hist = histograms + c * radix_sort_buckets;
+            std::size_t begin = chunks[c];
+            std::size_t end = chunks[c + 1];
+
+            workitems.push_back(execution::async_execute(
+                policy.executor(),
+                [=, &proj]() -> void
+                {
+                    std::fill(hist, hist + radix_sort_buckets, std::size_t(0));
+                    for (std::size_t i = begin; i != end; ++i)
+                        ++hist[radix_sort_digit(src + i, proj, shift)];
+                }));
+        }
+
+        radix_sort_wait<policy_type>(workitems);
+    }
+
+    // Turn the histograms into the positions each chunk writes its elements
+    // to. The positions are assigned digit by digit and chunk by chunk which
+    // keeps every pass stable. Returns false if all elements have the same
+    // digit, the pass can be skipped in this case.
+    inline bool radix_sort_offsets(std::size_t* histograms,
+        std::size_t num_chunks, std::size_t count)
+    {
+        std::size_t total = 0;
+        for (std::size_t d = 0; d != radix_sort_buckets; ++d)
+        {
+            std::size_t bucket = 0;
+            for (std::size_t c = 0; c != num_chunks; ++c)
+            {
+                std::size_t& pos = histograms[c * radix_sort_buckets + d];
+                std::size_t n = pos;
+                pos = total;
+                total += n;
+                bucket += n;
+            }
+
+            if (bucket == count)
+                return false;
+        }
+
+        HPX_ASSERT(total == count);
+        return true;
+    }
+
+    // Each chunk moves its elements to the positions of their digits.
+    template <typename ExPolicy, typename Iter1, typename Iter2,
+        typename Proj>
+    void radix_sort_scatter(ExPolicy& policy, Iter1 src, Iter2 dest,
+        std::vector<std::size_t> const& chunks, std::size_t* histograms,
+        std::size_t shift, Proj const& proj)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+        std::vector<hpx::future<void> > workitems;
+        workitems.reserve(chunks.size());
+
+        for (std::size_t c = 0; c != chunks.size() - 1; ++c)
+        {
+            std::size_t* pos = histograms + c * radix_sort_buckets;
+            std::size_t begin = chunks[c];
+            std::size_t end = chunks[c + 1];
+
+            workitems.push_back(execution::async_execute(
+                policy.executor(),
+                [=, &proj]() -> void
+                {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        std::size_t d = radix_sort_digit(src + i, proj, shift);
+                        dest[pos[d]++] = std::move(src[i]);
+                    }
+                }));
+        }
+
+        radix_sort_wait<policy_type>(workitems);
+    }
+
+    // Performs one pass of the radix sort moving the elements from src to
+    // dest, returns false if the pass was skipped.
+    template <typename ExPolicy, typename Iter1, typename Iter2,
+        typename Proj>
+    bool radix_sort_pass(ExPolicy& policy, Iter1 src, Iter2 dest,
+        std::vector<std::size_t> const& chunks, std::size_t* histograms,
+        std::size_t shift, Proj const& proj)
+    {
+        radix_sort_histograms(policy, src, chunks, histograms, shift, proj);
+
+        if (!radix_sort_offsets(histograms, chunks.size() - 1,
+                chunks.back()))
+        {
+            return false;
+        }
+
+        radix_sort_scatter(policy, src, dest, chunks, histograms, shift,
+            proj);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Least significant digit radix sort using one chunk per processing unit
+    // (as limited by the executor parameters of the execution policy). Each
+    // pass computes the per-chunk histograms of the current digit in
+    // parallel and scatters the elements to a temporary buffer (and back).
+    // Passes over digits shared by all keys are skipped.
+    template <typename ExPolicy, typename RandomIt, typename Proj>
+    void parallel_radix_sort_helper(ExPolicy& policy, RandomIt first,
+        RandomIt last, Proj const& proj)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type
+            value_type;
+        typedef radix_sort_key<Proj, RandomIt> key;
+
+        std::size_t const count = std::size_t(last - first);
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t num_chunks = (std::min)(
+            execution::maximal_number_of_chunks(
+                policy.parameters(), policy.executor(), cores, count),
+            cores);
+        num_chunks = (std::max)((std::min)(num_chunks,
+            (count + radix_sort_limit_per_task - 1) /
+                radix_sort_limit_per_task), std::size_t(1));
+
+        std::vector<std::size_t> chunks;
+        chunks.reserve(num_chunks + 1);
+        for (std::size_t c = 0; c != num_chunks; ++c)
+            chunks.push_back(c * (count / num_chunks));
+        chunks.push_back(count);
+
+        std::vector<std::size_t> histograms(num_chunks * radix_sort_buckets);
+        std::unique_ptr<value_type[]> buffer(new value_type[count]);
+
+        bool in_buffer = false;
+        for (std::size_t pass = 0; pass != key::num_passes; ++pass)
+        {
+            std::size_t shift = pass * radix_sort_bits;
+
+            bool moved = false;
+            if (in_buffer)
+            {
+                moved = radix_sort_pass(policy, buffer.get(), first, chunks,
+                    histograms.data(), shift, proj);
+            }
+            else
+            {
+                moved = radix_sort_pass(policy, first, buffer.get(), chunks,
+                    histograms.data(), shift, proj);
+            }
+
+            if (moved)
+                in_buffer = !in_buffer;
+        }
+
+        // move the result back into the input range, if needed
+        if (in_buffer)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+            std::vector<hpx::future<void> > workitems;
+            workitems.reserve(num_chunks);
+
+            value_type* src = buffer.get();
+            for (std::size_t c = 0; c != num_chunks; ++c)
+            {
+                std::size_t begin = chunks[c];
+                std::size_t end = chunks[c + 1];
+
+                workitems.push_back(execution::async_execute(
+                    policy.executor(),
+                    [=]() -> void
+                    {
+                        std::move(src + begin, src + end, first + begin);
+                    }));
+            }
+
+            radix_sort_wait<policy_type>(workitems);
+        }
+    }
+
+    template <typename ExPolicy, typename RandomIt, typename Proj>
+    hpx::future<RandomIt>
+    parallel_radix_sort_async(ExPolicy && policy, RandomIt first,
+        RandomIt last, Proj && proj)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+        return execution::async_execute(policy.executor(),
+            [policy, first, last, proj]() mutable -> RandomIt
+            {
+                try {
+                    parallel_radix_sort_helper(policy, first, last, proj);
+                    return last;
+                }
+                catch (...) {
+                    util::detail::handle_local_exceptions<
+                            policy_type
+                        >::call(std::current_exception());
+                }
+
+                // Not reachable.
+                HPX_ASSERT(false);
+                return last;
+            });
+    }
+
+    /// \endcond
+}}}}
+
+#endif
@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2015 Hartmut Kaiser
+//  Copyright (c) 2007-2017 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -7,7 +7,8 @@
 #define HPX_PARALLEL_ALGORITHMS_SET_OPERATION_MAR_06_2015_0704PM
 
 #include <hpx/config.hpp>
-#include <hpx/util/assert.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/decay.hpp>
 
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/executors/execution_information.hpp>
@@ -17,174 +18,219 @@
 
 #include <boost/shared_array.hpp>
 
+#include <algorithm>
 #include <cstddef>
-#include <type_traits>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace parallel { inline namespace v1 { namespace detail
 {
     /// \cond NOINTERNAL
 
+    // The set operations partition the input along the merge path of both
+    // sequences: every chunk covers (about) the same number of elements of
+    // both sequences combined, independently of how these are distributed
+    // over the two sequences. The number of elements produced by each chunk
+    // is counted first, which allows for every chunk to write its result
+    // directly to its final position in the destination afterwards.
+
     ///////////////////////////////////////////////////////////////////////////
-    template <typename FwdIter>
-    struct set_operations_buffer
+    // Output iterator counting the elements written to it.
+    struct set_operation_counter
     {
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        set_operation_counter& operator*()
+        {
+            return *this;
+        }
+
         template <typename T>
-        class rewritable_ref
+        set_operation_counter& operator=(T const&)
         {
-        public:
-            rewritable_ref() : item_(0) {}
-            rewritable_ref(T const& item) : item_(item) {}
+            return *this;
+        }
 
-            rewritable_ref& operator= (T const& item)
-            {
-                item_ = &item;
-                return *this;
-            }
+        set_operation_counter& operator++()
+        {
+            ++count_;
+            return *this;
+        }
 
-            operator T const&() const
-            {
-                HPX_ASSERT(item_ != 0);
-                return *item_;
-            }
-
-        private:
-            T const* item_;
-        };
-
-        typedef typename std::iterator_traits<FwdIter>::value_type value_type;
-        typedef typename std::conditional<
-            std::is_scalar<value_type>::value,
-            value_type, rewritable_ref<value_type>
-        >::type type;
+        set_operation_counter operator++(int)
+        {
+            set_operation_counter tmp = *this;
+            ++count_;
+            return tmp;
+        }
+
+        std::size_t count_;
     };
 
     struct set_chunk_data
     {
-        std::size_t start;
+        std::size_t start1;
+        std::size_t end1;
+        std::size_t start2;
+        std::size_t end2;
         std::size_t len;
         std::size_t start_index;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Adjust the split of both sequences at the given merge path position
+    // such that it does not separate equivalent elements which are matched
+    // by the set operation: the k-th element equivalent to x in the first
+    // sequence is matched with the k-th element equivalent to x in the
+    // second sequence. The elements equivalent to x preceding the split are
+    // divided evenly between both sequences.
+    template <typename RanIter1, typename RanIter2, typename T, typename F>
+    std::pair<std::size_t, std::size_t> set_operation_balance_split(
+        RanIter1 first1, std::size_t len1, RanIter2 first2, std::size_t len2,
+        std::size_t i, std::size_t j, T const& x, F const& f)
+    {
+        std::size_t run1 = std::lower_bound(first1, first1 + i, x, f) - first1;
+        std::size_t run2 = std::lower_bound(first2, first2 + j, x, f) - first2;
+
+        std::size_t count1 =
+            std::upper_bound(first1 + i, first1 + len1, x, f) - first1 - run1;
+        std::size_t count2 =
+            std::upper_bound(first2 + j, first2 + len2, x, f) - first2 - run2;
+
+        std::size_t matched = (i - run1 + j - run2 + 1) / 2;
+        return std::make_pair(run1 + (std::min)(matched, count1),
+            run2 + (std::min)(matched, count2));
+    }
+
+    // Find the number of elements of both sequences preceding the given
+    // position on their merge path.
+    template <typename RanIter1, typename RanIter2, typename F>
+    std::pair<std::size_t, std::size_t> set_operation_split(
+        RanIter1 first1, std::size_t len1, RanIter2 first2, std::size_t len2,
+        std::size_t diag, F const& f)
+    {
+        std::size_t lo = (diag > len2) ? diag - len2 : 0;
+        std::size_t hi = (std::min)(diag, len1);
+
+        while (lo < hi)
+        {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (!f(first2[diag - mid - 1], first1[mid]))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        std::size_t i = lo;
+        std::size_t j = diag - lo;
+
+        if (i == len1 && j == len2)
+            return std::make_pair(i, j);
+
+        // balance the split based on the element following it on the merge
+        // path, equivalent elements of the first sequence come first
+        if (i != len1 && (j == len2 || !f(first2[j], first1[i])))
+        {
+            return set_operation_balance_split(first1, len1, first2, len2,
+                i, j, first1[i], f);
+        }
+        return set_operation_balance_split(first1, len1, first2, len2,
+            i, j, first2[j], f);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename ExPolicy, typename RanIter1, typename RanIter2,
-        typename FwdIter, typename F, typename Combiner, typename SetOp>
+        typename FwdIter, typename F, typename SetOp>
     typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
     set_operation(ExPolicy policy,
         RanIter1 first1, RanIter1 last1, RanIter2 first2, RanIter2 last2,
-        FwdIter dest, F && f, Combiner && combiner, SetOp && setop)
+        FwdIter dest, F && f, SetOp && setop)
     {
-        typedef typename std::iterator_traits<RanIter1>::difference_type
-            difference_type1;
-        typedef typename std::iterator_traits<RanIter2>::difference_type
-            difference_type2;
-
-        // allocate intermediate buffers
-        difference_type1 len1 = std::distance(first1, last1);
-        difference_type2 len2 = std::distance(first2, last2);
+        typedef typename hpx::util::decay<F>::type func_type;
+        typedef typename hpx::util::decay<SetOp>::type setop_type;
 
-        typedef typename set_operations_buffer<FwdIter>::type buffer_type;
-        boost::shared_array<buffer_type> buffer(
-            new buffer_type[combiner(len1, len2)]);
+        std::size_t len1 = std::distance(first1, last1);
+        std::size_t len2 = std::distance(first2, last2);
+        std::size_t size = len1 + len2;
 
         std::size_t cores = execution::processing_units_count(
             policy.executor(), policy.parameters());
 
-        std::size_t step = (len1 + cores - 1) / cores;
-        boost::shared_array<set_chunk_data> chunks(new set_chunk_data[cores]);
+        // create more chunks than cores to compensate for differences in
+        // the time needed to run the set operation on the chunks
+        std::size_t count = (std::min)(4 * cores, size);
+        boost::shared_array<set_chunk_data> chunks(new set_chunk_data[count]);
 
-        // fill the buffer piecewise
+        func_type func(std::forward<F>(f));
+        setop_type op(std::forward<SetOp>(setop));
+
+        // first pass: split the input and count the elements produced by
+        // each of the chunks
         return parallel::util::partitioner<ExPolicy, FwdIter, void>::call(
-            policy, chunks.get(), cores,
-            // first step, is applied to all partitions
-            [=](set_chunk_data* curr_chunk, std::size_t part_size) -> void
+            policy, chunks.get(), count,
+            [=](set_chunk_data* part_begin, std::size_t part_size) -> void
             {
-                HPX_ASSERT(part_size == 1);
-
-                // find start in sequence 1
-                std::size_t start1 = (curr_chunk - chunks.get()) * step;
-                std::size_t end1 = (std::min)(start1 + step, std::size_t(len1));
-
-                bool first_partition = (start1 == 0);
-                bool last_partition = (end1 == std::size_t(len1));
-
-                // all but the last chunk require special handling
-                if (!last_partition)
+                for (/**/; part_size != 0; (void) ++part_begin, --part_size)
                 {
-                    // this chunk will be handled by the next one if all
-                    // elements of this partition are equal
-                    if (!f(first1[start1], first1[end1 + 1]))
-                        return;
-
-                    // move backwards to find earliest element which is equal to
-                    // the last element of the current chunk
-                    while (end1 != 0 && !f(first1[end1 - 1], first1[end1]))
-                        --end1;
+                    std::size_t k = part_begin - chunks.get();
+
+                    std::pair<std::size_t, std::size_t> start =
+                        set_operation_split(first1, len1, first2, len2,
+                            k * size / count, func);
+                    std::pair<std::size_t, std::size_t> end =
+                        set_operation_split(first1, len1, first2, len2,
+                            (k + 1) * size / count, func);
+
+                    part_begin->start1 = start.first;
+                    part_begin->end1 = end.first;
+                    part_begin->start2 = start.second;
+                    part_begin->end2 = end.second;
+                    part_begin->len =
+                        op(first1 + start.first, first1 + end.first,
+                            first2 + start.second, first2 + end.second,
+                            set_operation_counter{0}, func).count_;
                 }
-
-                // move backwards to find earliest element which is equal to
-                // the first element of the current chunk
-                while (start1 != 0 && !f(first1[start1 - 1], first1[start1]))
-                    --start1;
-
-                // find start and end in sequence 2
-                std::size_t start2 = 0;
-                if (!first_partition)
-                {
-                    start2 =
-                        std::lower_bound(
-                            first2, first2 + len2, first1[start1], f
-                        ) - first2;
-                }
-
-                std::size_t end2 = len2;
-                if (!last_partition)
-                {
-                    end2 =
-                        std::lower_bound(
-                            first2 + start2, first2 + len2, first1[end1], f
-                        ) - first2;
-                }
-
-                // perform requested set-operation into the proper place of the
-                // intermediate buffer
-                curr_chunk->start = combiner(start1, start2);
-                auto buffer_dest = buffer.get() + curr_chunk->start;
-                curr_chunk->len =
-                    setop(first1 + start1, first1 + end1,
-                          first2 + start2, first2 + end2, buffer_dest, f
-                    ) - buffer_dest;
             },
-            // second step, is executed after all partitions are done running
-            [buffer, chunks, cores, dest](std::vector<future<void> >&&) -> FwdIter
+            // second pass: let every chunk write its elements to their final
+            // position, this is executed after all partitions are done
+            // running
+            [=](std::vector<hpx::future<void> >&&) -> FwdIter
             {
-                // accumulate real length
-                set_chunk_data* chunk = chunks.get();
-                chunk->start_index = 0;
-                for (size_t i = 1; i != cores; ++i)
+                std::size_t start_index = 0;
+                for (std::size_t k = 0; k != count; ++k)
                 {
-                    set_chunk_data* curr_chunk = chunk++;
-                    chunk->start_index =
-                        curr_chunk->start_index + curr_chunk->len;
+                    chunks[k].start_index = start_index;
+                    start_index += chunks[k].len;
                 }
 
-                // finally, copy data to destination
                 parallel::util::foreach_partitioner<
                         hpx::parallel::execution::parallel_policy
-                    >::call(execution::par, chunks.get(), cores,
-                        [buffer, dest](
-                            set_chunk_data* chunk, std::size_t, std::size_t)
+                    >::call(execution::par, chunks.get(), count,
+                        [=](set_chunk_data* part_begin, std::size_t part_size,
+                            std::size_t)
                         {
-                            std::copy(buffer.get() + chunk->start,
-                                buffer.get() + chunk->start + chunk->len,
-                                dest + chunk->start_index);
+                            for (/**/; part_size != 0;
+                                 (void) ++part_begin, --part_size)
+                            {
+                                op(first1 + part_begin->start1,
+                                    first1 + part_begin->end1,
+                                    first2 + part_begin->start2,
+                                    first2 + part_begin->end2,
+                                    std::next(dest, part_begin->start_index),
+                                    func);
+                            }
                         },
                         [](set_chunk_data* last) -> set_chunk_data*
                         {
                             return last;
                         });
 
-                return dest;
+                return std::next(dest, start_index);
             });
     }
 
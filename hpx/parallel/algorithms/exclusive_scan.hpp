@@ -12,7 +12,6 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
 #include <hpx/util/invoke.hpp>
-#include <hpx/util/unwrap.hpp>
 #include <hpx/util/zip_iterator.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -20,9 +19,9 @@
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/util/unused.hpp>
 
 #include <algorithm>
@@ -114,11 +113,11 @@ namespace hpx { namespace parallel { inline namespace v1
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 3
-                // steps. The first calculates the scan results for each
-                // partition. The second accumulates the result from left to
-                // right to be used by the third step--which operates on the
-                // same partitions the first step operated on.
+                // The overall scan algorithm is performed in a single pass
+                // over the input. The first step calculates the scan results
+                // for each tile. The tiles then look back at the results
+                // published by their predecessors to find their prefix,
+                // which the third step applies to the (still cached) tile.
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
@@ -126,14 +125,11 @@ namespace hpx { namespace parallel { inline namespace v1
                 auto f3 =
                     [op, policy](
                         zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
+                        T val
                     )
                     {
                         HPX_UNUSED(policy);
 
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
                         FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
                         *dst++ = val;
 
@@ -146,7 +142,9 @@ namespace hpx { namespace parallel { inline namespace v1
                             });
                     };
 
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
+                return util::lookback_scan_partitioner<
+                        ExPolicy, FwdIter2, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
                     // step 1 performs first part of scan algorithm
@@ -165,14 +163,12 @@ namespace hpx { namespace parallel { inline namespace v1
                         else
                             return part_init;
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final accumulation on each partition
+                    // step 2 combines the results of adjacent tiles
+                    op,
+                    // step 3 runs final accumulation on each tile
                     std::move(f3),
                     // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&)
+                    [final_dest](T const&)
                     {
                         return final_dest;
                     });
@@ -0,0 +1,1026 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/hash_reduce_by_key.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_HASH_REDUCE_BY_KEY_OCT_19_2017)
+#define HPX_PARALLEL_ALGORITHM_HASH_REDUCE_BY_KEY_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/for_each.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+#include <hpx/parallel/util/zip_iterator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // hash_reduce_by_key, histogram, group_by
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // The hash based aggregation runs in three phases:
+        //
+        // - every chunk of the input is aggregated into thread-local hash
+        //   tables, one for each partition of the key space (the partition
+        //   of a key is selected by its hash value),
+        // - the tables of each of the partitions are merged independently
+        //   of each other, in the order of the chunks,
+        // - the merged partitions are written to their (precomputed)
+        //   positions in the output sequences.
+        //
+        // Partitioning the key space keeps the merge phase parallel even if
+        // the number of distinct keys is large.
+
+        // Select the partition a key belongs to from its hash value. The
+        // hash is scrambled first, as the hash tables themselves select
+        // their buckets from the low order bits.
+        inline std::size_t hash_partition_index(std::size_t hash,
+            std::size_t parts)
+        {
+            return static_cast<std::size_t>(
+                (static_cast<std::uint64_t>(hash) *
+                    0x9e3779b97f4a7c15ull) >> 32) % parts;
+        }
+
+        template <typename ExPolicy>
+        std::size_t hash_partition_count(ExPolicy& policy, std::false_type)
+        {
+            return execution::processing_units_count(
+                policy.executor(), policy.parameters());
+        }
+
+        template <typename ExPolicy>
+        std::size_t hash_partition_count(ExPolicy&, std::true_type)
+        {
+            return 1;
+        }
+
+        template <typename Table, typename Key, typename T, typename Func>
+        void hash_accumulate(Table& table, Key const& key, T && value,
+            Func const& func)
+        {
+            auto it = table.find(key);
+            if (it == table.end())
+            {
+                table.emplace(key, std::forward<T>(value));
+            }
+            else
+            {
+                it->second = hpx::util::invoke(func, it->second,
+                    std::forward<T>(value));
+            }
+        }
+
+        // Accessors for the elements of the input sequence
+        struct hash_aggregate_key
+        {
+            template <typename T>
+            auto operator()(T && t) const
+            ->  decltype(hpx::util::get<0>(t))
+            {
+                return hpx::util::get<0>(t);
+            }
+        };
+
+        struct hash_aggregate_value
+        {
+            template <typename T>
+            auto operator()(T && t) const
+            ->  decltype(hpx::util::get<1>(t))
+            {
+                return hpx::util::get<1>(t);
+            }
+        };
+
+        struct hash_aggregate_one
+        {
+            template <typename T>
+            std::size_t operator()(T &&) const
+            {
+                return 1;
+            }
+        };
+
+        // The aggregation of one chunk of the input sequence
+        template <typename Iter, typename Table>
+        struct hash_aggregate_chunk
+        {
+            Iter first_;
+            std::size_t size_;
+            std::vector<Table> tables_;
+        };
+
+        // The merged aggregation of one partition of the key space
+        template <typename Table>
+        struct hash_aggregate_partition
+        {
+            std::size_t index_;
+            Table table_;
+            std::size_t key_offset_;
+            std::size_t value_offset_;
+        };
+
+        template <typename Iter, typename Table, typename KeyOf,
+            typename ValueOf, typename Func>
+        hash_aggregate_chunk<Iter, Table>
+        hash_aggregate_chunk_(Iter first, std::size_t size, std::size_t parts,
+            Table const& proto, KeyOf const& key_of, ValueOf const& value_of,
+            Func const& func)
+        {
+            hash_aggregate_chunk<Iter, Table> chunk = {
+                first, size, std::vector<Table>(parts, proto)
+            };
+
+            typename Table::hasher hash = proto.hash_function();
+            for (/**/; size != 0; (void) ++first, --size)
+            {
+                auto && key = hpx::util::invoke(key_of, *first);
+                hash_accumulate(
+                    chunk.tables_[hash_partition_index(hash(key), parts)],
+                    key, hpx::util::invoke(value_of, *first), func);
+            }
+            return chunk;
+        }
+
+        template <typename ExPolicy, typename Iter, typename Table,
+            typename KeyOf, typename ValueOf, typename Func>
+        std::vector<hash_aggregate_chunk<Iter, Table> >
+        hash_aggregate_chunks(ExPolicy &&, Iter first, std::size_t count,
+            std::size_t parts, Table const& proto, KeyOf const& key_of,
+            ValueOf const& value_of, Func const& func, std::true_type)
+        {
+            std::vector<hash_aggregate_chunk<Iter, Table> > chunks;
+            chunks.push_back(hash_aggregate_chunk_(first, count, parts,
+                proto, key_of, value_of, func));
+            return chunks;
+        }
+
+        template <typename ExPolicy, typename Iter, typename Table,
+            typename KeyOf, typename ValueOf, typename Func>
+        std::vector<hash_aggregate_chunk<Iter, Table> >
+        hash_aggregate_chunks(ExPolicy && policy, Iter first,
+            std::size_t count, std::size_t parts, Table const& proto,
+            KeyOf const& key_of, ValueOf const& value_of, Func const& func,
+            std::false_type)
+        {
+            typedef hash_aggregate_chunk<Iter, Table> chunk_type;
+
+            return util::partitioner<
+                    ExPolicy, std::vector<chunk_type>, chunk_type
+                >::call(
+                    std::forward<ExPolicy>(policy), first, count,
+                    [&](Iter part_begin, std::size_t part_size) -> chunk_type
+                    {
+                        return hash_aggregate_chunk_(part_begin, part_size,
+                            parts, proto, key_of, value_of, func);
+                    },
+                    hpx::util::unwrapping(
+                        [](std::vector<chunk_type> && chunks)
+                        {
+                            return std::move(chunks);
+                        }));
+        }
+
+        // Merge the tables of all chunks partition by partition. The chunks
+        // are merged in order, which makes the result independent of the
+        // commutativity of func. The tables of the chunks are consumed
+        // unless keep_chunks is set.
+        template <typename ExPolicy, typename Iter, typename Table,
+            typename Func>
+        std::vector<hash_aggregate_partition<Table> >
+        hash_merge_partitions(ExPolicy && policy,
+            std::vector<hash_aggregate_chunk<Iter, Table> >& chunks,
+            std::size_t parts, Table const& proto, Func const& func,
+            bool keep_chunks)
+        {
+            typedef hash_aggregate_partition<Table> partition_type;
+
+            std::vector<partition_type> partitions;
+            partitions.reserve(parts);
+            for (std::size_t i = 0; i != parts; ++i)
+            {
+                partitions.push_back(partition_type{i, proto, 0, 0});
+            }
+
+            parallel::for_each(std::forward<ExPolicy>(policy),
+                partitions.begin(), partitions.end(),
+                [&](partition_type& part)
+                {
+                    std::size_t const i = part.index_;
+
+                    auto it = chunks.begin();
+                    if (!keep_chunks)
+                    {
+                        part.table_ = std::move(it->tables_[i]);
+                        ++it;
+                    }
+
+                    for (/**/; it != chunks.end(); ++it)
+                    {
+                        for (auto const& kv : it->tables_[i])
+                        {
+                            hash_accumulate(part.table_, kv.first,
+                                kv.second, func);
+                        }
+                    }
+                });
+
+            std::size_t offset = 0;
+            for (partition_type& part : partitions)
+            {
+                part.key_offset_ = offset;
+                offset += part.table_.size();
+            }
+
+            return partitions;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Table, typename ExPolicy, typename IsSeq,
+            typename Iter, typename KeyOf, typename ValueOf, typename Func,
+            typename FwdIter1, typename FwdIter2>
+        std::pair<FwdIter1, FwdIter2>
+        hash_aggregate(ExPolicy policy, IsSeq is_seq, Iter first,
+            std::size_t count, Table const& proto, KeyOf const& key_of,
+            ValueOf const& value_of, Func const& func, FwdIter1 keys_output,
+            FwdIter2 values_output)
+        {
+            typedef hash_aggregate_partition<Table> partition_type;
+
+            std::size_t const parts = hash_partition_count(policy, is_seq);
+
+            std::vector<hash_aggregate_chunk<Iter, Table> > chunks =
+                hash_aggregate_chunks(policy, first, count, parts, proto,
+                    key_of, value_of, func, is_seq);
+
+            std::vector<partition_type> partitions =
+                hash_merge_partitions(policy, chunks, parts, proto, func,
+                    false);
+
+            parallel::for_each(policy, partitions.begin(), partitions.end(),
+                [&](partition_type& part)
+                {
+                    FwdIter1 k = std::next(keys_output, part.key_offset_);
+                    FwdIter2 v = std::next(values_output, part.key_offset_);
+                    for (auto& kv : part.table_)
+                    {
+                        *k = kv.first;
+                        *v = std::move(kv.second);
+                        ++k; ++v;
+                    }
+                });
+
+            std::size_t const keys = partitions.back().key_offset_ +
+                partitions.back().table_.size();
+
+            return std::make_pair(std::next(keys_output, keys),
+                std::next(values_output, keys));
+        }
+
+        template <typename Table, typename ExPolicy, typename IsSeq,
+            typename FwdIter1, typename FwdIter2, typename FwdIter3,
+            typename FwdIter4, typename RanIter>
+        hpx::util::tuple<FwdIter3, FwdIter4, RanIter>
+        hash_group_by(ExPolicy policy, IsSeq is_seq, FwdIter1 key_first,
+            FwdIter2 values_first, std::size_t count, Table const& proto,
+            FwdIter3 keys_output, FwdIter4 counts_output,
+            RanIter values_output)
+        {
+            typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
+            typedef hash_aggregate_chunk<zip_iterator, Table> chunk_type;
+            typedef hash_aggregate_partition<Table> partition_type;
+
+            std::size_t const parts = hash_partition_count(policy, is_seq);
+            std::plus<std::size_t> func;
+
+            // count the number of elements of each group in each chunk
+            std::vector<chunk_type> chunks = hash_aggregate_chunks(policy,
+                hpx::util::make_zip_iterator(key_first, values_first), count,
+                parts, proto, hash_aggregate_key(), hash_aggregate_one(),
+                func, is_seq);
+
+            std::vector<partition_type> partitions =
+                hash_merge_partitions(policy, chunks, parts, proto, func,
+                    true);
+
+            parallel::for_each(policy, partitions.begin(), partitions.end(),
+                [](partition_type& part)
+                {
+                    for (auto const& kv : part.table_)
+                        part.value_offset_ += kv.second;
+                });
+
+            std::size_t offset = 0;
+            for (partition_type& part : partitions)
+            {
+                std::size_t size = part.value_offset_;
+                part.value_offset_ = offset;
+                offset += size;
+            }
+
+            // write the keys and sizes of all groups and turn the number of
+            // elements each chunk contributes to a group into the position
+            // of its first element in the output sequence
+            parallel::for_each(policy, partitions.begin(), partitions.end(),
+                [&](partition_type& part)
+                {
+                    FwdIter3 k = std::next(keys_output, part.key_offset_);
+                    FwdIter4 c = std::next(counts_output, part.key_offset_);
+                    std::size_t pos = part.value_offset_;
+
+                    for (auto const& kv : part.table_)
+                    {
+                        *k = kv.first;
+                        *c = kv.second;
+                        ++k; ++c;
+
+                        for (chunk_type& chunk : chunks)
+                        {
+                            Table& table = chunk.tables_[part.index_];
+                            auto it = table.find(kv.first);
+                            if (it != table.end())
+                            {
+                                std::size_t size = it->second;
+                                it->second = pos;
+                                pos += size;
+                            }
+                        }
+                    }
+                });
+
+            // scatter the values of each chunk to their groups
+            typename Table::hasher hash = proto.hash_function();
+            parallel::for_each(policy, chunks.begin(), chunks.end(),
+                [&](chunk_type& chunk)
+                {
+                    zip_iterator it = chunk.first_;
+                    for (std::size_t i = 0; i != chunk.size_; (void) ++i, ++it)
+                    {
+                        auto && key = hpx::util::get<0>(*it);
+                        std::size_t part =
+                            hash_partition_index(hash(key), parts);
+
+                        std::size_t& pos =
+                            chunk.tables_[part].find(key)->second;
+                        *std::next(values_output, pos++) =
+                            hpx::util::get<1>(*it);
+                    }
+                });
+
+            std::size_t const keys = partitions.back().key_offset_ +
+                partitions.back().table_.size();
+
+            return hpx::util::make_tuple(std::next(keys_output, keys),
+                std::next(counts_output, keys),
+                std::next(values_output, count));
+        }
+
+        template <typename ExPolicy>
+        struct hash_aggregate_policy
+        {
+            typedef decltype(
+                    execution::par.on(std::declval<ExPolicy&>().executor())
+                        .with(std::declval<ExPolicy&>().parameters())
+                ) type;
+
+            static type call(ExPolicy& policy)
+            {
+                return execution::par.on(policy.executor())
+                    .with(policy.parameters());
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename FwdIter3, typename FwdIter4>
+        struct hash_reduce_by_key
+          : public detail::algorithm<
+                hash_reduce_by_key<FwdIter3, FwdIter4>,
+                std::pair<FwdIter3, FwdIter4> >
+        {
+            hash_reduce_by_key()
+              : hash_reduce_by_key::algorithm("hash_reduce_by_key")
+            {}
+
+            template <typename Key, typename T, typename Hash,
+                typename KeyEqual>
+            struct table
+            {
+                typedef std::unordered_map<
+                        Key, T,
+                        typename hpx::util::decay<Hash>::type,
+                        typename hpx::util::decay<KeyEqual>::type
+                    > type;
+            };
+
+            template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+                typename Func, typename Hash, typename KeyEqual>
+            static std::pair<FwdIter3, FwdIter4>
+            sequential(ExPolicy && policy, FwdIter1 key_first,
+                FwdIter1 key_last, FwdIter2 values_first, FwdIter3 keys_output,
+                FwdIter4 values_output, Func && func, Hash && hash,
+                KeyEqual && key_eq)
+            {
+                typedef typename table<
+                        typename std::iterator_traits<FwdIter1>::value_type,
+                        typename std::iterator_traits<FwdIter2>::value_type,
+                        Hash, KeyEqual
+                    >::type table_type;
+
+                return hash_aggregate(execution::seq, std::true_type(),
+                    hpx::util::make_zip_iterator(key_first, values_first),
+                    std::distance(key_first, key_last),
+                    table_type(0, std::forward<Hash>(hash),
+                        std::forward<KeyEqual>(key_eq)),
+                    hash_aggregate_key(), hash_aggregate_value(),
+                    std::forward<Func>(func), keys_output, values_output);
+            }
+
+            template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+                typename Func, typename Hash, typename KeyEqual>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::pair<FwdIter3, FwdIter4>
+            >::type
+            parallel(ExPolicy && policy, FwdIter1 key_first,
+                FwdIter1 key_last, FwdIter2 values_first, FwdIter3 keys_output,
+                FwdIter4 values_output, Func && func, Hash && hash,
+                KeyEqual && key_eq)
+            {
+                typedef std::pair<FwdIter3, FwdIter4> result_type;
+                typedef typename table<
+                        typename std::iterator_traits<FwdIter1>::value_type,
+                        typename std::iterator_traits<FwdIter2>::value_type,
+                        Hash, KeyEqual
+                    >::type table_type;
+                typedef typename hpx::util::decay<Func>::type func_type;
+                typedef hash_aggregate_policy<
+                        typename hpx::util::decay<ExPolicy>::type
+                    > sync_policy;
+
+                auto p = sync_policy::call(policy);
+                table_type proto(0, std::forward<Hash>(hash),
+                    std::forward<KeyEqual>(key_eq));
+                func_type f(std::forward<Func>(func));
+                std::size_t count = std::distance(key_first, key_last);
+
+                // The phases of the algorithm run synchronously inside of
+                // a single task, this task is what the caller waits for.
+                return util::detail::algorithm_result<
+                        ExPolicy, result_type
+                    >::get(execution::async_execute(policy.executor(),
+                        [=]() -> result_type
+                        {
+                            return hash_aggregate(p, std::false_type(),
+                                hpx::util::make_zip_iterator(
+                                    key_first, values_first),
+                                count, proto, hash_aggregate_key(),
+                                hash_aggregate_value(), f, keys_output,
+                                values_output);
+                        }));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename FwdIter2, typename FwdIter3>
+        struct histogram
+          : public detail::algorithm<
+                histogram<FwdIter2, FwdIter3>, std::pair<FwdIter2, FwdIter3> >
+        {
+            histogram()
+              : histogram::algorithm("histogram")
+            {}
+
+            template <typename Key, typename Hash, typename KeyEqual>
+            struct table
+            {
+                typedef std::unordered_map<
+                        Key, std::size_t,
+                        typename hpx::util::decay<Hash>::type,
+                        typename hpx::util::decay<KeyEqual>::type
+                    > type;
+            };
+
+            template <typename ExPolicy, typename FwdIter1, typename Hash,
+                typename KeyEqual>
+            static std::pair<FwdIter2, FwdIter3>
+            sequential(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+                FwdIter2 keys_output, FwdIter3 counts_output, Hash && hash,
+                KeyEqual && key_eq)
+            {
+                typedef typename table<
+                        typename std::iterator_traits<FwdIter1>::value_type,
+                        Hash, KeyEqual
+                    >::type table_type;
+
+                return hash_aggregate(execution::seq, std::true_type(),
+                    first, std::distance(first, last),
+                    table_type(0, std::forward<Hash>(hash),
+                        std::forward<KeyEqual>(key_eq)),
+                    util::projection_identity(), hash_aggregate_one(),
+                    std::plus<std::size_t>(), keys_output, counts_output);
+            }
+
+            template <typename ExPolicy, typename FwdIter1, typename Hash,
+                typename KeyEqual>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::pair<FwdIter2, FwdIter3>
+            >::type
+            parallel(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+                FwdIter2 keys_output, FwdIter3 counts_output, Hash && hash,
+                KeyEqual && key_eq)
+            {
+                typedef std::pair<FwdIter2, FwdIter3> result_type;
+                typedef typename table<
+                        typename std::iterator_traits<FwdIter1>::value_type,
+                        Hash, KeyEqual
+                    >::type table_type;
+                typedef hash_aggregate_policy<
+                        typename hpx::util::decay<ExPolicy>::type
+                    > sync_policy;
+
+                auto p = sync_policy::call(policy);
+                table_type proto(0, std::forward<Hash>(hash),
+                    std::forward<KeyEqual>(key_eq));
+                std::size_t count = std::distance(first, last);
+
+                return util::detail::algorithm_result<
+                        ExPolicy, result_type
+                    >::get(execution::async_execute(policy.executor(),
+                        [=]() -> result_type
+                        {
+                            return hash_aggregate(p, std::false_type(),
+                                first, count, proto,
+                                util::projection_identity(),
+                                hash_aggregate_one(),
+                                std::plus<std::size_t>(), keys_output,
+                                counts_output);
+                        }));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename FwdIter3, typename FwdIter4, typename RanIter>
+        struct group_by
+          : public detail::algorithm<
+                group_by<FwdIter3, FwdIter4, RanIter>,
+                hpx::util::tuple<FwdIter3, FwdIter4, RanIter> >
+        {
+            group_by()
+              : group_by::algorithm("group_by")
+            {}
+
+            template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+                typename Hash, typename KeyEqual>
+            static hpx::util::tuple<FwdIter3, FwdIter4, RanIter>
+            sequential(ExPolicy && policy, FwdIter1 key_first,
+                FwdIter1 key_last, FwdIter2 values_first, FwdIter3 keys_output,
+                FwdIter4 counts_output, RanIter values_output, Hash && hash,
+                KeyEqual && key_eq)
+            {
+                typedef typename histogram<FwdIter3, FwdIter4>::template table<
+                        typename std::iterator_traits<FwdIter1>::value_type,
+                        Hash, KeyEqual
+                    >::type table_type;
+
+                return hash_group_by(execution::seq, std::true_type(),
+                    key_first, values_first,
+                    std::distance(key_first, key_last),
+                    table_type(0, std::forward<Hash>(hash),
+                        std::forward<KeyEqual>(key_eq)),
+                    keys_output, counts_output, values_output);
+            }
+
+            template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+                typename Hash, typename KeyEqual>
+            static typename util::detail::algorithm_result<
+                ExPolicy, hpx::util::tuple<FwdIter3, FwdIter4, RanIter>
+            >::type
+            parallel(ExPolicy && policy, FwdIter1 key_first,
+                FwdIter1 key_last, FwdIter2 values_first, FwdIter3 keys_output,
+                FwdIter4 counts_output, RanIter values_output, Hash && hash,
+                KeyEqual && key_eq)
+            {
+                typedef hpx::util::tuple<FwdIter3, FwdIter4, RanIter>
+                    result_type;
+                typedef typename histogram<FwdIter3, FwdIter4>::template table<
+                        typename std::iterator_traits<FwdIter1>::value_type,
+                        Hash, KeyEqual
+                    >::type table_type;
+                typedef hash_aggregate_policy<
+                        typename hpx::util::decay<ExPolicy>::type
+                    > sync_policy;
+
+                auto p = sync_policy::call(policy);
+                table_type proto(0, std::forward<Hash>(hash),
+                    std::forward<KeyEqual>(key_eq));
+                std::size_t count = std::distance(key_first, key_last);
+
+                return util::detail::algorithm_result<
+                        ExPolicy, result_type
+                    >::get(execution::async_execute(policy.executor(),
+                        [=]() -> result_type
+                        {
+                            return hash_group_by(p, std::false_type(),
+                                key_first, values_first, count, proto,
+                                keys_output, counts_output, values_output);
+                        }));
+            }
+        };
+        /// \endcond
+    }
+
+    /// Reduces the values supplied for equal keys in [key_first, key_last)
+    /// to a single value for each distinct key. Unlike \a reduce_by_key,
+    /// the keys are not required to be sorted: equal keys are found using
+    /// hash tables instead of comparing adjacent elements, which avoids
+    /// having to sort the input before reducing it.
+    ///
+    /// \note   Complexity: O(\a key_last - \a key_first) applications of the
+    ///         function \a func and of the hash function \a hash.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam FwdIter1    The type of the key iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter2    The type of the value iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter3    The type of the iterator representing the
+    ///                     destination key range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter4    The type of the iterator representing the
+    ///                     destination value range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam Func        The type of the function/function object to use
+    ///                     (deduced). Defaults to std::plus.
+    /// \tparam Hash        The type of the hash function object used for the
+    ///                     keys (deduced). Defaults to std::hash.
+    /// \tparam KeyEqual    The type of the function object used to compare
+    ///                     keys for equality (deduced). Defaults to
+    ///                     std::equal_to.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param key_first    Refers to the beginning of the sequence of key
+    ///                     elements the algorithm will be applied to.
+    /// \param key_last     Refers to the end of the sequence of key elements
+    ///                     the algorithm will be applied to.
+    /// \param values_first Refers to the beginning of the sequence of value
+    ///                     elements the algorithm will be applied to.
+    /// \param keys_output  Refers to the start output location for the keys
+    ///                     produced by the algorithm.
+    /// \param values_output Refers to the start output location for the
+    ///                     values produced by the algorithm.
+    /// \param func         Specifies the function (or function object) which
+    ///                     is used to combine two values supplied for the same
+    ///                     key. This is a binary predicate. The signature of
+    ///                     this predicate should be equivalent to:
+    ///                     \code
+    ///                     Ret fun(const Type1 &a, const Type1 &b);
+    ///                     \endcode \n
+    ///                     The signature does not need to have const&.
+    ///                     The types \a Type1 and \a Ret must be such that an
+    ///                     object of type \a FwdIter2 can be dereferenced and
+    ///                     then implicitly converted to any of those types.
+    ///                     \a func has to be associative.
+    /// \param hash         The hash function object used for the keys.
+    /// \param key_eq       The function object used to compare keys for
+    ///                     equality.
+    ///
+    /// The values of each key are combined in the order in which they appear
+    /// in the input sequence. The order in which the distinct keys are
+    /// written to the output is unspecified, the value written for a key
+    /// is placed at the same position as the key itself.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a hash_reduce_by_key algorithm returns a
+    ///           \a hpx::future<pair<FwdIter3,FwdIter4>> if the execution
+    ///           policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns
+    ///           \a pair<FwdIter3,FwdIter4> otherwise. The returned iterators
+    ///           refer to the ends of the written key and value sequences.
+    ///
+    template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+        typename FwdIter3, typename FwdIter4,
+        typename Func = std::plus<
+            typename std::iterator_traits<FwdIter2>::value_type>,
+        typename Hash = std::hash<
+            typename std::iterator_traits<FwdIter1>::value_type>,
+        typename KeyEqual = std::equal_to<
+            typename std::iterator_traits<FwdIter1>::value_type>,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter1>::value &&
+        hpx::traits::is_iterator<FwdIter2>::value &&
+        hpx::traits::is_iterator<FwdIter3>::value &&
+        hpx::traits::is_iterator<FwdIter4>::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, std::pair<FwdIter3, FwdIter4>
+    >::type
+    hash_reduce_by_key(ExPolicy && policy, FwdIter1 key_first,
+        FwdIter1 key_last, FwdIter2 values_first, FwdIter3 keys_output,
+        FwdIter4 values_output, Func && func = Func(), Hash && hash = Hash(),
+        KeyEqual && key_eq = KeyEqual())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter1>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter2>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter3>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter4>::value),
+            "Requires at least forward iterator.");
+
+        typedef std::pair<FwdIter3, FwdIter4> result_type;
+
+        if (key_first == key_last)
+        {
+            return util::detail::algorithm_result<
+                    ExPolicy, result_type
+                >::get(std::make_pair(keys_output, values_output));
+        }
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::hash_reduce_by_key<FwdIter3, FwdIter4>().call(
+            std::forward<ExPolicy>(policy), is_seq(), key_first, key_last,
+            values_first, keys_output, values_output,
+            std::forward<Func>(func), std::forward<Hash>(hash),
+            std::forward<KeyEqual>(key_eq));
+    }
+
+    /// Counts the number of occurrences of each distinct element in the
+    /// range [first, last). The elements are not required to be sorted,
+    /// equal elements are found using hash tables.
+    ///
+    /// \note   Complexity: O(\a last - \a first) applications of the hash
+    ///         function \a hash.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam FwdIter1    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter2    The type of the iterator representing the
+    ///                     destination key range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter3    The type of the iterator representing the
+    ///                     destination count range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam Hash        The type of the hash function object used for the
+    ///                     elements (deduced). Defaults to std::hash.
+    /// \tparam KeyEqual    The type of the function object used to compare
+    ///                     elements for equality (deduced). Defaults to
+    ///                     std::equal_to.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param keys_output  Refers to the start output location for the
+    ///                     distinct elements.
+    /// \param counts_output Refers to the start output location for the
+    ///                     number of occurrences of each of the distinct
+    ///                     elements.
+    /// \param hash         The hash function object used for the elements.
+    /// \param key_eq       The function object used to compare elements for
+    ///                     equality.
+    ///
+    /// The order in which the distinct elements are written to the output is
+    /// unspecified, the count of an element is placed at the same position
+    /// as the element itself.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a histogram algorithm returns a
+    ///           \a hpx::future<pair<FwdIter2,FwdIter3>> if the execution
+    ///           policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns
+    ///           \a pair<FwdIter2,FwdIter3> otherwise. The returned iterators
+    ///           refer to the ends of the written key and count sequences.
+    ///
+    template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+        typename FwdIter3,
+        typename Hash = std::hash<
+            typename std::iterator_traits<FwdIter1>::value_type>,
+        typename KeyEqual = std::equal_to<
+            typename std::iterator_traits<FwdIter1>::value_type>,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter1>::value &&
+        hpx::traits::is_iterator<FwdIter2>::value &&
+        hpx::traits::is_iterator<FwdIter3>::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, std::pair<FwdIter2, FwdIter3>
+    >::type
+    histogram(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+        FwdIter2 keys_output, FwdIter3 counts_output, Hash && hash = Hash(),
+        KeyEqual && key_eq = KeyEqual())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter1>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter2>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter3>::value),
+            "Requires at least forward iterator.");
+
+        typedef std::pair<FwdIter2, FwdIter3> result_type;
+
+        if (first == last)
+        {
+            return util::detail::algorithm_result<
+                    ExPolicy, result_type
+                >::get(std::make_pair(keys_output, counts_output));
+        }
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::histogram<FwdIter2, FwdIter3>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            keys_output, counts_output, std::forward<Hash>(hash),
+            std::forward<KeyEqual>(key_eq));
+    }
+
+    /// Groups the values supplied in [values_first, values_first +
+    /// (key_last - key_first)) by their keys in [key_first, key_last). The
+    /// keys are not required to be sorted, equal keys are found using hash
+    /// tables. The values of each group are written contiguously to the
+    /// output, preserving their relative order.
+    ///
+    /// \note   Complexity: O(\a key_last - \a key_first) applications of the
+    ///         hash function \a hash.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam FwdIter1    The type of the key iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter2    The type of the value iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter3    The type of the iterator representing the
+    ///                     destination key range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam FwdIter4    The type of the iterator representing the
+    ///                     destination group size range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam RanIter     The type of the iterator representing the
+    ///                     destination value range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Hash        The type of the hash function object used for the
+    ///                     keys (deduced). Defaults to std::hash.
+    /// \tparam KeyEqual    The type of the function object used to compare
+    ///                     keys for equality (deduced). Defaults to
+    ///                     std::equal_to.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param key_first    Refers to the beginning of the sequence of key
+    ///                     elements the algorithm will be applied to.
+    /// \param key_last     Refers to the end of the sequence of key elements
+    ///                     the algorithm will be applied to.
+    /// \param values_first Refers to the beginning of the sequence of value
+    ///                     elements the algorithm will be applied to.
+    /// \param keys_output  Refers to the start output location for the
+    ///                     distinct keys.
+    /// \param counts_output Refers to the start output location for the
+    ///                     sizes of the groups.
+    /// \param values_output Refers to the start output location for the
+    ///                     grouped values.
+    /// \param hash         The hash function object used for the keys.
+    /// \param key_eq       The function object used to compare keys for
+    ///                     equality.
+    ///
+    /// The order of the groups is unspecified. The i-th key written to
+    /// \a keys_output and the i-th size written to \a counts_output describe
+    /// the i-th group of values written to \a values_output.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a group_by algorithm returns a
+    ///           \a hpx::future<tuple<FwdIter3,FwdIter4,RanIter>> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns
+    ///           \a tuple<FwdIter3,FwdIter4,RanIter> otherwise. The returned
+    ///           iterators refer to the ends of the written key, group size
+    ///           and value sequences.
+    ///
+    template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+        typename FwdIter3, typename FwdIter4, typename RanIter,
+        typename Hash = std::hash<
+            typename std::iterator_traits<FwdIter1>::value_type>,
+        typename KeyEqual = std::equal_to<
+            typename std::iterator_traits<FwdIter1>::value_type>,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter1>::value &&
+        hpx::traits::is_iterator<FwdIter2>::value &&
+        hpx::traits::is_iterator<FwdIter3>::value &&
+        hpx::traits::is_iterator<FwdIter4>::value &&
+        hpx::traits::is_iterator<RanIter>::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, hpx::util::tuple<FwdIter3, FwdIter4, RanIter>
+    >::type
+    group_by(ExPolicy && policy, FwdIter1 key_first, FwdIter1 key_last,
+        FwdIter2 values_first, FwdIter3 keys_output, FwdIter4 counts_output,
+        RanIter values_output, Hash && hash = Hash(),
+        KeyEqual && key_eq = KeyEqual())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter1>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter2>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter3>::value) &&
+            (hpx::traits::is_forward_iterator<FwdIter4>::value),
+            "Requires at least forward iterator.");
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RanIter>::value),
+            "Requires a random access iterator.");
+
+        typedef hpx::util::tuple<FwdIter3, FwdIter4, RanIter> result_type;
+
+        if (key_first == key_last)
+        {
+            return util::detail::algorithm_result<
+                    ExPolicy, result_type
+                >::get(hpx::util::make_tuple(
+                    keys_output, counts_output, values_output));
+        }
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::group_by<FwdIter3, FwdIter4, RanIter>().call(
+            std::forward<ExPolicy>(policy), is_seq(), key_first, key_last,
+            values_first, keys_output, counts_output, values_output,
+            std::forward<Hash>(hash), std::forward<KeyEqual>(key_eq));
+    }
+}}}
+
+#endif
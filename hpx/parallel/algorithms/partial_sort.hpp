@@ -0,0 +1,562 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_HPP)
+#define HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/merge_path.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/nth_element.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Select the smallest elements using the parallel nth_element and
+        // sort those in parallel.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt>
+        parallel_partial_sort(ExPolicy && policy, RandomIt first,
+            RandomIt middle, RandomIt last, Compare && comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+            return execution::async_execute(policy.executor(),
+                [policy, first, middle, last, comp]() mutable -> RandomIt
+                {
+                    try {
+                        if (middle == first)
+                            return last;
+
+                        if (middle != last)
+                        {
+                            parallel_nth_element_helper(policy, first,
+                                middle, last, comp);
+                        }
+
+                        parallel_sort_async(policy, first, middle, comp)
+                            .get();
+                        return last;
+                    }
+                    catch (...) {
+                        util::detail::handle_local_exceptions<
+                                policy_type
+                            >::call(std::current_exception());
+                    }
+
+                    // Not reachable.
+                    HPX_ASSERT(false);
+                    return last;
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // partial_sort
+        template <typename RandomIt>
+        struct partial_sort
+          : public detail::algorithm<partial_sort<RandomIt>, RandomIt>
+        {
+            partial_sort()
+              : partial_sort::algorithm("partial_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                std::partial_sort(first, middle, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                        ExPolicy, RandomIt
+                    > algorithm_result;
+
+                // the comparison is performed asynchronously, store copies
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                try {
+                    return algorithm_result::get(
+                        parallel_partial_sort(std::forward<ExPolicy>(policy),
+                            first, middle, last,
+                            compare_type(
+                                std::forward<Compare>(comp),
+                                std::forward<Proj>(proj)
+                            )));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges elements such that the range [first, middle) contains the
+    /// sorted middle - first smallest elements in the range [first, last).
+    /// The order of equal elements is not guaranteed to be preserved. The
+    /// order of the remaining elements in the range [middle, last) is
+    /// unspecified.
+    ///
+    /// \note   Complexity: Approximately (last-first)log(middle-first)
+    ///                     applications of the comparison function.
+    ///
+    /// The parallel version selects the smallest elements using the
+    /// parallel \a nth_element algorithm and sorts those using the parallel
+    /// \a sort algorithm.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Compare     The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param middle       Refers to the end of the sorted part of the
+    ///                     sequence.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a partial_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort(ExPolicy && policy, RandomIt first, RandomIt middle,
+        RandomIt last, Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::partial_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, middle, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort_copy
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        static const std::size_t partial_sort_limit_per_task = 16384ul;
+
+        // Each chunk of the input selects its (at most) N smallest elements,
+        // these sorted runs are merged pairwise (keeping at most N elements)
+        // with the last merge writing directly to the destination.
+        template <typename ExPolicy, typename FwdIter, typename RandomIt,
+            typename Compare>
+        RandomIt parallel_partial_sort_copy_helper(ExPolicy& policy,
+            FwdIter first, FwdIter last, RandomIt d_first, RandomIt d_last,
+            Compare const& comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename std::iterator_traits<FwdIter>::value_type
+                value_type;
+            typedef std::vector<value_type> run_type;
+
+            std::size_t const count = std::distance(first, last);
+            std::size_t const num_selected =
+                (std::min)(count, std::size_t(d_last - d_first));
+
+            if (num_selected == 0)
+                return d_first;
+
+            std::size_t const chunk_size = merge_path_chunk_size(
+                policy, count, partial_sort_limit_per_task);
+
+            // select the smallest elements of each chunk
+            std::vector<hpx::future<run_type> > selections;
+            selections.reserve(count / chunk_size + 1);
+
+            for (std::size_t base = 0; base < count; base += chunk_size)
+            {
+                FwdIter chunk_first = first;
+                std::advance(first, (std::min)(chunk_size, count - base));
+
+                selections.push_back(execution::async_execute(
+                    policy.executor(),
+                    [chunk_first, first, num_selected, comp]() -> run_type
+                    {
+                        run_type run(chunk_first, first);
+
+                        std::size_t num =
+                            (std::min)(num_selected, run.size());
+                        std::partial_sort(run.begin(), run.begin() + num,
+                            run.end(), comp);
+                        run.erase(run.begin() + num, run.end());
+
+                        return run;
+                    }));
+            }
+
+            merge_path_wait<policy_type>(selections);
+
+            std::vector<run_type> runs;
+            runs.reserve(selections.size());
+            for (hpx::future<run_type>& f : selections)
+                runs.push_back(f.get());
+
+            // merge the selected runs pairwise
+            std::vector<hpx::future<void> > workitems;
+            while (runs.size() > 2)
+            {
+                std::vector<run_type> merged((runs.size() + 1) / 2);
+
+                try {
+                    for (std::size_t r = 0; r < runs.size(); r += 2)
+                    {
+                        if (r + 1 == runs.size())
+                        {
+                            merged[r / 2] = std::move(runs[r]);
+                            continue;
+                        }
+
+                        run_type& run1 = runs[r];
+                        run_type& run2 = runs[r + 1];
+
+                        std::size_t num = (std::min)(
+                            num_selected, run1.size() + run2.size());
+                        merged[r / 2].resize(num);
+
+                        merge_path_async(policy, workitems,
+                            run1.begin(), run1.size(),
+                            run2.begin(), run2.size(),
+                            merged[r / 2].begin(), num, chunk_size, comp);
+                    }
+                }
+                catch (...) {
+                    // the scheduled merges still refer to the runs
+                    hpx::wait_all(workitems);
+                    throw;
+                }
+
+                merge_path_wait<policy_type>(workitems);
+                workitems.clear();
+
+                runs = std::move(merged);
+            }
+
+            // write the result to the destination
+            if (runs.size() == 2)
+            {
+                merge_path_async(policy, workitems,
+                    runs[0].begin(), runs[0].size(),
+                    runs[1].begin(), runs[1].size(),
+                    d_first, num_selected, chunk_size, comp);
+            }
+            else
+            {
+                merge_path_async(policy, workitems,
+                    runs[0].begin(), runs[0].size(),
+                    runs[0].end(), std::size_t(0),
+                    d_first, num_selected, chunk_size, comp);
+            }
+
+            merge_path_wait<policy_type>(workitems);
+
+            return d_first + num_selected;
+        }
+
+        template <typename ExPolicy, typename FwdIter, typename RandomIt,
+            typename Compare>
+        hpx::future<RandomIt>
+        parallel_partial_sort_copy(ExPolicy && policy, FwdIter first,
+            FwdIter last, RandomIt d_first, RandomIt d_last, Compare && comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+            return execution::async_execute(policy.executor(),
+                [policy, first, last, d_first, d_last, comp]() mutable
+                ->  RandomIt
+                {
+                    try {
+                        return parallel_partial_sort_copy_helper(policy,
+                            first, last, d_first, d_last, comp);
+                    }
+                    catch (...) {
+                        util::detail::handle_local_exceptions<
+                                policy_type
+                            >::call(std::current_exception());
+                    }
+
+                    // Not reachable.
+                    HPX_ASSERT(false);
+                    return d_first;
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // partial_sort_copy
+        template <typename RandomIt>
+        struct partial_sort_copy
+          : public detail::algorithm<partial_sort_copy<RandomIt>, RandomIt>
+        {
+            partial_sort_copy()
+              : partial_sort_copy::algorithm("partial_sort_copy")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Compare,
+                typename Proj>
+            static RandomIt
+            sequential(ExPolicy, InIter first, InIter last,
+                RandomIt d_first, RandomIt d_last, Compare && comp,
+                Proj && proj)
+            {
+                return std::partial_sort_copy(first, last, d_first, d_last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                RandomIt d_first, RandomIt d_last, Compare && comp,
+                Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                        ExPolicy, RandomIt
+                    > algorithm_result;
+
+                // the comparison is performed asynchronously, store copies
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                try {
+                    return algorithm_result::get(
+                        parallel_partial_sort_copy(
+                            std::forward<ExPolicy>(policy),
+                            first, last, d_first, d_last,
+                            compare_type(
+                                std::forward<Compare>(comp),
+                                std::forward<Proj>(proj)
+                            )));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts some of the elements in the range [first, last) in ascending
+    /// order, storing the result in the range [d_first, d_last). At most
+    /// d_last - d_first of the elements are placed sorted to the range
+    /// [d_first, d_first + n) where n is the number of elements to sort
+    /// (n = min(last - first, d_last - d_first)). The order of equal
+    /// elements is not guaranteed to be preserved.
+    ///
+    /// \note   Complexity: O(Nlog(min(D,N))), where N =
+    ///                     std::distance(first, last) and D =
+    ///                     std::distance(d_first, d_last) comparisons.
+    ///
+    /// The parallel version selects the smallest elements of each chunk of
+    /// the input (as determined by the executor parameters of the execution
+    /// policy) and merges the selected runs pairwise, splitting each merge
+    /// into pieces of equal size along its merge path.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam FwdIter     The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     forward iterator.
+    /// \tparam RandomIt    The type of the destination iterators used
+    ///                     (deduced). This iterator type must meet the
+    ///                     requirements of a random access iterator.
+    /// \tparam Compare     The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param d_first      Refers to the beginning of the destination range.
+    /// \param d_last       Refers to the end of the destination range.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a partial_sort_copy algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator to the element defining
+    ///           the upper boundary of the sorted range, i.e.
+    ///           d_first + min(last - first, d_last - d_first).
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename FwdIter, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, FwdIter>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, FwdIter>,
+                traits::projected<Proj, FwdIter>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort_copy(ExPolicy && policy, FwdIter first, FwdIter last,
+        RandomIt d_first, RandomIt d_last, Compare && comp = Compare(),
+        Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter>::value),
+            "Requires at least forward iterator.");
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::partial_sort_copy<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            d_first, d_last, std::forward<Compare>(comp),
+            std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
@@ -32,8 +32,8 @@
 #include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
 #include <hpx/parallel/util/invoke_projected.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
@@ -1143,7 +1143,7 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
-                typedef util::scan_partitioner<
+                typedef util::lookback_scan_partitioner<
                         ExPolicy, hpx::util::tuple<FwdIter1, FwdIter2, FwdIter3>,
                         output_iterator_offset
                     > scan_partitioner_type;
@@ -1177,29 +1177,26 @@ namespace hpx { namespace parallel { inline namespace v1
                 auto f3 =
                     [dest_true, dest_false, flags, policy](
                         zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<output_iterator_offset> curr,
-                        hpx::shared_future<output_iterator_offset> next
-                    ) mutable -> void
+                        output_iterator_offset offset
+                    ) -> void
                     {
                         HPX_UNUSED(flags);
                         HPX_UNUSED(policy);
 
-                        next.get();     // rethrow exceptions
-
-                        output_iterator_offset offset = curr.get();
-                        std::size_t count_true = get<0>(offset);
-                        std::size_t count_false = get<1>(offset);
-                        std::advance(dest_true, count_true);
-                        std::advance(dest_false, count_false);
+                        // this is invoked concurrently for all tiles
+                        FwdIter2 dst_true = dest_true;
+                        FwdIter3 dst_false = dest_false;
+                        std::advance(dst_true, get<0>(offset));
+                        std::advance(dst_false, get<1>(offset));
 
                         util::loop_n<ExPolicy>(
                             part_begin, part_size,
-                            [&dest_true, &dest_false](zip_iterator it) mutable
+                            [&dst_true, &dst_false](zip_iterator it) mutable
                             {
                                 if(get<1>(*it))
-                                    *dest_true++ = get<0>(*it);
+                                    *dst_true++ = get<0>(*it);
                                 else
-                                    *dest_false++ = get<0>(*it);
+                                    *dst_false++ = get<0>(*it);
                             });
                     };
 
@@ -1208,31 +1205,25 @@ namespace hpx { namespace parallel { inline namespace v1
                     make_zip_iterator(first, flags.get()), count, init,
                     // step 1 performs first part of scan algorithm
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(
-                        [](output_iterator_offset const& prev_sum,
-                            output_iterator_offset const& curr)
-                        -> output_iterator_offset
-                        {
-                            return output_iterator_offset(
-                                get<0>(prev_sum) + get<0>(curr),
-                                get<1>(prev_sum) + get<1>(curr));
-                        }),
-                    // step 3 runs final accumulation on each partition
+                    // step 2 combines the results of adjacent tiles
+                    [](output_iterator_offset const& prev_sum,
+                        output_iterator_offset const& curr)
+                    -> output_iterator_offset
+                    {
+                        return output_iterator_offset(
+                            get<0>(prev_sum) + get<0>(curr),
+                            get<1>(prev_sum) + get<1>(curr));
+                    },
+                    // step 3 runs final accumulation on each tile
                     std::move(f3),
                     // step 4 use this return value
                     [last, dest_true, dest_false, count, flags](
-                        std::vector<
-                            hpx::shared_future<output_iterator_offset>
-                        > && items,
-                        std::vector<hpx::future<void> > &&) mutable
+                        output_iterator_offset const& count_pair) mutable
                     ->  hpx::util::tuple<FwdIter1, FwdIter2, FwdIter3>
                     {
                         HPX_UNUSED(flags);
                         HPX_UNUSED(count);
 
-                        output_iterator_offset count_pair = items.back().get();
                         std::size_t count_true = get<0>(count_pair);
                         std::size_t count_false = get<1>(count_pair);
                         std::advance(dest_true, count_true);
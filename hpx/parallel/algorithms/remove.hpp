@@ -11,6 +11,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 #include <hpx/util/unused.hpp>
@@ -209,6 +210,30 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, FwdIter
+        >::type
+        remove_if_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::remove_if<FwdIter>().call(
+                    std::forward<ExPolicy>(policy), is_seq(),
+                    first, last, std::forward<Pred>(pred),
+                    std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        remove_if_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -298,12 +323,12 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Required at least forward iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
 
-        return detail::remove_if<FwdIter>().call(
-                std::forward<ExPolicy>(policy), is_seq(),
-                first, last, std::forward<Pred>(pred),
-                std::forward<Proj>(proj));
+        return detail::remove_if_(
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<Pred>(pred), std::forward<Proj>(proj),
+                is_segmented());
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -371,15 +396,9 @@ namespace hpx { namespace parallel { inline namespace v1
     remove(ExPolicy && policy, FwdIter first, FwdIter last,
         T const& value, Proj && proj = Proj())
     {
-        typedef typename std::iterator_traits<FwdIter>::value_type Type;
-
         // Just utilize existing parallel remove_if.
         return remove_if(std::forward<ExPolicy>(policy),
-                first, last,
-                [value](Type const& a) -> bool
-                {
-                    return value == a;
-                },
+                first, last, detail::compare_to<T>(value),
                 std::forward<Proj>(proj));
     }
 }}}
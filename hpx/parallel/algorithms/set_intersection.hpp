@@ -31,6 +31,21 @@ namespace hpx { namespace parallel { inline namespace v1
     namespace detail
     {
         /// \cond NOINTERNAL
+
+        // Perform the set operation on one chunk of the input sequences
+        struct set_intersection_chunk
+        {
+            template <typename RanIter1, typename RanIter2, typename OutIter,
+                typename F>
+            OutIter operator()(RanIter1 first1, RanIter1 last1,
+                RanIter2 first2, RanIter2 last2, OutIter dest,
+                F const& f) const
+            {
+                return std::set_intersection(first1, last1, first2, last2,
+                    dest, f);
+            }
+        };
+
         template <typename FwdIter>
         struct set_intersection
           : public detail::algorithm<set_intersection<FwdIter>, FwdIter>
@@ -57,11 +72,6 @@ namespace hpx { namespace parallel { inline namespace v1
             parallel(ExPolicy && policy, RanIter1 first1, RanIter1 last1,
                 RanIter2 first2, RanIter2 last2, FwdIter dest, F && f)
             {
-                typedef typename std::iterator_traits<RanIter1>::difference_type
-                    difference_type1;
-                typedef typename std::iterator_traits<RanIter2>::difference_type
-                    difference_type2;
-
                 if (first1 == last1 || first2 == last2)
                 {
                     typedef util::detail::algorithm_result<
@@ -70,26 +80,9 @@ namespace hpx { namespace parallel { inline namespace v1
                     return result::get(std::move(dest));
                 }
 
-                typedef typename set_operations_buffer<FwdIter>::type buffer_type;
-                typedef typename hpx::util::decay<F>::type func_type;
-
                 return set_operation(std::forward<ExPolicy>(policy),
                     first1, last1, first2, last2, dest, std::forward<F>(f),
-                    // calculate approximate destination index
-                    [](difference_type1 idx1, difference_type2 idx2)
-                    ->  difference_type1
-                    {
-                        return (std::min)(idx1, idx2);
-                    },
-                    // perform required set operation for one chunk
-                    [](RanIter1 part_first1, RanIter1 part_last1,
-                        RanIter2 part_first2, RanIter2 part_last2,
-                        buffer_type* dest, func_type const& f)
-                    ->  buffer_type*
-                    {
-                        return std::set_intersection(part_first1, part_last1,
-                            part_first2, part_last2, dest, f);
-                    });
+                    set_intersection_chunk());
             }
         };
         /// \endcond
@@ -12,12 +12,14 @@
 #include <hpx/dataflow.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/invoke.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
 #include <hpx/parallel/exception_list.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/executors/execution.hpp>
@@ -245,17 +247,84 @@ namespace hpx { namespace parallel { inline namespace v1
             parallel(ExPolicy && policy, RandomIt first, RandomIt last,
                 Compare && comp, Proj && proj)
             {
+                typedef use_radix_sort<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type,
+                        RandomIt
+                    > use_radix;
+
                 // call the sort routine and return the right type,
                 // depending on execution policy
                 return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
-                    parallel_sort_async(std::forward<ExPolicy>(policy),
-                        first, last,
-                        util::compare_projected<Compare, Proj>(
-                            std::forward<Compare>(comp),
-                            std::forward<Proj>(proj)
-                        )));
+                    parallel_sort_dispatch(std::forward<ExPolicy>(policy),
+                        first, last, std::forward<Compare>(comp),
+                        std::forward<Proj>(proj), use_radix()));
+            }
+
+        private:
+            // comparison based sort
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_sort_dispatch(ExPolicy && policy, RandomIt first,
+                RandomIt last, Compare && comp, Proj && proj, std::false_type)
+            {
+                return parallel_sort_async(std::forward<ExPolicy>(policy),
+                    first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)
+                    ));
+            }
+
+            // arithmetic keys compared using operator< are radix sorted
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_sort_dispatch(ExPolicy && policy, RandomIt first,
+                RandomIt last, Compare && comp, Proj && proj, std::true_type)
+            {
+                if (std::size_t(last - first) < radix_sort_limit)
+                {
+                    return parallel_sort_dispatch(
+                        std::forward<ExPolicy>(policy), first, last,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj),
+                        std::false_type());
+                }
+
+                try {
+                    return parallel_radix_sort_async(
+                        std::forward<ExPolicy>(policy), first, last,
+                        typename hpx::util::decay<Proj>::type(
+                            std::forward<Proj>(proj)));
+                }
+                catch (...) {
+                    return detail::handle_exception<ExPolicy, RandomIt>::call(
+                        std::current_exception());
+                }
             }
         };
+
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, RandomIt
+        >::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::sort<RandomIt>().call(
+                std::forward<ExPolicy>(policy), is_seq(), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -274,6 +343,11 @@ namespace hpx { namespace parallel { inline namespace v1
     /// pointing to an element of the sequence, and
     /// INVOKE(comp, INVOKE(proj, *(i + n)), INVOKE(proj, *i)) == false.
     ///
+    /// The parallel version sorts large sequences of (projected) integral or
+    /// floating point keys compared using \a std::less (the default) with a
+    /// least significant digit radix sort instead of comparing the elements.
+    /// This requires a temporary buffer of N default constructed elements.
+    ///
     /// \tparam ExPolicy    The type of the execution policy to use (deduced).
     ///                     It describes the manner in which the execution
     ///                     of the algorithm may be parallelized and the manner
@@ -346,11 +420,12 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_random_access_iterator<RandomIt>::value),
             "Requires a random access iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<RandomIt> is_segmented;
 
-        return detail::sort<RandomIt>().call(
-            std::forward<ExPolicy>(policy), is_seq(), first, last,
-            std::forward<Compare>(comp), std::forward<Proj>(proj));
+        return detail::sort_(
+            std::forward<ExPolicy>(policy), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj),
+            is_segmented());
     }
 }}}
 
@@ -0,0 +1,353 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_STABLE_SORT_HPP)
+#define HPX_PARALLEL_ALGORITHM_STABLE_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/merge_path.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // stable_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        static const std::size_t stable_sort_limit_per_task = 16384ul;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Merge the neighboring sorted runs (given by their boundaries) of
+        // the source pairwise into the destination, a run without partner
+        // is moved. All merges of one round are split into blocks of equal
+        // size along their merge paths.
+        template <typename ExPolicy, typename Iter1, typename Iter2,
+            typename Compare>
+        void merge_sorted_runs(ExPolicy& policy, Iter1 src, Iter2 dest,
+            std::vector<std::size_t>& runs, std::size_t chunk_size,
+            Compare const& comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+            std::size_t const num_runs = runs.size() - 1;
+
+            std::vector<std::size_t> merged_runs;
+            merged_runs.reserve(num_runs / 2 + 2);
+
+            std::vector<hpx::future<void> > workitems;
+            workitems.reserve(runs.back() / chunk_size + num_runs);
+
+            try {
+                for (std::size_t r = 0; r < num_runs; r += 2)
+                {
+                    std::size_t begin = runs[r];
+                    std::size_t middle = runs[r + 1];
+                    std::size_t end =
+                        (r + 2 <= num_runs) ? runs[r + 2] : middle;
+
+                    merge_path_async(policy, workitems,
+                        src + begin, middle - begin,
+                        src + middle, end - middle,
+                        dest + begin, end - begin, chunk_size, comp);
+
+                    merged_runs.push_back(begin);
+                }
+            }
+            catch (...) {
+                // the scheduled merges still refer to the buffers
+                hpx::wait_all(workitems);
+                throw;
+            }
+            merged_runs.push_back(runs.back());
+
+            merge_path_wait<policy_type>(workitems);
+
+            runs = std::move(merged_runs);
+        }
+
+        // Sort the chunks of the input independently and merge the sorted
+        // runs pairwise until a single run is left. The merge rounds
+        // alternate between the input range and a temporary buffer.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        void parallel_stable_sort_helper(ExPolicy& policy,
+            RandomIt first, RandomIt last, Compare const& comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            std::size_t const count = std::size_t(last - first);
+            if (count <= stable_sort_limit_per_task)
+            {
+                std::stable_sort(first, last, comp);
+                return;
+            }
+
+            std::size_t const chunk_size = merge_path_chunk_size(
+                policy, count, stable_sort_limit_per_task);
+
+            // sort the initial runs
+            std::vector<std::size_t> runs;
+            runs.reserve(count / chunk_size + 2);
+
+            std::vector<hpx::future<void> > workitems;
+            workitems.reserve(count / chunk_size + 1);
+
+            for (std::size_t base = 0; base < count; base += chunk_size)
+            {
+                RandomIt run_first = first + base;
+                RandomIt run_last =
+                    first + (std::min)(base + chunk_size, count);
+
+                workitems.push_back(execution::async_execute(
+                    policy.executor(),
+                    [run_first, run_last, comp]() -> void
+                    {
+                        std::stable_sort(run_first, run_last, comp);
+                    }));
+
+                runs.push_back(base);
+            }
+            runs.push_back(count);
+
+            merge_path_wait<policy_type>(workitems);
+
+            if (runs.size() == 2)
+                return;
+
+            // merge the runs, ping-ponging between input and buffer
+            std::unique_ptr<value_type[]> buffer(new value_type[count]);
+
+            bool in_buffer = false;
+            while (runs.size() > 2)
+            {
+                if (in_buffer)
+                {
+                    merge_sorted_runs(policy, buffer.get(), first, runs,
+                        chunk_size, comp);
+                }
+                else
+                {
+                    merge_sorted_runs(policy, first, buffer.get(), runs,
+                        chunk_size, comp);
+                }
+                in_buffer = !in_buffer;
+            }
+
+            // move the result back into the input range, if needed
+            if (in_buffer)
+            {
+                merge_sorted_runs(policy, buffer.get(), first, runs,
+                    chunk_size, comp);
+            }
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt>
+        parallel_stable_sort(ExPolicy && policy, RandomIt first,
+            RandomIt last, Compare && comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+
+            return execution::async_execute(policy.executor(),
+                [policy, first, last, comp]() mutable -> RandomIt
+                {
+                    try {
+                        parallel_stable_sort_helper(policy, first, last,
+                            comp);
+                        return last;
+                    }
+                    catch (...) {
+                        util::detail::handle_local_exceptions<
+                                policy_type
+                            >::call(std::current_exception());
+                    }
+
+                    // Not reachable.
+                    HPX_ASSERT(false);
+                    return last;
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // stable_sort
+        template <typename RandomIt>
+        struct stable_sort
+          : public detail::algorithm<stable_sort<RandomIt>, RandomIt>
+        {
+            stable_sort()
+              : stable_sort::algorithm("stable_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                        ExPolicy, RandomIt
+                    > algorithm_result;
+
+                // the comparison is performed asynchronously, store copies
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                try {
+                    return algorithm_result::get(
+                        parallel_stable_sort(std::forward<ExPolicy>(policy),
+                            first, last,
+                            compare_type(
+                                std::forward<Compare>(comp),
+                                std::forward<Proj>(proj)
+                            )));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts the elements in the range [first, last) in ascending order. The
+    /// relative order of equal elements is preserved. The function
+    /// uses the given comparison function object comp (defaults to using
+    /// operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
+    ///                     comparisons.
+    ///
+    /// The parallel version sorts chunks of the input (as determined by the
+    /// executor parameters of the execution policy) independently and
+    /// merges the sorted runs pairwise. Each merge is split into pieces of
+    /// equal size along its merge path, which requires a temporary buffer of
+    /// N default constructed elements.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Compare     The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a stable_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    stable_sort(ExPolicy && policy, RandomIt first, RandomIt last,
+        Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::stable_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
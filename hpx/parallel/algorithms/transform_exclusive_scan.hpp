@@ -21,8 +21,8 @@
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -112,10 +112,11 @@ namespace hpx { namespace parallel { inline namespace v1
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 2
-                // subsequent parallel steps. The first calculates the scan
-                // results for each partition and the second produces the
-                // overall result
+                // The overall scan algorithm is performed in a single pass
+                // over the input. The first step calculates the scan results
+                // for each tile. The tiles then look back at the results
+                // published by their predecessors to find their prefix,
+                // which the third step applies to the (still cached) tile.
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
@@ -123,14 +124,11 @@ namespace hpx { namespace parallel { inline namespace v1
                 auto f3 =
                     [op, policy](
                         zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
+                        T val
                     ) -> void
                     {
                         HPX_UNUSED(policy);
 
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
                         FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
                         *dst++ = val;
 
@@ -142,7 +140,9 @@ namespace hpx { namespace parallel { inline namespace v1
                             });
                     };
 
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
+                return util::lookback_scan_partitioner<
+                        ExPolicy, FwdIter2, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
                     // step 1 performs first part of scan algorithm
@@ -158,14 +158,12 @@ namespace hpx { namespace parallel { inline namespace v1
                             get<1>(iters),
                             conv, part_init, op);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final_accumulation on each partition
+                    // step 2 combines the results of adjacent tiles
+                    op,
+                    // step 3 runs final accumulation on each tile
                     std::move(f3),
                     // use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&) -> FwdIter2
+                    [final_dest](T const&) -> FwdIter2
                     {
                         return final_dest;
                     });
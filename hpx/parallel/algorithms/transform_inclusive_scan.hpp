@@ -20,8 +20,8 @@
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/util/unused.hpp>
 
 #include <algorithm>
@@ -109,10 +109,11 @@ namespace hpx { namespace parallel { inline namespace v1
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 2
-                // subsequent parallel steps. The first calculates the scan
-                // results for each partition and the second produces the
-                // overall result
+                // The overall scan algorithm is performed in a single pass
+                // over the input. The first step calculates the scan results
+                // for each tile. The tiles then look back at the results
+                // published by their predecessors to find their prefix,
+                // which the third step applies to the (still cached) tile.
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
@@ -120,14 +121,11 @@ namespace hpx { namespace parallel { inline namespace v1
                 auto f3 =
                     [op, policy](
                         zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
+                        T val
                     ) -> void
                     {
                         HPX_UNUSED(policy);
 
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
                         FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
 
                         util::loop_n<ExPolicy>(
@@ -138,7 +136,9 @@ namespace hpx { namespace parallel { inline namespace v1
                             });
                     };
 
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
+                return util::lookback_scan_partitioner<
+                        ExPolicy, FwdIter2, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
                     // step 1 performs first part of scan algorithm
@@ -157,14 +157,12 @@ namespace hpx { namespace parallel { inline namespace v1
                             get<1>(iters),
                             conv, part_init, op);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final accumulation on each partition
+                    // step 2 combines the results of adjacent tiles
+                    op,
+                    // step 3 runs final accumulation on each tile
                     std::move(f3),
                     // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&) -> FwdIter2
+                    [final_dest](T const&) -> FwdIter2
                     {
                         return final_dest;
                     });
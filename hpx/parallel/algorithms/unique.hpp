@@ -9,6 +9,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 #include <hpx/util/unused.hpp>
@@ -225,6 +226,37 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, FwdIter
+        >::type
+        unique_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::unique<FwdIter>().call(
+                    std::forward<ExPolicy>(policy), is_seq(),
+                    first, last, std::forward<Pred>(pred),
+                    std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        unique_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -317,23 +349,18 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter>::value),
             "Required at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Required at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::unique<FwdIter>().call(
-                std::forward<ExPolicy>(policy), is_seq(),
-                first, last, std::forward<Pred>(pred),
-                std::forward<Proj>(proj));
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::unique_(
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<Pred>(pred), std::forward<Proj>(proj),
+                is_segmented());
     }
 
     /////////////////////////////////////////////////////////////////////////////
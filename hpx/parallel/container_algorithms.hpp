@@ -12,10 +12,12 @@
 #include <hpx/parallel/container_algorithms/copy.hpp>
 #include <hpx/parallel/container_algorithms/for_each.hpp>
 #include <hpx/parallel/container_algorithms/generate.hpp>
+#include <hpx/parallel/container_algorithms/inclusive_scan.hpp>
 #include <hpx/parallel/container_algorithms/is_heap.hpp>
 #include <hpx/parallel/container_algorithms/merge.hpp>
 #include <hpx/parallel/container_algorithms/minmax.hpp>
 #include <hpx/parallel/container_algorithms/partition.hpp>
+#include <hpx/parallel/container_algorithms/reduce.hpp>
 #include <hpx/parallel/container_algorithms/remove.hpp>
 #include <hpx/parallel/container_algorithms/remove_copy.hpp>
 #include <hpx/parallel/container_algorithms/replace.hpp>
@@ -24,5 +26,6 @@
 #include <hpx/parallel/container_algorithms/sort.hpp>
 #include <hpx/parallel/container_algorithms/transform.hpp>
 #include <hpx/parallel/container_algorithms/unique.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
 
 #endif
@@ -12,13 +12,28 @@
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
 #include <hpx/traits/is_range.hpp>
+#include <hpx/util/invoke.hpp>
 #include <hpx/util/range.hpp>
 #include <hpx/util/tagged_pair.hpp>
+#include <hpx/util/unused.hpp>
+#include <hpx/util/zip_iterator.hpp>
 
 #include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/tagspec.hpp>
 #include <hpx/parallel/traits/projected.hpp>
 #include <hpx/parallel/traits/projected_range.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 
+#include <boost/shared_array.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <type_traits>
 #include <utility>
 
@@ -183,6 +198,243 @@ namespace hpx { namespace parallel { inline namespace v1
             std::forward<Proj>(proj));
     }
     /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    // copy of a filtered view
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename IterPair>
+        struct copy_filtered
+          : public detail::algorithm<copy_filtered<IterPair>, IterPair>
+        {
+            copy_filtered()
+              : copy_filtered::algorithm("copy")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename OutIter,
+                typename Pred, typename Proj>
+            static std::pair<InIter, OutIter>
+            sequential(ExPolicy, InIter first, InIter last, OutIter dest,
+                Pred && pred, Proj && proj)
+            {
+                for (/**/; first != last; ++first)
+                {
+                    auto && t = *first;
+                    if (hpx::util::invoke(pred, t))
+                    {
+                        *dest = hpx::util::invoke(proj, t);
+                        ++dest;
+                    }
+                }
+                return std::make_pair(first, dest);
+            }
+
+            template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+                typename Pred, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::pair<FwdIter1, FwdIter2>
+            >::type
+            parallel(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+                FwdIter2 dest, Pred && pred, Proj && proj)
+            {
+                typedef hpx::util::zip_iterator<FwdIter1, bool*> zip_iterator;
+                typedef util::detail::algorithm_result<
+                    ExPolicy, std::pair<FwdIter1, FwdIter2>
+                > result;
+                typedef typename std::iterator_traits<FwdIter1>::difference_type
+                    difference_type;
+
+                if (first == last)
+                    return result::get(std::make_pair(last, dest));
+
+                difference_type count = std::distance(first, last);
+
+                // Like copy_if, the filter is evaluated once while counting
+                // the elements of each tile. Only the elements which are part
+                // of the view are computed, right before they are written to
+                // their final position.
+                boost::shared_array<bool> flags(new bool[count]);
+                std::size_t init = 0;
+
+                using hpx::util::get;
+                using hpx::util::make_zip_iterator;
+                typedef util::lookback_scan_partitioner<
+                        ExPolicy, std::pair<FwdIter1, FwdIter2>, std::size_t
+                    > scan_partitioner_type;
+
+                auto f1 =
+                    [pred, flags, policy]
+                    (
+                       zip_iterator part_begin, std::size_t part_size
+                    )   -> std::size_t
+                    {
+                        HPX_UNUSED(flags);
+                        HPX_UNUSED(policy);
+
+                        std::size_t curr = 0;
+                        util::loop_n<ExPolicy>(
+                            part_begin, part_size,
+                            [&pred, &curr](zip_iterator it) mutable
+                            {
+                                if ((get<1>(*it) =
+                                        hpx::util::invoke(pred, get<0>(*it))))
+                                {
+                                    ++curr;
+                                }
+                            });
+
+                        return curr;
+                    };
+                auto f3 =
+                    [dest, flags, proj, policy](
+                        zip_iterator part_begin, std::size_t part_size,
+                        std::size_t offset
+                    )
+                    {
+                        HPX_UNUSED(flags);
+                        HPX_UNUSED(policy);
+
+                        // this is invoked concurrently for all tiles
+                        FwdIter2 dst = dest;
+                        std::advance(dst, offset);
+                        util::loop_n<ExPolicy>(
+                            part_begin, part_size,
+                            [&dst, &proj](zip_iterator it) mutable
+                            {
+                                if (get<1>(*it))
+                                {
+                                    *dst = hpx::util::invoke(proj,
+                                        get<0>(*it));
+                                    ++dst;
+                                }
+                            });
+                    };
+
+                return scan_partitioner_type::call(
+                    std::forward<ExPolicy>(policy),
+                    make_zip_iterator(first, flags.get()), count, init,
+                    // step 1 performs first part of scan algorithm
+                    std::move(f1),
+                    // step 2 combines the results of adjacent tiles
+                    std::plus<std::size_t>(),
+                    // step 3 runs final accumulation on each tile
+                    std::move(f3),
+                    // step 4 use this return value
+                    [last, dest, flags](std::size_t total) mutable
+                    ->  std::pair<FwdIter1, FwdIter2>
+                    {
+                        HPX_UNUSED(flags);
+
+                        std::advance(dest, total);
+                        return std::make_pair(last, dest);
+                    });
+            }
+        };
+        /// \endcond
+    }
+
+    /// Copies the elements of the filtered view \a rng to another range
+    /// beginning at \a dest. The order of the elements is preserved.
+    ///
+    /// \note   Complexity: Evaluates the filter of \a rng exactly once for
+    ///         each element of the underlying range, performs exactly one
+    ///         assignment for each of the elements of the view.
+    ///
+    /// The filter and the transformations of the view are evaluated while
+    /// copying, no intermediate sequence is created. The elements of the
+    /// view are computed only once, after their position in the
+    /// destination range has been determined.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    ///
+    /// \returns  The \a copy algorithm returns a
+    ///           \a hpx::future<tagged_pair<tag::in(Iter), tag::out(OutIter)> >
+    ///           if the execution policy is of type
+    ///           \a sequenced_task_policy or \a parallel_task_policy and
+    ///           returns \a tagged_pair<tag::in(Iter), tag::out(OutIter)>
+    ///           otherwise.
+    ///           The \a copy algorithm returns the pair of the end of the
+    ///           range underlying \a rng and the output iterator to the
+    ///           element in the destination range, one past the last element
+    ///           copied.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename OutIter,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, hpx::util::tagged_pair<tag::in(Iter), tag::out(OutIter)>
+    >::type
+    copy(ExPolicy && policy, view::filter_view<Iter, Pred, Proj> const& rng,
+        OutIter dest)
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<OutIter>::value),
+            "Requires at least forward iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return hpx::util::make_tagged_pair<tag::in, tag::out>(
+            detail::copy_filtered<std::pair<Iter, OutIter> >().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                rng.base_begin(), rng.base_end(), dest, rng.predicate(),
+                rng.projection()));
+    }
+
+    /// Copies the elements of the filtered view \a rng for which the
+    /// predicate \a f returns true to another range beginning at \a dest.
+    /// This is equivalent to copying the view \a view::filter(rng, f).
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    /// \param f            Specifies the predicate which selects the
+    ///                     elements of the view to copy.
+    ///
+    /// \returns  The \a copy_if algorithm returns a
+    ///           \a hpx::future<tagged_pair<tag::in(Iter), tag::out(OutIter)> >
+    ///           if the execution policy is of type
+    ///           \a sequenced_task_policy or \a parallel_task_policy and
+    ///           returns \a tagged_pair<tag::in(Iter), tag::out(OutIter)>
+    ///           otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename OutIter, typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, hpx::util::tagged_pair<tag::in(Iter), tag::out(OutIter)>
+    >::type
+    copy_if(ExPolicy && policy, view::filter_view<Iter, Pred, Proj> const& rng,
+        OutIter dest, F && f)
+    {
+        return copy(std::forward<ExPolicy>(policy),
+            view::filter(rng, std::forward<F>(f)), dest);
+    }
 }}}
 
 #endif
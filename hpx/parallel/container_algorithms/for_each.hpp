@@ -11,9 +11,12 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
 #include <hpx/util/range.hpp>
 
 #include <hpx/parallel/algorithms/for_each.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
 #include <hpx/parallel/traits/projected_range.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 
@@ -110,8 +113,83 @@ namespace hpx { namespace parallel { inline namespace v1
             hpx::util::begin(rng), hpx::util::end(rng), std::forward<F>(f),
             std::forward<Proj>(proj));
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        // Invokes the function on the elements of the underlying range which
+        // are part of a filtered view.
+        template <typename F, typename Pred, typename Proj>
+        struct filtered_invoke
+        {
+            template <typename T>
+            void operator()(T && t)
+            {
+                if (hpx::util::invoke(pred_, t))
+                    hpx::util::invoke(f_, hpx::util::invoke(proj_, t));
+            }
+
+            F f_;
+            Pred pred_;
+            Proj proj_;
+        };
+    }
+    /// \endcond
+
+    /// Applies \a f to every element of the given filtered view \a rng.
+    ///
+    /// \note   Complexity: Evaluates the filter of \a rng exactly once for
+    ///         each element of the underlying range and applies \a f to each
+    ///         of the elements of the view.
+    ///
+    /// The filter, the transformations of the view and \a f are evaluated
+    /// in a single pass over the underlying range, no intermediate sequence
+    /// is created.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a for_each requires \a F to meet the
+    ///                     requirements of \a CopyConstructible.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements of the
+    ///                     view.
+    ///
+    /// \returns  The \a for_each algorithm returns a
+    ///           \a hpx::future<Iter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a Iter
+    ///           otherwise.
+    ///           It returns the end of the range underlying \a rng.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value)>
+    typename util::detail::algorithm_result<ExPolicy, Iter>::type
+    for_each(ExPolicy && policy, view::filter_view<Iter, Pred, Proj> const& rng,
+        F && f)
+    {
+        typedef detail::filtered_invoke<
+                typename hpx::util::decay<F>::type, Pred, Proj
+            > filtered_invoke;
+
+        filtered_invoke fi = {
+            std::forward<F>(f), rng.predicate(), rng.projection()
+        };
+        return for_each(std::forward<ExPolicy>(policy),
+            rng.base_begin(), rng.base_end(), std::move(fi));
+    }
 }}}
 
 #endif
 
-
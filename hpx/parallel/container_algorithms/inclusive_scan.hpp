@@ -0,0 +1,523 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/container_algorithms/inclusive_scan.hpp
+
+#if !defined(HPX_PARALLEL_CONTAINER_ALGORITHM_INCLUSIVE_SCAN_OCT_19_2017)
+#define HPX_PARALLEL_CONTAINER_ALGORITHM_INCLUSIVE_SCAN_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/range.hpp>
+#include <hpx/util/unused.hpp>
+#include <hpx/util/zip_iterator.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/inclusive_scan.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
+
+#include <boost/shared_array.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    /// Assigns through each iterator \a i in [dest, dest + size(rng)) the
+    /// value of GENERALIZED_NONCOMMUTATIVE_SUM(op, init, *begin(rng), ...,
+    /// *(begin(rng) + (i - dest))).
+    ///
+    /// \note   Complexity: O(\a size(rng)) applications of the
+    ///         predicate \a op.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam Rng         The type of the source range used (deduced).
+    ///                     The iterators extracted from this range type must
+    ///                     meet the requirements of a forward iterator.
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam Op          The type of the binary function object used for
+    ///                     the reduction operation.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to. This may be a view created
+    ///                     from other ranges, in which case the elements of
+    ///                     the view are computed while being scanned.
+    /// \param dest         Refers to the beginning of the destination range.
+    /// \param op           Specifies the function (or function object) which
+    ///                     will be invoked for each of the values of the input
+    ///                     sequence. This is a binary predicate. The signature
+    ///                     of this predicate should be equivalent to:
+    ///                     \code
+    ///                     Ret fun(const Type1 &a, const Type1 &b);
+    ///                     \endcode \n
+    ///                     The signature does not need to have const&, but
+    ///                     the function must not modify the objects passed to
+    ///                     it.
+    /// \param init         The initial value for the generalized sum.
+    ///
+    /// \returns  The \a inclusive_scan algorithm returns a
+    ///           \a hpx::future<OutIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///           The \a inclusive_scan algorithm returns the output iterator
+    ///           to the element in the destination range, one past the last
+    ///           element copied.
+    ///
+    template <typename ExPolicy, typename Rng, typename OutIter, typename Op,
+        typename T,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    inclusive_scan(ExPolicy && policy, Rng && rng, OutIter dest, Op && op,
+        T init)
+    {
+        return inclusive_scan(std::forward<ExPolicy>(policy),
+            hpx::util::begin(rng), hpx::util::end(rng), dest,
+            std::forward<Op>(op), std::move(init));
+    }
+
+    /// Assigns through each iterator \a i in [dest, dest + size(rng)) the
+    /// value of GENERALIZED_NONCOMMUTATIVE_SUM(op, *begin(rng), ...,
+    /// *(begin(rng) + (i - dest))).
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    /// \tparam Rng         The type of the source range used (deduced).
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    /// \tparam Op          The type of the binary function object used for
+    ///                     the reduction operation.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    /// \param op           Specifies the function (or function object) which
+    ///                     will be invoked for each of the values of the input
+    ///                     sequence.
+    ///
+    /// \returns  The \a inclusive_scan algorithm returns a
+    ///           \a hpx::future<OutIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///
+    template <typename ExPolicy, typename Rng, typename OutIter, typename Op,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    inclusive_scan(ExPolicy && policy, Rng && rng, OutIter dest, Op && op)
+    {
+        return inclusive_scan(std::forward<ExPolicy>(policy),
+            hpx::util::begin(rng), hpx::util::end(rng), dest,
+            std::forward<Op>(op));
+    }
+
+    /// Assigns through each iterator \a i in [dest, dest + size(rng)) the
+    /// value of GENERALIZED_NONCOMMUTATIVE_SUM(+, *begin(rng), ...,
+    /// *(begin(rng) + (i - dest))).
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    /// \tparam Rng         The type of the source range used (deduced).
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    ///
+    /// \returns  The \a inclusive_scan algorithm returns a
+    ///           \a hpx::future<OutIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///
+    template <typename ExPolicy, typename Rng, typename OutIter,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    inclusive_scan(ExPolicy && policy, Rng && rng, OutIter dest)
+    {
+        return inclusive_scan(std::forward<ExPolicy>(policy),
+            hpx::util::begin(rng), hpx::util::end(rng), dest);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // inclusive_scan over a filtered view
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Aggregate of a tile: the number of elements of the view it holds
+        // and their sum.
+        template <typename T>
+        struct filtered_scan_state
+        {
+            std::size_t count_;
+            view::detail::partial_result<T> sum_;
+        };
+
+        template <typename T, typename Op>
+        struct filtered_scan_combine
+        {
+            filtered_scan_state<T> operator()(
+                filtered_scan_state<T> const& lhs,
+                filtered_scan_state<T> const& rhs) const
+            {
+                Op op = op_;
+
+                filtered_scan_state<T> result = {
+                    lhs.count_ + rhs.count_, lhs.sum_
+                };
+                result.sum_.combine(op, rhs.sum_);
+                return result;
+            }
+
+            Op op_;
+        };
+
+        template <typename T, typename OutIter>
+        struct inclusive_scan_filtered
+          : public detail::algorithm<inclusive_scan_filtered<T, OutIter>,
+                OutIter>
+        {
+            inclusive_scan_filtered()
+              : inclusive_scan_filtered::algorithm("inclusive_scan")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Op,
+                typename Pred, typename Proj>
+            static OutIter
+            sequential(ExPolicy, InIter first, InIter last, OutIter dest,
+                view::detail::partial_result<T> const& init, Op && op, Pred && pred,
+                Proj && proj)
+            {
+                view::detail::partial_result<T> sum = init;
+                for (/**/; first != last; ++first)
+                {
+                    auto && t = *first;
+                    if (hpx::util::invoke(pred, t))
+                    {
+                        sum.accumulate(op, hpx::util::invoke(proj, t));
+                        *dest = sum.value_;
+                        ++dest;
+                    }
+                }
+                return dest;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Op,
+                typename Pred, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, OutIter
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                OutIter dest, view::detail::partial_result<T> const& init, Op && op,
+                Pred && pred, Proj && proj)
+            {
+                typedef hpx::util::zip_iterator<FwdIter, bool*> zip_iterator;
+                typedef util::detail::algorithm_result<ExPolicy, OutIter>
+                    result;
+                typedef typename std::iterator_traits<FwdIter>::difference_type
+                    difference_type;
+                typedef filtered_scan_state<T> state_type;
+                typedef typename hpx::util::decay<Op>::type op_type;
+
+                if (first == last)
+                    return result::get(std::move(dest));
+
+                difference_type count = std::distance(first, last);
+
+                // The first step evaluates the filter and sums up the
+                // elements of the view in each tile. The third step places
+                // the scanned elements once the number of elements and the
+                // sum of all preceding tiles are known. This avoids storing
+                // the elements of the view, which are computed in both steps
+                // instead.
+                boost::shared_array<bool> flags(new bool[count]);
+                state_type init_state = { 0, init };
+
+                using hpx::util::get;
+                using hpx::util::make_zip_iterator;
+
+                auto f1 =
+                    [op, pred, proj, flags, policy]
+                    (
+                        zip_iterator part_begin, std::size_t part_size
+                    )   -> state_type
+                    {
+                        HPX_UNUSED(flags);
+                        HPX_UNUSED(policy);
+
+                        state_type state = {
+                            0, view::detail::partial_result<T>()
+                        };
+                        op_type tile_op = op;
+
+                        util::loop_n<ExPolicy>(
+                            part_begin, part_size,
+                            [&](zip_iterator it)
+                            {
+                                auto && t = get<0>(*it);
+                                if ((get<1>(*it) = hpx::util::invoke(pred, t)))
+                                {
+                                    ++state.count_;
+                                    state.sum_.accumulate(tile_op,
+                                        hpx::util::invoke(proj, t));
+                                }
+                            });
+
+                        return state;
+                    };
+                auto f3 =
+                    [dest, op, proj, flags, policy](
+                        zip_iterator part_begin, std::size_t part_size,
+                        state_type const& prefix
+                    )
+                    {
+                        HPX_UNUSED(flags);
+                        HPX_UNUSED(policy);
+
+                        // this is invoked concurrently for all tiles
+                        OutIter dst = dest;
+                        std::advance(dst, prefix.count_);
+
+                        view::detail::partial_result<T> sum = prefix.sum_;
+                        op_type tile_op = op;
+
+                        util::loop_n<ExPolicy>(
+                            part_begin, part_size,
+                            [&](zip_iterator it)
+                            {
+                                if (get<1>(*it))
+                                {
+                                    sum.accumulate(tile_op,
+                                        hpx::util::invoke(proj,
+                                            get<0>(*it)));
+                                    *dst = sum.value_;
+                                    ++dst;
+                                }
+                            });
+                    };
+
+                filtered_scan_combine<T, op_type> combine = { op };
+
+                return util::lookback_scan_partitioner<
+                        ExPolicy, OutIter, state_type
+                    >::call(
+                    std::forward<ExPolicy>(policy),
+                    make_zip_iterator(first, flags.get()), count, init_state,
+                    // step 1 performs first part of scan algorithm
+                    std::move(f1),
+                    // step 2 combines the results of adjacent tiles
+                    std::move(combine),
+                    // step 3 runs final accumulation on each tile
+                    std::move(f3),
+                    // step 4 use this return value
+                    [dest, flags](state_type const& total) mutable
+                    ->  OutIter
+                    {
+                        HPX_UNUSED(flags);
+
+                        std::advance(dest, total.count_);
+                        return dest;
+                    });
+            }
+        };
+
+        template <typename T, typename ExPolicy, typename Iter, typename Pred,
+            typename Proj, typename OutIter, typename Op>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        inclusive_scan_filtered_(ExPolicy && policy,
+            view::filter_view<Iter, Pred, Proj> const& rng, OutIter dest,
+            view::detail::partial_result<T> const& init, Op && op)
+        {
+            static_assert(
+                (hpx::traits::is_forward_iterator<OutIter>::value),
+                "Requires at least forward iterator.");
+
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return inclusive_scan_filtered<T, OutIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                rng.base_begin(), rng.base_end(), dest, init,
+                std::forward<Op>(op), rng.predicate(), rng.projection());
+        }
+        /// \endcond
+    }
+
+    /// Assigns through each iterator \a i in [dest, dest + n) the value of
+    /// GENERALIZED_NONCOMMUTATIVE_SUM(op, init, e_0, ..., e_(i - dest)),
+    /// where e_0 to e_n-1 are the elements of the filtered view \a rng.
+    ///
+    /// \note   Complexity: Evaluates the filter of \a rng exactly once for
+    ///         each element of the underlying range, O(n) applications of
+    ///         the predicate \a op.
+    ///
+    /// The filter, the transformations of the view and the scan are
+    /// evaluated in a single pass over the underlying range, no
+    /// intermediate sequence is created. The transformations of the view
+    /// are evaluated twice for each of its elements.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam Op          The type of the binary function object used for
+    ///                     the reduction operation.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    /// \param op           Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements of the
+    ///                     view.
+    /// \param init         The initial value for the generalized sum.
+    ///
+    /// \returns  The \a inclusive_scan algorithm returns a
+    ///           \a hpx::future<OutIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///           The \a inclusive_scan algorithm returns the output iterator
+    ///           to the element in the destination range, one past the last
+    ///           element written.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename OutIter, typename Op, typename T,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    inclusive_scan(ExPolicy && policy,
+        view::filter_view<Iter, Pred, Proj> const& rng, OutIter dest,
+        Op && op, T init)
+    {
+        return detail::inclusive_scan_filtered_<T>(
+            std::forward<ExPolicy>(policy), rng, dest,
+            view::detail::partial_result<T>(std::move(init)),
+            std::forward<Op>(op));
+    }
+
+    /// Assigns through each iterator \a i in [dest, dest + n) the value of
+    /// GENERALIZED_NONCOMMUTATIVE_SUM(op, e_0, ..., e_(i - dest)), where e_0
+    /// to e_n-1 are the elements of the filtered view \a rng.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    /// \tparam Op          The type of the binary function object used for
+    ///                     the reduction operation.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    /// \param op           Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements of the
+    ///                     view.
+    ///
+    /// \returns  The \a inclusive_scan algorithm returns a
+    ///           \a hpx::future<OutIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename OutIter, typename Op,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    inclusive_scan(ExPolicy && policy,
+        view::filter_view<Iter, Pred, Proj> const& rng, OutIter dest,
+        Op && op)
+    {
+        typedef typename view::filter_view<Iter, Pred, Proj>::value_type
+            value_type;
+
+        return detail::inclusive_scan_filtered_<value_type>(
+            std::forward<ExPolicy>(policy), rng, dest,
+            view::detail::partial_result<value_type>(),
+            std::forward<Op>(op));
+    }
+
+    /// Assigns through each iterator \a i in [dest, dest + n) the value of
+    /// GENERALIZED_NONCOMMUTATIVE_SUM(+, e_0, ..., e_(i - dest)), where e_0
+    /// to e_n-1 are the elements of the filtered view \a rng.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    ///
+    /// \returns  The \a inclusive_scan algorithm returns a
+    ///           \a hpx::future<OutIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename OutIter,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<OutIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    inclusive_scan(ExPolicy && policy,
+        view::filter_view<Iter, Pred, Proj> const& rng, OutIter dest)
+    {
+        typedef typename view::filter_view<Iter, Pred, Proj>::value_type
+            value_type;
+
+        return inclusive_scan(std::forward<ExPolicy>(policy), rng, dest,
+            std::plus<value_type>());
+    }
+}}}
+
+#endif
@@ -0,0 +1,316 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/container_algorithms/reduce.hpp
+
+#if !defined(HPX_PARALLEL_CONTAINER_ALGORITHM_REDUCE_OCT_19_2017)
+#define HPX_PARALLEL_CONTAINER_ALGORITHM_REDUCE_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/range.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/reduce.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    /// Returns GENERALIZED_SUM(f, init, *begin(rng), ..., *(end(rng) - 1)).
+    ///
+    /// \note   Complexity: O(\a size(rng)) applications of the
+    ///         predicate \a f.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam Rng         The type of the source range used (deduced).
+    ///                     The iterators extracted from this range type must
+    ///                     meet the requirements of a forward iterator.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a reduce requires \a F to meet the
+    ///                     requirements of \a CopyConstructible.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to. This may be a view created
+    ///                     from other ranges, in which case the elements of
+    ///                     the view are computed while being reduced.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements in the
+    ///                     sequence. This is a binary predicate. The signature
+    ///                     of this predicate should be equivalent to:
+    ///                     \code
+    ///                     Ret fun(const Type1 &a, const Type1 &b);
+    ///                     \endcode \n
+    ///                     The signature does not need to have const&.
+    ///                     The types \a Type1 \a Ret must be
+    ///                     such that an object of type \a iterator_t<Rng>
+    ///                     can be dereferenced and then implicitly converted
+    ///                     to any of those types.
+    /// \param init         The initial value for the generalized sum.
+    ///
+    /// The reduce operations in the parallel \a reduce algorithm invoked
+    /// with an execution policy object of type \a sequenced_policy
+    /// execute in sequential order in the calling thread.
+    ///
+    /// The reduce operations in the parallel \a reduce algorithm invoked
+    /// with an execution policy object of type \a parallel_policy
+    /// or \a parallel_task_policy are permitted to execute in an unordered
+    /// fashion in unspecified threads, and indeterminately sequenced
+    /// within each thread.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a T otherwise.
+    ///           The \a reduce algorithm returns the result of the
+    ///           generalized sum over the elements given by the input range.
+    ///
+    template <typename ExPolicy, typename Rng, typename T, typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value)>
+    typename util::detail::algorithm_result<ExPolicy, T>::type
+    reduce(ExPolicy && policy, Rng && rng, T init, F && f)
+    {
+        return reduce(std::forward<ExPolicy>(policy),
+            hpx::util::begin(rng), hpx::util::end(rng), std::move(init),
+            std::forward<F>(f));
+    }
+
+    /// Returns GENERALIZED_SUM(+, init, *begin(rng), ..., *(end(rng) - 1)).
+    ///
+    /// \note   Complexity: O(\a size(rng)) applications of the
+    ///         operator+().
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam Rng         The type of the source range used (deduced).
+    ///                     The iterators extracted from this range type must
+    ///                     meet the requirements of a forward iterator.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to.
+    /// \param init         The initial value for the generalized sum.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a T otherwise.
+    ///           The \a reduce algorithm returns the result of the
+    ///           generalized sum (applying operator+()) over the elements
+    ///           given by the input range.
+    ///
+    template <typename ExPolicy, typename Rng, typename T,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value)>
+    typename util::detail::algorithm_result<ExPolicy, T>::type
+    reduce(ExPolicy && policy, Rng && rng, T init)
+    {
+        return reduce(std::forward<ExPolicy>(policy),
+            hpx::util::begin(rng), hpx::util::end(rng), std::move(init),
+            std::plus<T>());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // reduce over a filtered view
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename T>
+        struct reduce_filtered
+          : public detail::algorithm<reduce_filtered<T>, T>
+        {
+            reduce_filtered()
+              : reduce_filtered::algorithm("reduce")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename T_,
+                typename Reduce, typename Pred, typename Proj>
+            static T
+            sequential(ExPolicy, InIter first, InIter last, T_ && init,
+                Reduce && r, Pred && pred, Proj && proj)
+            {
+                T val = std::forward<T_>(init);
+                for (/**/; first != last; ++first)
+                {
+                    auto && t = *first;
+                    if (hpx::util::invoke(pred, t))
+                    {
+                        val = hpx::util::invoke(r, std::move(val),
+                            hpx::util::invoke(proj, t));
+                    }
+                }
+                return val;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename T_,
+                typename Reduce, typename Pred, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy, T>::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                T_ && init, Reduce && r, Pred && pred, Proj && proj)
+            {
+                // chunks without any element of the view don't contribute
+                // to the result
+                typedef view::detail::partial_result<T> partial_result;
+
+                if (first == last)
+                {
+                    return util::detail::algorithm_result<ExPolicy, T>::get(
+                        std::forward<T_>(init));
+                }
+
+                return util::partitioner<ExPolicy, T, partial_result>::call(
+                    std::forward<ExPolicy>(policy),
+                    first, std::distance(first, last),
+                    [r, pred, proj](FwdIter part_begin, std::size_t part_size)
+                    ->  partial_result
+                    {
+                        typename hpx::util::decay<Reduce>::type op = r;
+
+                        partial_result val;
+                        util::loop_n<ExPolicy>(part_begin, part_size,
+                            [&](FwdIter it)
+                            {
+                                auto && t = *it;
+                                if (hpx::util::invoke(pred, t))
+                                {
+                                    val.accumulate(op,
+                                        hpx::util::invoke(proj, t));
+                                }
+                            });
+                        return val;
+                    },
+                    hpx::util::unwrapping(
+                        [init, r](std::vector<partial_result> && results) -> T
+                        {
+                            typename hpx::util::decay<Reduce>::type op = r;
+
+                            partial_result val(init);
+                            for (partial_result const& result : results)
+                                val.combine(op, result);
+                            return std::move(val.value_);
+                        }));
+            }
+        };
+        /// \endcond
+    }
+
+    /// Returns GENERALIZED_SUM(f, init, e_0, ..., e_n-1), where e_0 to e_n-1
+    /// are the elements of the given filtered view \a rng.
+    ///
+    /// \note   Complexity: Evaluates the filter of \a rng exactly once for
+    ///         each element of the underlying range, O(n) applications of
+    ///         the predicate \a f.
+    ///
+    /// The filter, the transformations of the view and the reduction are
+    /// evaluated in a single pass over the underlying range, no
+    /// intermediate sequence is created.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a reduce requires \a F to meet the
+    ///                     requirements of \a CopyConstructible.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param init         The initial value for the generalized sum.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked to combine the elements of the
+    ///                     view and the intermediate results.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a T otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename T, typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value)>
+    typename util::detail::algorithm_result<ExPolicy, T>::type
+    reduce(ExPolicy && policy, view::filter_view<Iter, Pred, Proj> const& rng,
+        T init, F && f)
+    {
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::reduce_filtered<T>().call(
+            std::forward<ExPolicy>(policy), is_seq(),
+            rng.base_begin(), rng.base_end(), std::move(init),
+            std::forward<F>(f), rng.predicate(), rng.projection());
+    }
+
+    /// Returns GENERALIZED_SUM(+, init, e_0, ..., e_n-1), where e_0 to e_n-1
+    /// are the elements of the given filtered view \a rng.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the filtered view of the elements the
+    ///                     algorithm will be applied to.
+    /// \param init         The initial value for the generalized sum.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a T otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Pred, typename Proj,
+        typename T,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value)>
+    typename util::detail::algorithm_result<ExPolicy, T>::type
+    reduce(ExPolicy && policy, view::filter_view<Iter, Pred, Proj> const& rng,
+        T init)
+    {
+        return reduce(std::forward<ExPolicy>(policy), rng, std::move(init),
+            std::plus<T>());
+    }
+}}}
+
+#endif
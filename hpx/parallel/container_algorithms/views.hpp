@@ -0,0 +1,428 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/container_algorithms/views.hpp
+
+#if !defined(HPX_PARALLEL_CONTAINER_ALGORITHM_VIEWS_OCT_19_2017)
+#define HPX_PARALLEL_CONTAINER_ALGORITHM_VIEWS_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/iterator_facade.hpp>
+#include <hpx/util/iterator_range.hpp>
+#include <hpx/util/range.hpp>
+#include <hpx/util/transform_iterator.hpp>
+#include <hpx/util/zip_iterator.hpp>
+
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace view
+{
+    // The views defined here are lazy: they refer to the elements of the
+    // underlying ranges and compute the elements they expose only when
+    // those are accessed. A terminal algorithm (for_each, reduce, copy,
+    // inclusive_scan, etc.) applied to a chain of views runs the whole chain
+    // in a single partitioned pass, without materializing any intermediate
+    // sequence.
+    //
+    // With the exception of filter, all views are random access ranges
+    // which can be passed to any of the range based algorithms. A filtered
+    // view does not have a random access iteration space. It keeps the
+    // iteration space of the range it was created from instead and can be
+    // used with the terminal algorithms providing an overload for it.
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        // Random access iterator representing a sequence of increasing
+        // values.
+        template <typename T>
+        class iota_iterator
+          : public hpx::util::iterator_facade<
+                iota_iterator<T>, T const, std::random_access_iterator_tag, T>
+        {
+        private:
+            typedef hpx::util::iterator_facade<
+                    iota_iterator<T>, T const,
+                    std::random_access_iterator_tag, T
+                > base_type;
+
+        public:
+            iota_iterator()
+              : value_()
+            {}
+
+            explicit iota_iterator(T value)
+              : value_(value)
+            {}
+
+        private:
+            friend class hpx::util::iterator_core_access;
+
+            bool equal(iota_iterator const& other) const
+            {
+                return value_ == other.value_;
+            }
+
+            T dereference() const
+            {
+                return value_;
+            }
+
+            void increment()
+            {
+                ++value_;
+            }
+
+            void decrement()
+            {
+                --value_;
+            }
+
+            void advance(std::ptrdiff_t n)
+            {
+                value_ += static_cast<T>(n);
+            }
+
+            std::ptrdiff_t distance_to(iota_iterator const& other) const
+            {
+                return static_cast<std::ptrdiff_t>(other.value_) -
+                    static_cast<std::ptrdiff_t>(value_);
+            }
+
+            T value_;
+        };
+
+        // Iterators have to be copy assignable, which function objects (most
+        // notably lambdas) are not necessarily.
+        template <typename F>
+        class assignable_function
+        {
+        public:
+            explicit assignable_function(F const& f)
+            {
+                new (&storage_) F(f);
+            }
+            explicit assignable_function(F && f)
+            {
+                new (&storage_) F(std::move(f));
+            }
+
+            assignable_function(assignable_function const& rhs)
+            {
+                new (&storage_) F(rhs.get());
+            }
+            assignable_function(assignable_function && rhs)
+            {
+                new (&storage_) F(std::move(rhs.get()));
+            }
+
+            ~assignable_function()
+            {
+                get().~F();
+            }
+
+            assignable_function& operator=(assignable_function const& rhs)
+            {
+                if (this != &rhs)
+                {
+                    get().~F();
+                    new (&storage_) F(rhs.get());
+                }
+                return *this;
+            }
+
+            F& get()
+            {
+                return *reinterpret_cast<F*>(&storage_);
+            }
+            F const& get() const
+            {
+                return *reinterpret_cast<F const*>(&storage_);
+            }
+
+        private:
+            typename std::aligned_storage<sizeof(F), alignof(F)>::type storage_;
+        };
+
+        // Invoked by the transform_iterator with the underlying iterator.
+        template <typename F>
+        struct transform_dereference
+        {
+            template <typename F_>
+            explicit transform_dereference(F_ && f)
+              : f_(std::forward<F_>(f))
+            {}
+
+            template <typename Iter>
+            auto operator()(Iter const& it) const
+            ->  decltype(hpx::util::invoke(std::declval<F const&>(), *it))
+            {
+                return hpx::util::invoke(f_.get(), *it);
+            }
+
+            assignable_function<F> f_;
+        };
+
+        // Partial result of a reduction over the elements of a view, this is
+        // empty if none of the reduced elements are part of the view.
+        template <typename T>
+        struct partial_result
+        {
+            partial_result()
+              : has_value_(false), value_()
+            {}
+
+            explicit partial_result(T value)
+              : has_value_(true), value_(std::move(value))
+            {}
+
+            template <typename Op, typename U>
+            void accumulate(Op& op, U && value)
+            {
+                if (has_value_)
+                {
+                    value_ = hpx::util::invoke(op, std::move(value_),
+                        std::forward<U>(value));
+                }
+                else
+                {
+                    value_ = std::forward<U>(value);
+                    has_value_ = true;
+                }
+            }
+
+            template <typename Op>
+            void combine(Op& op, partial_result const& rhs)
+            {
+                if (rhs.has_value_)
+                    accumulate(op, rhs.value_);
+            }
+
+            bool has_value_;
+            T value_;
+        };
+
+        // f(g(x))
+        template <typename F, typename G>
+        struct compose
+        {
+            template <typename T>
+            auto operator()(T && t) const
+            ->  decltype(hpx::util::invoke(std::declval<F const&>(),
+                    hpx::util::invoke(std::declval<G const&>(),
+                        std::forward<T>(t))))
+            {
+                return hpx::util::invoke(f_,
+                    hpx::util::invoke(g_, std::forward<T>(t)));
+            }
+
+            F f_;
+            G g_;
+        };
+
+        // Combined predicate of two stacked filters, the second predicate is
+        // invoked on the projected element.
+        template <typename Pred1, typename Pred2, typename Proj>
+        struct both
+        {
+            template <typename T>
+            bool operator()(T && t) const
+            {
+                return hpx::util::invoke(pred1_, t) &&
+                    hpx::util::invoke(pred2_, hpx::util::invoke(proj_, t));
+            }
+
+            Pred1 pred1_;
+            Pred2 pred2_;
+            Proj proj_;
+        };
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A view of the elements of the range [base_begin, base_end) for which
+    /// \a pred returns true, each of which is exposed as the result of
+    /// invoking \a proj on it.
+    template <typename Iter, typename Pred,
+        typename Proj = util::projection_identity>
+    class filter_view
+    {
+    public:
+        typedef Iter base_iterator;
+        typedef Pred predicate_type;
+        typedef Proj projection_type;
+
+        typedef typename hpx::util::decay<
+                typename hpx::util::invoke_result<Proj,
+                    typename std::iterator_traits<Iter>::reference
+                >::type
+            >::type value_type;
+
+        filter_view(Iter first, Iter last, Pred pred, Proj proj = Proj())
+          : first_(std::move(first)), last_(std::move(last)),
+            pred_(std::move(pred)), proj_(std::move(proj))
+        {}
+
+        /// The iteration space of the underlying range
+        Iter base_begin() const { return first_; }
+        Iter base_end() const { return last_; }
+
+        /// Returns whether the given element of the underlying range is part
+        /// of this view
+        Pred const& predicate() const { return pred_; }
+
+        /// Computes the element of this view from the given element of the
+        /// underlying range
+        Proj const& projection() const { return proj_; }
+
+    private:
+        Iter first_;
+        Iter last_;
+        Pred pred_;
+        Proj proj_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Creates a view of the sequence of values [first, last), generated by
+    /// repeatedly incrementing \a first.
+    template <typename T>
+    hpx::util::iterator_range<detail::iota_iterator<T> >
+    iota(T first, T last)
+    {
+        return hpx::util::make_iterator_range(
+            detail::iota_iterator<T>(first), detail::iota_iterator<T>(last));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Creates a view of the results of invoking \a f on the elements of the
+    /// given range. The function is invoked whenever an element is accessed.
+    template <typename Rng, typename F>
+    typename std::enable_if<
+        hpx::traits::is_range<Rng>::value,
+        hpx::util::iterator_range<
+            hpx::util::transform_iterator<
+                typename hpx::traits::range_iterator<Rng>::type,
+                detail::transform_dereference<
+                    typename hpx::util::decay<F>::type>
+            >
+        >
+    >::type
+    transform(Rng && rng, F && f)
+    {
+        typedef typename hpx::traits::range_iterator<Rng>::type iterator;
+        typedef detail::transform_dereference<
+                typename hpx::util::decay<F>::type
+            > transformer;
+
+        transformer t(std::forward<F>(f));
+        return hpx::util::make_iterator_range(
+            hpx::util::transform_iterator<iterator, transformer>(
+                hpx::util::begin(rng), t),
+            hpx::util::transform_iterator<iterator, transformer>(
+                hpx::util::end(rng), t));
+    }
+
+    template <typename Iter, typename Pred, typename Proj, typename F>
+    filter_view<Iter, Pred,
+        detail::compose<typename hpx::util::decay<F>::type, Proj> >
+    transform(filter_view<Iter, Pred, Proj> const& rng, F && f)
+    {
+        typedef detail::compose<typename hpx::util::decay<F>::type, Proj>
+            projection;
+
+        projection proj = { std::forward<F>(f), rng.projection() };
+        return filter_view<Iter, Pred, projection>(rng.base_begin(),
+            rng.base_end(), rng.predicate(), std::move(proj));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Creates a view of the elements of the given range for which \a pred
+    /// returns true.
+    template <typename Rng, typename Pred>
+    typename std::enable_if<
+        hpx::traits::is_range<Rng>::value,
+        filter_view<
+            typename hpx::traits::range_iterator<Rng>::type,
+            typename hpx::util::decay<Pred>::type>
+    >::type
+    filter(Rng && rng, Pred && pred)
+    {
+        typedef typename hpx::traits::range_iterator<Rng>::type iterator;
+
+        return filter_view<iterator, typename hpx::util::decay<Pred>::type>(
+            hpx::util::begin(rng), hpx::util::end(rng),
+            std::forward<Pred>(pred));
+    }
+
+    template <typename Iter, typename Pred1, typename Proj, typename Pred2>
+    filter_view<Iter,
+        detail::both<Pred1, typename hpx::util::decay<Pred2>::type, Proj>,
+        Proj>
+    filter(filter_view<Iter, Pred1, Proj> const& rng, Pred2 && pred)
+    {
+        typedef detail::both<
+                Pred1, typename hpx::util::decay<Pred2>::type, Proj
+            > predicate;
+
+        predicate p = {
+            rng.predicate(), std::forward<Pred2>(pred), rng.projection()
+        };
+        return filter_view<Iter, predicate, Proj>(rng.base_begin(),
+            rng.base_end(), std::move(p), rng.projection());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Creates a view of tuples holding the corresponding elements of all
+    /// given ranges. The view is as long as the first of the ranges. Filtered
+    /// views can't be zipped as their elements can't be matched up without
+    /// evaluating the filters.
+    template <typename Rng, typename ... Rngs>
+    hpx::util::iterator_range<
+        hpx::util::zip_iterator<
+            typename hpx::traits::range_iterator<Rng>::type,
+            typename hpx::traits::range_iterator<Rngs>::type...
+        >
+    >
+    zip(Rng && rng, Rngs &&... rngs)
+    {
+        std::ptrdiff_t count = std::distance(
+            hpx::util::begin(rng), hpx::util::end(rng));
+
+        return hpx::util::make_iterator_range(
+            hpx::util::make_zip_iterator(
+                hpx::util::begin(rng), hpx::util::begin(rngs)...),
+            hpx::util::make_zip_iterator(
+                hpx::util::end(rng),
+                std::next(hpx::util::begin(rngs), count)...));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Creates a view of tuples holding the index and the value of each of
+    /// the elements of the given range. Filtered views can't be enumerated.
+    template <typename Rng>
+    hpx::util::iterator_range<
+        hpx::util::zip_iterator<
+            detail::iota_iterator<std::size_t>,
+            typename hpx::traits::range_iterator<Rng>::type
+        >
+    >
+    enumerate(Rng && rng)
+    {
+        return zip(iota(std::size_t(0), std::size_t(hpx::util::size(rng))),
+            std::forward<Rng>(rng));
+    }
+}}}}
+
+#endif
@@ -0,0 +1,374 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_DATAPAR_DETAIL_SIMD_OPS_OCT_19_2017_0214PM)
+#define HPX_PARALLEL_DATAPAR_DETAIL_SIMD_OPS_OCT_19_2017_0214PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define HPX_DATAPAR_SIMD_AVX512
+#define HPX_DATAPAR_SIMD_AVX
+#define HPX_DATAPAR_SIMD_SSE2
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define HPX_DATAPAR_SIMD_AVX
+#define HPX_DATAPAR_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HPX_DATAPAR_SIMD_SSE2
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace simd { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The width (in bytes) of the widest vector register the target
+    // architecture was compiled for. A value of zero selects the scalar
+    // fallback.
+#if defined(HPX_DATAPAR_SIMD_AVX512)
+    static std::size_t const native_register_size = 64;
+#elif defined(HPX_DATAPAR_SIMD_AVX)
+    static std::size_t const native_register_size = 32;
+#elif defined(HPX_DATAPAR_SIMD_SSE2)
+    static std::size_t const native_register_size = 16;
+#else
+    static std::size_t const native_register_size = 0;
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    // All operations work on the (suitably aligned) storage of the vector
+    // packs. The generic implementation relies on the compiler to vectorize
+    // the fixed length loops, the specializations below use the intrinsics
+    // of the instruction set the code is compiled for. The operands of the
+    // min/max intrinsics are swapped to match std::min/std::max for NaNs.
+    template <typename T, std::size_t N>
+    struct simd_ops
+    {
+        static HPX_FORCEINLINE void
+        add(T* r, T const* a, T const* b)
+        {
+            for (std::size_t i = 0; i != N; ++i)
+                r[i] = a[i] + b[i];
+        }
+
+        static HPX_FORCEINLINE void
+        sub(T* r, T const* a, T const* b)
+        {
+            for (std::size_t i = 0; i != N; ++i)
+                r[i] = a[i] - b[i];
+        }
+
+        static HPX_FORCEINLINE void
+        mul(T* r, T const* a, T const* b)
+        {
+            for (std::size_t i = 0; i != N; ++i)
+                r[i] = a[i] * b[i];
+        }
+
+        static HPX_FORCEINLINE void
+        div(T* r, T const* a, T const* b)
+        {
+            for (std::size_t i = 0; i != N; ++i)
+                r[i] = a[i] / b[i];
+        }
+
+        static HPX_FORCEINLINE void
+        min(T* r, T const* a, T const* b)
+        {
+            for (std::size_t i = 0; i != N; ++i)
+                r[i] = (std::min)(a[i], b[i]);
+        }
+
+        static HPX_FORCEINLINE void
+        max(T* r, T const* a, T const* b)
+        {
+            for (std::size_t i = 0; i != N; ++i)
+                r[i] = (std::max)(a[i], b[i]);
+        }
+    };
+
+#if defined(HPX_DATAPAR_SIMD_SSE2)
+    ///////////////////////////////////////////////////////////////////////////
+    template <>
+    struct simd_ops<float, 4>
+    {
+        static HPX_FORCEINLINE void
+        add(float* r, float const* a, float const* b)
+        {
+            _mm_store_ps(r, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        sub(float* r, float const* a, float const* b)
+        {
+            _mm_store_ps(r, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        mul(float* r, float const* a, float const* b)
+        {
+            _mm_store_ps(r, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        div(float* r, float const* a, float const* b)
+        {
+            _mm_store_ps(r, _mm_div_ps(_mm_load_ps(a), _mm_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        min(float* r, float const* a, float const* b)
+        {
+            _mm_store_ps(r, _mm_min_ps(_mm_load_ps(b), _mm_load_ps(a)));
+        }
+
+        static HPX_FORCEINLINE void
+        max(float* r, float const* a, float const* b)
+        {
+            _mm_store_ps(r, _mm_max_ps(_mm_load_ps(b), _mm_load_ps(a)));
+        }
+    };
+
+    template <>
+    struct simd_ops<double, 2>
+    {
+        static HPX_FORCEINLINE void
+        add(double* r, double const* a, double const* b)
+        {
+            _mm_store_pd(r, _mm_add_pd(_mm_load_pd(a), _mm_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        sub(double* r, double const* a, double const* b)
+        {
+            _mm_store_pd(r, _mm_sub_pd(_mm_load_pd(a), _mm_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        mul(double* r, double const* a, double const* b)
+        {
+            _mm_store_pd(r, _mm_mul_pd(_mm_load_pd(a), _mm_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        div(double* r, double const* a, double const* b)
+        {
+            _mm_store_pd(r, _mm_div_pd(_mm_load_pd(a), _mm_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        min(double* r, double const* a, double const* b)
+        {
+            _mm_store_pd(r, _mm_min_pd(_mm_load_pd(b), _mm_load_pd(a)));
+        }
+
+        static HPX_FORCEINLINE void
+        max(double* r, double const* a, double const* b)
+        {
+            _mm_store_pd(r, _mm_max_pd(_mm_load_pd(b), _mm_load_pd(a)));
+        }
+    };
+#endif
+
+#if defined(HPX_DATAPAR_SIMD_AVX)
+    ///////////////////////////////////////////////////////////////////////////
+    template <>
+    struct simd_ops<float, 8>
+    {
+        static HPX_FORCEINLINE void
+        add(float* r, float const* a, float const* b)
+        {
+            _mm256_store_ps(r,
+                _mm256_add_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        sub(float* r, float const* a, float const* b)
+        {
+            _mm256_store_ps(r,
+                _mm256_sub_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        mul(float* r, float const* a, float const* b)
+        {
+            _mm256_store_ps(r,
+                _mm256_mul_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        div(float* r, float const* a, float const* b)
+        {
+            _mm256_store_ps(r,
+                _mm256_div_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        min(float* r, float const* a, float const* b)
+        {
+            _mm256_store_ps(r,
+                _mm256_min_ps(_mm256_load_ps(b), _mm256_load_ps(a)));
+        }
+
+        static HPX_FORCEINLINE void
+        max(float* r, float const* a, float const* b)
+        {
+            _mm256_store_ps(r,
+                _mm256_max_ps(_mm256_load_ps(b), _mm256_load_ps(a)));
+        }
+    };
+
+    template <>
+    struct simd_ops<double, 4>
+    {
+        static HPX_FORCEINLINE void
+        add(double* r, double const* a, double const* b)
+        {
+            _mm256_store_pd(r,
+                _mm256_add_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        sub(double* r, double const* a, double const* b)
+        {
+            _mm256_store_pd(r,
+                _mm256_sub_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        mul(double* r, double const* a, double const* b)
+        {
+            _mm256_store_pd(r,
+                _mm256_mul_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        div(double* r, double const* a, double const* b)
+        {
+            _mm256_store_pd(r,
+                _mm256_div_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        min(double* r, double const* a, double const* b)
+        {
+            _mm256_store_pd(r,
+                _mm256_min_pd(_mm256_load_pd(b), _mm256_load_pd(a)));
+        }
+
+        static HPX_FORCEINLINE void
+        max(double* r, double const* a, double const* b)
+        {
+            _mm256_store_pd(r,
+                _mm256_max_pd(_mm256_load_pd(b), _mm256_load_pd(a)));
+        }
+    };
+#endif
+
+#if defined(HPX_DATAPAR_SIMD_AVX512)
+    ///////////////////////////////////////////////////////////////////////////
+    template <>
+    struct simd_ops<float, 16>
+    {
+        static HPX_FORCEINLINE void
+        add(float* r, float const* a, float const* b)
+        {
+            _mm512_store_ps(r,
+                _mm512_add_ps(_mm512_load_ps(a), _mm512_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        sub(float* r, float const* a, float const* b)
+        {
+            _mm512_store_ps(r,
+                _mm512_sub_ps(_mm512_load_ps(a), _mm512_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        mul(float* r, float const* a, float const* b)
+        {
+            _mm512_store_ps(r,
+                _mm512_mul_ps(_mm512_load_ps(a), _mm512_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        div(float* r, float const* a, float const* b)
+        {
+            _mm512_store_ps(r,
+                _mm512_div_ps(_mm512_load_ps(a), _mm512_load_ps(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        min(float* r, float const* a, float const* b)
+        {
+            _mm512_store_ps(r,
+                _mm512_min_ps(_mm512_load_ps(b), _mm512_load_ps(a)));
+        }
+
+        static HPX_FORCEINLINE void
+        max(float* r, float const* a, float const* b)
+        {
+            _mm512_store_ps(r,
+                _mm512_max_ps(_mm512_load_ps(b), _mm512_load_ps(a)));
+        }
+    };
+
+    template <>
+    struct simd_ops<double, 8>
+    {
+        static HPX_FORCEINLINE void
+        add(double* r, double const* a, double const* b)
+        {
+            _mm512_store_pd(r,
+                _mm512_add_pd(_mm512_load_pd(a), _mm512_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        sub(double* r, double const* a, double const* b)
+        {
+            _mm512_store_pd(r,
+                _mm512_sub_pd(_mm512_load_pd(a), _mm512_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        mul(double* r, double const* a, double const* b)
+        {
+            _mm512_store_pd(r,
+                _mm512_mul_pd(_mm512_load_pd(a), _mm512_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        div(double* r, double const* a, double const* b)
+        {
+            _mm512_store_pd(r,
+                _mm512_div_pd(_mm512_load_pd(a), _mm512_load_pd(b)));
+        }
+
+        static HPX_FORCEINLINE void
+        min(double* r, double const* a, double const* b)
+        {
+            _mm512_store_pd(r,
+                _mm512_min_pd(_mm512_load_pd(b), _mm512_load_pd(a)));
+        }
+
+        static HPX_FORCEINLINE void
+        max(double* r, double const* a, double const* b)
+        {
+            _mm512_store_pd(r,
+                _mm512_max_pd(_mm512_load_pd(b), _mm512_load_pd(a)));
+        }
+    };
+#endif
+}}}}
+
+#endif
+#endif
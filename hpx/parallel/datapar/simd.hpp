@@ -0,0 +1,517 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/datapar/simd.hpp
+
+#if !defined(HPX_PARALLEL_DATAPAR_SIMD_OCT_19_2017_0208PM)
+#define HPX_PARALLEL_DATAPAR_SIMD_OCT_19_2017_0208PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <hpx/parallel/datapar/detail/simd_ops.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+// A self-contained vector pack abstraction modelled after the data-parallel
+// types of the Parallelism TS 2 (std::experimental::simd). It is used as the
+// vectorization backend of the datapar execution policies if neither Vc nor
+// Boost.SIMD are available.
+namespace hpx { namespace parallel { namespace simd
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace simd_abi
+    {
+        // a pack of N elements
+        template <std::size_t N>
+        struct fixed_size {};
+
+        // a pack holding exactly one element
+        typedef fixed_size<1> scalar;
+
+        // the widest pack supported by the target architecture
+        template <typename T>
+        struct native_abi
+        {
+            static std::size_t const size =
+                (detail::native_register_size > sizeof(T)) ?
+                    detail::native_register_size / sizeof(T) : 1;
+
+            typedef fixed_size<size> type;
+        };
+
+        template <typename T>
+        using native = typename native_abi<T>::type;
+    }
+
+    // flags for loading and storing vector packs
+    struct element_aligned_tag {};
+    struct vector_aligned_tag {};
+
+    HPX_STATIC_CONSTEXPR element_aligned_tag element_aligned = {};
+    HPX_STATIC_CONSTEXPR vector_aligned_tag vector_aligned = {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Packs whose size is a power of two are aligned to their size which
+        // allows to use the aligned load and store instructions.
+        template <typename T, std::size_t N>
+        struct simd_alignment
+          : std::integral_constant<std::size_t,
+                ((N * sizeof(T)) & (N * sizeof(T) - 1)) == 0 &&
+                    N * sizeof(T) <= 64 ?
+                        N * sizeof(T) : std::alignment_of<T>::value>
+        {};
+
+        template <typename Abi>
+        struct simd_abi_size;
+
+        template <std::size_t N>
+        struct simd_abi_size<simd_abi::fixed_size<N> >
+          : std::integral_constant<std::size_t, N>
+        {};
+    }
+
+    template <typename T, typename Abi = simd_abi::native<T> >
+    class mask;
+
+    template <typename T, typename Abi = simd_abi::native<T> >
+    class pack;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The result of comparing two vector packs element-wise.
+    template <typename T, typename Abi>
+    class mask
+    {
+    public:
+        typedef bool value_type;
+        typedef pack<T, Abi> pack_type;
+        typedef Abi abi_type;
+
+        static HPX_CONSTEXPR std::size_t size()
+        {
+            return detail::simd_abi_size<Abi>::value;
+        }
+
+        mask() = default;
+
+        mask(bool value)
+        {
+            for (std::size_t i = 0; i != size(); ++i)
+                data_[i] = value;
+        }
+
+        bool operator[](std::size_t i) const
+        {
+            return data_[i];
+        }
+
+        bool& operator[](std::size_t i)
+        {
+            return data_[i];
+        }
+
+        friend mask operator!(mask const& m)
+        {
+            mask r;
+            for (std::size_t i = 0; i != size(); ++i)
+                r.data_[i] = !m.data_[i];
+            return r;
+        }
+
+        friend mask operator&&(mask const& lhs, mask const& rhs)
+        {
+            mask r;
+            for (std::size_t i = 0; i != size(); ++i)
+                r.data_[i] = lhs.data_[i] && rhs.data_[i];
+            return r;
+        }
+
+        friend mask operator||(mask const& lhs, mask const& rhs)
+        {
+            mask r;
+            for (std::size_t i = 0; i != size(); ++i)
+                r.data_[i] = lhs.data_[i] || rhs.data_[i];
+            return r;
+        }
+
+        friend mask operator==(mask const& lhs, mask const& rhs)
+        {
+            mask r;
+            for (std::size_t i = 0; i != size(); ++i)
+                r.data_[i] = lhs.data_[i] == rhs.data_[i];
+            return r;
+        }
+
+        friend mask operator!=(mask const& lhs, mask const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        bool data_[detail::simd_abi_size<Abi>::value];
+    };
+
+    /// Returns the number of elements of the mask which are set.
+    template <typename T, typename Abi>
+    std::size_t popcount(mask<T, Abi> const& m)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i != m.size(); ++i)
+            count += m[i] ? 1 : 0;
+        return count;
+    }
+
+    template <typename T, typename Abi>
+    bool all_of(mask<T, Abi> const& m)
+    {
+        return popcount(m) == m.size();
+    }
+
+    template <typename T, typename Abi>
+    bool any_of(mask<T, Abi> const& m)
+    {
+        return popcount(m) != 0;
+    }
+
+    template <typename T, typename Abi>
+    bool none_of(mask<T, Abi> const& m)
+    {
+        return popcount(m) == 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A vector pack of elements of type \a T. The number of elements is
+    /// determined by \a Abi and defaults to the widest vector register of the
+    /// target architecture.
+    template <typename T, typename Abi>
+    class pack
+    {
+        static_assert(std::is_arithmetic<T>::value,
+            "vector packs support arithmetic types only");
+
+        typedef detail::simd_ops<T, detail::simd_abi_size<Abi>::value> ops;
+
+    public:
+        typedef T value_type;
+        typedef mask<T, Abi> mask_type;
+        typedef Abi abi_type;
+
+        static HPX_CONSTEXPR std::size_t size()
+        {
+            return detail::simd_abi_size<Abi>::value;
+        }
+
+        static std::size_t const alignment =
+            detail::simd_alignment<T, detail::simd_abi_size<Abi>::value>::value;
+
+        pack() = default;
+
+        // broadcast the given value to all elements
+        template <typename U, typename Enable = typename std::enable_if<
+            std::is_convertible<U, T>::value>::type>
+        pack(U && value)
+        {
+            T v(std::forward<U>(value));
+            for (std::size_t i = 0; i != size(); ++i)
+                data_[i] = v;
+        }
+
+        template <typename U>
+        pack(U const* mem, element_aligned_tag)
+        {
+            copy_from(mem, element_aligned);
+        }
+
+        template <typename U>
+        pack(U const* mem, vector_aligned_tag)
+        {
+            copy_from(mem, vector_aligned);
+        }
+
+        // convert from a pack with the same number of elements
+        template <typename U>
+        explicit pack(pack<U, Abi> const& other)
+        {
+            for (std::size_t i = 0; i != size(); ++i)
+                data_[i] = static_cast<T>(other[i]);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename U>
+        void copy_from(U const* mem, element_aligned_tag)
+        {
+            for (std::size_t i = 0; i != size(); ++i)
+                data_[i] = static_cast<T>(mem[i]);
+        }
+
+        template <typename U>
+        void copy_from(U const* mem, vector_aligned_tag)
+        {
+            copy_from(mem, element_aligned);
+        }
+
+        template <typename U>
+        void copy_to(U* mem, element_aligned_tag) const
+        {
+            for (std::size_t i = 0; i != size(); ++i)
+                mem[i] = static_cast<U>(data_[i]);
+        }
+
+        template <typename U>
+        void copy_to(U* mem, vector_aligned_tag) const
+        {
+            copy_to(mem, element_aligned);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        T const& operator[](std::size_t i) const
+        {
+            return data_[i];
+        }
+
+        T& operator[](std::size_t i)
+        {
+            return data_[i];
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        pack& operator++()
+        {
+            return *this += pack(T(1));
+        }
+
+        pack operator++(int)
+        {
+            pack tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        pack& operator--()
+        {
+            return *this -= pack(T(1));
+        }
+
+        pack operator--(int)
+        {
+            pack tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        friend pack operator+(pack const& v)
+        {
+            return v;
+        }
+
+        friend pack operator-(pack const& v)
+        {
+            return pack(T(0)) - v;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        friend pack operator+(pack const& lhs, pack const& rhs)
+        {
+            pack r;
+            ops::add(r.data_, lhs.data_, rhs.data_);
+            return r;
+        }
+
+        friend pack operator-(pack const& lhs, pack const& rhs)
+        {
+            pack r;
+            ops::sub(r.data_, lhs.data_, rhs.data_);
+            return r;
+        }
+
+        friend pack operator*(pack const& lhs, pack const& rhs)
+        {
+            pack r;
+            ops::mul(r.data_, lhs.data_, rhs.data_);
+            return r;
+        }
+
+        friend pack operator/(pack const& lhs, pack const& rhs)
+        {
+            pack r;
+            ops::div(r.data_, lhs.data_, rhs.data_);
+            return r;
+        }
+
+        friend pack min(pack const& lhs, pack const& rhs)
+        {
+            pack r;
+            ops::min(r.data_, lhs.data_, rhs.data_);
+            return r;
+        }
+
+        friend pack max(pack const& lhs, pack const& rhs)
+        {
+            pack r;
+            ops::max(r.data_, lhs.data_, rhs.data_);
+            return r;
+        }
+
+        // operations which are available for integral types only
+        template <typename U = T, typename Enable = typename std::enable_if<
+            std::is_integral<U>::value>::type>
+        friend pack operator%(pack const& lhs, pack const& rhs)
+        {
+            return lhs.apply(rhs, [](T l, T r) -> T { return l % r; });
+        }
+
+        template <typename U = T, typename Enable = typename std::enable_if<
+            std::is_integral<U>::value>::type>
+        friend pack operator&(pack const& lhs, pack const& rhs)
+        {
+            return lhs.apply(rhs, [](T l, T r) -> T { return l & r; });
+        }
+
+        template <typename U = T, typename Enable = typename std::enable_if<
+            std::is_integral<U>::value>::type>
+        friend pack operator|(pack const& lhs, pack const& rhs)
+        {
+            return lhs.apply(rhs, [](T l, T r) -> T { return l | r; });
+        }
+
+        template <typename U = T, typename Enable = typename std::enable_if<
+            std::is_integral<U>::value>::type>
+        friend pack operator^(pack const& lhs, pack const& rhs)
+        {
+            return lhs.apply(rhs, [](T l, T r) -> T { return l ^ r; });
+        }
+
+        template <typename U = T, typename Enable = typename std::enable_if<
+            std::is_integral<U>::value>::type>
+        friend pack operator<<(pack const& lhs, pack const& rhs)
+        {
+            return lhs.apply(rhs, [](T l, T r) -> T { return l << r; });
+        }
+
+        template <typename U = T, typename Enable = typename std::enable_if<
+            std::is_integral<U>::value>::type>
+        friend pack operator>>(pack const& lhs, pack const& rhs)
+        {
+            return lhs.apply(rhs, [](T l, T r) -> T { return l >> r; });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        pack& operator+=(pack const& rhs)
+        {
+            ops::add(data_, data_, rhs.data_);
+            return *this;
+        }
+
+        pack& operator-=(pack const& rhs)
+        {
+            ops::sub(data_, data_, rhs.data_);
+            return *this;
+        }
+
+        pack& operator*=(pack const& rhs)
+        {
+            ops::mul(data_, data_, rhs.data_);
+            return *this;
+        }
+
+        pack& operator/=(pack const& rhs)
+        {
+            ops::div(data_, data_, rhs.data_);
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        friend mask_type operator==(pack const& lhs, pack const& rhs)
+        {
+            return lhs.compare(rhs, [](T l, T r) { return l == r; });
+        }
+
+        friend mask_type operator!=(pack const& lhs, pack const& rhs)
+        {
+            return lhs.compare(rhs, [](T l, T r) { return l != r; });
+        }
+
+        friend mask_type operator<(pack const& lhs, pack const& rhs)
+        {
+            return lhs.compare(rhs, [](T l, T r) { return l < r; });
+        }
+
+        friend mask_type operator<=(pack const& lhs, pack const& rhs)
+        {
+            return lhs.compare(rhs, [](T l, T r) { return l <= r; });
+        }
+
+        friend mask_type operator>(pack const& lhs, pack const& rhs)
+        {
+            return lhs.compare(rhs, [](T l, T r) { return l > r; });
+        }
+
+        friend mask_type operator>=(pack const& lhs, pack const& rhs)
+        {
+            return lhs.compare(rhs, [](T l, T r) { return l >= r; });
+        }
+
+    private:
+        template <typename F>
+        pack apply(pack const& rhs, F && f) const
+        {
+            pack r;
+            for (std::size_t i = 0; i != size(); ++i)
+                r.data_[i] = f(data_[i], rhs.data_[i]);
+            return r;
+        }
+
+        template <typename F>
+        mask_type compare(pack const& rhs, F && f) const
+        {
+            mask_type r;
+            for (std::size_t i = 0; i != size(); ++i)
+                r[i] = f(data_[i], rhs.data_[i]);
+            return r;
+        }
+
+        alignas(alignment) T data_[detail::simd_abi_size<Abi>::value];
+    };
+
+    template <typename T, typename Abi>
+    std::size_t const pack<T, Abi>::alignment;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Combines all elements of the given vector pack using \a op.
+    template <typename T, typename Abi, typename BinaryOp>
+    T reduce(pack<T, Abi> const& v, BinaryOp && op)
+    {
+        T result = v[0];
+        for (std::size_t i = 1; i != v.size(); ++i)
+            result = op(result, v[i]);
+        return result;
+    }
+
+    template <typename T, typename Abi>
+    T reduce(pack<T, Abi> const& v)
+    {
+        return reduce(v, [](T lhs, T rhs) { return lhs + rhs; });
+    }
+
+    /// Returns the elements of \a v where the corresponding element of \a m
+    /// is set, and the elements of \a otherwise everywhere else.
+    template <typename T, typename Abi>
+    pack<T, Abi> choose(mask<T, Abi> const& m, pack<T, Abi> const& v,
+        pack<T, Abi> const& otherwise)
+    {
+        pack<T, Abi> r;
+        for (std::size_t i = 0; i != v.size(); ++i)
+            r[i] = m[i] ? v[i] : otherwise[i];
+        return r;
+    }
+}}}
+
+#endif
+#endif
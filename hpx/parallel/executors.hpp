@@ -19,6 +19,7 @@
 #include <hpx/parallel/executors/v1/thread_timed_executor_traits.hpp>
 #endif
 
+#include <hpx/parallel/executors/adaptive_continuation_executor.hpp>
 #include <hpx/parallel/executors/default_executor.hpp>
 #include <hpx/parallel/executors/distribution_policy_executor.hpp>
 #include <hpx/parallel/executors/parallel_executor.hpp>
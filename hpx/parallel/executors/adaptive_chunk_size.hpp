@@ -0,0 +1,382 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/adaptive_chunk_size.hpp
+
+#if !defined(HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_OCT_19_2017_0412PM)
+#define HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_OCT_19_2017_0412PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+#include <hpx/util/adaptive_chunk_size_statistics.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <hpx/parallel/executors/execution_parameters.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The measurement history of one call site. The candidate chunk sizes
+        // are powers of two, for each of them we keep a moving average of the
+        // measured execution time per element.
+        class adaptive_chunk_size_site
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            static int const num_candidates = 8 * sizeof(std::size_t);
+
+            // integral log2, rounded down
+            static int log2(std::size_t value)
+            {
+                int result = 0;
+                while (value > 1)
+                {
+                    value >>= 1;
+                    ++result;
+                }
+                return result;
+            }
+
+            bool is_measured(int candidate) const
+            {
+                return candidate >= 0 && candidate < num_candidates &&
+                    time_per_element_[candidate] != 0;
+            }
+
+        public:
+            // Call sites with a name publish their statistics through the
+            // performance counters
+            explicit adaptive_chunk_size_site(std::string const& name)
+              : best_(-1), invocations_(0)
+            {
+                std::fill(time_per_element_,
+                    time_per_element_ + num_candidates, std::uint64_t(0));
+
+                if (!name.empty())
+                {
+                    stats_ =
+                        hpx::util::get_adaptive_chunk_size_statistics(name);
+                }
+            }
+
+            // Select the candidate to use for the next invocation. Mostly
+            // this is the best candidate found so far, but neighbours which
+            // have not been measured yet are tried right away and every
+            // explore_interval invocations one of the neighbours is measured
+            // again to follow changes in the behavior of the call site.
+            int select(std::size_t cores, std::size_t count,
+                std::size_t explore_interval)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                int const largest = log2((count + cores - 1) / cores);
+                if (best_ < 0)
+                {
+                    // start out with the default number of chunks, four
+                    // chunks per core
+                    best_ = log2((count + 4 * cores - 1) / (4 * cores));
+                }
+
+                int const best = (std::min)(best_, largest);
+                int candidate = best;
+                bool explore = false;
+
+                if (best > 0 && !is_measured(best - 1))
+                {
+                    candidate = best - 1;
+                    explore = true;
+                }
+                else if (best < largest && !is_measured(best + 1))
+                {
+                    candidate = best + 1;
+                    explore = true;
+                }
+                else if (++invocations_ % explore_interval == 0)
+                {
+                    // alternate between the smaller and the larger neighbour
+                    bool smaller =
+                        (invocations_ / explore_interval) % 2 == 0;
+                    if (smaller && best > 0)
+                        candidate = best - 1;
+                    else if (best < largest)
+                        candidate = best + 1;
+                    else if (best > 0)
+                        candidate = best - 1;
+                    explore = candidate != best;
+                }
+
+                if (stats_)
+                {
+                    ++stats_->invocations_;
+                    if (explore)
+                        ++stats_->explorations_;
+                }
+                return candidate;
+            }
+
+            // Record the execution time of an invocation which has used the
+            // given candidate and move towards the better neighbour.
+            void record(int candidate, std::size_t count,
+                std::uint64_t elapsed)
+            {
+                if (count == 0 || candidate < 0 || candidate >= num_candidates)
+                    return;
+
+                // use a fixed point representation to keep the resolution
+                // for very short per element times
+                std::uint64_t t = (elapsed << 10) / count + 1;
+
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::uint64_t& avg = time_per_element_[candidate];
+                avg = (avg == 0) ? t : (3 * avg + t) / 4;
+
+                if (best_ < 0)
+                    best_ = candidate;
+
+                int best = best_;
+                if (is_measured(best_ - 1) &&
+                    time_per_element_[best_ - 1] < time_per_element_[best])
+                {
+                    best = best_ - 1;
+                }
+                if (is_measured(best_ + 1) &&
+                    time_per_element_[best_ + 1] < time_per_element_[best])
+                {
+                    best = best_ + 1;
+                }
+                if (!is_measured(best))
+                    best = candidate;
+                best_ = best;
+
+                if (stats_)
+                    stats_->chunk_size_ = std::int64_t(1) << best_;
+            }
+
+        private:
+            mutex_type mtx_;
+            int best_;
+            std::uint64_t invocations_;
+            std::uint64_t time_per_element_[num_candidates];
+            std::shared_ptr<hpx::util::adaptive_chunk_size_statistics> stats_;
+        };
+
+        // There is one history for each call site. The function passed to
+        // get_chunk_size is a lambda defined inside of the partitioners
+        // which depends on the type of the user supplied function and on the
+        // execution policy, which makes it a good key for the call site.
+        // Different names given to the executor parameters object keep
+        // separate histories for the same function type, as the same
+        // algorithm may be invoked on differently shaped work. The sites are
+        // never destroyed, invocations refer to them until they have ended.
+        template <typename F, typename Executor>
+        adaptive_chunk_size_site& get_adaptive_chunk_size_site(
+            std::string const& name)
+        {
+            typedef std::map<
+                    std::string, std::unique_ptr<adaptive_chunk_size_site>
+                > sites_type;
+
+            static lcos::local::spinlock mtx;
+            static sites_type sites;
+
+            std::lock_guard<lcos::local::spinlock> l(mtx);
+
+            std::unique_ptr<adaptive_chunk_size_site>& site = sites[name];
+            if (!site)
+                site.reset(new adaptive_chunk_size_site(name));
+            return *site;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The data shared between all copies of an adaptive_chunk_size object
+        // which is needed to associate the time measured between
+        // mark_begin_execution and mark_end_execution with the call site.
+        struct adaptive_chunk_size_invocation
+        {
+            adaptive_chunk_size_invocation()
+              : site_(nullptr), candidate_(-1), count_(0), start_(0)
+            {}
+
+            lcos::local::spinlock mtx_;
+            adaptive_chunk_size_site* site_;
+            int candidate_;
+            std::size_t count_;
+            std::uint64_t start_;
+        };
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are divided into pieces and then assigned to threads.
+    /// The number of loop iterations combined is learned across invocations
+    /// of the same call site (the same algorithm invoked with the same
+    /// function type, execution policy, and name of the executor parameters
+    /// object). The execution time of each
+    /// invocation is measured and the chunk size is moved towards the one
+    /// with the shortest execution time per element. Neighbouring chunk
+    /// sizes are explored periodically to follow changes in the behavior of
+    /// the call site.
+    ///
+    /// \note The measurement of an invocation is attributed to the call site
+    ///       which most recently requested a chunk size from this object.
+    ///       An \a adaptive_chunk_size object should therefore not be used
+    ///       by concurrently running algorithms.
+    ///
+    struct adaptive_chunk_size
+    {
+    public:
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \note Default constructed \a adaptive_chunk_size executor
+        ///       parameter types will explore neighbouring chunk sizes every
+        ///       16 invocations of a call site and do not expose their
+        ///       choice as performance counters.
+        ///
+        adaptive_chunk_size()
+          : explore_interval_(16)
+          , data_(std::make_shared<detail::adaptive_chunk_size_invocation>())
+        {}
+
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \param name         [in] The name of the call site used as the
+        ///                     parameter of the performance counters
+        ///                     /parallel/adaptive-chunk-size/chunk-size,
+        ///                     /parallel/adaptive-chunk-size/invocations, and
+        ///                     /parallel/adaptive-chunk-size/explorations.
+        ///                     Each name keeps its own history.
+        /// \param explore_interval [in] The number of invocations of a call
+        ///                     site after which a neighbouring chunk size is
+        ///                     measured again.
+        ///
+        explicit adaptive_chunk_size(std::string name,
+                std::size_t explore_interval = 16)
+          : name_(std::move(name))
+          , explore_interval_((std::max)(explore_interval, std::size_t(1)))
+          , data_(std::make_shared<detail::adaptive_chunk_size_invocation>())
+        {}
+
+        /// \cond NOINTERNAL
+        template <typename Executor>
+        void mark_begin_execution(Executor && exec)
+        {
+            std::lock_guard<lcos::local::spinlock> l(data_->mtx_);
+            data_->site_ = nullptr;
+            data_->start_ = hpx::util::high_resolution_clock::now();
+        }
+
+        template <typename Executor>
+        void mark_end_execution(Executor && exec)
+        {
+            std::uint64_t const now = hpx::util::high_resolution_clock::now();
+
+            detail::adaptive_chunk_size_site* site = nullptr;
+            int candidate = -1;
+            std::size_t count = 0;
+            std::uint64_t start = 0;
+
+            {
+                std::lock_guard<lcos::local::spinlock> l(data_->mtx_);
+                std::swap(site, data_->site_);
+                candidate = data_->candidate_;
+                count = data_->count_;
+                start = data_->start_;
+            }
+
+            if (site != nullptr && now > start)
+                site->record(candidate, count, now - start);
+        }
+
+        // Use the chunk size which is currently considered best for the
+        // calling site. The given test function is never invoked.
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(Executor && exec, F && f,
+            std::size_t cores, std::size_t count)
+        {
+            if (cores == 0)
+                cores = 1;
+
+            if (count < 4 * cores)
+                return (count + cores - 1) / cores;
+
+            detail::adaptive_chunk_size_site& site =
+                detail::get_adaptive_chunk_size_site<
+                    typename std::decay<F>::type,
+                    typename std::decay<Executor>::type
+                >(name_);
+
+            int candidate = site.select(cores, count, explore_interval_);
+
+            {
+                std::lock_guard<lcos::local::spinlock> l(data_->mtx_);
+                data_->site_ = &site;
+                data_->candidate_ = candidate;
+                data_->count_ = count;
+            }
+
+            return (std::min)(count, std::size_t(1) << candidate);
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & name_ & explore_interval_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::string name_;
+        std::size_t explore_interval_;
+        std::shared_ptr<detail::adaptive_chunk_size_invocation> data_;
+        /// \endcond
+    };
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    template <>
+    struct is_executor_parameters<parallel::execution::adaptive_chunk_size>
+      : std::true_type
+    {};
+    /// \endcond
+}}}
+
+#if defined(HPX_HAVE_EXECUTOR_COMPATIBILITY)
+
+#include <hpx/parallel/executors/v1/executor_parameter_traits.hpp>
+#include <hpx/traits/v1/is_executor_parameters.hpp>
+
+namespace hpx { namespace parallel { inline namespace v3
+{
+    using adaptive_chunk_size = execution::adaptive_chunk_size;
+}}}
+
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/adaptive_continuation_executor.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_ADAPTIVE_CONTINUATION_EXECUTOR_HPP)
+#define HPX_PARALLEL_EXECUTORS_ADAPTIVE_CONTINUATION_EXECUTOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async_launch_policy_dispatch.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/parallel/executors/post_policy_dispatch.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/traits/is_executor.hpp>
+#include <hpx/util/continuation_statistics.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { namespace execution
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// An \a adaptive_continuation_executor runs the functions it is given
+    /// directly on the calling HPX thread as long as the continuation
+    /// recursion depth of that thread stays below the given budget. Past the
+    /// budget (or if called from a non-HPX thread) a new HPX thread is
+    /// created instead. This avoids the cost of creating a thread for every
+    /// small continuation attached to an already ready future while still
+    /// bounding the stack depth of long chains of continuations:
+    ///
+    /// \code
+    ///     adaptive_continuation_executor exec;
+    ///     hpx::future<int> f = hpx::make_ready_future(41);
+    ///     hpx::future<int> g = f.then(exec,
+    ///         [](hpx::future<int> f) { return f.get() + 1; });
+    /// \endcode
+    ///
+    /// The number of inlined and spawned continuations is exposed through
+    /// the performance counters /runtime/count/continuations-inlined and
+    /// /runtime/count/continuations-spawned.
+    ///
+    /// This executor conforms to the concepts of a TwoWayExecutor and a
+    /// NonBlockingOneWayExecutor.
+    struct adaptive_continuation_executor
+    {
+        /// Associate the parallel_execution_tag executor tag type as a default
+        /// with this executor.
+        typedef parallel_execution_tag execution_category;
+
+        /// Create a new adaptive continuation executor
+        ///
+        /// \param max_depth [in] The maximal continuation recursion depth of
+        ///                  the calling thread up to which functions are run
+        ///                  inline.
+        /// \param priority  [in] The priority of the threads created once
+        ///                  the budget is exhausted.
+        HPX_CONSTEXPR explicit adaptive_continuation_executor(
+                std::size_t max_depth = HPX_CONTINUATION_MAX_RECURSION_DEPTH,
+                threads::thread_priority priority =
+                    threads::thread_priority_default)
+          : max_depth_(max_depth), policy_(priority)
+        {}
+
+        /// \cond NOINTERNAL
+        bool operator==(adaptive_continuation_executor const& rhs) const
+            noexcept
+        {
+            return max_depth_ == rhs.max_depth_ && policy_ == rhs.policy_;
+        }
+
+        bool operator!=(adaptive_continuation_executor const& rhs) const
+            noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        adaptive_continuation_executor const& context() const noexcept
+        {
+            return *this;
+        }
+
+        std::size_t max_depth() const noexcept
+        {
+            return max_depth_;
+        }
+
+        // TwoWayExecutor interface
+        template <typename F, typename ... Ts>
+        hpx::future<
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type
+        >
+        async_execute(F && f, Ts &&... ts) const
+        {
+            if (run_inline())
+            {
+                hpx::util::detail::count_inlined_continuation();
+
+                lcos::detail::handle_continuation_recursion_count cnt;
+                return hpx::detail::async_launch_policy_dispatch<
+                        launch::sync_policy
+                    >::call(launch::sync, std::forward<F>(f),
+                        std::forward<Ts>(ts)...);
+            }
+
+            hpx::util::detail::count_spawned_continuation();
+            return hpx::detail::async_launch_policy_dispatch<
+                    launch::async_policy
+                >::call(policy_, std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        // NonBlockingOneWayExecutor (adapted) interface
+        template <typename F, typename ... Ts>
+        void post(F && f, Ts &&... ts) const
+        {
+            if (run_inline())
+            {
+                hpx::util::detail::count_inlined_continuation();
+
+                lcos::detail::handle_continuation_recursion_count cnt;
+                hpx::util::invoke(std::forward<F>(f), std::forward<Ts>(ts)...);
+                return;
+            }
+
+            hpx::util::detail::count_spawned_continuation();
+
+            hpx::util::thread_description desc(f,
+                "hpx::parallel::execution::"
+                    "adaptive_continuation_executor::post");
+
+            detail::post_policy_dispatch<launch::async_policy>::call(
+                desc, policy_, std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        // Functions are run inline only on HPX threads (which have a bounded
+        // stack) and only while the recursion depth budget is not exhausted.
+        bool run_inline() const
+        {
+            if (threads::get_self_ptr() == nullptr)
+                return false;
+
+#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+            if (!this_thread::has_sufficient_stack_space())
+                return false;
+#endif
+            return threads::get_continuation_recursion_count() < max_depth_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t max_depth_;
+        launch::async_policy policy_;
+        /// \endcond
+    };
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    template <>
+    struct is_one_way_executor<
+            parallel::execution::adaptive_continuation_executor>
+      : std::true_type
+    {};
+
+    template <>
+    struct is_two_way_executor<
+            parallel::execution::adaptive_continuation_executor>
+      : std::true_type
+    {};
+    /// \endcond
+}}}
+
+#endif
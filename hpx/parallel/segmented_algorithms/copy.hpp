@@ -0,0 +1,104 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_COPY_IF_OCT_19_2017)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_COPY_IF_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/redistribute.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_copy_if
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // Filter applied to each segment: copies the elements satisfying the
+        // predicate.
+        template <typename F, typename Proj>
+        struct copy_if_filter
+        {
+            template <typename ExPolicy, typename InIter, typename OutIter>
+            OutIter operator()(ExPolicy && policy, InIter first, InIter last,
+                OutIter dest)
+            {
+                return parallel::copy_if(std::forward<ExPolicy>(policy),
+                    first, last, dest, f_, proj_).out();
+            }
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & f_ & proj_;
+            }
+
+            F f_;
+            Proj proj_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::true_type)
+        {
+            typedef std::pair<FwdIter1, FwdIter2> result_type;
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef copy_if_filter<
+                    typename hpx::util::decay<F>::type,
+                    typename hpx::util::decay<Proj>::type
+                > filter_type;
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, result_type
+                    >::get(std::make_pair(last, dest));
+            }
+
+            policy_type p(std::forward<ExPolicy>(policy));
+            filter_type filter = {
+                std::forward<F>(f), std::forward<Proj>(proj)
+            };
+
+            return run_segmented_phases<policy_type, result_type>(
+                [p, first, last, dest, filter]() -> result_type
+                {
+                    return segmented_compact(p, is_seq(), first, last, dest,
+                        [&filter](std::size_t) { return filter; });
+                });
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,663 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHMS_REDISTRIBUTE_OCT_19_2017)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHMS_REDISTRIBUTE_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/map.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/exception_list.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+
+    // The algorithms which move elements between the segments of a sequence
+    // (sort, merge, unique, copy_if, remove_if) operate in phases. Every
+    // phase invokes one operation for each of the segments involved, the
+    // data moves directly between the localities owning the segments.
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A contiguous range of elements stored in one segment together with the
+    // id used to invoke operations on the locality owning the segment.
+    template <typename LocalIter>
+    struct segment_range
+    {
+        segment_range()
+          : size_(0)
+        {}
+
+        segment_range(id_type const& id, LocalIter first, LocalIter last,
+                std::size_t size)
+          : id_(id), first_(first), last_(last), size_(size)
+        {}
+
+        id_type id_;
+        LocalIter first_;
+        LocalIter last_;
+        std::size_t size_;
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & id_ & first_ & last_ & size_;
+        }
+    };
+
+    // Return the non-empty parts of all segments covered by [first, last).
+    template <typename SegIter>
+    std::vector<segment_range<
+        typename hpx::traits::segmented_iterator_traits<SegIter>::local_iterator
+    > >
+    get_segment_ranges(SegIter first, SegIter last)
+    {
+        typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+        typedef typename traits::segment_iterator segment_iterator;
+        typedef typename traits::local_iterator local_iterator_type;
+        typedef segment_range<local_iterator_type> range_type;
+
+        std::vector<range_type> ranges;
+        if (first == last)
+            return ranges;
+
+        segment_iterator sit = traits::segment(first);
+        segment_iterator send = traits::segment(last);
+
+        auto add_range =
+            [&ranges](segment_iterator const& sit, local_iterator_type beg,
+                local_iterator_type end)
+            {
+                std::size_t size = std::size_t(std::distance(beg, end));
+                if (size != 0)
+                {
+                    ranges.push_back(
+                        range_type(traits::get_id(sit), beg, end, size));
+                }
+            };
+
+        if (sit == send)
+        {
+            // all elements are on the same partition
+            add_range(sit, traits::local(first), traits::local(last));
+        }
+        else {
+            ranges.reserve(std::distance(sit, send) + 1);
+
+            // handle the remaining part of the first partition
+            add_range(sit, traits::local(first), traits::end(sit));
+
+            // handle all of the full partitions
+            for (++sit; sit != send; ++sit)
+                add_range(sit, traits::begin(sit), traits::end(sit));
+
+            // handle the beginning of the last partition
+            add_range(sit, traits::begin(sit), traits::local(last));
+        }
+
+        return ranges;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Elements are staged on the locality which has computed them until all
+    // segments have finished reading their input. This allows to write the
+    // results back into the (overlapping) input sequence.
+    template <typename T>
+    struct staging_buffers
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct data
+        {
+            data()
+              : next_key_(1)
+            {}
+
+            mutex_type mtx_;
+            std::uint64_t next_key_;
+            std::map<std::uint64_t, std::vector<T> > buffers_;
+        };
+
+        static data& get_data()
+        {
+            static data data_;
+            return data_;
+        }
+
+    public:
+        // the key zero stands for an empty buffer which is never stored
+        static std::uint64_t store(std::vector<T> && values)
+        {
+            if (values.empty())
+                return 0;
+
+            data& d = get_data();
+            std::lock_guard<mutex_type> l(d.mtx_);
+
+            std::uint64_t key = d.next_key_++;
+            d.buffers_.insert(std::make_pair(key, std::move(values)));
+            return key;
+        }
+
+        static std::vector<T> retrieve(std::uint64_t key)
+        {
+            std::vector<T> values;
+            if (key == 0)
+                return values;
+
+            data& d = get_data();
+            std::lock_guard<mutex_type> l(d.mtx_);
+
+            auto it = d.buffers_.find(key);
+            if (it == d.buffers_.end())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "staging_buffers::retrieve",
+                    "attempting to retrieve an unknown staging buffer");
+            }
+
+            values = std::move(it->second);
+            d.buffers_.erase(it);
+            return values;
+        }
+
+        // discard a buffer, buffers which have been retrieved already are
+        // ignored
+        static void release(std::uint64_t key)
+        {
+            if (key == 0)
+                return;
+
+            std::vector<T> values;
+
+            data& d = get_data();
+            std::lock_guard<mutex_type> l(d.mtx_);
+
+            auto it = d.buffers_.find(key);
+            if (it != d.buffers_.end())
+            {
+                values = std::move(it->second);
+                d.buffers_.erase(it);
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return a copy of the elements of a segment.
+    template <typename T>
+    struct fetch_segment
+      : public detail::algorithm<fetch_segment<T>, std::vector<T> >
+    {
+        fetch_segment()
+          : fetch_segment::algorithm("fetch_segment")
+        {}
+
+        template <typename ExPolicy, typename InIter>
+        static std::vector<T>
+        sequential(ExPolicy, InIter first, InIter last)
+        {
+            return std::vector<T>(first, last);
+        }
+
+        template <typename ExPolicy, typename InIter>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::vector<T>
+        >::type
+        parallel(ExPolicy &&, InIter first, InIter last)
+        {
+            return util::detail::algorithm_result<
+                    ExPolicy, std::vector<T>
+                >::get(std::vector<T>(first, last));
+        }
+    };
+
+    // Overwrite the elements of a segment starting at the given position.
+    template <typename T>
+    struct assign_segment
+      : public detail::algorithm<assign_segment<T> >
+    {
+        assign_segment()
+          : assign_segment::algorithm("assign_segment")
+        {}
+
+        template <typename ExPolicy, typename OutIter>
+        static hpx::util::unused_type
+        sequential(ExPolicy, OutIter dest, std::vector<T> values)
+        {
+            std::move(values.begin(), values.end(), dest);
+            return hpx::util::unused;
+        }
+
+        template <typename ExPolicy, typename OutIter>
+        static typename util::detail::algorithm_result<ExPolicy>::type
+        parallel(ExPolicy &&, OutIter dest, std::vector<T> values)
+        {
+            std::move(values.begin(), values.end(), dest);
+            return util::detail::algorithm_result<ExPolicy>::get();
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the given filter to the elements of a segment and stage the
+    // result. The filter is invoked as filter(policy, first, last, dest) and
+    // has to return the end of the elements it has written to dest. Returns
+    // the key of the staged buffer and the number of elements it holds.
+    template <typename T>
+    struct stage_segment
+      : public detail::algorithm<
+            stage_segment<T>, std::pair<std::uint64_t, std::size_t> >
+    {
+        typedef std::pair<std::uint64_t, std::size_t> staged_type;
+
+        stage_segment()
+          : stage_segment::algorithm("stage_segment")
+        {}
+
+        template <typename ExPolicy, typename InIter, typename Filter>
+        static staged_type
+        sequential(ExPolicy, InIter first, InIter last, Filter && filter)
+        {
+            std::vector<T> values(std::distance(first, last));
+            values.erase(
+                filter(execution::seq, first, last, values.begin()),
+                values.end());
+
+            std::size_t size = values.size();
+            return staged_type(
+                staging_buffers<T>::store(std::move(values)), size);
+        }
+
+        template <typename ExPolicy, typename InIter, typename Filter>
+        static typename util::detail::algorithm_result<
+            ExPolicy, staged_type
+        >::type
+        parallel(ExPolicy && policy, InIter first, InIter last,
+            Filter && filter)
+        {
+            std::vector<T> values(std::distance(first, last));
+            values.erase(
+                filter(execution::par.with(policy.parameters()),
+                    first, last, values.begin()),
+                values.end());
+
+            std::size_t size = values.size();
+            return util::detail::algorithm_result<
+                    ExPolicy, staged_type
+                >::get(staged_type(
+                    staging_buffers<T>::store(std::move(values)), size));
+        }
+    };
+
+    // Write a staged buffer to the given ranges, the ranges have to cover
+    // exactly the number of staged elements.
+    template <typename T>
+    struct unstage_segment
+      : public detail::algorithm<unstage_segment<T> >
+    {
+        unstage_segment()
+          : unstage_segment::algorithm("unstage_segment")
+        {}
+
+        template <typename ExPolicy, typename LocalIter>
+        static hpx::util::unused_type
+        sequential(ExPolicy && policy, std::uint64_t key,
+            std::vector<segment_range<LocalIter> > const& ranges)
+        {
+            distribute(policy, key, ranges);
+            return hpx::util::unused;
+        }
+
+        template <typename ExPolicy, typename LocalIter>
+        static typename util::detail::algorithm_result<ExPolicy>::type
+        parallel(ExPolicy && policy, std::uint64_t key,
+            std::vector<segment_range<LocalIter> > const& ranges)
+        {
+            distribute(policy, key, ranges);
+            return util::detail::algorithm_result<ExPolicy>::get();
+        }
+
+    private:
+        template <typename ExPolicy, typename LocalIter>
+        static void distribute(ExPolicy const& policy, std::uint64_t key,
+            std::vector<segment_range<LocalIter> > const& ranges);
+    };
+
+    // Discard a staged buffer, this is used if a later phase will not be
+    // executed or has failed because of an error.
+    template <typename T>
+    struct release_segment
+      : public detail::algorithm<release_segment<T> >
+    {
+        release_segment()
+          : release_segment::algorithm("release_segment")
+        {}
+
+        template <typename ExPolicy>
+        static hpx::util::unused_type
+        sequential(ExPolicy, std::uint64_t key)
+        {
+            staging_buffers<T>::release(key);
+            return hpx::util::unused;
+        }
+
+        template <typename ExPolicy>
+        static typename util::detail::algorithm_result<ExPolicy>::type
+        parallel(ExPolicy &&, std::uint64_t key)
+        {
+            staging_buffers<T>::release(key);
+            return util::detail::algorithm_result<ExPolicy>::get();
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Wait for the operations invoked on all segments, any remote exceptions
+    // are rethrown as an exception_list.
+    template <typename ExPolicy, typename T>
+    std::vector<T> get_segment_results(std::vector<hpx::future<T> > && results)
+    {
+        hpx::wait_all(results);
+
+        std::list<std::exception_ptr> errors;
+        util::detail::handle_remote_exceptions<ExPolicy>::call(
+            results, errors);
+
+        std::vector<T> values;
+        values.reserve(results.size());
+        for (hpx::future<T>& f : results)
+            values.push_back(f.get());
+        return values;
+    }
+
+    template <typename ExPolicy>
+    void wait_segment_results(std::vector<hpx::future<void> > && results)
+    {
+        hpx::wait_all(results);
+
+        std::list<std::exception_ptr> errors;
+        util::detail::handle_remote_exceptions<ExPolicy>::call(
+            results, errors);
+    }
+
+    // Wait for the staging operations invoked on all segments. If any of
+    // them has failed, all successfully staged buffers are released before
+    // the remote exceptions are rethrown.
+    template <typename T, typename ExPolicy>
+    std::vector<std::pair<std::uint64_t, std::size_t> >
+    get_staged_results(ExPolicy const& policy,
+        std::vector<id_type> const& ids,
+        std::vector<hpx::future<std::pair<std::uint64_t, std::size_t> > > &&
+            results)
+    {
+        HPX_ASSERT(ids.size() == results.size());
+
+        hpx::wait_all(results);
+
+        std::list<std::exception_ptr> errors;
+        for (auto const& f : results)
+        {
+            if (f.has_exception())
+            {
+                util::detail::handle_remote_exceptions<ExPolicy>::call(
+                    f.get_exception_ptr(), errors);
+            }
+        }
+
+        if (!errors.empty())
+        {
+            std::vector<hpx::future<void> > released;
+            for (std::size_t i = 0; i != results.size(); ++i)
+            {
+                if (results[i].has_exception())
+                    continue;
+
+                std::uint64_t key = results[i].get().first;
+                if (key != 0)
+                {
+                    released.push_back(dispatch_async(ids[i],
+                        release_segment<T>(), policy, std::true_type(), key));
+                }
+            }
+            hpx::wait_all(released);
+
+            throw exception_list(std::move(errors));
+        }
+
+        std::vector<std::pair<std::uint64_t, std::size_t> > values;
+        values.reserve(results.size());
+        for (auto& f : results)
+            values.push_back(f.get());
+        return values;
+    }
+
+    // Release the staged buffers which have not been handed over to
+    // unstage_segment when leaving the scope. This makes sure that no buffer
+    // is left behind on any of the localities if a later phase fails.
+    template <typename T, typename ExPolicy>
+    class staged_buffers_guard
+    {
+    public:
+        HPX_NON_COPYABLE(staged_buffers_guard);
+
+    public:
+        staged_buffers_guard(ExPolicy const& policy,
+                std::vector<id_type> const& ids,
+                std::vector<std::pair<std::uint64_t, std::size_t> >& staged)
+          : policy_(policy), ids_(ids), staged_(staged)
+        {}
+
+        ~staged_buffers_guard()
+        {
+            try {
+                std::vector<hpx::future<void> > released;
+                for (std::size_t i = 0; i != staged_.size(); ++i)
+                {
+                    if (staged_[i].first == 0)
+                        continue;
+
+                    released.push_back(dispatch_async(ids_[i],
+                        release_segment<T>(), policy_, std::true_type(),
+                        staged_[i].first));
+                }
+                hpx::wait_all(released);
+            }
+            catch (...) {
+                // the original error is reported to the caller
+            }
+        }
+
+        // the buffer of the given segment is gone
+        void dismiss(std::size_t i)
+        {
+            staged_[i].first = 0;
+        }
+
+    private:
+        ExPolicy const& policy_;
+        std::vector<id_type> const& ids_;
+        std::vector<std::pair<std::uint64_t, std::size_t> >& staged_;
+    };
+
+    // Write the staged buffers contiguously to the sequence starting at
+    // dest, returns the end of the written elements.
+    template <typename T, typename ExPolicy, typename IsSeq,
+        typename SegOutIter>
+    SegOutIter unstage_segments(ExPolicy const& policy, IsSeq,
+        std::vector<id_type> const& ids,
+        std::vector<std::pair<std::uint64_t, std::size_t> > staged,
+        SegOutIter dest)
+    {
+        HPX_ASSERT(ids.size() == staged.size());
+
+        staged_buffers_guard<T, ExPolicy> guard(policy, ids, staged);
+
+        std::vector<std::size_t> indices;
+        std::vector<hpx::future<void> > segments;
+        indices.reserve(staged.size());
+        segments.reserve(staged.size());
+
+        SegOutIter out = dest;
+        for (std::size_t i = 0; i != staged.size(); ++i)
+        {
+            if (staged[i].second == 0)
+                continue;
+
+            SegOutIter out_end = std::next(out, staged[i].second);
+            segments.push_back(dispatch_async(ids[i],
+                unstage_segment<T>(), policy, IsSeq(),
+                staged[i].first, get_segment_ranges(out, out_end)));
+            indices.push_back(i);
+            out = out_end;
+        }
+
+        hpx::wait_all(segments);
+
+        // a buffer is retrieved before anything else can fail
+        for (std::size_t k = 0; k != segments.size(); ++k)
+        {
+            if (!segments[k].has_exception())
+                guard.dismiss(indices[k]);
+        }
+
+        wait_segment_results<ExPolicy>(std::move(segments));
+        return out;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    template <typename ExPolicy, typename LocalIter>
+    void unstage_segment<T>::distribute(ExPolicy const& policy,
+        std::uint64_t key, std::vector<segment_range<LocalIter> > const& ranges)
+    {
+        std::vector<T> values = staging_buffers<T>::retrieve(key);
+
+        std::vector<hpx::future<void> > segments;
+        segments.reserve(ranges.size());
+
+        auto it = std::make_move_iterator(values.begin());
+        for (segment_range<LocalIter> const& r : ranges)
+        {
+            HPX_ASSERT(std::size_t(std::distance(it.base(), values.end())) >=
+                r.size_);
+
+            std::vector<T> part(it, it + r.size_);
+            it += r.size_;
+
+            segments.push_back(dispatch_async(r.id_, assign_segment<T>(),
+                policy, std::true_type(), r.first_, std::move(part)));
+        }
+
+        wait_segment_results<ExPolicy>(std::move(segments));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The redistributing algorithms are implemented as a sequence of
+    // synchronous phases. If an asynchronous execution policy was given, the
+    // phases are run on a new thread.
+    template <typename ExPolicy, typename R, typename F>
+    typename util::detail::algorithm_result<ExPolicy, R>::type
+    run_segmented_phases(F && f, std::false_type)
+    {
+        return util::detail::algorithm_result<ExPolicy, R>::get(f());
+    }
+
+    template <typename ExPolicy, typename R, typename F>
+    typename util::detail::algorithm_result<ExPolicy, R>::type
+    run_segmented_phases(F && f, std::true_type)
+    {
+        return util::detail::algorithm_result<ExPolicy, R>::get(
+            hpx::async(std::forward<F>(f)));
+    }
+
+    template <typename ExPolicy, typename R, typename F>
+    typename util::detail::algorithm_result<ExPolicy, R>::type
+    run_segmented_phases(F && f)
+    {
+        typedef execution::is_async_execution_policy<ExPolicy> is_async;
+        return run_segmented_phases<ExPolicy, R>(std::forward<F>(f),
+            is_async());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Distributed stream compaction: every segment of [first, last) applies
+    // the filter created by make_filter(i) (where i is the index of the
+    // segment) and stages its result. Once all segments have been filtered,
+    // the staged elements are written contiguously to the sequence starting
+    // at dest. The output sequence may overlap with the input sequence.
+    template <typename ExPolicy, typename IsSeq, typename SegIter,
+        typename SegOutIter, typename MakeFilter>
+    std::pair<SegIter, SegOutIter>
+    segmented_compact(ExPolicy const& policy, IsSeq, SegIter first,
+        SegIter last, SegOutIter dest, MakeFilter && make_filter)
+    {
+        typedef typename std::iterator_traits<SegIter>::value_type value_type;
+        typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+        typedef typename traits::local_iterator local_iterator_type;
+
+        std::vector<segment_range<local_iterator_type> > ranges =
+            get_segment_ranges(first, last);
+
+        // filter all segments and stage the elements to keep
+        std::vector<id_type> ids;
+        std::vector<
+                hpx::future<std::pair<std::uint64_t, std::size_t> >
+            > stages;
+        ids.reserve(ranges.size());
+        stages.reserve(ranges.size());
+
+        for (std::size_t i = 0; i != ranges.size(); ++i)
+        {
+            ids.push_back(ranges[i].id_);
+            stages.push_back(dispatch_async(ranges[i].id_,
+                stage_segment<value_type>(), policy, IsSeq(),
+                ranges[i].first_, ranges[i].last_, make_filter(i)));
+        }
+
+        std::vector<std::pair<std::uint64_t, std::size_t> > staged =
+            get_staged_results<value_type>(policy, ids, std::move(stages));
+
+        // write the staged elements to their final position
+        SegOutIter out = unstage_segments<value_type>(policy, IsSeq(), ids,
+            std::move(staged), dest);
+
+        return std::make_pair(last, out);
+    }
+
+    /// \endcond
+}}}}
+
+#endif
@@ -0,0 +1,295 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_MERGE_OCT_19_2017)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_MERGE_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/merge.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/redistribute.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_merge
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The segmented merge partitions the output along the merge path:
+        // for every output segment the number of elements contributed by
+        // each of the input sequences is found by a binary search. The
+        // corresponding input runs are then fetched and merged on the
+        // locality of the output segment, independently of all other output
+        // segments.
+
+        // Fetch the elements of the given ranges into a single buffer.
+        template <typename T, typename ExPolicy, typename LocalIter>
+        std::vector<T> fetch_ranges(ExPolicy const& policy,
+            std::vector<segment_range<LocalIter> > const& ranges)
+        {
+            std::vector<hpx::future<std::vector<T> > > fetched;
+            fetched.reserve(ranges.size());
+            for (segment_range<LocalIter> const& r : ranges)
+            {
+                fetched.push_back(dispatch_async(r.id_, fetch_segment<T>(),
+                    policy, std::true_type(), r.first_, r.last_));
+            }
+
+            std::vector<std::vector<T> > parts =
+                get_segment_results<ExPolicy>(std::move(fetched));
+
+            if (parts.size() == 1)
+                return std::move(parts[0]);
+
+            std::vector<T> values;
+            for (std::vector<T>& part : parts)
+            {
+                std::move(part.begin(), part.end(),
+                    std::back_inserter(values));
+            }
+            return values;
+        }
+
+        // Merge the given runs of both input sequences into a segment.
+        template <typename T1, typename T2>
+        struct merge_segment
+          : public detail::algorithm<merge_segment<T1, T2> >
+        {
+            merge_segment()
+              : merge_segment::algorithm("merge_segment")
+            {}
+
+            template <typename ExPolicy, typename OutIter,
+                typename LocalIter1, typename LocalIter2, typename Comp,
+                typename Proj1, typename Proj2>
+            static hpx::util::unused_type
+            sequential(ExPolicy && policy, OutIter dest,
+                std::vector<segment_range<LocalIter1> > const& runs1,
+                std::vector<segment_range<LocalIter2> > const& runs2,
+                Comp && comp, Proj1 && proj1, Proj2 && proj2)
+            {
+                std::vector<T1> values1 = fetch_ranges<T1>(policy, runs1);
+                std::vector<T2> values2 = fetch_ranges<T2>(policy, runs2);
+
+                parallel::merge(execution::seq,
+                    values1.begin(), values1.end(),
+                    values2.begin(), values2.end(), dest,
+                    std::forward<Comp>(comp), std::forward<Proj1>(proj1),
+                    std::forward<Proj2>(proj2));
+
+                return hpx::util::unused;
+            }
+
+            template <typename ExPolicy, typename OutIter,
+                typename LocalIter1, typename LocalIter2, typename Comp,
+                typename Proj1, typename Proj2>
+            static typename util::detail::algorithm_result<ExPolicy>::type
+            parallel(ExPolicy && policy, OutIter dest,
+                std::vector<segment_range<LocalIter1> > const& runs1,
+                std::vector<segment_range<LocalIter2> > const& runs2,
+                Comp && comp, Proj1 && proj1, Proj2 && proj2)
+            {
+                std::vector<T1> values1 = fetch_ranges<T1>(policy, runs1);
+                std::vector<T2> values2 = fetch_ranges<T2>(policy, runs2);
+
+                parallel::merge(execution::par.with(policy.parameters()),
+                    values1.begin(), values1.end(),
+                    values2.begin(), values2.end(), dest,
+                    std::forward<Comp>(comp), std::forward<Proj1>(proj1),
+                    std::forward<Proj2>(proj2));
+
+                return util::detail::algorithm_result<ExPolicy>::get();
+            }
+        };
+
+        // Find the number of elements of the first sequence among the first
+        // diag elements of the merged sequence. Equivalent elements of the
+        // first sequence precede those of the second one.
+        template <typename SegIter1, typename SegIter2, typename Comp,
+            typename Proj1, typename Proj2>
+        std::size_t merge_path_split(SegIter1 first1, std::size_t size1,
+            SegIter2 first2, std::size_t size2, std::size_t diag,
+            Comp const& comp, Proj1 const& proj1, Proj2 const& proj2)
+        {
+            typedef typename std::iterator_traits<SegIter1>::value_type
+                value_type1;
+            typedef typename std::iterator_traits<SegIter2>::value_type
+                value_type2;
+
+            std::size_t lo = (diag > size2) ? diag - size2 : 0;
+            std::size_t hi = (std::min)(diag, size1);
+
+            while (lo < hi)
+            {
+                std::size_t mid = lo + (hi - lo) / 2;
+
+                value_type1 a = *std::next(first1, mid);
+                value_type2 b = *std::next(first2, diag - mid - 1);
+
+                if (!hpx::util::invoke(comp, hpx::util::invoke(proj2, b),
+                        hpx::util::invoke(proj1, a)))
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename SegIter1, typename SegIter2,
+            typename SegIter3, typename Comp, typename Proj1, typename Proj2>
+        SegIter3 segmented_merge(ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, SegIter2 last2,
+            SegIter3 dest, Comp const& comp, Proj1 const& proj1,
+            Proj2 const& proj2)
+        {
+            typedef typename hpx::traits::segmented_iterator_traits<
+                    SegIter3
+                >::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter1>::value_type
+                value_type1;
+            typedef typename std::iterator_traits<SegIter2>::value_type
+                value_type2;
+
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            std::size_t size1 = std::distance(first1, last1);
+            std::size_t size2 = std::distance(first2, last2);
+
+            SegIter3 dest_last = std::next(dest, size1 + size2);
+            std::vector<segment_range<local_iterator_type> > out_ranges =
+                get_segment_ranges(dest, dest_last);
+
+            // find the merge path splits at all output segment boundaries
+            std::vector<hpx::future<std::size_t> > splits;
+            splits.reserve(out_ranges.size());
+
+            std::size_t diag = 0;
+            for (std::size_t j = 0; j + 1 < out_ranges.size(); ++j)
+            {
+                diag += out_ranges[j].size_;
+                splits.push_back(hpx::async(
+                    [=]() -> std::size_t
+                    {
+                        return merge_path_split(first1, size1, first2, size2,
+                            diag, comp, proj1, proj2);
+                    }));
+            }
+
+            std::vector<std::size_t> bounds1 =
+                get_segment_results<ExPolicy>(std::move(splits));
+            bounds1.insert(bounds1.begin(), 0);
+            bounds1.push_back(size1);
+
+            // merge the runs ending up in each of the output segments on the
+            // locality of that segment
+            std::vector<hpx::future<void> > segments;
+            segments.reserve(out_ranges.size());
+
+            diag = 0;
+            for (std::size_t j = 0; j != out_ranges.size(); ++j)
+            {
+                std::size_t b1 = bounds1[j];
+                std::size_t e1 = bounds1[j + 1];
+                std::size_t b2 = diag - b1;
+
+                diag += out_ranges[j].size_;
+                std::size_t e2 = diag - e1;
+
+                segments.push_back(dispatch_async(out_ranges[j].id_,
+                    merge_segment<value_type1, value_type2>(), policy,
+                    is_seq(), out_ranges[j].first_,
+                    get_segment_ranges(std::next(first1, b1),
+                        std::next(first1, e1)),
+                    get_segment_ranges(std::next(first2, b2),
+                        std::next(first2, e2)),
+                    comp, proj1, proj2));
+            }
+
+            wait_segment_results<ExPolicy>(std::move(segments));
+
+            return dest_last;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename RandIter1, typename RandIter2,
+            typename RandIter3, typename Comp, typename Proj1, typename Proj2>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, hpx::util::tuple<RandIter1, RandIter2, RandIter3>
+        >::type
+        merge_(ExPolicy && policy, RandIter1 first1, RandIter1 last1,
+            RandIter2 first2, RandIter2 last2, RandIter3 dest, Comp && comp,
+            Proj1 && proj1, Proj2 && proj2, std::true_type)
+        {
+            typedef hpx::util::tuple<RandIter1, RandIter2, RandIter3>
+                result_type;
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Comp>::type comp_type;
+            typedef typename hpx::util::decay<Proj1>::type proj1_type;
+            typedef typename hpx::util::decay<Proj2>::type proj2_type;
+
+            if (first1 == last1 && first2 == last2)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, result_type
+                    >::get(hpx::util::make_tuple(last1, last2, dest));
+            }
+
+            policy_type p(std::forward<ExPolicy>(policy));
+            comp_type c(std::forward<Comp>(comp));
+            proj1_type pj1(std::forward<Proj1>(proj1));
+            proj2_type pj2(std::forward<Proj2>(proj2));
+
+            return run_segmented_phases<policy_type, result_type>(
+                [p, first1, last1, first2, last2, dest, c, pj1, pj2]()
+                ->  result_type
+                {
+                    return hpx::util::make_tuple(last1, last2,
+                        segmented_merge(p, first1, last1, first2, last2,
+                            dest, c, pj1, pj2));
+                });
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename RandIter1, typename RandIter2,
+            typename RandIter3, typename Comp, typename Proj1, typename Proj2>
+        typename util::detail::algorithm_result<
+            ExPolicy, hpx::util::tuple<RandIter1, RandIter2, RandIter3>
+        >::type
+        merge_(ExPolicy && policy, RandIter1 first1, RandIter1 last1,
+            RandIter2 first2, RandIter2 last2, RandIter3 dest, Comp && comp,
+            Proj1 && proj1, Proj2 && proj2, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,106 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_REMOVE_OCT_19_2017)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_REMOVE_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/remove.hpp>
+#include <hpx/parallel/algorithms/remove_copy.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/redistribute.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_remove_if
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // Filter applied to each segment: copies the elements not satisfying
+        // the predicate.
+        template <typename Pred, typename Proj>
+        struct remove_if_filter
+        {
+            template <typename ExPolicy, typename InIter, typename OutIter>
+            OutIter operator()(ExPolicy && policy, InIter first, InIter last,
+                OutIter dest)
+            {
+                return parallel::remove_copy_if(
+                    std::forward<ExPolicy>(policy), first, last, dest,
+                    pred_, proj_).out();
+            }
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & pred_ & proj_;
+            }
+
+            Pred pred_;
+            Proj proj_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, FwdIter
+        >::type
+        remove_if_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef remove_if_filter<
+                    typename hpx::util::decay<Pred>::type,
+                    typename hpx::util::decay<Proj>::type
+                > filter_type;
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, FwdIter
+                    >::get(std::move(last));
+            }
+
+            policy_type p(std::forward<ExPolicy>(policy));
+            filter_type filter = {
+                std::forward<Pred>(pred), std::forward<Proj>(proj)
+            };
+
+            // the remaining elements are compacted to the front of the
+            // sequence, all segments have been filtered before any element
+            // is overwritten
+            return run_segmented_phases<policy_type, FwdIter>(
+                [p, first, last, filter]() -> FwdIter
+                {
+                    return segmented_compact(p, is_seq(), first, last, first,
+                        [&filter](std::size_t) { return filter; }).second;
+                });
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        remove_if_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,517 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_19_2017)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/merge.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/redistribute.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The segmented sort is a sample sort: every segment is sorted
+        // locally and contributes regularly spaced samples from which the
+        // splitters delimiting one bucket per segment are chosen. Each bucket
+        // is gathered and merged on the locality of the segment with the same
+        // index and is finally written to its position in the sequence.
+        //
+        // Elements are ordered by (key, segment, position in the sorted
+        // segment) when splitting the segments into buckets. This spreads
+        // runs of equivalent keys over several buckets, otherwise all of the
+        // elements with the same key would end up on a single locality.
+
+        // The position of the k-th (1 <= k <= count) of count regularly
+        // spaced samples of a sorted range of the given size.
+        inline std::size_t regular_sample_position(std::size_t k,
+            std::size_t size, std::size_t count)
+        {
+            return (k * size) / (count + 1);
+        }
+
+        // Draw count regularly spaced samples from a sorted range.
+        template <typename T, typename Iter>
+        std::vector<T> regular_samples(Iter first, Iter last,
+            std::size_t count)
+        {
+            std::vector<T> samples;
+            samples.reserve(count);
+
+            std::size_t size = std::distance(first, last);
+            for (std::size_t k = 1; k <= count; ++k)
+            {
+                samples.push_back(
+                    *std::next(first, regular_sample_position(k, size, count)));
+            }
+
+            return samples;
+        }
+
+        // The splitters delimiting the buckets, the i-th splitter is the
+        // element at positions_[i] in the sorted segment segments_[i].
+        template <typename T>
+        struct sort_splitters
+        {
+            std::vector<T> values_;
+            std::vector<std::size_t> segments_;
+            std::vector<std::size_t> positions_;
+        };
+
+        // Choose count - 1 splitters from the samples drawn from each of the
+        // count segments of the given sizes.
+        template <typename T, typename Compare, typename Proj>
+        sort_splitters<T> select_splitters(
+            std::vector<std::vector<T> > const& samples,
+            std::vector<std::size_t> const& sizes,
+            Compare const& comp, Proj const& proj)
+        {
+            typedef std::pair<std::size_t, std::size_t> sample_index;
+
+            std::size_t const count = samples.size();
+            HPX_ASSERT(sizes.size() == count);
+
+            std::vector<sample_index> all_samples;
+            all_samples.reserve(count * (count - 1));
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                for (std::size_t k = 0; k != samples[i].size(); ++k)
+                    all_samples.push_back(sample_index(i, k));
+            }
+
+            // the samples of a segment are drawn in ascending order of their
+            // position, which breaks the ties between equivalent samples
+            util::compare_projected<Compare, Proj> pred(comp, proj);
+            std::sort(all_samples.begin(), all_samples.end(),
+                [&](sample_index const& lhs, sample_index const& rhs)
+                {
+                    T const& l = samples[lhs.first][lhs.second];
+                    T const& r = samples[rhs.first][rhs.second];
+                    if (pred(l, r))
+                        return true;
+                    if (pred(r, l))
+                        return false;
+                    return lhs < rhs;
+                });
+
+            sort_splitters<T> splitters;
+            splitters.values_.reserve(count - 1);
+            splitters.segments_.reserve(count - 1);
+            splitters.positions_.reserve(count - 1);
+
+            for (std::size_t j = 1; j != count; ++j)
+            {
+                sample_index const& sample =
+                    all_samples[(j * all_samples.size()) / count];
+
+                std::size_t const i = sample.first;
+                splitters.values_.push_back(samples[i][sample.second]);
+                splitters.segments_.push_back(i);
+                splitters.positions_.push_back(regular_sample_position(
+                    sample.second + 1, sizes[i], samples[i].size()));
+            }
+            return splitters;
+        }
+
+        // Sort a segment and return regular samples of the sorted elements.
+        template <typename T>
+        struct sort_segment
+          : public detail::algorithm<sort_segment<T>, std::vector<T> >
+        {
+            sort_segment()
+              : sort_segment::algorithm("sort_segment")
+            {}
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static std::vector<T>
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                std::size_t num_samples, Compare && comp, Proj && proj)
+            {
+                std::sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)));
+
+                return regular_samples<T>(first, last, num_samples);
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                std::size_t num_samples, Compare && comp, Proj && proj)
+            {
+                parallel::sort(execution::par.with(policy.parameters()),
+                    first, last, std::forward<Compare>(comp),
+                    std::forward<Proj>(proj));
+
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(regular_samples<T>(first, last, num_samples));
+            }
+        };
+
+        // Return the offsets in a sorted segment at which each of the
+        // buckets delimited by the given splitters ends. The elements which
+        // are equivalent to a splitter belong to the preceding bucket if
+        // they are located in a preceding segment, or at a preceding
+        // position of the segment the splitter was drawn from.
+        template <typename T>
+        struct split_segment
+          : public detail::algorithm<
+                split_segment<T>, std::vector<std::size_t> >
+        {
+            split_segment()
+              : split_segment::algorithm("split_segment")
+            {}
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static std::vector<std::size_t>
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                std::size_t segment, std::vector<T> const& splitters,
+                std::vector<std::size_t> const& splitter_segments,
+                std::vector<std::size_t> const& splitter_positions,
+                Compare && comp, Proj && proj)
+            {
+                HPX_ASSERT(splitters.size() == splitter_segments.size());
+                HPX_ASSERT(splitters.size() == splitter_positions.size());
+
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(splitters.size());
+
+                RandomIt it = first;
+                for (std::size_t j = 0; j != splitters.size(); ++j)
+                {
+                    it = std::lower_bound(it, last, splitters[j], pred);
+
+                    std::size_t bound = std::distance(first, it);
+                    if (segment < splitter_segments[j])
+                    {
+                        bound = std::distance(first,
+                            std::upper_bound(it, last, splitters[j], pred));
+                    }
+                    else if (segment == splitter_segments[j])
+                    {
+                        HPX_ASSERT(splitter_positions[j] >= bound);
+                        bound = splitter_positions[j];
+                    }
+                    bounds.push_back(bound);
+                }
+                return bounds;
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<std::size_t>
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                std::size_t segment, std::vector<T> const& splitters,
+                std::vector<std::size_t> const& splitter_segments,
+                std::vector<std::size_t> const& splitter_positions,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<std::size_t>
+                    >::get(sequential(policy, first, last, segment,
+                        splitters, splitter_segments, splitter_positions,
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)));
+            }
+        };
+
+        // Fetch the sorted runs making up a bucket, merge them and stage the
+        // result.
+        template <typename T>
+        struct gather_bucket
+          : public detail::algorithm<
+                gather_bucket<T>, std::pair<std::uint64_t, std::size_t> >
+        {
+            typedef std::pair<std::uint64_t, std::size_t> staged_type;
+
+            gather_bucket()
+              : gather_bucket::algorithm("gather_bucket")
+            {}
+
+            template <typename ExPolicy, typename LocalIter, typename Compare,
+                typename Proj>
+            static staged_type
+            sequential(ExPolicy && policy,
+                std::vector<segment_range<LocalIter> > const& runs,
+                Compare && comp, Proj && proj)
+            {
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                return gather(policy, runs,
+                    [&pred](typename std::vector<T>::iterator first,
+                        typename std::vector<T>::iterator middle,
+                        typename std::vector<T>::iterator last)
+                    {
+                        std::inplace_merge(first, middle, last, pred);
+                    });
+            }
+
+            template <typename ExPolicy, typename LocalIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, staged_type
+            >::type
+            parallel(ExPolicy && policy,
+                std::vector<segment_range<LocalIter> > const& runs,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, staged_type
+                    >::get(gather(policy, runs,
+                        [&](typename std::vector<T>::iterator first,
+                            typename std::vector<T>::iterator middle,
+                            typename std::vector<T>::iterator last)
+                        {
+                            parallel::inplace_merge(
+                                execution::par.with(policy.parameters()),
+                                first, middle, last, comp, proj);
+                        }));
+            }
+
+        private:
+            template <typename ExPolicy, typename LocalIter, typename Merge>
+            static staged_type
+            gather(ExPolicy const& policy,
+                std::vector<segment_range<LocalIter> > const& runs,
+                Merge && merge)
+            {
+                std::vector<hpx::future<std::vector<T> > > fetched;
+                fetched.reserve(runs.size());
+                for (segment_range<LocalIter> const& r : runs)
+                {
+                    fetched.push_back(dispatch_async(r.id_,
+                        fetch_segment<T>(), policy, std::true_type(),
+                        r.first_, r.last_));
+                }
+
+                std::vector<std::vector<T> > parts =
+                    get_segment_results<ExPolicy>(std::move(fetched));
+
+                std::size_t size = 0;
+                for (std::vector<T> const& part : parts)
+                    size += part.size();
+
+                std::vector<T> values;
+                values.reserve(size);
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(parts.size() + 1);
+                bounds.push_back(0);
+
+                for (std::vector<T>& part : parts)
+                {
+                    std::move(part.begin(), part.end(),
+                        std::back_inserter(values));
+                    bounds.push_back(values.size());
+                }
+
+                // merge adjacent runs until a single run is left
+                while (bounds.size() > 2)
+                {
+                    std::vector<std::size_t> merged;
+                    merged.reserve(bounds.size() / 2 + 1);
+
+                    std::size_t i = 0;
+                    for (/**/; i + 2 < bounds.size(); i += 2)
+                    {
+                        merge(values.begin() + bounds[i],
+                            values.begin() + bounds[i + 1],
+                            values.begin() + bounds[i + 2]);
+                        merged.push_back(bounds[i]);
+                    }
+                    for (/**/; i != bounds.size(); ++i)
+                        merged.push_back(bounds[i]);
+
+                    bounds = std::move(merged);
+                }
+
+                return staged_type(
+                    staging_buffers<T>::store(std::move(values)), size);
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        SegIter segmented_sort(ExPolicy const& policy, SegIter first,
+            SegIter last, Compare const& comp, Proj const& proj)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef segment_range<local_iterator_type> range_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+            typedef std::pair<std::uint64_t, std::size_t> staged_type;
+
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            std::vector<range_type> ranges = get_segment_ranges(first, last);
+            std::size_t const count = ranges.size();
+            if (count == 0)
+                return last;
+
+            // sort all segments and draw samples from each of them
+            std::vector<hpx::future<std::vector<value_type> > > sampled;
+            sampled.reserve(count);
+            for (range_type const& r : ranges)
+            {
+                sampled.push_back(dispatch_async(r.id_,
+                    sort_segment<value_type>(), policy, is_seq(),
+                    r.first_, r.last_, count - 1, comp, proj));
+            }
+
+            std::vector<std::vector<value_type> > samples =
+                get_segment_results<ExPolicy>(std::move(sampled));
+
+            if (count == 1)
+                return last;
+
+            // choose the splitters delimiting the buckets
+            std::vector<std::size_t> sizes;
+            sizes.reserve(count);
+            for (range_type const& r : ranges)
+                sizes.push_back(r.size_);
+
+            sort_splitters<value_type> splitters =
+                select_splitters(samples, sizes, comp, proj);
+
+            // find the part of every segment which belongs to each bucket
+            std::vector<hpx::future<std::vector<std::size_t> > > split;
+            split.reserve(count);
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                split.push_back(dispatch_async(ranges[i].id_,
+                    split_segment<value_type>(), policy, std::true_type(),
+                    ranges[i].first_, ranges[i].last_, i,
+                    splitters.values_, splitters.segments_,
+                    splitters.positions_, comp, proj));
+            }
+
+            std::vector<std::vector<std::size_t> > bounds =
+                get_segment_results<ExPolicy>(std::move(split));
+
+            // gather the buckets, bucket j is merged on the locality owning
+            // the j-th segment
+            std::vector<id_type> ids;
+            std::vector<hpx::future<staged_type> > stages;
+            ids.reserve(count);
+            stages.reserve(count);
+
+            for (std::size_t j = 0; j != count; ++j)
+            {
+                std::vector<range_type> runs;
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    std::size_t b = (j == 0) ? 0 : bounds[i][j - 1];
+                    std::size_t e =
+                        (j == count - 1) ? ranges[i].size_ : bounds[i][j];
+
+                    if (b != e)
+                    {
+                        runs.push_back(range_type(ranges[i].id_,
+                            std::next(ranges[i].first_, b),
+                            std::next(ranges[i].first_, e), e - b));
+                    }
+                }
+
+                ids.push_back(ranges[j].id_);
+                stages.push_back(dispatch_async(ranges[j].id_,
+                    gather_bucket<value_type>(), policy, is_seq(),
+                    std::move(runs), comp, proj));
+            }
+
+            std::vector<staged_type> staged =
+                get_staged_results<value_type>(policy, ids, std::move(stages));
+
+            // write the buckets to their final position
+            SegIter out = unstage_segments<value_type>(policy, is_seq(), ids,
+                std::move(staged), first);
+
+            HPX_ASSERT(out == last);
+            return last;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, RandomIt
+        >::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Compare>::type compare_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, RandomIt
+                    >::get(std::move(last));
+            }
+
+            policy_type p(std::forward<ExPolicy>(policy));
+            compare_type c(std::forward<Compare>(comp));
+            proj_type pr(std::forward<Proj>(proj));
+
+            return run_segmented_phases<policy_type, RandomIt>(
+                [p, first, last, c, pr]() -> RandomIt
+                {
+                    return segmented_sort(p, first, last, c, pr);
+                });
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,159 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_UNIQUE_OCT_19_2017)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_UNIQUE_OCT_19_2017
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/algorithms/unique.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/redistribute.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_unique
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // Filter applied to each segment: copies the first element of every
+        // group of equivalent elements. The first element of the segment is
+        // dropped as well if it is equivalent to the last element of the
+        // preceding segment.
+        template <typename T, typename Pred, typename Proj>
+        struct unique_filter
+        {
+            template <typename ExPolicy, typename InIter, typename OutIter>
+            OutIter operator()(ExPolicy && policy, InIter first, InIter last,
+                OutIter dest)
+            {
+                OutIter end = parallel::unique_copy(
+                    std::forward<ExPolicy>(policy), first, last, dest,
+                    pred_, proj_).out();
+
+                if (has_prev_ && dest != end &&
+                    hpx::util::invoke(pred_,
+                        hpx::util::invoke(proj_, prev_),
+                        hpx::util::invoke(proj_, *dest)))
+                {
+                    end = std::move(std::next(dest), end, dest);
+                }
+                return end;
+            }
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & pred_ & proj_ & prev_ & has_prev_;
+            }
+
+            Pred pred_;
+            Proj proj_;
+            T prev_;
+            bool has_prev_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        SegIter segmented_unique(ExPolicy const& policy, SegIter first,
+            SegIter last, Pred const& pred, Proj const& proj)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+            typedef unique_filter<value_type, Pred, Proj> filter_type;
+
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            std::vector<segment_range<local_iterator_type> > ranges =
+                get_segment_ranges(first, last);
+
+            // fetch the last element of all but the last segment
+            std::vector<hpx::future<std::vector<value_type> > > fetched;
+            fetched.reserve(ranges.size());
+            for (std::size_t i = 0; i + 1 < ranges.size(); ++i)
+            {
+                fetched.push_back(dispatch_async(ranges[i].id_,
+                    fetch_segment<value_type>(), policy, std::true_type(),
+                    std::prev(ranges[i].last_), ranges[i].last_));
+            }
+
+            std::vector<std::vector<value_type> > prev =
+                get_segment_results<ExPolicy>(std::move(fetched));
+
+            return segmented_compact(policy, is_seq(), first, last, first,
+                [&](std::size_t i) -> filter_type
+                {
+                    if (i == 0)
+                    {
+                        return filter_type{
+                            pred, proj, value_type(), false
+                        };
+                    }
+                    return filter_type{pred, proj, prev[i - 1][0], true};
+                }).second;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, FwdIter
+        >::type
+        unique_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Pred>::type pred_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, FwdIter
+                    >::get(std::move(last));
+            }
+
+            policy_type p(std::forward<ExPolicy>(policy));
+            pred_type pr(std::forward<Pred>(pred));
+            proj_type pj(std::forward<Proj>(proj));
+
+            return run_segmented_phases<policy_type, FwdIter>(
+                [p, first, last, pr, pj]() -> FwdIter
+                {
+                    return segmented_unique(p, first, last, pr, pj);
+                });
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        unique_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
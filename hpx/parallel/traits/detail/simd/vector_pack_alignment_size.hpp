@@ -0,0 +1,67 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_TRAITS_VECTOR_PACK_ALIGNMENT_SIMD_OCT_19_2017_0306PM)
+#define HPX_PARALLEL_TRAITS_VECTOR_PACK_ALIGNMENT_SIMD_OCT_19_2017_0306PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <hpx/parallel/datapar/simd.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    struct is_vector_pack<simd::pack<T, Abi> >
+      : std::true_type
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    struct is_scalar_vector_pack<simd::pack<T, Abi> >
+      : std::integral_constant<bool, simd::pack<T, Abi>::size() == 1>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    struct is_non_scalar_vector_pack<simd::pack<T, Abi> >
+      : std::integral_constant<bool, simd::pack<T, Abi>::size() != 1>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Enable>
+    struct vector_pack_alignment
+    {
+        static std::size_t const value = simd::pack<T>::alignment;
+    };
+
+    template <typename T, typename Abi>
+    struct vector_pack_alignment<simd::pack<T, Abi> >
+    {
+        static std::size_t const value = simd::pack<T, Abi>::alignment;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Enable>
+    struct vector_pack_size
+    {
+        static std::size_t const value = simd::pack<T>::size();
+    };
+
+    template <typename T, typename Abi>
+    struct vector_pack_size<simd::pack<T, Abi> >
+    {
+        static std::size_t const value = simd::pack<T, Abi>::size();
+    };
+}}}
+
+#endif
+#endif
+
@@ -0,0 +1,29 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_DATAPAR_SIMD_COUNT_BITS_OCT_19_2017_0307PM)
+#define HPX_PARALLEL_DATAPAR_SIMD_COUNT_BITS_OCT_19_2017_0307PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <hpx/parallel/datapar/simd.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace parallel { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    std::size_t count_bits(simd::mask<T, Abi> const& mask)
+    {
+        return simd::popcount(mask);
+    }
+}}}
+
+#endif
+#endif
+
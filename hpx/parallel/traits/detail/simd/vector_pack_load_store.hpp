@@ -0,0 +1,108 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_TRAITS_VECTOR_PACK_LOAD_SIMD_OCT_19_2017_0308PM)
+#define HPX_PARALLEL_TRAITS_VECTOR_PACK_LOAD_SIMD_OCT_19_2017_0308PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <hpx/parallel/datapar/simd.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Abi, typename NewT>
+    struct rebind_pack<simd::pack<T, Abi>, NewT>
+    {
+        typedef simd::pack<NewT, Abi> type;
+    };
+
+    // don't wrap types twice
+    template <typename T, typename Abi1, typename NewT, typename Abi2>
+    struct rebind_pack<simd::pack<T, Abi1>, simd::pack<NewT, Abi2> >
+    {
+        typedef simd::pack<NewT, Abi2> type;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename V, typename ValueType, typename Enable>
+    struct vector_pack_load
+    {
+        typedef typename rebind_pack<V, ValueType>::type value_type;
+
+        template <typename Iter>
+        static value_type aligned(Iter const& iter)
+        {
+            return value_type(std::addressof(*iter), simd::vector_aligned);
+        }
+
+        template <typename Iter>
+        static value_type unaligned(Iter const& iter)
+        {
+            return value_type(std::addressof(*iter), simd::element_aligned);
+        }
+    };
+
+    template <typename V, typename T, typename Abi>
+    struct vector_pack_load<V, simd::pack<T, Abi> >
+    {
+        typedef typename rebind_pack<V, simd::pack<T, Abi> >::type value_type;
+
+        template <typename Iter>
+        static value_type aligned(Iter const& iter)
+        {
+            return *iter;
+        }
+
+        template <typename Iter>
+        static value_type unaligned(Iter const& iter)
+        {
+            return *iter;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename V, typename ValueType, typename Enable>
+    struct vector_pack_store
+    {
+        template <typename Iter>
+        static void aligned(V const& value, Iter const& iter)
+        {
+            value.copy_to(std::addressof(*iter), simd::vector_aligned);
+        }
+
+        template <typename Iter>
+        static void unaligned(V const& value, Iter const& iter)
+        {
+            value.copy_to(std::addressof(*iter), simd::element_aligned);
+        }
+    };
+
+    template <typename V, typename T, typename Abi>
+    struct vector_pack_store<V, simd::pack<T, Abi> >
+    {
+        template <typename Iter>
+        static void aligned(V const& value, Iter const& iter)
+        {
+            *iter = value;
+        }
+
+        template <typename Iter>
+        static void unaligned(V const& value, Iter const& iter)
+        {
+            *iter = value;
+        }
+    };
+}}}
+
+#endif
+#endif
+
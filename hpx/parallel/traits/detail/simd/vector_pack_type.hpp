@@ -0,0 +1,62 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_TRAITS_VECTOR_PACK_TYPE_SIMD_OCT_19_2017_0305PM)
+#define HPX_PARALLEL_TRAITS_VECTOR_PACK_TYPE_SIMD_OCT_19_2017_0305PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <hpx/parallel/datapar/simd.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T, std::size_t N, typename Abi>
+        struct vector_pack_type
+        {
+            typedef simd::pack<T, simd::simd_abi::fixed_size<N> > type;
+        };
+
+        template <typename T, typename Abi>
+        struct vector_pack_type<T, 0, Abi>
+        {
+            typedef typename std::conditional<
+                    std::is_void<Abi>::value, simd::simd_abi::native<T>, Abi
+                >::type abi_type;
+
+            typedef simd::pack<T, abi_type> type;
+        };
+
+        template <typename T, typename Abi>
+        struct vector_pack_type<T, 1, Abi>
+        {
+            typedef simd::pack<T, simd::simd_abi::scalar> type;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, std::size_t N, typename Abi>
+    struct vector_pack_type
+      : detail::vector_pack_type<T, N, Abi>
+    {};
+
+    // don't wrap types twice
+    template <typename T, std::size_t N, typename Abi1, typename Abi2>
+    struct vector_pack_type<simd::pack<T, Abi1>, N, Abi2>
+    {
+        typedef simd::pack<T, Abi1> type;
+    };
+}}}
+
+#endif
+#endif
+
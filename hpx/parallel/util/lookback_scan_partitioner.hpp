@@ -0,0 +1,379 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_LOOKBACK_SCAN_PARTITIONER_OCT_19_2017_1105AM)
+#define HPX_PARALLEL_UTIL_LOOKBACK_SCAN_PARTITIONER_OCT_19_2017_1105AM
+
+#include <hpx/config.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace util
+{
+    // The largest number of elements handled by one tile of the look-back
+    // scan. Tiles of this size usually stay in the cache between the first
+    // (local scan) and the second (prefix application) pass over them.
+    static std::size_t const lookback_scan_tile_size = 16384;
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The state each tile publishes for its successors.
+        enum lookback_scan_status
+        {
+            lookback_scan_invalid = 0,      // nothing published yet
+            lookback_scan_aggregate = 1,    // the local aggregate is valid
+            lookback_scan_prefix = 2,       // the inclusive prefix is valid
+            lookback_scan_failed = 3        // the tile ran into an error
+        };
+
+        template <typename T>
+        struct lookback_scan_tile
+        {
+            lookback_scan_tile()
+              : status_(lookback_scan_invalid)
+            {}
+
+            std::atomic<int> status_;
+            hpx::util::optional<T> aggregate_;
+            hpx::util::optional<T> prefix_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Single pass scan based on decoupled look-back: every tile computes
+        // its local aggregate, publishes it, and then walks backwards over
+        // its predecessors combining their published aggregates until it
+        // finds a tile which has published its inclusive prefix. Tiles are
+        // handed out in order to a fixed set of workers which guarantees that
+        // all predecessors of a tile are already being worked on.
+        template <typename FwdIter, typename T, typename F1, typename Op,
+            typename F3>
+        class lookback_scan
+        {
+        public:
+            lookback_scan(FwdIter first, std::size_t count,
+                    std::size_t tile_size, T const& init, F1& f1, Op& op,
+                    F3& f3)
+              : count_(count), tile_size_(tile_size),
+                num_tiles_((count + tile_size - 1) / tile_size),
+                tiles_(new lookback_scan_tile<T>[num_tiles_]),
+                next_tile_(0), init_(init), f1_(f1), op_(op), f3_(f3)
+            {
+                starts_.reserve(num_tiles_);
+                for (std::size_t i = 0; i != num_tiles_; ++i)
+                {
+                    starts_.push_back(first);
+                    if (i != num_tiles_ - 1)
+                        std::advance(first, tile_size_);
+                }
+            }
+
+            std::size_t num_tiles() const
+            {
+                return num_tiles_;
+            }
+
+            // executed by each of the workers
+            void run()
+            {
+                for (;;)
+                {
+                    std::size_t tile = next_tile_++;
+                    if (tile >= num_tiles_ || !process(tile))
+                        return;
+                }
+            }
+
+            T const& total() const
+            {
+                HPX_ASSERT(tiles_[num_tiles_ - 1].prefix_.has_value());
+                return *tiles_[num_tiles_ - 1].prefix_;
+            }
+
+        private:
+            bool process(std::size_t tile)
+            {
+                lookback_scan_tile<T>& t = tiles_[tile];
+                std::size_t size = (tile == num_tiles_ - 1) ?
+                    count_ - tile * tile_size_ : tile_size_;
+
+                try {
+                    T aggregate = f1_(starts_[tile], size);
+
+                    hpx::util::optional<T> exclusive;
+                    if (tile == 0)
+                    {
+                        exclusive.emplace(init_);
+                    }
+                    else
+                    {
+                        t.aggregate_.emplace(aggregate);
+                        t.status_.store(lookback_scan_aggregate,
+                            std::memory_order_release);
+
+                        if (!look_back(tile, exclusive))
+                        {
+                            // one of the predecessors has failed, its
+                            // exception is reported by its worker
+                            t.status_.store(lookback_scan_failed,
+                                std::memory_order_release);
+                            return false;
+                        }
+                    }
+
+                    t.prefix_.emplace(op_(*exclusive, aggregate));
+                    t.status_.store(lookback_scan_prefix,
+                        std::memory_order_release);
+
+                    f3_(starts_[tile], size, *exclusive);
+                }
+                catch (...) {
+                    if (t.status_.load(std::memory_order_relaxed) !=
+                        lookback_scan_prefix)
+                    {
+                        t.status_.store(lookback_scan_failed,
+                            std::memory_order_release);
+                    }
+                    throw;
+                }
+                return true;
+            }
+
+            // Combine the results published by the predecessors of the
+            // given tile into its exclusive prefix.
+            bool look_back(std::size_t tile, hpx::util::optional<T>& exclusive)
+            {
+                for (std::size_t pred = tile; pred-- != 0; /**/)
+                {
+                    lookback_scan_tile<T>& p = tiles_[pred];
+
+                    int status = p.status_.load(std::memory_order_acquire);
+                    for (std::size_t k = 0;
+                         status == lookback_scan_invalid; ++k)
+                    {
+                        hpx::util::detail::yield_k(k,
+                            "hpx::parallel::util::lookback_scan::look_back");
+                        status = p.status_.load(std::memory_order_acquire);
+                    }
+
+                    if (status == lookback_scan_failed)
+                        return false;
+
+                    T const& value = (status == lookback_scan_prefix) ?
+                        *p.prefix_ : *p.aggregate_;
+
+                    if (exclusive.has_value())
+                    {
+                        T combined = op_(value, *exclusive);
+                        exclusive.emplace(std::move(combined));
+                    }
+                    else
+                    {
+                        exclusive.emplace(value);
+                    }
+
+                    if (status == lookback_scan_prefix)
+                        return true;
+                }
+
+                // tile zero always publishes its prefix
+                HPX_ASSERT(false);
+                return false;
+            }
+
+        private:
+            std::size_t count_;
+            std::size_t tile_size_;
+            std::size_t num_tiles_;
+            std::unique_ptr<lookback_scan_tile<T>[]> tiles_;
+            std::vector<FwdIter> starts_;
+            std::atomic<std::size_t> next_tile_;
+
+            T const& init_;
+            F1& f1_;
+            Op& op_;
+            F3& f3_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename R, typename T>
+        struct lookback_scan_partitioner_helper
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename Op, typename F3, typename F4>
+            static R call(ExPolicy && policy, FwdIter first,
+                std::size_t count, T const& init, F1 && f1, Op && op,
+                F3 && f3, F4 && f4)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_type
+                    executor_type;
+
+                typedef lookback_scan<
+                        FwdIter, T, typename hpx::util::decay<F1>::type,
+                        typename hpx::util::decay<Op>::type,
+                        typename hpx::util::decay<F3>::type
+                    > lookback_scan_type;
+
+                // inform parameter traits
+                scoped_executor_parameters_ref<
+                        parameters_type, executor_type
+                    > scoped_param(policy.parameters(), policy.executor());
+
+                HPX_ASSERT(count > 0);
+
+                std::size_t const cores = execution::processing_units_count(
+                    policy.executor(), policy.parameters());
+
+                // honor an explicitly specified chunk size, but never let
+                // tiles grow beyond what is likely to stay in the cache
+                std::size_t tile_size = execution::get_chunk_size(
+                    policy.parameters(), policy.executor(),
+                    [](){ return 0; }, cores, count);
+                if (tile_size == 0)
+                    tile_size = (count + cores - 1) / cores;
+                tile_size = (std::max)(std::size_t(1),
+                    (std::min)(tile_size, lookback_scan_tile_size));
+
+                typename hpx::util::decay<F1>::type f1_(std::forward<F1>(f1));
+                typename hpx::util::decay<Op>::type op_(std::forward<Op>(op));
+                typename hpx::util::decay<F3>::type f3_(std::forward<F3>(f3));
+
+                std::vector<hpx::future<void> > workitems;
+                std::list<std::exception_ptr> errors;
+
+                try {
+                    lookback_scan_type scan(
+                        first, count, tile_size, init, f1_, op_, f3_);
+
+                    std::size_t num_workers =
+                        (std::min)(cores, scan.num_tiles());
+                    workitems.reserve(num_workers);
+
+                    try {
+                        for (std::size_t i = 0; i != num_workers; ++i)
+                        {
+                            workitems.push_back(execution::async_execute(
+                                policy.executor(),
+                                [&scan]() { scan.run(); }));
+                        }
+                    }
+                    catch (...) {
+                        handle_local_exceptions<ExPolicy>::call(
+                            std::current_exception(), errors);
+                    }
+
+                    // the workers refer to 'scan', wait for all of them
+                    // to finish
+                    hpx::wait_all(workitems);
+
+                    // always rethrow if 'errors' is not empty or
+                    // 'workitems' has an exceptional future
+                    handle_local_exceptions<ExPolicy>::call(
+                        workitems, errors);
+
+                    return f4(scan.total());
+                }
+                catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions<ExPolicy>::call(
+                        std::current_exception());
+                }
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy_, typename R, typename T>
+        struct lookback_scan_partitioner
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename Op, typename F3, typename F4>
+            static R call(ExPolicy && policy, FwdIter first,
+                std::size_t count, T const& init, F1 && f1, Op && op,
+                F3 && f3, F4 && f4)
+            {
+                return lookback_scan_partitioner_helper<R, T>::call(
+                    std::forward<ExPolicy>(policy), first, count, init,
+                    std::forward<F1>(f1), std::forward<Op>(op),
+                    std::forward<F3>(f3), std::forward<F4>(f4));
+            }
+        };
+
+        template <typename R, typename T>
+        struct lookback_scan_partitioner<
+            execution::parallel_task_policy, R, T>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename Op, typename F3, typename F4>
+            static hpx::future<R> call(ExPolicy && policy, FwdIter first,
+                std::size_t count, T const& init, F1 && f1, Op && op,
+                F3 && f3, F4 && f4)
+            {
+                return execution::async_execute(
+                    policy.executor(),
+                    [=]() mutable -> R
+                    {
+                        return lookback_scan_partitioner_helper<R, T>::call(
+                            policy, first, count, init, f1, op, f3, f4);
+                    });
+            }
+        };
+
+        template <typename Executor, typename Parameters, typename R,
+            typename T>
+        struct lookback_scan_partitioner<
+                execution::parallel_task_policy_shim<Executor, Parameters>,
+                R, T>
+          : lookback_scan_partitioner<execution::parallel_task_policy, R, T>
+        {};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ExPolicy:    execution policy
+    // R:           overall result type
+    // T:           type of the values accumulated by the scan
+    //
+    // The partitioner invokes the given functions as follows:
+    //
+    //  f1(it, size) -> T:      performs the local scan of a tile and returns
+    //                          its aggregate
+    //  op(T, T) -> T:          combines the results of two adjacent tiles
+    //  f3(it, size, T):        applies the exclusive prefix of a tile (which
+    //                          is 'init' for the first tile)
+    //  f4(T) -> R:             is given the overall result of the scan
+    template <typename ExPolicy, typename R, typename T>
+    struct lookback_scan_partitioner
+      : detail::lookback_scan_partitioner<
+            typename hpx::util::decay<ExPolicy>::type, R, T>
+    {};
+}}}
+
+#endif
@@ -768,6 +768,10 @@ namespace hpx { namespace actions
         // typed continuations...
         typed_continuation_hpx_agas_response,
 
+        // appended to keep the ids of all preceding actions unchanged
+        symbol_namespace_bind_n_action_id,
+        symbol_namespace_resolve_n_action_id,
+
         last_action_id
     };
 
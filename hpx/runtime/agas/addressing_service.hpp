@@ -21,6 +21,7 @@
 #include <hpx/runtime/agas/locality_namespace.hpp>
 #include <hpx/runtime/agas/symbol_namespace.hpp>
 #include <hpx/runtime/agas/primary_namespace.hpp>
+#include <hpx/runtime/agas/detail/gva_hit_cache.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/name.hpp>
@@ -30,6 +31,7 @@
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 #include <hpx/util/function.hpp>
+#include <hpx/util/interval_timer.hpp>
 
 #include <boost/dynamic_bitset.hpp>
 
@@ -87,6 +89,10 @@ public:
     mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
+    // lock-free front end of the gva cache, modified only while holding
+    // gva_cache_mtx_
+    std::unique_ptr<detail::gva_hit_cache> gva_hit_cache_;
+
     mutable mutex_type migrated_objects_mtx_;
     migrated_objects_table_type migrated_objects_table_;
 
@@ -101,6 +107,30 @@ public:
 
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // credit which was requested from AGAS in advance for gids whose credit
+    // was exhausted repeatedly, protected by refcnt_requests_mtx_
+    struct credit_reserve_entry
+    {
+        credit_reserve_entry()
+          : credits_(0), prefetch_(1), used_(true)
+        {}
+
+        std::int64_t credits_;      // surplus credit available locally
+        std::int64_t prefetch_;     // factor applied to the next request
+        bool used_;                 // entry was used since the last flush
+    };
+    typedef std::map<naming::gid_type, credit_reserve_entry>
+        credit_reserve_type;
+
+    credit_reserve_type credit_reserve_;
+    std::int64_t const max_credit_prefetch_;
+
+    // periodically sends buffered reference counting requests, the timer is
+    // running only while requests or credit reserves are pending
+    std::int64_t const refcnt_flush_interval_;
+    util::interval_timer refcnt_flush_timer_;
+    bool refcnt_flush_timer_armed_;     // protected by refcnt_requests_mtx_
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
@@ -205,6 +235,13 @@ public:
       , std::int64_t compensated_credit
         );
 
+    std::int64_t synchronize_with_credit_prefetch(
+        hpx::future<std::int64_t> fut
+      , naming::gid_type const& gid
+      , std::int64_t credits
+      , std::int64_t surplus_credits
+        );
+
     naming::address::address_type get_primary_ns_lva() const
     {
         return primary_ns_.ptr();
@@ -264,6 +301,29 @@ private:
       , error_code& ec
         );
 
+    /// Assumes that \a refcnt_requests_mtx_ is locked.
+    void add_decref_request_locked(
+        naming::gid_type const& raw
+      , std::int64_t credits
+        );
+
+    /// Convert the credit held by the local credit reserve into decref
+    /// requests. If \a all is false only reserves which have not been used
+    /// since the last invocation are released.
+    ///
+    /// Assumes that \a refcnt_requests_mtx_ is locked.
+    void release_credit_reserves_locked(bool all);
+
+    /// Invoked periodically by the refcnt_flush_timer_, stops the timer
+    /// once nothing is left to be flushed.
+    bool flush_refcnt_requests();
+
+    /// Mark refcnt_flush_timer_ as running. Returns whether the timer has
+    /// to be started by the caller (after releasing the lock).
+    ///
+    /// Assumes that \a refcnt_requests_mtx_ is locked.
+    bool arm_refcnt_flush_timer_locked();
+
     // Helper functions to access the current cache statistics
     std::uint64_t get_cache_entries(bool);
     std::uint64_t get_cache_hits(bool);
@@ -1179,6 +1239,26 @@ public:
       , error_code& ec = throws
         );
 
+    /// \brief Acquire additional credit for the given id whose credit is
+    ///        exhausted
+    ///
+    /// This is equivalent to \a incref_async, except that the credit is
+    /// taken from the local credit reserve if possible. If the credit of the
+    /// same id is exhausted repeatedly, geometrically growing blocks of credit
+    /// are requested from AGAS and the surplus is kept in the local credit
+    /// reserve. Unused reserves are given back to AGAS when buffered
+    /// reference counting requests are flushed.
+    ///
+    /// \param gid        [in] The global address (id) for which the
+    ///                   credit should be acquired.
+    /// \param credits    [in] The number of credits to acquire.
+    ///
+    /// \returns          The number of acquired credits.
+    lcos::future<std::int64_t> borrow_credit_async(
+        naming::gid_type const& gid
+      , std::int64_t credits
+        );
+
     /// \brief Invoke the supplied \a hpx#function for every registered global
     ///        name.
     ///
@@ -1301,6 +1381,27 @@ public:
       , error_code& ec = throws
         );
 
+    /// \brief Register a batch of global names with the given global
+    ///        addresses (ids).
+    ///
+    /// All names hosted by the same locality are registered using a single
+    /// request. The returned future holds one entry for each of the given
+    /// names, which is \a true if the corresponding name was registered.
+    lcos::future<std::vector<bool> > register_names_async(
+        std::vector<std::string> const& names
+      , std::vector<naming::id_type> const& ids
+        );
+
+    /// \brief Query for the global addresses associated with a batch of
+    ///        global names.
+    ///
+    /// All names hosted by the same locality are resolved using a single
+    /// request. The returned future holds one id for each of the given
+    /// names, which is invalid if the corresponding name is not registered.
+    lcos::future<std::vector<naming::id_type> > resolve_names_async(
+        std::vector<std::string> const& names
+        );
+
     /// \brief Install a listener for a given symbol namespace event.
     ///
     /// This function installs a listener for a given symbol namespace event.
@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_AGAS_DETAIL_GVA_HIT_CACHE_HPP)
+#define HPX_AGAS_DETAIL_GVA_HIT_CACHE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The \a gva_hit_cache is a fixed size, direct mapped cache of
+    ///        resolved (gid, gva) pairs which sits in front of the (range
+    ///        based) LRU cache of the addressing service.
+    ///
+    /// Each slot is protected by a sequence lock. Lookups never block: a
+    /// reader copies the slot and validates the sequence number afterwards,
+    /// a concurrent writer simply causes a miss. Inserting skips slots which
+    /// are currently being written. Invalidation of all entries is performed
+    /// by bumping a global generation counter, which makes all existing
+    /// slots stale without having to touch them.
+    ///
+    /// \note The functions \a insert and \a invalidate have to be called
+    ///       while holding the lock protecting the backing LRU cache. This
+    ///       guarantees that no stale data can be re-inserted after an
+    ///       invalidation.
+    class gva_hit_cache
+    {
+    private:
+        enum slot_layout
+        {
+            gid_msb = 0, gid_lsb,
+            idbase_msb, idbase_lsb,
+            prefix_msb, prefix_lsb,
+            type, count, lva, offset,
+            generation,
+            num_words
+        };
+
+        struct slot
+        {
+            slot()
+              : seq_(0)
+            {
+                for (std::size_t i = 0; i != num_words; ++i)
+                    data_[i].store(0, std::memory_order_relaxed);
+            }
+
+            std::atomic<std::uint64_t> seq_;
+            std::atomic<std::uint64_t> data_[num_words];
+
+            // avoid false sharing between neighbouring slots
+            char padding_[128 - (num_words + 1) * sizeof(std::uint64_t)];
+        };
+
+        static std::uint64_t now()
+        {
+            std::chrono::nanoseconds ns =
+                std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(ns.count());
+        }
+
+        static std::int64_t get_and_reset_value(
+            std::atomic<std::int64_t>& value, bool reset)
+        {
+            if (reset)
+                return value.exchange(0, std::memory_order_relaxed);
+            return value.load(std::memory_order_relaxed);
+        }
+
+        static std::size_t round_up_to_power_of_two(std::size_t size)
+        {
+            std::size_t result = 1;
+            while (result < size)
+                result <<= 1;
+            return result;
+        }
+
+        std::size_t index(naming::gid_type const& gid) const
+        {
+            // Fibonacci hashing over both halves of the (stripped) gid
+            std::uint64_t h = gid.get_lsb() ^
+                (gid.get_msb() * 0x9e3779b97f4a7c15ull);
+            h *= 0x9e3779b97f4a7c15ull;
+            return static_cast<std::size_t>(h >> 32) & mask_;
+        }
+
+    public:
+        /// Construct a cache holding (at least) \a size entries. The number
+        /// of slots is rounded up to the next power of two.
+        explicit gva_hit_cache(std::size_t size = HPX_AGAS_LOCAL_CACHE_SIZE)
+          : mask_(round_up_to_power_of_two(size ? size : 1) - 1)
+          , slots_(new slot[mask_ + 1])
+          , generation_(1)
+          , hits_(0)
+          , get_entry_count_(0)
+          , get_entry_time_(0)
+        {}
+
+        /// Return the number of slots available in this cache
+        std::size_t capacity() const
+        {
+            return mask_ + 1;
+        }
+
+        /// Look up the given (stripped) gid. On success \a idbase and \a g
+        /// are set to the cached base gid and gva of the range the gid
+        /// belongs to. This function does not acquire any lock.
+        bool get_entry(naming::gid_type const& gid,
+            naming::gid_type& idbase, gva& g)
+        {
+            std::uint64_t started_at = now();
+
+            slot& s = slots_[index(gid)];
+
+            std::uint64_t seq = s.seq_.load(std::memory_order_acquire);
+            if (seq & 1)
+                return false;       // concurrent writer, treat as a miss
+
+            std::uint64_t words[num_words];
+            for (std::size_t i = 0; i != num_words; ++i)
+                words[i] = s.data_[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq_.load(std::memory_order_relaxed) != seq)
+                return false;       // slot was modified while reading
+
+            if (words[generation] !=
+                    generation_.load(std::memory_order_acquire) ||
+                words[gid_msb] != gid.get_msb() ||
+                words[gid_lsb] != gid.get_lsb())
+            {
+                return false;
+            }
+
+            idbase = naming::gid_type(words[idbase_msb], words[idbase_lsb]);
+
+            g.prefix = naming::gid_type(words[prefix_msb], words[prefix_lsb]);
+            g.type = static_cast<gva::component_type>(words[type]);
+            g.count = words[count];
+            g.lva(words[lva]);
+            g.offset = words[offset];
+
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            get_entry_count_.fetch_add(1, std::memory_order_relaxed);
+            get_entry_time_.fetch_add(
+                static_cast<std::int64_t>(now() - started_at),
+                std::memory_order_relaxed);
+
+            return true;
+        }
+
+        /// Store the given (stripped) gid together with the base gid and
+        /// gva of the range it belongs to. If the target slot is currently
+        /// being written by another thread the insertion is skipped.
+        void insert(naming::gid_type const& gid,
+            naming::gid_type const& idbase, gva const& g)
+        {
+            slot& s = slots_[index(gid)];
+
+            std::uint64_t seq = s.seq_.load(std::memory_order_relaxed);
+            if ((seq & 1) || !s.seq_.compare_exchange_strong(
+                    seq, seq + 1, std::memory_order_acquire))
+            {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            s.data_[gid_msb].store(gid.get_msb(), std::memory_order_relaxed);
+            s.data_[gid_lsb].store(gid.get_lsb(), std::memory_order_relaxed);
+            s.data_[idbase_msb].store(
+                idbase.get_msb(), std::memory_order_relaxed);
+            s.data_[idbase_lsb].store(
+                idbase.get_lsb(), std::memory_order_relaxed);
+            s.data_[prefix_msb].store(
+                g.prefix.get_msb(), std::memory_order_relaxed);
+            s.data_[prefix_lsb].store(
+                g.prefix.get_lsb(), std::memory_order_relaxed);
+            s.data_[type].store(static_cast<std::uint64_t>(g.type),
+                std::memory_order_relaxed);
+            s.data_[count].store(g.count, std::memory_order_relaxed);
+            s.data_[lva].store(g.lva(), std::memory_order_relaxed);
+            s.data_[offset].store(g.offset, std::memory_order_relaxed);
+            s.data_[generation].store(
+                generation_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+
+            s.seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        /// Make all entries currently held by this cache stale.
+        void invalidate()
+        {
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        /// Return the number of lookups which were satisfied by this cache
+        std::int64_t hits(bool reset)
+        {
+            return get_and_reset_value(hits_, reset);
+        }
+
+        /// Return the number of invocations of \a get_entry which were
+        /// satisfied by this cache
+        std::int64_t get_get_entry_count(bool reset)
+        {
+            return get_and_reset_value(get_entry_count_, reset);
+        }
+
+        /// Return the overall time spent in successful invocations of
+        /// \a get_entry (in nanoseconds)
+        std::int64_t get_get_entry_time(bool reset)
+        {
+            return get_and_reset_value(get_entry_time_, reset);
+        }
+
+    private:
+        std::size_t const mask_;
+        std::unique_ptr<slot[]> slots_;
+
+        std::atomic<std::uint64_t> generation_;
+
+        std::atomic<std::int64_t> hits_;
+        std::atomic<std::int64_t> get_entry_count_;
+        std::atomic<std::int64_t> get_entry_time_;
+    };
+}}}
+
+#endif
@@ -11,6 +11,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/agas/component_namespace.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
@@ -18,11 +19,18 @@
 #include <hpx/util/function.hpp>
 
 #include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
 namespace hpx { namespace agas { namespace detail
 {
+    // The component namespace is hosted on the root locality only. All
+    // other localities cache results which can't change anymore: the name
+    // of a component type (type ids are never reused) and, if no localities
+    // may connect later on, the list of localities supporting a type once
+    // all localities have registered it. This avoids sending repeated
+    // requests to the root locality.
     struct hosted_component_namespace
         : component_namespace
     {
@@ -59,9 +67,22 @@ namespace hpx { namespace agas { namespace detail
             components::component_type type);
 
         naming::gid_type statistics_counter(std::string const& name);
+
     private:
+        void cache_type(std::string const& name,
+            components::component_type type);
+
+        bool may_cache_localities() const;
+
         naming::id_type gid_;
         naming::address addr_;
+
+        typedef lcos::local::spinlock mutex_type;
+        mutex_type mtx_;
+
+        std::map<components::component_type, std::string> type_names_;
+        std::map<components::component_type, std::vector<std::uint32_t> >
+            localities_;
     };
 
 }}}
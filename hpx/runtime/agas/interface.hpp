@@ -119,6 +119,18 @@ HPX_API_EXPORT lcos::future<naming::id_type> resolve_name(
     std::string const& name
     );
 
+///////////////////////////////////////////////////////////////////////////////
+// Register or resolve a batch of names using (at most) one request for each
+// of the localities hosting the corresponding symbol namespace entries.
+HPX_API_EXPORT lcos::future<std::vector<bool> > register_names(
+    std::vector<std::string> const& names
+  , std::vector<naming::id_type> const& ids
+    );
+
+HPX_API_EXPORT lcos::future<std::vector<naming::id_type> > resolve_names(
+    std::vector<std::string> const& names
+    );
+
 #if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
 HPX_DEPRECATED(HPX_DEPRECATED_MSG)
 inline bool resolve_name_sync(
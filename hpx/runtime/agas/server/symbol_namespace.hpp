@@ -14,9 +14,13 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/components/server/fixed_component_base.hpp>
+#include <hpx/runtime/serialization/map.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/util/function.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -50,13 +54,38 @@ struct HPX_EXPORT symbol_namespace
         gid_table_type;
 
     typedef std::multimap<std::string, hpx::id_type> on_event_data_map_type;
+
+    typedef std::vector<std::pair<std::string, naming::gid_type> >
+        bind_n_data_type;
     // }}}
 
   private:
-    mutex_type mutex_;
-    gid_table_type gids_;
+    // The table is split into independently locked shards, selected based
+    // on the hash of the name. Each shard is ordered by name, which allows
+    // to look up all names sharing a common prefix without a full scan.
+    struct shard
+    {
+        mutex_type mutex_;
+        gid_table_type gids_;
+        on_event_data_map_type on_event_data_;
+    };
+
+    static std::size_t const num_shards = 16;
+
+    shard& get_shard(std::string const& key);
+
+    // collect all entries of the given shard whose names start with the
+    // given prefix and (optionally) match the given regular expression
+    template <typename F>
+    void find_matching(shard& s, std::string const& prefix, F && f);
+
+    // bind a name in the given shard, the shard's mutex has to be locked
+    // by l, it is released before returning
+    bool bind_locked(std::unique_lock<mutex_type>& l, shard& s,
+        std::string key, naming::gid_type gid);
+
+    shard shards_[num_shards];
     std::string instance_name_;
-    on_event_data_map_type on_event_data_;
 
     // data structure holding all counters for the omponent_namespace component
     struct counter_data
@@ -148,6 +177,12 @@ struct HPX_EXPORT symbol_namespace
 
     naming::gid_type resolve(std::string const& key);
 
+    // register/resolve a batch of names at once
+    std::vector<bool> bind_n(bind_n_data_type data);
+
+    std::vector<naming::gid_type> resolve_n(
+        std::vector<std::string> const& keys);
+
     naming::gid_type unbind(std::string const& key);
 
     iterate_names_return_type iterate(std::string const& pattern);
@@ -162,6 +197,8 @@ struct HPX_EXPORT symbol_namespace
 
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, bind);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, resolve);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, bind_n);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, resolve_n);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, unbind);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, iterate);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, on_event);
@@ -184,6 +221,20 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::resolve_action,
     symbol_namespace_resolve_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::bind_n_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::bind_n_action,
+    symbol_namespace_bind_n_action)
+
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::resolve_n_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::resolve_n_action,
+    symbol_namespace_resolve_n_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::symbol_namespace::unbind_action)
 
@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
@@ -66,6 +67,14 @@ struct symbol_namespace
     hpx::future<naming::id_type> resolve_async(std::string key) const;
     naming::id_type resolve(std::string key) const;
 
+    // Register or resolve a batch of names, sending at most one request to
+    // each of the localities hosting the corresponding entries.
+    hpx::future<std::vector<bool> > bind_n_async(
+        std::vector<std::pair<std::string, naming::gid_type> > data);
+
+    hpx::future<std::vector<naming::id_type> > resolve_n_async(
+        std::vector<std::string> keys) const;
+
     hpx::future<naming::id_type> unbind_async(std::string key);
     naming::id_type unbind(std::string key);
 
@@ -0,0 +1,48 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_SERIALIZE_DATAPAR_SIMD_OCT_19_2017_0320PM)
+#define HPX_SERIALIZE_DATAPAR_SIMD_OCT_19_2017_0320PM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DATAPAR_SIMD)
+#include <hpx/parallel/datapar/simd.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/array.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace serialization
+{
+    template <typename T, typename Abi>
+    void serialize(input_archive & ar,
+        hpx::parallel::simd::pack<T, Abi> & v, unsigned)
+    {
+        ar & make_array(&v[0], v.size());
+    }
+
+    template <typename T, typename Abi>
+    void serialize(output_archive & ar,
+        hpx::parallel::simd::pack<T, Abi> const& v, unsigned)
+    {
+        T const* data = &v[0];
+        ar & make_array(data, v.size());
+    }
+}}
+
+namespace hpx { namespace traits
+{
+    template <typename T, typename Abi>
+    struct is_bitwise_serializable<hpx::parallel::simd::pack<T, Abi> >
+      : is_bitwise_serializable<typename std::remove_const<T>::type>
+    {};
+}}
+
+#endif
+#endif
@@ -0,0 +1,54 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_ADAPTIVE_CHUNK_SIZE_STATISTICS_HPP)
+#define HPX_UTIL_ADAPTIVE_CHUNK_SIZE_STATISTICS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/performance_counters/counters_fwd.hpp>
+#include <hpx/runtime/naming_fwd.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The adaptive_chunk_size executor parameters publish the chunk size they
+    // currently consider best for each named call site. The values are
+    // exposed through the /parallel/adaptive-chunk-size/* performance
+    // counters, the name of the call site is the counter parameter.
+    struct adaptive_chunk_size_statistics
+    {
+        adaptive_chunk_size_statistics()
+          : chunk_size_(0), invocations_(0), explorations_(0)
+        {}
+
+        std::atomic<std::int64_t> chunk_size_;
+        std::atomic<std::int64_t> invocations_;
+        std::atomic<std::int64_t> explorations_;
+    };
+
+    /// Return the statistics record for the call site with the given name,
+    /// the record is created on first use.
+    HPX_EXPORT std::shared_ptr<adaptive_chunk_size_statistics>
+        get_adaptive_chunk_size_statistics(std::string const& name);
+
+    namespace detail
+    {
+        HPX_EXPORT naming::gid_type adaptive_chunk_size_counter_creator(
+            performance_counters::counter_info const& info, error_code& ec);
+
+        HPX_EXPORT bool adaptive_chunk_size_counter_discoverer(
+            performance_counters::counter_info const& info,
+            performance_counters::discover_counter_func const& f,
+            performance_counters::discover_counters_mode mode,
+            error_code& ec);
+    }
+}}
+
+#endif
@@ -0,0 +1,35 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_CONTINUATION_STATISTICS_HPP)
+#define HPX_UTIL_CONTINUATION_STATISTICS_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstdint>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The adaptive continuation executor records for each continuation
+    // whether it was run inline on the thread which made the predecessor
+    // ready or whether a new HPX thread was created for it. The counts are
+    // kept per worker thread to avoid contention on a shared cache line.
+
+    /// Return the number of continuations which were run inline
+    HPX_EXPORT std::int64_t get_inlined_continuation_count(bool reset);
+
+    /// Return the number of continuations for which a new HPX thread was
+    /// created as the recursion depth budget was exhausted
+    HPX_EXPORT std::int64_t get_spawned_continuation_count(bool reset);
+
+    namespace detail
+    {
+        HPX_EXPORT void count_inlined_continuation();
+        HPX_EXPORT void count_spawned_continuation();
+    }
+}}
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
+#include <hpx/util/slab_allocator.hpp>
 
 namespace hpx { namespace util { namespace detail
 {
@@ -22,7 +23,7 @@ namespace hpx { namespace util { namespace detail
             {
                 new (v) T(vtable::get<T>(src));
             } else {
-                *v = new T(vtable::get<T>(src));
+                *v = util::slab_new<T>(vtable::get<T>(src));
             }
         }
         void (*copy)(void**, void* const*);
@@ -9,6 +9,7 @@
 #define HPX_UTIL_DETAIL_VTABLE_VTABLE_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/util/slab_allocator.hpp>
 
 #include <cstddef>
 #include <memory>
@@ -75,7 +76,7 @@ namespace hpx { namespace util { namespace detail
             {
                 ::new (static_cast<void*>(v)) T; //-V206
             } else {
-                *v = new T;
+                *v = util::slab_new<T>();
             }
         }
 
@@ -86,7 +87,7 @@ namespace hpx { namespace util { namespace detail
             {
                 ::new (static_cast<void*>(v)) T(std::forward<Arg>(arg)); //-V206
             } else {
-                *v = new T(std::forward<Arg>(arg));
+                *v = util::slab_new<T>(std::forward<Arg>(arg));
             }
         }
 
@@ -118,7 +119,7 @@ namespace hpx { namespace util { namespace detail
             {
                 _destruct<T>(v);
             } else {
-                delete &get<T>(v);
+                util::slab_delete(&get<T>(v));
             }
         }
         void (*delete_)(void**);
@@ -11,7 +11,9 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/util/spinlock.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 
 #if defined(HPX_MSVC_WARNING_PRAGMA)
@@ -23,19 +25,30 @@ namespace hpx { namespace util
 {
     /// The unique_id_ranges class is a type responsible for generating
     /// unique ids for components, parcels, threads etc.
+    ///
+    /// Ids are handed out from the current block. A second block is
+    /// reserved in the background as soon as the current one has been
+    /// taken into use, so callers block only if the reserve has not been
+    /// refilled in time (or if a single request exceeds the reserved block).
+    /// The size of the reserved blocks grows geometrically up to
+    /// HPX_MAX_GID_RANGE.
     class HPX_EXPORT unique_id_ranges
     {
         typedef hpx::util::spinlock mutex_type;
 
         mutex_type mtx_;
 
-        /// size of the id range returned by command_getidrange
-        /// FIXME: is this a policy?
+        /// initial size of the id range returned by command_getidrange
         enum { range_delta = 0x100000 };
 
     public:
         unique_id_ranges()
           : mtx_(), lower_(0), upper_(0)
+          , reserve_lower_(0), reserve_upper_(0)
+          , next_block_size_(range_delta)
+          , refill_pending_(false), refill_failed_(false)
+          , block_size_(0), reserve_size_(0)
+          , refills_(0), stalls_(0)
         {}
 
         /// Generate next unique component id
@@ -48,12 +61,49 @@ namespace hpx { namespace util
             std::lock_guard<mutex_type> l(mtx_);
             lower_ = lower;
             upper_ = upper;
+
+            block_size_.store(
+                static_cast<std::int64_t>((upper - lower).get_lsb()),
+                std::memory_order_relaxed);
         }
 
+        /// Return the size of the block ids are currently allocated from
+        std::int64_t get_block_size(bool reset);
+
+        /// Return the size of the block reserved for future allocations
+        std::int64_t get_reserve_size(bool reset);
+
+        /// Return the number of blocks reserved from AGAS
+        std::int64_t get_refill_count(bool reset);
+
+        /// Return the number of times an id request had to wait for a new
+        /// block to be allocated from AGAS
+        std::int64_t get_stall_count(bool reset);
+
     private:
+        // allocate a new block from AGAS and store it as the reserve
+        void refill();
+        void schedule_refill(std::unique_lock<mutex_type>& l);
+
+        // take the reserved block into use, if possible
+        bool use_reserve(std::size_t count);
+
         /// The range of available ids for components
         naming::gid_type lower_;
         naming::gid_type upper_;
+
+        /// The range reserved for future allocations
+        naming::gid_type reserve_lower_;
+        naming::gid_type reserve_upper_;
+
+        std::size_t next_block_size_;
+        bool refill_pending_;
+        bool refill_failed_;    // last background refill has failed
+
+        std::atomic<std::int64_t> block_size_;
+        std::atomic<std::int64_t> reserve_size_;
+        std::atomic<std::int64_t> refills_;
+        std::atomic<std::int64_t> stalls_;
     };
 }}
 
@@ -62,5 +112,3 @@ namespace hpx { namespace util
 #endif
 
 #endif
-
-
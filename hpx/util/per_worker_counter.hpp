@@ -0,0 +1,114 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_PER_WORKER_COUNTER_HPP)
+#define HPX_UTIL_PER_WORKER_COUNTER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A counter which is split into one cache line aligned slot per core.
+    // Every worker thread modifies the slot assigned to it only, threads
+    // running on different cores never touch the same cache line. Threads not managed by
+    // HPX are mapped onto the slots based on their id.
+    //
+    // HPX threads may be migrated between worker threads, an increment and
+    // the matching decrement may therefore hit different slots. Only the sum
+    // over all slots is meaningful.
+    class per_worker_counter
+    {
+    private:
+        HPX_STATIC_CONSTEXPR std::size_t cache_line_size = 64;
+
+        struct alignas(cache_line_size) slot
+        {
+            slot()
+              : count_(0)
+            {}
+
+            std::atomic<std::int64_t> count_;
+        };
+
+        static_assert(sizeof(slot) == cache_line_size,
+            "every slot has to occupy exactly one cache line");
+
+    public:
+        HPX_NON_COPYABLE(per_worker_counter);
+
+    public:
+        // operator new[] does not guarantee the alignment of the slots,
+        // they are constructed in an over-allocated buffer instead
+        per_worker_counter()
+          : num_slots_((std::max)(
+                threads::hardware_concurrency(), std::size_t(1)))
+          , storage_(new char[(num_slots_ + 1) * sizeof(slot)])
+          , slots_(nullptr)
+        {
+            void* p = storage_.get();
+            std::size_t space = (num_slots_ + 1) * sizeof(slot);
+            p = std::align(alignof(slot), num_slots_ * sizeof(slot), p, space);
+            HPX_ASSERT(p != nullptr);
+
+            slots_ = static_cast<slot*>(p);
+            for (std::size_t i = 0; i != num_slots_; ++i)
+                new (&slots_[i]) slot();
+        }
+
+        ~per_worker_counter()
+        {
+            for (std::size_t i = 0; i != num_slots_; ++i)
+                slots_[i].~slot();
+        }
+
+        /// Return the slot assigned to the calling thread
+        std::atomic<std::int64_t>& local()
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread == std::size_t(-1))
+            {
+                num_thread =
+                    std::hash<std::thread::id>()(std::this_thread::get_id());
+            }
+            return slots_[num_thread % num_slots_].count_;
+        }
+
+        /// Return the sum over all slots, optionally resetting them to zero
+        std::int64_t sum(bool reset = false,
+            std::memory_order order = std::memory_order_relaxed) const
+        {
+            std::int64_t result = 0;
+            for (std::size_t i = 0; i != num_slots_; ++i)
+            {
+                std::atomic<std::int64_t>& value = slots_[i].count_;
+                if (reset)
+                    result += value.exchange(0, order);
+                else
+                    result += value.load(order);
+            }
+            return result;
+        }
+
+    private:
+        std::size_t const num_slots_;
+        std::unique_ptr<char[]> storage_;
+        slot* slots_;
+    };
+}}
+
+#endif
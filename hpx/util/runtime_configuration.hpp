@@ -79,6 +79,13 @@ namespace hpx { namespace util
 
         std::size_t get_agas_max_pending_refcnt_requests() const;
 
+        // Get the interval (in milliseconds) after which buffered reference
+        // counting requests are flushed
+        std::int64_t get_agas_refcnt_flush_interval() const;
+
+        // Get the maximal factor used for pre-fetching credits from AGAS
+        std::int64_t get_agas_max_credit_prefetch() const;
+
         // Load application specific configuration and merge it with the
         // default configuration loaded from hpx.ini
         bool load_application_configuration(char const* filename,
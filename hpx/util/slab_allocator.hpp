@@ -0,0 +1,102 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_SLAB_ALLOCATOR_HPP)
+#define HPX_UTIL_SLAB_ALLOCATOR_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The slab allocator manages small blocks of memory (up to
+    // HPX_SLAB_ALLOCATOR_MAX_SIZE bytes) in size classes. Each (kernel)
+    // thread owns a private heap of slabs from which it allocates without any
+    // synchronization. Blocks released by a thread other than the owner of
+    // the slab are pushed onto a (lock-free) remote-free list of the owning
+    // heap, which is drained by the owner once its current slab runs
+    // full. Slabs without any blocks in use are returned to the system.
+    // Heaps of exited threads are handed over to newly started threads.
+    //
+    // Larger requests are forwarded to the global operator new.
+
+    /// The alignment guaranteed for blocks returned by \a slab_allocate
+    HPX_STATIC_CONSTEXPR std::size_t slab_allocator_alignment = 16;
+
+    /// Allocate a block of memory of at least \a size bytes
+    HPX_EXPORT void* slab_allocate(std::size_t size);
+
+    /// Release a block of memory previously acquired from \a slab_allocate,
+    /// \a size has to be the same value as passed while allocating
+    HPX_EXPORT void slab_deallocate(void* p, std::size_t size) noexcept;
+
+    /// Return the number of slabs currently managed by the slab allocator
+    HPX_EXPORT std::int64_t get_slab_count(bool reset);
+
+    /// Return the number of bytes currently handed out by all slabs
+    HPX_EXPORT std::int64_t get_slab_allocated_bytes(bool reset);
+
+    /// Return the fraction of the slab memory currently handed out (in
+    /// 0.01%)
+    HPX_EXPORT std::int64_t get_slab_occupancy(bool reset);
+
+    /// Return the number of blocks which were released by a thread other
+    /// than the one owning the corresponding slab
+    HPX_EXPORT std::int64_t get_slab_remote_free_count(bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T>
+        struct use_slab_allocator
+        {
+#if defined(HPX_HAVE_SLAB_ALLOCATOR)
+            static bool const value =
+                alignof(T) <= slab_allocator_alignment &&
+                sizeof(T) <= HPX_SLAB_ALLOCATOR_MAX_SIZE;
+#else
+            static bool const value = false;
+#endif
+        };
+    }
+
+    /// Create a new object of type T using the slab allocator if possible
+    template <typename T, typename ...Ts>
+    T* slab_new(Ts&&... vs)
+    {
+        if (!detail::use_slab_allocator<T>::value)
+            return new T(std::forward<Ts>(vs)...);
+
+        void* p = slab_allocate(sizeof(T));
+        try {
+            return ::new (p) T(std::forward<Ts>(vs)...);
+        }
+        catch (...) {
+            slab_deallocate(p, sizeof(T));
+            throw;
+        }
+    }
+
+    /// Destroy an object which was created using \a slab_new
+    template <typename T>
+    void slab_delete(T* p) noexcept
+    {
+        if (!detail::use_slab_allocator<T>::value)
+        {
+            delete p;
+            return;
+        }
+
+        p->~T();
+        slab_deallocate(p, sizeof(T));
+    }
+}}
+
+#endif
@@ -7,12 +7,18 @@
 
 #include <hpx/compute/host/numa_domains.hpp>
 #include <hpx/compute/host/target.hpp>
+#include <hpx/exception.hpp>
 #include <hpx/runtime.hpp>
 #include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/resource/detail/partitioner.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 
+#if defined(HPX_HAVE_HWLOC)
+#include <hwloc.h>
+#endif
+
+#include <atomic>
 #include <cstddef>
 #include <vector>
 
@@ -62,4 +68,31 @@ namespace hpx { namespace compute { namespace host
 
         return res;
     }
+
+    std::size_t get_numa_domain(void const* addr)
+    {
+#if defined(HPX_HAVE_HWLOC) && HWLOC_API_VERSION >= 0x00010b03
+        // querying the location of pages is not supported everywhere (for
+        // instance if the corresponding system call is not permitted), stop
+        // asking after the first failure
+        static std::atomic<bool> supported(true);
+        if (!supported.load(std::memory_order_relaxed))
+            return std::size_t(-1);
+
+        hwloc_nodeset_t nodeset = hwloc_bitmap_alloc();
+        int domain = -1;
+        try {
+            domain = hpx::threads::get_topology().get_numa_domain(
+                addr, nodeset);
+        }
+        catch (hpx::exception const&) {
+            supported.store(false, std::memory_order_relaxed);
+        }
+        hwloc_bitmap_free(nodeset);
+
+        return domain < 0 ? std::size_t(-1) : std::size_t(domain);
+#else
+        return std::size_t(-1);
+#endif
+    }
 }}}
@@ -0,0 +1,107 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/buffered_send_channel.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/function.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    // The upper 32 bits hold the locality id of the sender, which makes the
+    // sender ids unique across all localities.
+    std::uint64_t get_buffered_sender_id()
+    {
+        static std::atomic<std::uint32_t> next_id(0);
+
+        return (std::uint64_t(hpx::get_locality_id()) << 32) |
+            next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    buffered_send_channel_statistics& get_buffered_send_channel_statistics()
+    {
+        static buffered_send_channel_statistics statistics;
+        return statistics;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t get_sent_count(bool reset)
+    {
+        return buffered_send_channel_statistics::get(
+            get_buffered_send_channel_statistics().sent_, reset);
+    }
+
+    std::int64_t get_batch_count(bool reset)
+    {
+        return buffered_send_channel_statistics::get(
+            get_buffered_send_channel_statistics().batches_, reset);
+    }
+
+    std::int64_t get_average_latency(bool reset)
+    {
+        buffered_send_channel_statistics& s =
+            get_buffered_send_channel_statistics();
+
+        std::int64_t count =
+            buffered_send_channel_statistics::get(s.granted_batches_, reset);
+        std::int64_t latency =
+            buffered_send_channel_statistics::get(s.latency_, reset);
+        return count != 0 ? latency / count : 0;
+    }
+
+    void register_buffered_send_channel_counter_types()
+    {
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        util::function_nonser<std::int64_t(bool)> sent(&get_sent_count);
+        util::function_nonser<std::int64_t(bool)> batches(&get_batch_count);
+        util::function_nonser<std::int64_t(bool)> latency(
+            &get_average_latency);
+
+        performance_counters::generic_counter_type_data counter_types[] =
+        {
+            { "/lcos/buffered_send_channel/count/sent",
+              performance_counters::counter_raw,
+              "returns the number of values sent by all buffered senders "
+              "on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, sent, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/lcos/buffered_send_channel/count/batches",
+              performance_counters::counter_raw,
+              "returns the number of batches (parcels) sent by all buffered "
+              "senders on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, batches, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/lcos/buffered_send_channel/time/average-latency",
+              performance_counters::counter_raw,
+              "returns the average time between sending a batch and the "
+              "credits for it being granted back for all buffered senders "
+              "on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, latency, _2),
+              &performance_counters::locality_counter_discoverer,
+              "ns"
+            }
+        };
+        performance_counters::install_counter_types(
+            counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+    }
+}}}
@@ -0,0 +1,153 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/state.hpp>
+#include <hpx/lcos/communicator.hpp>
+#include <hpx/lcos/detail/communicator_node.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/components/server/component.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx
+{
+    bool is_stopped_or_shutting_down();
+}
+
+namespace hpx { namespace lcos
+{
+    communicator::communicator(std::string const& base_name)
+      : id_(hpx::local_new<node_type>(base_name,
+            hpx::get_num_localities(hpx::launch::sync),
+            hpx::get_locality_id()).get())
+      , node_(hpx::get_ptr<node_type>(hpx::launch::sync, id_))
+    {
+        connect();
+    }
+
+    communicator::communicator(std::string const& base_name,
+            std::size_t num, std::size_t rank)
+      : id_(hpx::local_new<node_type>(base_name, num, rank).get())
+      , node_(hpx::get_ptr<node_type>(hpx::launch::sync, id_))
+    {
+        connect();
+    }
+
+    communicator::communicator(communicator&& other)
+      : id_(std::move(other.id_))
+      , node_(std::move(other.node_))
+    {
+        other.id_ = naming::invalid_id;
+        other.node_.reset();
+    }
+
+    communicator& communicator::operator=(communicator&& other)
+    {
+        release();
+
+        id_ = std::move(other.id_);
+        node_ = std::move(other.node_);
+        other.id_ = naming::invalid_id;
+        other.node_.reset();
+
+        return *this;
+    }
+
+    communicator::~communicator()
+    {
+        release();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Look up all peers once, resolving their addresses makes sure the
+    // parcels sent later on don't require any AGAS round trips.
+    void communicator::connect()
+    {
+        register_with_basename(node_->base_name_, id_, node_->rank_).get();
+
+        std::vector<std::size_t> ranks =
+            node_type::get_peers(node_->num_, node_->rank_);
+
+        std::vector<hpx::future<naming::id_type> > id_futures =
+            find_from_basename(node_->base_name_, ranks);
+
+        std::vector<naming::id_type> ids;
+        ids.reserve(id_futures.size());
+        for (hpx::future<naming::id_type>& f : id_futures)
+            ids.push_back(f.get());
+
+        std::vector<hpx::future<naming::address> > addresses;
+        addresses.reserve(ids.size());
+        for (naming::id_type const& id : ids)
+            addresses.push_back(agas::resolve(id));
+        hpx::wait_all(addresses);
+
+        node_->connect(ranks, std::move(ids));
+    }
+
+    void communicator::release()
+    {
+        if (node_)
+        {
+            if (hpx::get_runtime_ptr() != nullptr &&
+                hpx::threads::threadmanager_is(state_running) &&
+                !hpx::is_stopped_or_shutting_down())
+            {
+                // make sure no participant is still using the name before
+                // giving it up
+                barrier();
+                hpx::unregister_with_basename(
+                    node_->base_name_, node_->rank_).get();
+            }
+            node_.reset();
+            id_ = naming::invalid_id;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t communicator::size() const
+    {
+        HPX_ASSERT(node_);
+        return node_->num_;
+    }
+
+    std::size_t communicator::rank() const
+    {
+        HPX_ASSERT(node_);
+        return node_->rank_;
+    }
+
+    void communicator::barrier()
+    {
+        node_->barrier(node_->next_generation());
+    }
+
+    hpx::future<void> communicator::barrier(hpx::launch::async_policy)
+    {
+        std::shared_ptr<node_type> node = node_;
+        std::uint64_t generation = node_->next_generation();
+
+        return hpx::async(
+            [node, generation]()
+            {
+                node->barrier(generation);
+            });
+    }
+}}
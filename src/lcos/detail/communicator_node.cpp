@@ -0,0 +1,131 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/lcos/detail/communicator_node.hpp>
+#include <hpx/runtime/components/component_factory.hpp>
+#include <hpx/runtime/components/server/component.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef hpx::components::component<hpx::lcos::detail::communicator_node>
+    communicator_node_type;
+
+HPX_REGISTER_COMPONENT(communicator_node_type, hpx_lcos_communicator_node)
+
+HPX_REGISTER_ACTION(hpx::lcos::detail::communicator_node::set_data_action,
+    communicator_node_set_data_action);
+
+namespace hpx { namespace lcos { namespace detail
+{
+    communicator_node::communicator_node()
+      : num_(0), rank_(0), generation_(0)
+    {
+        HPX_ASSERT(false);
+    }
+
+    communicator_node::communicator_node(std::string const& base_name,
+            std::size_t num, std::size_t rank)
+      : base_name_(base_name), num_(num), rank_(rank), generation_(0)
+    {
+        HPX_ASSERT(rank_ < num_);
+    }
+
+    communicator_node::~communicator_node()
+    {
+        HPX_ASSERT(buffer_.empty());
+    }
+
+    std::vector<std::size_t> communicator_node::get_peers(
+        std::size_t num, std::size_t rank)
+    {
+        std::set<std::size_t> peers;
+
+        // dissemination (barrier) and Bruck (all_gather) partners
+        for (std::size_t dist = 1; dist < num; dist *= 2)
+        {
+            peers.insert((rank + dist) % num);
+            peers.insert((rank + num - dist) % num);
+        }
+
+        // recursive doubling (all_reduce) partners
+        std::size_t pof2 = 1;
+        while (2 * pof2 <= num)
+            pof2 *= 2;
+
+        std::size_t const rem = num - pof2;
+        if (rank < 2 * rem)
+        {
+            peers.insert(rank % 2 == 0 ? rank + 1 : rank - 1);
+        }
+
+        if (rank >= 2 * rem || rank % 2 != 0)
+        {
+            std::size_t const new_rank =
+                rank < 2 * rem ? rank / 2 : rank - rem;
+
+            for (std::size_t mask = 1; mask < pof2; mask *= 2)
+            {
+                std::size_t const new_peer = new_rank ^ mask;
+                peers.insert(
+                    new_peer < rem ? 2 * new_peer + 1 : new_peer + rem);
+            }
+        }
+
+        peers.erase(rank);
+        return std::vector<std::size_t>(peers.begin(), peers.end());
+    }
+
+    void communicator_node::connect(std::vector<std::size_t> const& ranks,
+        std::vector<naming::id_type> && ids)
+    {
+        HPX_ASSERT(ranks.size() == ids.size());
+        for (std::size_t i = 0; i != ranks.size(); ++i)
+            peers_[ranks[i]] = std::move(ids[i]);
+    }
+
+    void communicator_node::set_data(std::uint64_t tag, buffer_type && data)
+    {
+        buffer_.store_received(tag, std::move(data));
+    }
+
+    void communicator_node::send(
+        std::size_t rank, std::uint64_t tag, buffer_type && data)
+    {
+        std::map<std::size_t, naming::id_type>::const_iterator it =
+            peers_.find(rank);
+        HPX_ASSERT(it != peers_.end());
+
+        hpx::apply(set_data_action(), it->second, tag, std::move(data));
+    }
+
+    hpx::future<communicator_node::buffer_type>
+    communicator_node::receive(std::uint64_t tag)
+    {
+        return buffer_.receive(tag);
+    }
+
+    // dissemination barrier: in step k every participant notifies the one
+    // 2^k ranks ahead of it and waits for the one 2^k ranks behind it
+    void communicator_node::barrier(std::uint64_t generation)
+    {
+        std::size_t step = 0;
+        for (std::size_t dist = 1; dist < num_; dist *= 2, ++step)
+        {
+            std::uint64_t const tag = get_tag(generation, step);
+
+            send((rank_ + dist) % num_, tag, buffer_type());
+            receive(tag).get();
+        }
+    }
+}}}
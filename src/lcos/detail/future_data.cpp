@@ -66,7 +66,9 @@ namespace hpx { namespace lcos { namespace detail
     ///////////////////////////////////////////////////////////////////////////
     future_data_base<traits::detail::future_data_void>::
         ~future_data_base()
-    {}
+    {
+        release_callbacks(get_callbacks(state_.load(std::memory_order_relaxed)));
+    }
 
     util::unused_type* future_data_base<traits::detail::future_data_void>::
         get_result_void(void const* storage, error_code& ec)
@@ -82,7 +84,8 @@ namespace hpx { namespace lcos { namespace detail
         // - there are multiple readers only (shared_future, lock hurts
         //   concurrency)
 
-        if (state_ == empty) {
+        state_word s = state_.load(std::memory_order_acquire) & state_mask;
+        if (s == state_empty) {
             // the value has already been moved out of this future
             HPX_THROWS_IF(ec, no_state,
                 "future_data_base::get_result",
@@ -93,7 +96,7 @@ namespace hpx { namespace lcos { namespace detail
         // the thread has been re-activated by one of the actions
         // supported by this promise (see promise::set_event
         // and promise::set_exception).
-        if (state_ == exception)
+        if (s == state_exception)
         {
             std::exception_ptr const* exception_ptr =
                 static_cast<std::exception_ptr const*>(storage);
@@ -138,7 +141,7 @@ namespace hpx { namespace lcos { namespace detail
         // non HPX thread.
         bool recurse_asynchronously = hpx::threads::get_self_ptr() == nullptr;
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-        recurse_asynchronously =
+        recurse_asynchronously = recurse_asynchronously ||
             !this_thread::has_sufficient_stack_space();
 #else
         handle_continuation_recursion_count cnt;
@@ -182,6 +185,109 @@ namespace hpx { namespace lcos { namespace detail
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    bool future_data_base<traits::detail::future_data_void>::
+        start_setting_state()
+    {
+        state_word s = state_.load(std::memory_order_relaxed);
+        do {
+            if ((s & state_mask) != state_empty)
+                return false;
+        } while (!state_.compare_exchange_weak(s, s | state_setting,
+                    std::memory_order_acquire, std::memory_order_relaxed));
+        return true;
+    }
+
+    void future_data_base<traits::detail::future_data_void>::
+        abort_setting_state()
+    {
+        state_.fetch_and(~state_mask, std::memory_order_release);
+    }
+
+    void future_data_base<traits::detail::future_data_void>::
+        finish_setting_state(state_word new_state, error_code& ec)
+    {
+        // publish the new state and detach the list of continuations
+        state_word s = state_.exchange(new_state, std::memory_order_acq_rel);
+        HPX_ASSERT((s & state_mask) == state_setting);
+
+        // handle all threads waiting for the future to become ready
+        if (s & has_waiters)
+        {
+            // Note: we use notify_one repeatedly instead of notify_all as we
+            //       know: a) that most of the time we have at most one thread
+            //       waiting on the future (most futures are not shared), and
+            //       b) our implementation of condition_variable::notify_one
+            //       relinquishes the lock before resuming the waiting thread
+            //       which avoids suspension of this thread when it tries to
+            //       re-lock the mutex while exiting from condition_variable::wait
+            std::unique_lock<mutex_type> l(mtx_);
+            while (cond_.notify_one(
+                std::move(l), threads::thread_priority_boost, ec))
+            {
+                l = std::unique_lock<mutex_type>(mtx_);
+            }
+
+            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
+            //       it unlocked when returning.
+        }
+
+        // the continuations were pushed in front of the list, reverse it to
+        // invoke them in the order they were attached
+        completed_callback_node* head = nullptr;
+        for (completed_callback_node* p = get_callbacks(s); p != nullptr; /**/)
+        {
+            completed_callback_node* next = p->next_;
+            p->next_ = head;
+            head = p;
+            p = next;
+        }
+
+        // invoke the callback (continuation) functions
+        while (head != nullptr)
+        {
+            completed_callback_node* next = head->next_;
+            completed_callback_type on_completed = std::move(head->f_);
+
+            release_callback_node(head);
+            head = next;
+
+            try {
+                handle_on_completed(std::move(on_completed));
+            }
+            catch (...) {
+                release_callbacks(head);
+                throw;
+            }
+        }
+    }
+
+    void future_data_base<traits::detail::future_data_void>::
+        release_callbacks(completed_callback_node* head)
+    {
+        while (head != nullptr)
+        {
+            completed_callback_node* next = head->next_;
+
+            // the continuation may keep alive the owner of an external list
+            // element, make sure to destroy it only after the element is
+            // not referenced anymore
+            completed_callback_type f = std::move(head->f_);
+            release_callback_node(head);
+
+            head = next;
+        }
+    }
+
+    void future_data_base<traits::detail::future_data_void>::
+        release_callback_node(completed_callback_node* node)
+    {
+        if (node == &first_callback_)
+            first_callback_used_.store(false, std::memory_order_release);
+        else if (!node->external_)
+            delete node;
+    }
+
     /// Set the callback which needs to be invoked when the future becomes
     /// ready. If the future is ready the function will be invoked
     /// immediately.
@@ -190,35 +296,89 @@ namespace hpx { namespace lcos { namespace detail
     {
         if (!data_sink) return;
 
-        std::unique_lock<mutex_type> l(mtx_);
+        state_word s = state_.load(std::memory_order_acquire);
+        if (is_ready_state(s))
+        {
+            // invoke the callback (continuation) function right away
+            handle_on_completed(std::move(data_sink));
+            return;
+        }
 
-        if (is_ready_locked(l)) {
+        // use the embedded list element if it is still available
+        completed_callback_node* node = nullptr;
+        if (!first_callback_used_.exchange(true, std::memory_order_acquire))
+        {
+            node = &first_callback_;
+            node->f_ = std::move(data_sink);
+        }
+        else
+        {
+            node = new completed_callback_node(std::move(data_sink));
+        }
 
-            HPX_ASSERT(!on_completed_);
+        push_callback(node, s);
+    }
 
-            // invoke the callback (continuation) function right away
-            l.unlock();
+    void future_data_base<traits::detail::future_data_void>::
+        attach_on_completed(completed_callback_node& node)
+    {
+        HPX_ASSERT(node.external_ && node.f_);
 
-            handle_on_completed(std::move(data_sink));
-        }
-        else {
-            // store a combined callback wrapping the old and the new one
-            // make sure continuations are evaluated in the order they are
-            // attached
-            on_completed_ = compose_cb(
-                std::move(on_completed_), std::move(data_sink));
+        state_word s = state_.load(std::memory_order_acquire);
+        if (is_ready_state(s))
+        {
+            // invoke the callback (continuation) function right away
+            completed_callback_type on_completed = std::move(node.f_);
+            handle_on_completed(std::move(on_completed));
+            return;
         }
+
+        push_callback(&node, s);
     }
 
     void future_data_base<traits::detail::future_data_void>::
-        wait(error_code& ec)
+        push_callback(completed_callback_node* node, state_word s)
     {
-        std::unique_lock<mutex_type> l(mtx_);
+        // push the continuation onto the list, unless the shared state has
+        // become ready in the meantime
+        do {
+            if (is_ready_state(s))
+            {
+                completed_callback_type on_completed = std::move(node->f_);
+                release_callback_node(node);
+
+                // invoke the callback (continuation) function right away
+                handle_on_completed(std::move(on_completed));
+                return;
+            }
+
+            node->next_ = get_callbacks(s);
 
+        } while (!state_.compare_exchange_weak(s,
+                    (s & ~callback_mask) |
+                        reinterpret_cast<state_word>(node),
+                    std::memory_order_acq_rel, std::memory_order_acquire));
+    }
+
+    void future_data_base<traits::detail::future_data_void>::
+        wait(error_code& ec)
+    {
         // block if this entry is empty
-        if (state_ == empty) {
-            cond_.wait(l, "future_data_base::wait", ec);
-            if (ec) return;
+        if (!is_ready())
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // announce that a thread is about to wait, the thread setting the
+            // shared state will acquire the lock before notifying waiters
+            state_word s = state_.fetch_or(has_waiters,
+                std::memory_order_acq_rel);
+            while (!is_ready_state(s))
+            {
+                cond_.wait(l, "future_data_base::wait", ec);
+                if (ec) return;
+
+                s = state_.load(std::memory_order_acquire);
+            }
         }
 
         if (&ec != &throws)
@@ -228,19 +388,27 @@ namespace hpx { namespace lcos { namespace detail
     future_status future_data_base<traits::detail::future_data_void>::
         wait_until(util::steady_clock::time_point const& abs_time, error_code& ec)
     {
-        std::unique_lock<mutex_type> l(mtx_);
-
         // block if this entry is empty
-        if (state_ == empty) {
-            threads::thread_state_ex_enum const reason =
-                cond_.wait_until(l, abs_time,
-                    "future_data_base::wait_until", ec);
-            if (ec) return future_status::uninitialized;
+        if (!is_ready())
+        {
+            std::unique_lock<mutex_type> l(mtx_);
 
-            if (reason == threads::wait_timeout)
-                return future_status::timeout;
+            // announce that a thread is about to wait, the thread setting the
+            // shared state will acquire the lock before notifying waiters
+            state_word s = state_.fetch_or(has_waiters,
+                std::memory_order_acq_rel);
+            if (!is_ready_state(s))
+            {
+                threads::thread_state_ex_enum const reason =
+                    cond_.wait_until(l, abs_time,
+                        "future_data_base::wait_until", ec);
+                if (ec) return future_status::uninitialized;
 
-            return future_status::ready;
+                if (reason == threads::wait_timeout)
+                    return future_status::timeout;
+
+                return future_status::ready;
+            }
         }
 
         if (&ec != &throws)
@@ -16,14 +16,34 @@
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/steady_clock.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <utility>
 
 namespace hpx { namespace lcos { namespace local
 {
+    namespace
+    {
+        // the values of the state word
+        enum : std::uint32_t
+        {
+            unlocked = 0,
+            locked = 1,
+            contended = 2       // locked, other threads might be suspended
+        };
+
+        HPX_CONSTEXPR_OR_CONST std::int32_t max_spin_count = 100;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
-    mutex::mutex(char const* const description)
-      : owner_id_(threads::invalid_thread_id_repr)
+    mutex::mutex(char const* const description, mutex_policy policy)
+      : state_(unlocked)
+      , owner_id_(threads::invalid_thread_id_repr)
+      , spin_count_(0)
+      , policy_(policy)
+      , handoff_(false)
     {
         HPX_ITT_SYNC_CREATE(this, "lcos::local::mutex", description);
         HPX_ITT_SYNC_RENAME(this, "lcos::local::mutex");
@@ -34,15 +54,91 @@ namespace hpx { namespace lcos { namespace local
         HPX_ITT_SYNC_DESTROY(this);
     }
 
+    bool mutex::try_lock_state()
+    {
+        std::uint32_t expected = unlocked;
+        return state_.compare_exchange_strong(
+            expected, locked, std::memory_order_acquire);
+    }
+
+    // Spin for a bounded number of iterations. The bound follows the number
+    // of iterations it took to acquire the mutex recently, this way threads
+    // don't spin if the mutex tends to be held for a long time.
+    bool mutex::try_lock_spin()
+    {
+        std::int32_t const count = spin_count_.load(std::memory_order_relaxed);
+        std::int32_t const limit = (std::min)(max_spin_count, 2 * count + 10);
+
+        bool acquired = false;
+        std::int32_t k = 0;
+        for (/**/; k != limit; ++k)
+        {
+            std::uint32_t s = state_.load(std::memory_order_relaxed);
+            if (s == unlocked)
+            {
+                if (state_.compare_exchange_weak(
+                        s, locked, std::memory_order_acquire))
+                {
+                    acquired = true;
+                    break;
+                }
+            }
+            else if (s == contended && policy_ == mutex_policy::fair)
+            {
+                // the mutex will be handed over to a suspended thread
+                break;
+            }
+
+#if defined(BOOST_SMT_PAUSE)
+            BOOST_SMT_PAUSE
+#endif
+        }
+
+        spin_count_.store(count + (k - count) / 8, std::memory_order_relaxed);
+        return acquired;
+    }
+
+    // Suspend the calling thread until it either acquired the mutex or the
+    // mutex was handed over to it.
+    bool mutex::wait_for_lock(util::steady_time_point const* abs_time,
+        error_code& ec)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        // exchange() returning 'unlocked' means that we own the mutex now,
+        // otherwise the releasing thread will see that it has to wake us up
+        while (state_.exchange(contended, std::memory_order_acquire) !=
+            unlocked)
+        {
+            threads::thread_state_ex_enum reason = threads::wait_signaled;
+            if (abs_time != nullptr)
+                reason = cond_.wait_until(l, *abs_time, ec);
+            else
+                reason = cond_.wait(l, ec);
+
+            if (ec) return false;
+
+            if (handoff_)
+            {
+                handoff_ = false;
+                return true;
+            }
+
+            if (reason == threads::wait_timeout) //-V110
+                return false;
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
     void mutex::lock(char const* description, error_code& ec)
     {
         HPX_ASSERT(threads::get_self_ptr() != nullptr);
 
         HPX_ITT_SYNC_PREPARE(this);
-        std::unique_lock<mutex_type> l(mtx_);
 
         threads::thread_id_repr_type self_id = threads::get_self_id().get();
-        if(owner_id_ == self_id)
+        if (owner_id_.load(std::memory_order_relaxed) == self_id)
         {
             HPX_ITT_SYNC_CANCEL(this);
             HPX_THROWS_IF(ec, deadlock,
@@ -51,15 +147,16 @@ namespace hpx { namespace lcos { namespace local
             return;
         }
 
-        while (owner_id_ != threads::invalid_thread_id_repr)
+        if (!try_lock_state() && !try_lock_spin() &&
+            !wait_for_lock(nullptr, ec))
         {
-            cond_.wait(l, ec);
-            if (ec) { HPX_ITT_SYNC_CANCEL(this); return; }
+            HPX_ITT_SYNC_CANCEL(this);
+            return;
         }
 
         util::register_lock(this);
         HPX_ITT_SYNC_ACQUIRED(this);
-        owner_id_ = self_id;
+        owner_id_.store(self_id, std::memory_order_relaxed);
     }
 
     bool mutex::try_lock(char const* description, error_code& ec)
@@ -67,9 +164,8 @@ namespace hpx { namespace lcos { namespace local
         HPX_ASSERT(threads::get_self_ptr() != nullptr);
 
         HPX_ITT_SYNC_PREPARE(this);
-        std::unique_lock<mutex_type> l(mtx_);
 
-        if (owner_id_ != threads::invalid_thread_id_repr)
+        if (!try_lock_state())
         {
             HPX_ITT_SYNC_CANCEL(this);
             return false;
@@ -78,7 +174,7 @@ namespace hpx { namespace lcos { namespace local
         threads::thread_id_repr_type self_id = threads::get_self_id().get();
         util::register_lock(this);
         HPX_ITT_SYNC_ACQUIRED(this);
-        owner_id_ = self_id;
+        owner_id_.store(self_id, std::memory_order_relaxed);
         return true;
     }
 
@@ -87,10 +183,9 @@ namespace hpx { namespace lcos { namespace local
         HPX_ASSERT(threads::get_self_ptr() != nullptr);
 
         HPX_ITT_SYNC_RELEASING(this);
-        std::unique_lock<mutex_type> l(mtx_);
 
         threads::thread_id_repr_type self_id = threads::get_self_id().get();
-        if (HPX_UNLIKELY(owner_id_ != self_id))
+        if (HPX_UNLIKELY(owner_id_.load(std::memory_order_relaxed) != self_id))
         {
             util::unregister_lock(this);
             HPX_THROWS_IF(ec, lock_error,
@@ -101,14 +196,46 @@ namespace hpx { namespace lcos { namespace local
 
         util::unregister_lock(this);
         HPX_ITT_SYNC_RELEASED(this);
-        owner_id_ = threads::invalid_thread_id_repr;
+        owner_id_.store(threads::invalid_thread_id_repr,
+            std::memory_order_relaxed);
 
+        if (policy_ == mutex_policy::throughput)
+        {
+            // the mutex is released right away, the resumed thread has to
+            // compete with all others
+            if (state_.exchange(unlocked, std::memory_order_release) ==
+                contended)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                cond_.notify_one(
+                    std::move(l), threads::thread_priority_boost, ec);
+            }
+            return;
+        }
+
+        std::uint32_t expected = locked;
+        if (state_.compare_exchange_strong(
+                expected, unlocked, std::memory_order_release))
+        {
+            return;     // no thread is suspended
+        }
+
+        std::unique_lock<mutex_type> l(mtx_);
+        if (cond_.empty(l))
+        {
+            state_.store(unlocked, std::memory_order_release);
+            return;
+        }
+
+        // the mutex stays locked and is handed over to the resumed thread
+        handoff_ = true;
         cond_.notify_one(std::move(l), threads::thread_priority_boost, ec);
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    timed_mutex::timed_mutex(char const* const description)
-      : mutex(description)
+    timed_mutex::timed_mutex(char const* const description,
+            mutex_policy policy)
+      : mutex(description, policy)
     {}
 
     timed_mutex::~timed_mutex()
@@ -120,31 +247,18 @@ namespace hpx { namespace lcos { namespace local
         HPX_ASSERT(threads::get_self_ptr() != nullptr);
 
         HPX_ITT_SYNC_PREPARE(this);
-        std::unique_lock<mutex_type> l(mtx_);
 
         threads::thread_id_repr_type self_id = threads::get_self_id().get();
-        if (owner_id_ != threads::invalid_thread_id_repr)
+        if (!try_lock_state() && !try_lock_spin() &&
+            !wait_for_lock(&abs_time, ec))
         {
-            threads::thread_state_ex_enum const reason =
-                cond_.wait_until(l, abs_time, ec);
-            if (ec) { HPX_ITT_SYNC_CANCEL(this); return false; }
-
-            if (reason == threads::wait_timeout) //-V110
-            {
-                HPX_ITT_SYNC_CANCEL(this);
-                return false;
-            }
-
-            if (owner_id_ != threads::invalid_thread_id_repr) //-V110
-            {
-                HPX_ITT_SYNC_CANCEL(this);
-                return false;
-            }
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
         }
 
         util::register_lock(this);
         HPX_ITT_SYNC_ACQUIRED(this);
-        owner_id_ = self_id;
+        owner_id_.store(self_id, std::memory_order_relaxed);
         return true;
     }
 }}}
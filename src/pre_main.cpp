@@ -11,6 +11,7 @@
 #include <hpx/error_code.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/buffered_send_channel.hpp>
 #include <hpx/lcos/detail/barrier_node.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/applier/applier.hpp>
@@ -63,6 +64,10 @@ static void register_counter_types()
     applier::get_applier().get_parcel_handler().register_counter_types();
     lbt_ << "(2nd stage) pre_main: registered parcelset performance "
             "counter types";
+
+    lcos::detail::register_buffered_send_channel_counter_types();
+    lbt_ << "(2nd stage) pre_main: registered buffered channel sender "
+            "performance counter types";
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -24,13 +24,18 @@
 #include <hpx/runtime/threads/policies/topology.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/state.hpp>
+#include <hpx/util/adaptive_chunk_size_statistics.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/backtrace.hpp>
+#include <hpx/util/bind.hpp>
 #include <hpx/util/command_line_handling.hpp>
+#include <hpx/util/continuation_statistics.hpp>
 #include <hpx/util/debugging.hpp>
+#include <hpx/util/function.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/query_counters.hpp>
+#include <hpx/util/slab_allocator.hpp>
 #include <hpx/util/static_reinit.hpp>
 #include <hpx/util/thread_mapper.hpp>
 #include <hpx/version.hpp>
@@ -643,6 +648,139 @@ namespace hpx
         performance_counters::install_counter_types(
             arithmetic_counter_types,
             sizeof(arithmetic_counter_types)/sizeof(arithmetic_counter_types[0]));
+
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        util::function_nonser<std::int64_t(bool)> slab_count(
+            &util::get_slab_count);
+        util::function_nonser<std::int64_t(bool)> slab_allocated_bytes(
+            &util::get_slab_allocated_bytes);
+        util::function_nonser<std::int64_t(bool)> slab_occupancy(
+            &util::get_slab_occupancy);
+        util::function_nonser<std::int64_t(bool)> slab_remote_frees(
+            &util::get_slab_remote_free_count);
+
+        performance_counters::generic_counter_type_data slab_counter_types[] =
+        {
+            { "/runtime/slab_allocator/count/slabs",
+              performance_counters::counter_raw,
+              "returns the number of slabs currently managed by the slab "
+              "allocator on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, slab_count, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/runtime/slab_allocator/allocated",
+              performance_counters::counter_raw,
+              "returns the number of bytes currently handed out by the slab "
+              "allocator on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, slab_allocated_bytes, _2),
+              &performance_counters::locality_counter_discoverer,
+              "bytes"
+            },
+            { "/runtime/slab_allocator/occupancy",
+              performance_counters::counter_raw,
+              "returns the fraction of the memory managed by the slab "
+              "allocator on this locality which is currently handed out",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, slab_occupancy, _2),
+              &performance_counters::locality_counter_discoverer,
+              "0.01%"
+            },
+            { "/runtime/slab_allocator/count/remote-frees",
+              performance_counters::counter_raw,
+              "returns the number of blocks released by a thread other than "
+              "the one owning the corresponding slab on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, slab_remote_frees, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(
+            slab_counter_types,
+            sizeof(slab_counter_types)/sizeof(slab_counter_types[0]));
+
+        util::function_nonser<std::int64_t(bool)> continuations_inlined(
+            &util::get_inlined_continuation_count);
+        util::function_nonser<std::int64_t(bool)> continuations_spawned(
+            &util::get_spawned_continuation_count);
+
+        performance_counters::generic_counter_type_data
+            continuation_counter_types[] =
+        {
+            { "/runtime/count/continuations-inlined",
+              performance_counters::counter_raw,
+              "returns the number of continuations which were run inline by "
+              "the adaptive continuation executor on this locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, continuations_inlined, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/runtime/count/continuations-spawned",
+              performance_counters::counter_raw,
+              "returns the number of continuations for which the adaptive "
+              "continuation executor on this locality created a new thread "
+              "as the recursion depth budget was exhausted",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, continuations_spawned, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(
+            continuation_counter_types,
+            sizeof(continuation_counter_types) /
+                sizeof(continuation_counter_types[0]));
+
+        performance_counters::generic_counter_type_data
+            adaptive_chunk_size_counter_types[] =
+        {
+            { "/parallel/adaptive-chunk-size/chunk-size",
+              performance_counters::counter_raw,
+              "returns the chunk size the adaptive_chunk_size executor "
+              "parameters currently consider best for the call site given "
+              "as the counter parameter",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &util::detail::adaptive_chunk_size_counter_creator,
+              &util::detail::adaptive_chunk_size_counter_discoverer,
+              ""
+            },
+            { "/parallel/adaptive-chunk-size/invocations",
+              performance_counters::counter_raw,
+              "returns the number of invocations of the call site given as "
+              "the counter parameter which used adaptive_chunk_size "
+              "executor parameters",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &util::detail::adaptive_chunk_size_counter_creator,
+              &util::detail::adaptive_chunk_size_counter_discoverer,
+              ""
+            },
+            { "/parallel/adaptive-chunk-size/explorations",
+              performance_counters::counter_raw,
+              "returns the number of invocations of the call site given as "
+              "the counter parameter which measured a chunk size other than "
+              "the one currently considered best",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &util::detail::adaptive_chunk_size_counter_creator,
+              &util::detail::adaptive_chunk_size_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(
+            adaptive_chunk_size_counter_types,
+            sizeof(adaptive_chunk_size_counter_types) /
+                sizeof(adaptive_chunk_size_counter_types[0]));
     }
 
     std::uint32_t runtime::assign_cores(std::string const& locality_basename,
@@ -34,6 +34,7 @@
 #include <hpx/util/bind.hpp>
 #include <hpx/util/bind_back.hpp>
 #include <hpx/util/format.hpp>
+#include <hpx/util/generate_unique_ids.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
@@ -136,6 +137,13 @@ addressing_service::addressing_service(
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
   , refcnt_requests_(new refcnt_requests_type)
+  , max_credit_prefetch_(ini_.get_agas_max_credit_prefetch())
+  , refcnt_flush_interval_(ini_.get_agas_refcnt_flush_interval())
+  , refcnt_flush_timer_(
+        util::bind(&addressing_service::flush_refcnt_requests, this),
+        refcnt_flush_interval_ * 1000,
+        "addressing_service::flush_refcnt_requests", true)
+  , refcnt_flush_timer_armed_(false)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
   , caching_(ini_.get_agas_caching_mode())
@@ -148,8 +156,13 @@ addressing_service::addressing_service(
 { // {{{
     LPROGRESS_;
 
+    std::size_t cache_size = 1;
     if (caching_)
-        gva_cache_->reserve(ini_.get_agas_local_cache_size());
+    {
+        cache_size = ini_.get_agas_local_cache_size();
+        gva_cache_->reserve(cache_size);
+    }
+    gva_hit_cache_.reset(new detail::gva_hit_cache(cache_size));
 
 #if defined(HPX_HAVE_NETWORKING)
     std::shared_ptr<parcelset::parcelport> pp = ph.get_bootstrap_parcelport();
@@ -1567,9 +1580,19 @@ void addressing_service::decref(
         return;
     }
 
+    bool start_timer = false;
+
     try {
         std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
 
+        // Give back any credit reserved for this gid as well
+        credit_reserve_type::iterator reserved = credit_reserve_.find(raw);
+        if (reserved != credit_reserve_.end())
+        {
+            credit += reserved->second.credits_;
+            credit_reserve_.erase(reserved);
+        }
+
         // Match the decref request with entries in the incref table
         typedef refcnt_requests_type::iterator iterator;
         typedef refcnt_requests_type::value_type mapping;
@@ -1596,13 +1619,120 @@ void addressing_service::decref(
             }
         }
 
+        // make sure the buffered request is sent eventually
+        start_timer = arm_refcnt_flush_timer_locked();
+
         send_refcnt_requests(l, ec);
     }
     catch (hpx::exception const& e) {
+        if (start_timer)
+            refcnt_flush_timer_.start(false);
         HPX_RETHROWS_IF(ec, e, "addressing_service::decref");
+        return;
+    }
+
+    if (start_timer)
+        refcnt_flush_timer_.start(false);
+} // }}}
+
+///////////////////////////////////////////////////////////////////////////////
+lcos::future<std::int64_t> addressing_service::borrow_credit_async(
+    naming::gid_type const& gid
+  , std::int64_t credit
+    )
+{ // {{{ borrow_credit implementation
+    naming::gid_type raw(naming::detail::get_stripped_gid(gid));
+
+    std::int64_t requested_credit = credit;
+    bool start_timer = false;
+
+    {
+        std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
+
+        if (enable_refcnt_caching_ && max_credit_prefetch_ > 1)
+        {
+            credit_reserve_type::iterator it = credit_reserve_.find(raw);
+            if (it == credit_reserve_.end())
+            {
+                // The credit of this gid is exhausted for the first time,
+                // remember it but don't pre-fetch any credit yet.
+                credit_reserve_.insert(
+                    credit_reserve_type::value_type(
+                        raw, credit_reserve_entry()));
+
+                // the timer keeps running while reserves exist, it releases
+                // the unused ones
+                start_timer = arm_refcnt_flush_timer_locked();
+            }
+            else
+            {
+                credit_reserve_entry& e = it->second;
+                e.used_ = true;
+
+                // satisfy the request locally, if possible
+                if (e.credits_ >= credit)
+                {
+                    e.credits_ -= credit;
+                    return hpx::make_ready_future(credit);
+                }
+
+                // Repeated exhaustion, request geometrically growing blocks
+                // of credit.
+                e.prefetch_ = (std::min)(2 * e.prefetch_, max_credit_prefetch_);
+                requested_credit = e.prefetch_ * credit;
+            }
+        }
     }
+
+    if (start_timer)
+        refcnt_flush_timer_.start(false);
+
+    naming::id_type keep_alive(raw, naming::id_type::unmanaged);
+    lcos::future<std::int64_t> f =
+        incref_async(raw, requested_credit, keep_alive);
+
+    if (requested_credit == credit)
+        return f;
+
+    // store the surplus in the credit reserve once AGAS has acknowledged it
+    using util::placeholders::_1;
+    return f.then(util::bind(
+            util::one_shot(
+                &addressing_service::synchronize_with_credit_prefetch),
+            this, _1, raw, credit, requested_credit - credit
+        ));
 } // }}}
 
+std::int64_t addressing_service::synchronize_with_credit_prefetch(
+    hpx::future<std::int64_t> fut
+  , naming::gid_type const& raw
+  , std::int64_t credit
+  , std::int64_t surplus_credit
+    )
+{
+    fut.get();          // rethrow exceptions
+
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+
+    credit_reserve_type::iterator it = credit_reserve_.find(raw);
+    if (enable_refcnt_caching_ && it != credit_reserve_.end())
+    {
+        it->second.credits_ += surplus_credit;
+        return credit;
+    }
+
+    // the reserve was released in the meantime, give back the surplus
+    add_decref_request_locked(raw, surplus_credit);
+    bool start_timer = arm_refcnt_flush_timer_locked();
+
+    send_refcnt_requests(l);
+
+    if (start_timer)
+        refcnt_flush_timer_.start(false);
+
+    return credit;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool addressing_service::register_name(
     std::string const& name
@@ -1631,6 +1761,31 @@ static bool correct_credit_on_failure(future<bool> f, naming::id_type id,
     return true;
 }
 
+static std::vector<bool> correct_credits_on_failure(
+    future<std::vector<bool> > f, std::vector<naming::id_type> ids,
+    std::vector<std::int64_t> new_gid_credits)
+{
+    // Return the credit to all GIDs for which the operation failed
+    bool failed = f.has_exception();
+
+    std::vector<bool> result;
+    if (!failed)
+        result = f.get();
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        if ((failed || !result[i]) && new_gid_credits[i] != 0)
+        {
+            naming::detail::add_credit_to_gid(
+                ids[i].get_gid(), new_gid_credits[i]);
+        }
+    }
+
+    if (failed)
+        return f.get();         // rethrow the exception
+    return result;
+}
+
 lcos::future<bool> addressing_service::register_name_async(
     std::string const& name
   , naming::id_type const& id
@@ -1698,6 +1853,48 @@ lcos::future<naming::id_type> addressing_service::resolve_name_async(
     return symbol_ns_.resolve_async(name);
 } // }}}
 
+///////////////////////////////////////////////////////////////////////////////
+lcos::future<std::vector<bool> > addressing_service::register_names_async(
+    std::vector<std::string> const& names
+  , std::vector<naming::id_type> const& ids
+    )
+{ // {{{
+    HPX_ASSERT(names.size() == ids.size());
+
+    std::vector<std::pair<std::string, naming::gid_type> > data;
+    data.reserve(names.size());
+
+    std::vector<std::int64_t> new_credits;
+    new_credits.reserve(names.size());
+
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        // We need to modify the reference count.
+        naming::gid_type& mutable_gid =
+            const_cast<naming::id_type&>(ids[i]).get_gid();
+        naming::gid_type new_gid =
+            naming::detail::split_gid_if_needed(mutable_gid).get();
+
+        new_credits.push_back(naming::detail::get_credit_from_gid(new_gid));
+        data.emplace_back(names[i], new_gid);
+    }
+
+    future<std::vector<bool> > f = symbol_ns_.bind_n_async(std::move(data));
+
+    return f.then(util::bind_back(
+            util::one_shot(&correct_credits_on_failure),
+            ids, std::move(new_credits)
+        ));
+} // }}}
+
+lcos::future<std::vector<naming::id_type> >
+addressing_service::resolve_names_async(
+    std::vector<std::string> const& names
+    )
+{ // {{{
+    return symbol_ns_.resolve_n_async(names);
+} // }}}
+
 namespace detail
 {
     hpx::future<hpx::id_type> on_register_event(hpx::future<bool> f,
@@ -1813,6 +2010,12 @@ void addressing_service::update_cache_entry(
 
         {
             std::unique_lock<mutex_type> lock(gva_cache_mtx_);
+
+            // entries held by the lock-free front end must not outlive an
+            // existing entry being replaced
+            if (gva_cache_->holds_key(key))
+                gva_hit_cache_->invalidate();
+
             if (!gva_cache_->update_if(key, g, check_for_collisions))
             {
                 if (LAGAS_ENABLED(warning))
@@ -1860,6 +2063,13 @@ bool addressing_service::get_cache_entry(
     {
         return false;
     }
+    naming::gid_type const stripped_gid =
+        naming::detail::get_stripped_gid(gid);
+
+    // try the lock-free front end first
+    if (gva_hit_cache_->get_entry(stripped_gid, idbase, gva))
+        return true;
+
     gva_cache_key k(gid);
     gva_cache_key idbase_key;
 
@@ -1878,6 +2088,9 @@ bool addressing_service::get_cache_entry(
             return false;
         }
         idbase = idbase_key.get_gid();
+
+        // subsequent lookups of this gid will not need to acquire the lock
+        gva_hit_cache_->insert(stripped_gid, idbase, gva);
         return true;
     }
 
@@ -1902,6 +2115,7 @@ void addressing_service::clear_cache(
 
         std::lock_guard<mutex_type> lock(gva_cache_mtx_);
 
+        gva_hit_cache_->invalidate();
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -1949,6 +2163,7 @@ void addressing_service::remove_cache_entry(
 
         std::lock_guard<mutex_type> lock(gva_cache_mtx_);
 
+        gva_hit_cache_->invalidate();
         gva_cache_->erase(
             [&gid](std::pair<gva_cache_key, gva> const& p)
             {
@@ -1972,7 +2187,11 @@ void addressing_service::start_shutdown(error_code& ec)
 
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
     enable_refcnt_caching_ = false;
+    release_credit_reserves_locked(true);
     send_refcnt_requests_sync(l, ec);
+
+    // the timer is not armed anymore once caching has been disabled
+    refcnt_flush_timer_.stop();
 }
 
 namespace detail
@@ -2105,7 +2324,8 @@ std::uint64_t addressing_service::get_cache_entries(bool reset)
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return gva_hit_cache_->hits(reset) +
+        gva_cache_->get_statistics().hits(reset);
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
@@ -2130,7 +2350,8 @@ std::uint64_t addressing_service::get_cache_insertions(bool reset)
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    return gva_hit_cache_->get_get_entry_count(reset) +
+        gva_cache_->get_statistics().get_get_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
@@ -2154,7 +2375,8 @@ std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_time(reset);
+    return gva_hit_cache_->get_get_entry_time(reset) +
+        gva_cache_->get_statistics().get_get_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
@@ -2216,6 +2438,16 @@ void addressing_service::register_counter_types()
         util::bind_front(
             &addressing_service::get_cache_erase_entry_time, this));
 
+    util::unique_id_ranges& id_pool = get_runtime().get_id_pool();
+    util::function_nonser<std::int64_t(bool)> id_pool_block_size(
+        util::bind_front(&util::unique_id_ranges::get_block_size, &id_pool));
+    util::function_nonser<std::int64_t(bool)> id_pool_reserve_size(
+        util::bind_front(&util::unique_id_ranges::get_reserve_size, &id_pool));
+    util::function_nonser<std::int64_t(bool)> id_pool_refills(
+        util::bind_front(&util::unique_id_ranges::get_refill_count, &id_pool));
+    util::function_nonser<std::int64_t(bool)> id_pool_stalls(
+        util::bind_front(&util::unique_id_ranges::get_stall_count, &id_pool));
+
     performance_counters::generic_counter_type_data const counter_types[] =
     {
         { "/agas/count/cache/entries", performance_counters::counter_raw,
@@ -2330,6 +2562,42 @@ void addressing_service::register_counter_types()
           &performance_counters::locality_counter_discoverer,
           ""
         },
+        { "/agas/count/id_pool/block_size", performance_counters::counter_raw,
+          "returns the size of the block of global ids new ids are currently "
+                "allocated from",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, id_pool_block_size, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/id_pool/reserve_size", performance_counters::counter_raw,
+          "returns the size of the block of global ids reserved for future "
+                "allocations",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, id_pool_reserve_size, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/id_pool/refills", performance_counters::counter_raw,
+          "returns the number of blocks of global ids reserved in the "
+                "background",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, id_pool_refills, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/id_pool/stalls", performance_counters::counter_raw,
+          "returns the number of times the allocation of a global id had to "
+                "wait for a new block of ids",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, id_pool_stalls, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
     };
     performance_counters::install_counter_types(
         counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
@@ -2356,6 +2624,7 @@ void addressing_service::garbage_collect_non_blocking(
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
     if (!l.owns_lock()) return;     // no need to compete for garbage collection
 
+    release_credit_reserves_locked(true);
     send_refcnt_requests_non_blocking(l, ec);
 }
 
@@ -2366,9 +2635,85 @@ void addressing_service::garbage_collect(
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
     if (!l.owns_lock()) return;     // no need to compete for garbage collection
 
+    release_credit_reserves_locked(true);
     send_refcnt_requests_sync(l, ec);
 }
 
+void addressing_service::add_decref_request_locked(
+    naming::gid_type const& raw
+  , std::int64_t credit
+    )
+{
+    HPX_ASSERT(credit > 0);
+
+    std::pair<refcnt_requests_type::iterator, bool> p =
+        refcnt_requests_->insert(refcnt_requests_type::value_type(raw, 0));
+    p.first->second -= credit;
+    ++refcnt_requests_count_;
+
+    // a pending decref request might have been fully compensated
+    if (p.first->second == 0)
+        refcnt_requests_->erase(p.first);
+}
+
+void addressing_service::release_credit_reserves_locked(bool all)
+{
+    credit_reserve_type::iterator it = credit_reserve_.begin();
+    while (it != credit_reserve_.end())
+    {
+        if (all || !it->second.used_)
+        {
+            if (it->second.credits_ != 0)
+                add_decref_request_locked(it->first, it->second.credits_);
+            it = credit_reserve_.erase(it);
+        }
+        else
+        {
+            it->second.used_ = false;
+            ++it;
+        }
+    }
+}
+
+bool addressing_service::flush_refcnt_requests()
+{
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
+    if (!l.owns_lock())
+        return true;                // somebody else is busy, try again later
+
+    if (!enable_refcnt_caching_)
+        return false;               // shutting down, stop the timer
+
+    release_credit_reserves_locked(false);
+
+    if (refcnt_requests_->empty() && credit_reserve_.empty())
+    {
+        // Nothing is pending, stop the timer. This happens while still
+        // holding the lock, the next buffered request re-arms the timer.
+        refcnt_flush_timer_armed_ = false;
+        refcnt_flush_timer_.stop();
+        return true;
+    }
+
+    error_code ec(lightweight);
+    send_refcnt_requests_non_blocking(l, ec);
+
+    return true;
+}
+
+bool addressing_service::arm_refcnt_flush_timer_locked()
+{
+    // never re-arm the timer after shutdown has started
+    if (refcnt_flush_interval_ <= 0 || !enable_refcnt_caching_ ||
+        refcnt_flush_timer_armed_)
+    {
+        return false;
+    }
+
+    refcnt_flush_timer_armed_ = true;
+    return true;
+}
+
 void addressing_service::send_refcnt_requests(
     std::unique_lock<addressing_service::mutex_type>& l
   , error_code& ec
@@ -6,11 +6,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <hpx/async.hpp>
+#include <hpx/runtime.hpp>
 #include <hpx/runtime/agas/detail/hosted_component_namespace.hpp>
 #include <hpx/runtime/agas/server/component_namespace.hpp>
 #include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/runtime_configuration.hpp>
 
 #include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -23,29 +27,92 @@ namespace hpx { namespace agas { namespace detail
     {
     }
 
+    void hosted_component_namespace::cache_type(std::string const& name,
+        components::component_type type)
+    {
+        if (type == components::component_invalid)
+            return;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        type_names_[type] = name;
+    }
+
+    bool hosted_component_namespace::may_cache_localities() const
+    {
+        // A locality connecting later on registers its component types with
+        // the root locality only, this locality would not be notified.
+        return get_runtime().get_config().get_entry(
+            "hpx.expect_connecting_localities", "0") == "0";
+    }
+
     components::component_type hosted_component_namespace::bind_prefix(
         std::string const& key, std::uint32_t prefix)
     {
         server::component_namespace::bind_prefix_action action;
-        return action(gid_, key, prefix);
+        components::component_type type = action(gid_, key, prefix);
+
+        cache_type(key, type);
+
+        // the set of localities supporting this type has changed
+        std::lock_guard<mutex_type> l(mtx_);
+        localities_.erase(type);
+
+        return type;
     }
 
     components::component_type
     hosted_component_namespace::bind_name(std::string const& name)
     {
+        // The mapping of a name to its type is not cached, the name could
+        // be unbound and registered again by other localities.
         server::component_namespace::bind_name_action action;
-        return action(gid_, name);
+        components::component_type type = action(gid_, name);
+
+        cache_type(name, type);
+        return type;
     }
 
     std::vector<std::uint32_t>
     hosted_component_namespace::resolve_id(components::component_type key)
     {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            auto it = localities_.find(key);
+            if (it != localities_.end())
+                return it->second;
+        }
+
         server::component_namespace::resolve_id_action action;
-        return action(gid_, key);
+        std::vector<std::uint32_t> result = action(gid_, key);
+
+        // Cache the result only if all localities have registered this
+        // type, otherwise the list may grow later on.
+        std::uint32_t num_localities =
+            get_runtime().get_config().get_num_localities();
+        if (result.size() >= num_localities && may_cache_localities())
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            localities_[key] = result;
+        }
+
+        return result;
     }
 
     bool hosted_component_namespace::unbind(std::string const& key)
     {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            for (auto it = type_names_.begin(); it != type_names_.end(); ++it)
+            {
+                if (it->second == key)
+                {
+                    localities_.erase(it->first);
+                    type_names_.erase(it);
+                    break;
+                }
+            }
+        }
+
         server::component_namespace::unbind_action action;
         return action(gid_, key);
     }
@@ -61,8 +128,22 @@ namespace hpx { namespace agas { namespace detail
     hosted_component_namespace::get_component_type_name(
         components::component_type type)
     {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            auto it = type_names_.find(type);
+            if (it != type_names_.end())
+                return it->second;
+        }
+
         server::component_namespace::get_component_type_name_action action;
-        return action(gid_, type);
+        std::string name = action(gid_, type);
+
+        if (!name.empty())
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            type_names_[type] = name;
+        }
+        return name;
     }
 
     lcos::future<std::uint32_t> hosted_component_namespace::get_num_localities(
@@ -98,6 +98,24 @@ naming::id_type resolve_name(
     return agas_.resolve_name(name, ec);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+lcos::future<std::vector<bool> > register_names(
+    std::vector<std::string> const& names
+  , std::vector<naming::id_type> const& ids
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.register_names_async(names, ids);
+}
+
+lcos::future<std::vector<naming::id_type> > resolve_names(
+    std::vector<std::string> const& names
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.resolve_names_async(names);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // lcos::future<std::vector<naming::id_type> > get_localities(
 //     components::component_type type
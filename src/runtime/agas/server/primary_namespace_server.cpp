@@ -659,46 +659,70 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
     std::uint64_t const real_count = (count) ? (count - 1) : (0);
 
-    // Just return the prefix
-    // REVIEW: Should this be an error?
+    naming::gid_type lower, upper;
+    bool exhausted = false;
+
+    {
+        // ids may be requested concurrently by the local id pool, logging
+        // and error handling is done after releasing the lock
+        std::lock_guard<mutex_type> l(mutex_);
+
+        // Just return the prefix
+        // REVIEW: Should this be an error?
+        if (0 == count)
+        {
+            lower = upper = next_id_;
+        }
+        else
+        {
+            // Compute the new allocation.
+            lower = next_id_ + 1;
+            upper = lower + real_count;
+
+            // Check for overflow.
+            if (upper.get_msb() != lower.get_msb())
+            {
+                // Check for address space exhaustion (we currently use 86
+                // bits of the gid for the actual id)
+                if (HPX_UNLIKELY(
+                    (lower.get_msb() & naming::gid_type::virtual_memory_mask) ==
+                        naming::gid_type::virtual_memory_mask)
+                   )
+                {
+                    exhausted = true;
+                }
+                else
+                {
+                    // Otherwise, correct
+                    lower = naming::gid_type(upper.get_msb(), 0);
+                    upper = lower + real_count;
+                }
+            }
+
+            // Store the new upper bound.
+            if (!exhausted)
+                next_id_ = upper;
+        }
+    }
+
     if (0 == count)
     {
         LAGAS_(info) << hpx::util::format(
             "primary_namespace::allocate, count(%1%), "
             "lower(%1%), upper(%3%), prefix(%4%), response(repeated_request)",
-            count, next_id_, next_id_,
-            naming::get_locality_id_from_gid(next_id_));
+            count, lower, upper,
+            naming::get_locality_id_from_gid(lower));
 
-        return std::make_pair(next_id_, next_id_);
+        return std::make_pair(lower, upper);
     }
 
-    // Compute the new allocation.
-    naming::gid_type lower(next_id_ + 1);
-    naming::gid_type upper(lower + real_count);
-
-    // Check for overflow.
-    if (upper.get_msb() != lower.get_msb())
+    if (HPX_UNLIKELY(exhausted))
     {
-        // Check for address space exhaustion (we currently use 86 bits of
-        // the gid for the actual id)
-        if (HPX_UNLIKELY(
-            (lower.get_msb() & naming::gid_type::virtual_memory_mask) ==
-                naming::gid_type::virtual_memory_mask)
-           )
-        {
-            HPX_THROW_EXCEPTION(internal_server_error
-                , "locality_namespace::allocate"
-                , "primary namespace has been exhausted");
-        }
-
-        // Otherwise, correct
-        lower = naming::gid_type(upper.get_msb(), 0);
-        upper = lower + real_count;
+        HPX_THROW_EXCEPTION(internal_server_error
+            , "locality_namespace::allocate"
+            , "primary namespace has been exhausted");
     }
 
-    // Store the new upper bound.
-    next_id_ = upper;
-
     // Set the initial credit count.
     naming::detail::set_credit_for_gid(lower, std::int64_t(HPX_GLOBALCREDIT_INITIAL));
     naming::detail::set_credit_for_gid(upper, std::int64_t(HPX_GLOBALCREDIT_INITIAL));
@@ -30,6 +30,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -180,6 +181,11 @@ void symbol_namespace::finalize()
     }
 }
 
+symbol_namespace::shard& symbol_namespace::get_shard(std::string const& key)
+{
+    return shards_[std::hash<std::string>()(key) % num_shards];
+}
+
 bool symbol_namespace::bind(
     std::string key
   , naming::gid_type gid
@@ -191,10 +197,23 @@ bool symbol_namespace::bind(
     );
     counter_data_.increment_bind_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    shard& s = get_shard(key);
+    std::unique_lock<mutex_type> l(s.mutex_);
+
+    return bind_locked(l, s, std::move(key), std::move(gid));
+} // }}}
+
+bool symbol_namespace::bind_locked(
+    std::unique_lock<mutex_type>& l
+  , shard& s
+  , std::string key
+  , naming::gid_type gid
+    )
+{ // {{{ bind_locked implementation
+    HPX_ASSERT(l.owns_lock());
 
-    gid_table_type::iterator it = gids_.find(key);
-    gid_table_type::iterator end = gids_.end();
+    gid_table_type::iterator it = s.gids_.find(key);
+    gid_table_type::iterator end = s.gids_.end();
 
     if (it != end)
     {
@@ -207,19 +226,24 @@ bool symbol_namespace::bind(
         // increase reference count
         if (raw_gid == gid)
         {
-            LAGAS_(info) << hpx::util::format(
-                "symbol_namespace::bind, key(%1%), gid(%2%), old_credit(%3%), "
-                "new_credit(%4%)",
-                key, gid,
-                naming::detail::get_credit_from_gid(*(it->second)),
-                naming::detail::get_credit_from_gid(*(it->second)) + credits);
+            std::int64_t const old_credits =
+                naming::detail::get_credit_from_gid(*(it->second));
 
             // REVIEW: do we need to add the credit of the argument to the table?
             naming::detail::add_credit_to_gid(*(it->second), credits);
 
+            l.unlock();
+
+            LAGAS_(info) << hpx::util::format(
+                "symbol_namespace::bind, key(%1%), gid(%2%), old_credit(%3%), "
+                "new_credit(%4%)",
+                key, gid, old_credits, old_credits + credits);
+
             return true;
         }
 
+        l.unlock();
+
         if (LAGAS_ENABLED(info))
         {
             naming::detail::add_credit_to_gid(gid, credits);
@@ -231,7 +255,7 @@ bool symbol_namespace::bind(
         return false;
     }
 
-    if (HPX_UNLIKELY(!util::insert_checked(gids_.insert(
+    if (HPX_UNLIKELY(!util::insert_checked(s.gids_.insert(
             std::make_pair(key, std::make_shared<naming::gid_type>(gid))))))
     {
         l.unlock();
@@ -244,7 +268,7 @@ bool symbol_namespace::bind(
 
     // handle registered events
     typedef on_event_data_map_type::iterator iterator;
-    std::pair<iterator, iterator> p = on_event_data_.equal_range(key);
+    std::pair<iterator, iterator> p = s.on_event_data_.equal_range(key);
 
     std::vector<hpx::id_type> lcos;
     if (p.first != p.second)
@@ -256,7 +280,7 @@ bool symbol_namespace::bind(
             ++it;
         }
 
-        on_event_data_.erase(p.first, p.second);
+        s.on_event_data_.erase(p.first, p.second);
 
         // notify all LCOS which were registered with this name
         for (hpx::id_type const& id : lcos)
@@ -264,8 +288,8 @@ bool symbol_namespace::bind(
             // re-locate the entry in the GID table for each LCO anew, as we
             // need to unlock the mutex protecting the table for each iteration
             // below
-            gid_table_type::iterator gid_it = gids_.find(key);
-            if (gid_it == gids_.end())
+            gid_table_type::iterator gid_it = s.gids_.find(key);
+            if (gid_it == s.gids_.end())
             {
                 l.unlock();
 
@@ -300,6 +324,28 @@ bool symbol_namespace::bind(
     return true;
 } // }}}
 
+std::vector<bool> symbol_namespace::bind_n(bind_n_data_type data)
+{ // {{{ bind_n implementation
+    util::scoped_timer<std::atomic<std::int64_t> > update(
+        counter_data_.bind_.time_
+    );
+    counter_data_.bind_.count_ += static_cast<std::int64_t>(data.size());
+
+    std::vector<bool> result;
+    result.reserve(data.size());
+
+    for (auto && e : data)
+    {
+        shard& s = get_shard(e.first);
+        std::unique_lock<mutex_type> l(s.mutex_);
+
+        result.push_back(
+            bind_locked(l, s, std::move(e.first), std::move(e.second)));
+    }
+
+    return result;
+} // }}}
+
 naming::gid_type symbol_namespace::resolve(std::string const& key)
 { // {{{ resolve implementation
     // parameters
@@ -308,10 +354,11 @@ naming::gid_type symbol_namespace::resolve(std::string const& key)
     );
     counter_data_.increment_resolve_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    shard& s = get_shard(key);
+    std::unique_lock<mutex_type> l(s.mutex_);
 
-    gid_table_type::iterator it = gids_.find(key);
-    gid_table_type::iterator end = gids_.end();
+    gid_table_type::iterator it = s.gids_.find(key);
+    gid_table_type::iterator end = s.gids_.end();
 
     if (it == end)
     {
@@ -335,6 +382,59 @@ naming::gid_type symbol_namespace::resolve(std::string const& key)
     return gid;
 } // }}}
 
+std::vector<naming::gid_type> symbol_namespace::resolve_n(
+    std::vector<std::string> const& keys)
+{ // {{{ resolve_n implementation
+    util::scoped_timer<std::atomic<std::int64_t> > update(
+        counter_data_.resolve_.time_
+    );
+    counter_data_.resolve_.count_ += static_cast<std::int64_t>(keys.size());
+
+    // hold on to all entries while the maps are unlocked
+    std::vector<std::shared_ptr<naming::gid_type> > current_gids;
+    current_gids.reserve(keys.size());
+
+    for (std::string const& key : keys)
+    {
+        shard& s = get_shard(key);
+        std::lock_guard<mutex_type> l(s.mutex_);
+
+        gid_table_type::iterator it = s.gids_.find(key);
+        if (it != s.gids_.end())
+            current_gids.push_back(it->second);
+        else
+            current_gids.push_back(std::shared_ptr<naming::gid_type>());
+    }
+
+    // split the credits of all found entries concurrently
+    std::vector<hpx::future<naming::gid_type> > lazy_gids;
+    lazy_gids.reserve(keys.size());
+
+    for (std::shared_ptr<naming::gid_type> const& current_gid : current_gids)
+    {
+        if (current_gid)
+        {
+            lazy_gids.push_back(
+                naming::detail::split_gid_if_needed(*current_gid));
+        }
+        else
+        {
+            lazy_gids.push_back(hpx::make_ready_future(naming::invalid_gid));
+        }
+    }
+
+    std::vector<naming::gid_type> result;
+    result.reserve(keys.size());
+
+    for (hpx::future<naming::gid_type>& f : lazy_gids)
+        result.push_back(f.get());
+
+    LAGAS_(info) << hpx::util::format(
+        "symbol_namespace::resolve_n, keys(%1%)", keys.size());
+
+    return result;
+} // }}}
+
 naming::gid_type symbol_namespace::unbind(std::string const& key)
 { // {{{ unbind implementation
     util::scoped_timer<std::atomic<std::int64_t> > update(
@@ -342,10 +442,11 @@ naming::gid_type symbol_namespace::unbind(std::string const& key)
     );
     counter_data_.increment_unbind_count();
 
-    std::lock_guard<mutex_type> l(mutex_);
+    shard& s = get_shard(key);
+    std::lock_guard<mutex_type> l(s.mutex_);
 
-    gid_table_type::iterator it = gids_.find(key);
-    gid_table_type::iterator end = gids_.end();
+    gid_table_type::iterator it = s.gids_.find(key);
+    gid_table_type::iterator end = s.gids_.end();
 
     if (it == end)
     {
@@ -358,7 +459,7 @@ naming::gid_type symbol_namespace::unbind(std::string const& key)
 
     naming::gid_type const gid = *(it->second);
 
-    gids_.erase(it);
+    s.gids_.erase(it);
 
     LAGAS_(info) << hpx::util::format(
         "symbol_namespace::unbind, key(%1%), gid(%2%)",
@@ -367,6 +468,23 @@ naming::gid_type symbol_namespace::unbind(std::string const& key)
     return gid;
 } // }}}
 
+template <typename F>
+void symbol_namespace::find_matching(
+    shard& s, std::string const& prefix, F && f)
+{
+    // all names sharing the given prefix are stored consecutively
+    std::lock_guard<mutex_type> l(s.mutex_);
+
+    for (gid_table_type::iterator it = s.gids_.lower_bound(prefix);
+         it != s.gids_.end(); ++it)
+    {
+        if (it->first.compare(0, prefix.size(), prefix) != 0)
+            break;
+
+        f(it->first, it->second);
+    }
+}
+
 // TODO: catch exceptions
 symbol_namespace::iterate_names_return_type symbol_namespace::iterate(
     std::string const& pattern)
@@ -376,44 +494,60 @@ symbol_namespace::iterate_names_return_type symbol_namespace::iterate(
     );
     counter_data_.increment_iterate_names_count();
 
-    std::map<std::string, naming::gid_type> found;
+    // collect all matching entries first, holding on to them while the
+    // maps are unlocked
+    typedef std::vector<
+            std::pair<std::string, std::shared_ptr<naming::gid_type> >
+        > matches_type;
+    matches_type matches;
 
-    if (pattern.find_first_of("*?[]") != std::string::npos)
+    std::string::size_type wildcard = pattern.find_first_of("*?[]");
+    if (wildcard != std::string::npos)
     {
         std::string str_rx(util::regex_from_pattern(pattern, throws));
         boost::regex rx(str_rx, boost::regex::perl);
 
-        std::unique_lock<mutex_type> l(mutex_);
-        for (gid_table_type::iterator it = gids_.begin(); it != gids_.end();
-             ++it)
+        // only names starting with the literal prefix of the pattern can
+        // match at all
+        std::string const prefix = pattern.substr(0, wildcard);
+        for (shard& s : shards_)
         {
-            if (!boost::regex_match(it->first, rx))
-                continue;
-
-            // hold on to entry while map is unlocked
-            std::shared_ptr<naming::gid_type> current_gid(it->second);
-            util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
-
-            found[it->first] =
-                naming::detail::split_gid_if_needed(*current_gid).get();
+            find_matching(s, prefix,
+                [&](std::string const& key,
+                    std::shared_ptr<naming::gid_type> const& gid)
+                {
+                    if (boost::regex_match(key, rx))
+                        matches.push_back(std::make_pair(key, gid));
+                });
         }
     }
-    else
+    else if (pattern.empty())
     {
-        std::unique_lock<mutex_type> l(mutex_);
-        for (gid_table_type::iterator it = gids_.begin(); it != gids_.end();
-             ++it)
+        for (shard& s : shards_)
         {
-            if (!pattern.empty() && pattern != it->first)
-                continue;
+            find_matching(s, pattern,
+                [&](std::string const& key,
+                    std::shared_ptr<naming::gid_type> const& gid)
+                {
+                    matches.push_back(std::make_pair(key, gid));
+                });
+        }
+    }
+    else
+    {
+        shard& s = get_shard(pattern);
+        std::lock_guard<mutex_type> l(s.mutex_);
 
-            // hold on to entry while map is unlocked
-            std::shared_ptr<naming::gid_type> current_gid(it->second);
-            util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
+        gid_table_type::iterator it = s.gids_.find(pattern);
+        if (it != s.gids_.end())
+            matches.push_back(std::make_pair(it->first, it->second));
+    }
 
-            found[it->first] =
-                naming::detail::split_gid_if_needed(*current_gid).get();
-        }
+    std::map<std::string, naming::gid_type> found;
+    for (matches_type::value_type& m : matches)
+    {
+        found[std::move(m.first)] =
+            naming::detail::split_gid_if_needed(*m.second).get();
     }
 
     LAGAS_(info) << "symbol_namespace::iterate";
@@ -432,13 +566,14 @@ bool symbol_namespace::on_event(
     );
     counter_data_.increment_on_event_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    shard& s = get_shard(name);
+    std::unique_lock<mutex_type> l(s.mutex_);
 
     bool handled = false;
     if (call_for_past_events)
     {
-        gid_table_type::iterator it = gids_.find(name);
-        if (it != gids_.end())
+        gid_table_type::iterator it = s.gids_.find(name);
+        if (it != s.gids_.end())
         {
             // hold on to entry while map is unlocked
             std::shared_ptr<naming::gid_type> current_gid(it->second);
@@ -461,12 +596,12 @@ bool symbol_namespace::on_event(
 
     if (!handled)
     {
-        on_event_data_map_type::iterator it = on_event_data_.insert(
+        on_event_data_map_type::iterator it = s.on_event_data_.insert(
             on_event_data_map_type::value_type(std::move(name), lco));
 
         // This overload of insert always returns the iterator pointing
         // to the inserted value. It should never point to end
-        HPX_ASSERT(it != on_event_data_.end());
+        HPX_ASSERT(it != s.on_event_data_.end());
     }
     l.unlock();
 
@@ -8,6 +8,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/async.hpp>
+#include <hpx/dataflow.hpp>
 #include <hpx/lcos/base_lco_with_value.hpp>
 #include <hpx/lcos/broadcast.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
@@ -17,6 +18,7 @@
 #include <hpx/util/format.hpp>
 #include <hpx/util/jenkins_hash.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -42,6 +44,16 @@ HPX_REGISTER_ACTION_ID(
     symbol_namespace_resolve_action,
     hpx::actions::symbol_namespace_resolve_action_id)
 
+HPX_REGISTER_ACTION_ID(
+    symbol_namespace::bind_n_action,
+    symbol_namespace_bind_n_action,
+    hpx::actions::symbol_namespace_bind_n_action_id)
+
+HPX_REGISTER_ACTION_ID(
+    symbol_namespace::resolve_n_action,
+    symbol_namespace_resolve_n_action,
+    hpx::actions::symbol_namespace_resolve_n_action_id)
+
 HPX_REGISTER_ACTION_ID(
     symbol_namespace::unbind_action,
     symbol_namespace_unbind_action,
@@ -179,6 +191,155 @@ namespace hpx { namespace agas
         return resolve_async(std::move(key)).get();
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // group the indices of the given keys by the locality hosting the
+        // corresponding symbol namespace entry
+        template <typename F>
+        std::map<naming::id_type, std::vector<std::size_t> >
+        group_by_symbol_namespace_locality(std::size_t size, F && get_key)
+        {
+            std::map<naming::id_type, std::vector<std::size_t> > groups;
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                groups[symbol_namespace::symbol_namespace_locality(get_key(i))]
+                    .push_back(i);
+            }
+            return groups;
+        }
+
+        naming::id_type make_id_from_resolved_gid(naming::gid_type const& gid)
+        {
+            if (naming::detail::has_credits(gid))
+                return naming::id_type(gid, naming::id_type::managed);
+            return naming::id_type(gid, naming::id_type::unmanaged);
+        }
+    }
+
+    hpx::future<std::vector<bool> > symbol_namespace::bind_n_async(
+        std::vector<std::pair<std::string, naming::gid_type> > data)
+    {
+        typedef server::symbol_namespace::bind_n_data_type data_type;
+
+        std::map<naming::id_type, std::vector<std::size_t> > groups =
+            detail::group_by_symbol_namespace_locality(data.size(),
+                [&data](std::size_t i) -> std::string const&
+                {
+                    return data[i].first;
+                });
+
+        std::vector<hpx::future<std::vector<bool> > > lazy_results;
+        lazy_results.reserve(groups.size());
+
+        std::vector<std::vector<std::size_t> > indices;
+        indices.reserve(groups.size());
+
+        for (auto & group : groups)
+        {
+            data_type group_data;
+            group_data.reserve(group.second.size());
+            for (std::size_t i : group.second)
+                group_data.push_back(std::move(data[i]));
+
+            naming::id_type const& dest = group.first;
+            if (naming::get_locality_from_gid(dest.get_gid()) ==
+                hpx::get_locality())
+            {
+                lazy_results.push_back(hpx::make_ready_future(
+                    server_->bind_n(std::move(group_data))));
+            }
+            else
+            {
+                server::symbol_namespace::bind_n_action action;
+                lazy_results.push_back(
+                    hpx::async(action, dest, std::move(group_data)));
+            }
+            indices.push_back(std::move(group.second));
+        }
+
+        std::size_t size = data.size();
+        return hpx::dataflow(
+            [size, indices](
+                std::vector<hpx::future<std::vector<bool> > > && results)
+            {
+                std::vector<bool> result(size, false);
+                for (std::size_t g = 0; g != results.size(); ++g)
+                {
+                    std::vector<bool> r = results[g].get();
+                    HPX_ASSERT(r.size() == indices[g].size());
+                    for (std::size_t i = 0; i != r.size(); ++i)
+                        result[indices[g][i]] = r[i];
+                }
+                return result;
+            },
+            std::move(lazy_results));
+    }
+
+    hpx::future<std::vector<naming::id_type> >
+    symbol_namespace::resolve_n_async(std::vector<std::string> keys) const
+    {
+        std::map<naming::id_type, std::vector<std::size_t> > groups =
+            detail::group_by_symbol_namespace_locality(keys.size(),
+                [&keys](std::size_t i) -> std::string const&
+                {
+                    return keys[i];
+                });
+
+        std::vector<hpx::future<std::vector<naming::id_type> > > lazy_results;
+        lazy_results.reserve(groups.size());
+
+        std::vector<std::vector<std::size_t> > indices;
+        indices.reserve(groups.size());
+
+        for (auto & group : groups)
+        {
+            std::vector<std::string> group_keys;
+            group_keys.reserve(group.second.size());
+            for (std::size_t i : group.second)
+                group_keys.push_back(std::move(keys[i]));
+
+            naming::id_type const& dest = group.first;
+            if (naming::get_locality_from_gid(dest.get_gid()) ==
+                hpx::get_locality())
+            {
+                std::vector<naming::gid_type> raw_gids =
+                    server_->resolve_n(group_keys);
+
+                std::vector<naming::id_type> ids;
+                ids.reserve(raw_gids.size());
+                for (naming::gid_type const& raw_gid : raw_gids)
+                    ids.push_back(detail::make_id_from_resolved_gid(raw_gid));
+
+                lazy_results.push_back(hpx::make_ready_future(std::move(ids)));
+            }
+            else
+            {
+                server::symbol_namespace::resolve_n_action action;
+                lazy_results.push_back(
+                    hpx::async(action, dest, std::move(group_keys)));
+            }
+            indices.push_back(std::move(group.second));
+        }
+
+        std::size_t size = keys.size();
+        return hpx::dataflow(
+            [size, indices](std::vector<
+                hpx::future<std::vector<naming::id_type> > > && results)
+            {
+                std::vector<naming::id_type> result(size);
+                for (std::size_t g = 0; g != results.size(); ++g)
+                {
+                    std::vector<naming::id_type> r = results[g].get();
+                    HPX_ASSERT(r.size() == indices[g].size());
+                    for (std::size_t i = 0; i != r.size(); ++i)
+                        result[indices[g][i]] = std::move(r[i]);
+                }
+                return result;
+            },
+            std::move(lazy_results));
+    }
+
     hpx::future<naming::id_type> symbol_namespace::unbind_async(std::string key)
     {
         naming::id_type dest = symbol_namespace_locality(key);
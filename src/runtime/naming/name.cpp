@@ -97,7 +97,9 @@
 // sufficient credit is available. If the credit of the id_type to be split is
 // exhausted (reaches the value '1') it has to be replenished. This operation
 // is performed synchronously. This is done to ensure that AGAS has accounted
-// for the requested credit increase.
+// for the requested credit increase. If the credit of the same id_type is
+// exhausted repeatedly, larger blocks of credit are requested and the surplus
+// is kept by the local AGAS client (see addressing_service::borrow_credit_async).
 //
 // Note that both the id_type instance staying behind and the one sent along
 // are replenished before sending out the parcel at the sending locality.
@@ -353,7 +355,8 @@ namespace hpx { namespace naming
 
                     naming::gid_type new_gid = gid;     // strips lock-bit
                     HPX_ASSERT(new_gid != invalid_gid);
-                    return agas::incref(new_gid, new_credit)
+                    return naming::get_agas_client()
+                        .borrow_credit_async(new_gid, new_credit)
                         .then(
                             hpx::util::bind(postprocess_incref, std::ref(gid))
                         );
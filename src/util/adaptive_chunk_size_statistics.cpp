@@ -0,0 +1,204 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/util/adaptive_chunk_size_statistics.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/regex_from_pattern.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+namespace hpx { namespace util
+{
+    namespace
+    {
+        struct adaptive_chunk_size_registry
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef std::map<
+                    std::string,
+                    std::shared_ptr<adaptive_chunk_size_statistics>
+                > map_type;
+
+            std::shared_ptr<adaptive_chunk_size_statistics>
+                get(std::string const& name)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::shared_ptr<adaptive_chunk_size_statistics>& stats =
+                    sites_[name];
+                if (!stats)
+                    stats = std::make_shared<adaptive_chunk_size_statistics>();
+                return stats;
+            }
+
+            std::vector<std::string> names()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::vector<std::string> result;
+                result.reserve(sites_.size());
+                for (auto const& site : sites_)
+                    result.push_back(site.first);
+                return result;
+            }
+
+            mutex_type mtx_;
+            map_type sites_;
+        };
+
+        adaptive_chunk_size_registry& get_registry()
+        {
+            static adaptive_chunk_size_registry registry;
+            return registry;
+        }
+    }
+
+    std::shared_ptr<adaptive_chunk_size_statistics>
+        get_adaptive_chunk_size_statistics(std::string const& name)
+    {
+        return get_registry().get(name);
+    }
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        naming::gid_type adaptive_chunk_size_counter_creator(
+            performance_counters::counter_info const& info, error_code& ec)
+        {
+            performance_counters::counter_path_elements paths;
+            performance_counters::get_counter_path_elements(
+                info.fullname_, paths, ec);
+            if (ec) return naming::invalid_gid;
+
+            if (paths.parentinstance_is_basename_ ||
+                paths.instancename_ != "total" || paths.instanceindex_ != -1)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "adaptive_chunk_size_counter_creator",
+                    "invalid counter instance name: " + paths.instancename_);
+                return naming::invalid_gid;
+            }
+
+            if (paths.parameters_.empty())
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "adaptive_chunk_size_counter_creator",
+                    "invalid adaptive chunk size counter parameter: must "
+                    "specify the name of a call site");
+                return naming::invalid_gid;
+            }
+
+            // the call site does not have to exist yet, this allows to
+            // set up the counters before the algorithm runs the first time
+            std::shared_ptr<adaptive_chunk_size_statistics> stats =
+                get_registry().get(paths.parameters_);
+
+            std::atomic<std::int64_t> adaptive_chunk_size_statistics::*
+                value = nullptr;
+            if (paths.countername_ == "adaptive-chunk-size/chunk-size")
+                value = &adaptive_chunk_size_statistics::chunk_size_;
+            else if (paths.countername_ == "adaptive-chunk-size/invocations")
+                value = &adaptive_chunk_size_statistics::invocations_;
+            else if (paths.countername_ == "adaptive-chunk-size/explorations")
+                value = &adaptive_chunk_size_statistics::explorations_;
+
+            if (value == nullptr)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "adaptive_chunk_size_counter_creator",
+                    "invalid counter name: " + paths.countername_);
+                return naming::invalid_gid;
+            }
+
+            // the chunk size is a gauge, all other values are counts
+            bool const is_gauge =
+                value == &adaptive_chunk_size_statistics::chunk_size_;
+            util::function_nonser<std::int64_t(bool)> f =
+                [stats, value, is_gauge](bool reset) -> std::int64_t
+                {
+                    std::atomic<std::int64_t>& v = (*stats).*value;
+                    if (reset && !is_gauge)
+                        return v.exchange(0);
+                    return v.load();
+                };
+
+            return performance_counters::detail::create_raw_counter(
+                info, std::move(f), ec);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        bool adaptive_chunk_size_counter_discoverer(
+            performance_counters::counter_info const& info,
+            performance_counters::discover_counter_func const& f,
+            performance_counters::discover_counters_mode mode,
+            error_code& ec)
+        {
+            performance_counters::counter_path_elements p;
+            performance_counters::counter_status status =
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, p, ec);
+            if (!performance_counters::status_is_valid(status))
+                return false;
+
+            if (p.parentinstancename_.empty())
+            {
+                p.parentinstancename_ = "locality#*";
+                p.parentinstanceindex_ = -1;
+            }
+
+            if (p.instancename_.empty())
+            {
+                p.instancename_ = "total";
+                p.instanceindex_ = -1;
+            }
+
+            if (p.parameters_.empty())
+                p.parameters_ = "*";
+
+            std::string str_rx(util::regex_from_pattern(p.parameters_, ec));
+            if (ec) return false;
+
+            boost::regex rx(str_rx, boost::regex::perl);
+            for (std::string const& name : get_registry().names())
+            {
+                if (!boost::regex_match(name, rx))
+                    continue;
+
+                // propagate the name of the call site as the parameter
+                performance_counters::counter_path_elements cp = p;
+                cp.parameters_ = name;
+
+                std::string fullname;
+                performance_counters::get_counter_name(cp, fullname, ec);
+                if (ec) return false;
+
+                performance_counters::counter_info cinfo = info;
+                cinfo.fullname_ = fullname;
+
+                if (!f(cinfo, ec) || ec)
+                    return false;
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+
+            return true;
+        }
+    }
+}}
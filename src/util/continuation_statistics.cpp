@@ -0,0 +1,54 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/continuation_statistics.hpp>
+#include <hpx/util/per_worker_counter.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace util
+{
+    namespace
+    {
+        per_worker_counter& get_inlined_counter()
+        {
+            static per_worker_counter counter;
+            return counter;
+        }
+
+        per_worker_counter& get_spawned_counter()
+        {
+            static per_worker_counter counter;
+            return counter;
+        }
+    }
+
+    std::int64_t get_inlined_continuation_count(bool reset)
+    {
+        return get_inlined_counter().sum(reset);
+    }
+
+    std::int64_t get_spawned_continuation_count(bool reset)
+    {
+        return get_spawned_counter().sum(reset);
+    }
+
+    namespace detail
+    {
+        void count_inlined_continuation()
+        {
+            get_inlined_counter().local().fetch_add(
+                1, std::memory_order_relaxed);
+        }
+
+        void count_spawned_continuation()
+        {
+            get_spawned_counter().local().fetch_add(
+                1, std::memory_order_relaxed);
+        }
+    }
+}}
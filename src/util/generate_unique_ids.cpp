@@ -5,12 +5,23 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/format.hpp>
 #include <hpx/util/generate_unique_ids.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/logging.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
+#include <string>
 
 namespace hpx { namespace util
 {
@@ -22,10 +33,20 @@ namespace hpx { namespace util
         // ensure next_id doesn't overflow
         while (!lower_ || (lower_ + count) > upper_)
         {
+            // switch to the reserved block, if possible
+            if (use_reserve(count))
+                continue;
+
+            // no (sufficiently large) block has been reserved, we have to
+            // wait for a new block to be allocated, errors are reported to
+            // the caller from here
+            ++stalls_;
+            refill_failed_ = false;
+
             lower_ = naming::invalid_gid;
 
             naming::gid_type lower;
-            std::size_t count_ = (std::max)(std::size_t(range_delta), count);
+            std::size_t count_ = (std::max)(next_block_size_, count);
 
             {
                 unlock_guard<std::unique_lock<mutex_type> > ul(l);
@@ -38,12 +59,132 @@ namespace hpx { namespace util
             {
                 lower_ = lower;
                 upper_ = lower + count_;
+
+                block_size_.store(static_cast<std::int64_t>(count_),
+                    std::memory_order_relaxed);
             }
         }
 
         naming::gid_type result = lower_;
         lower_ += count;
+
+        // make sure the next block is being reserved in the background
+        if (!reserve_lower_ && !refill_pending_ && !refill_failed_)
+            schedule_refill(l);
+
         return result;
     }
-}}
 
+    bool unique_id_ranges::use_reserve(std::size_t count)
+    {
+        if (!reserve_lower_ || (reserve_lower_ + count) > reserve_upper_)
+            return false;
+
+        lower_ = reserve_lower_;
+        upper_ = reserve_upper_;
+
+        reserve_lower_ = naming::invalid_gid;
+        reserve_upper_ = naming::invalid_gid;
+
+        block_size_.store(reserve_size_.exchange(0, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+
+        return true;
+    }
+
+    void unique_id_ranges::schedule_refill(std::unique_lock<mutex_type>& l)
+    {
+        HPX_ASSERT(l.owns_lock());
+
+        refill_pending_ = true;
+
+        unlock_guard<std::unique_lock<mutex_type> > ul(l);
+
+        // reserve the next block asynchronously if we're running on an
+        // HPX thread, otherwise do it right away
+        if (threads::get_self_ptr() != nullptr)
+        {
+            error_code ec(lightweight);
+            threads::register_work_nullary(
+                util::bind(&unique_id_ranges::refill, this),
+                "unique_id_ranges::refill", threads::pending,
+                threads::thread_priority_normal, std::size_t(-1),
+                threads::thread_stacksize_default, ec);
+            if (!ec)
+                return;
+        }
+
+        refill();
+    }
+
+    void unique_id_ranges::refill()
+    {
+        std::size_t count = 0;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            count = next_block_size_;
+        }
+
+        error_code ec(lightweight);
+        naming::gid_type lower = hpx::agas::get_next_id(count, ec);
+
+        std::unique_lock<mutex_type> l(mtx_);
+        refill_pending_ = false;
+
+        if (ec || !lower)
+        {
+            // Don't retry in the background before the current block has
+            // been used up, the synchronous allocation happening at that
+            // point reports the error to its caller.
+            refill_failed_ = true;
+            l.unlock();
+
+            LAGAS_(error) << hpx::util::format(
+                "unique_id_ranges::refill, failed to reserve %1% ids: %2%",
+                count, ec ? ec.get_message() : std::string("invalid id"));
+            return;
+        }
+
+        ++refills_;
+
+        // we ignore the result if some other thread has already reserved
+        // the next block
+        if (!reserve_lower_)
+        {
+            reserve_lower_ = lower;
+            reserve_upper_ = lower + count;
+
+            reserve_size_.store(static_cast<std::int64_t>(count),
+                std::memory_order_relaxed);
+        }
+
+        // grow the blocks geometrically
+        if (next_block_size_ < std::size_t(HPX_MAX_GID_RANGE))
+        {
+            next_block_size_ = (std::min)(2 * next_block_size_,
+                std::size_t(HPX_MAX_GID_RANGE));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t unique_id_ranges::get_block_size(bool)
+    {
+        return block_size_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t unique_id_ranges::get_reserve_size(bool)
+    {
+        return reserve_size_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t unique_id_ranges::get_refill_count(bool reset)
+    {
+        return util::get_and_reset_value(refills_, reset);
+    }
+
+    std::int64_t unique_id_ranges::get_stall_count(bool reset)
+    {
+        return util::get_and_reset_value(stalls_, reset);
+    }
+}}
@@ -294,6 +294,14 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(
                     HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS))
                 "}",
+            "refcnt_flush_interval = ${HPX_AGAS_REFCNT_FLUSH_INTERVAL:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(
+                    HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL))
+                "}",
+            "max_credit_prefetch = ${HPX_AGAS_MAX_CREDIT_PREFETCH:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(
+                    HPX_INITIAL_AGAS_MAX_CREDIT_PREFETCH))
+                "}",
             "service_mode = hosted",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_AGAS_LOCAL_CACHE_SIZE)) "}",
@@ -743,6 +751,39 @@ namespace hpx { namespace util
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    std::int64_t
+    runtime_configuration::get_agas_refcnt_flush_interval() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::int64_t>(
+                    *sec, "refcnt_flush_interval",
+                    HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL);
+            }
+        }
+        return HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL;
+    }
+
+    std::int64_t
+    runtime_configuration::get_agas_max_credit_prefetch() const
+    {
+        std::int64_t factor = HPX_INITIAL_AGAS_MAX_CREDIT_PREFETCH;
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (nullptr != sec) {
+                factor = hpx::util::get_entry_as<std::int64_t>(
+                    *sec, "max_credit_prefetch", factor);
+            }
+        }
+        // limit bounds, avoid overflowing the credit count held by AGAS
+        if (factor < 1)
+            factor = 1;
+        else if (factor > 1024)
+            factor = 1024;
+        return factor;
+    }
+
     bool runtime_configuration::get_itt_notify_mode() const
     {
 #if HPX_HAVE_ITTNOTIFY != 0
@@ -0,0 +1,518 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/slab_allocator.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(HPX_WINDOWS)
+#include <malloc.h>
+#endif
+
+#if defined(HPX_HAVE_SLAB_ALLOCATOR)
+
+namespace hpx { namespace util
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        HPX_STATIC_CONSTEXPR std::size_t slab_size =
+            HPX_SLAB_ALLOCATOR_SLAB_SIZE;
+
+        static_assert((slab_size & (slab_size - 1)) == 0,
+            "HPX_SLAB_ALLOCATOR_SLAB_SIZE has to be a power of two");
+
+        HPX_STATIC_CONSTEXPR std::size_t size_classes[] =
+        {
+            16, 32, 48, 64, 96, 128, 192, 256, 384, 512
+        };
+
+        HPX_STATIC_CONSTEXPR std::size_t num_size_classes =
+            sizeof(size_classes) / sizeof(size_classes[0]);
+
+        static_assert(HPX_SLAB_ALLOCATOR_MAX_SIZE <= 512,
+            "HPX_SLAB_ALLOCATOR_MAX_SIZE exceeds the largest size class");
+
+        std::size_t get_size_class(std::size_t size)
+        {
+            std::size_t i = 0;
+            while (size_classes[i] < size)
+                ++i;
+            return i;
+        }
+
+        struct slab_heap;
+
+        struct free_block
+        {
+            free_block* next_;
+        };
+
+        // Every slab is aligned to its size, the header is located at the
+        // beginning of the slab, which allows to find the owning heap of
+        // any block. All blocks of a slab belong to the same size class.
+        struct slab_header
+        {
+            slab_heap* owner_;
+            slab_header* prev_;         // list of slabs with free blocks
+            slab_header* next_;
+            free_block* free_;          // blocks released to this slab
+            char* bump_;                // blocks never handed out
+            std::size_t used_;          // number of blocks handed out
+            bool listed_;               // slab is linked into the list
+        };
+
+        HPX_STATIC_CONSTEXPR std::size_t slab_header_size = 64;
+
+        static_assert(sizeof(slab_header) <= slab_header_size,
+            "the slab header does not fit into the reserved space");
+
+        slab_header* get_slab(void* p)
+        {
+            return reinterpret_cast<slab_header*>(
+                reinterpret_cast<std::uintptr_t>(p) & ~(slab_size - 1));
+        }
+
+        void* allocate_slab_memory()
+        {
+            void* memory = nullptr;
+#if defined(HPX_WINDOWS)
+            memory = _aligned_malloc(slab_size, slab_size);
+#else
+            if (posix_memalign(&memory, slab_size, slab_size) != 0)
+                memory = nullptr;
+#endif
+            if (memory == nullptr)
+                throw std::bad_alloc();
+            return memory;
+        }
+
+        void free_slab_memory(void* memory)
+        {
+#if defined(HPX_WINDOWS)
+            _aligned_free(memory);
+#else
+            std::free(memory);
+#endif
+        }
+
+        struct size_class_data
+        {
+            size_class_data()
+              : current_(nullptr), available_(nullptr), remote_free_(nullptr)
+            {}
+
+            // accessed by the owning thread only
+            slab_header* current_;      // slab blocks are taken from
+            slab_header* available_;    // other slabs with free blocks
+
+            // blocks released by other threads
+            std::atomic<free_block*> remote_free_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The statistics are modified by the owning thread only (except for
+        // the remote frees), they are atomic to allow for them to be read
+        // while collecting the performance counter values.
+        struct slab_heap
+        {
+            slab_heap()
+              : slab_count_(0), allocated_bytes_(0), freed_bytes_(0)
+              , remote_freed_bytes_(0), remote_frees_(0)
+            {}
+
+            static void add(
+                std::atomic<std::int64_t>& value, std::int64_t count)
+            {
+                value.store(value.load(std::memory_order_relaxed) + count,
+                    std::memory_order_relaxed);
+            }
+
+            slab_header* new_slab()
+            {
+                char* base = static_cast<char*>(allocate_slab_memory());
+
+                slab_header* slab = reinterpret_cast<slab_header*>(base);
+                slab->owner_ = this;
+                slab->prev_ = nullptr;
+                slab->next_ = nullptr;
+                slab->free_ = nullptr;
+                slab->bump_ = base + slab_header_size;
+                slab->used_ = 0;
+                slab->listed_ = false;
+
+                add(slab_count_, 1);
+                return slab;
+            }
+
+            void release_slab(slab_header* slab)
+            {
+                free_slab_memory(slab);
+                add(slab_count_, -1);
+            }
+
+            static void link(size_class_data& c, slab_header* slab)
+            {
+                slab->prev_ = nullptr;
+                slab->next_ = c.available_;
+                if (c.available_ != nullptr)
+                    c.available_->prev_ = slab;
+                c.available_ = slab;
+                slab->listed_ = true;
+            }
+
+            static void unlink(size_class_data& c, slab_header* slab)
+            {
+                if (slab->prev_ != nullptr)
+                    slab->prev_->next_ = slab->next_;
+                else
+                    c.available_ = slab->next_;
+                if (slab->next_ != nullptr)
+                    slab->next_->prev_ = slab->prev_;
+                slab->prev_ = slab->next_ = nullptr;
+                slab->listed_ = false;
+            }
+
+            static void* take_block(slab_header* slab, std::size_t block_size)
+            {
+                free_block* b = slab->free_;
+                if (b != nullptr)
+                {
+                    slab->free_ = b->next_;
+                }
+                else
+                {
+                    char* base = reinterpret_cast<char*>(slab);
+                    if (base + slab_size - slab->bump_ <
+                        static_cast<std::ptrdiff_t>(block_size))
+                    {
+                        return nullptr;
+                    }
+
+                    b = reinterpret_cast<free_block*>(slab->bump_);
+                    slab->bump_ += block_size;
+                }
+
+                ++slab->used_;
+                return b;
+            }
+
+            // Return a block to its slab. A slab which has no blocks in use
+            // anymore is released, unless blocks are currently taken from it.
+            void release_block(size_class_data& c, free_block* b)
+            {
+                slab_header* slab = get_slab(b);
+
+                b->next_ = slab->free_;
+                slab->free_ = b;
+                --slab->used_;
+
+                if (slab == c.current_)
+                    return;
+
+                if (slab->used_ == 0)
+                {
+                    if (slab->listed_)
+                        unlink(c, slab);
+                    release_slab(slab);
+                }
+                else if (!slab->listed_)
+                {
+                    link(c, slab);
+                }
+            }
+
+            void* allocate(std::size_t size_class)
+            {
+                size_class_data& c = classes_[size_class];
+                std::size_t const block_size = size_classes[size_class];
+
+                void* p = nullptr;
+                if (c.current_ != nullptr)
+                    p = take_block(c.current_, block_size);
+
+                if (p == nullptr)
+                {
+                    // pick up all blocks released by other threads
+                    free_block* b = c.remote_free_.exchange(
+                        nullptr, std::memory_order_acquire);
+                    while (b != nullptr)
+                    {
+                        free_block* next = b->next_;
+                        release_block(c, b);
+                        b = next;
+                    }
+
+                    if (c.current_ != nullptr)
+                        p = take_block(c.current_, block_size);
+                }
+
+                if (p == nullptr)
+                {
+                    // switch to another slab, the current one is full
+                    slab_header* slab = c.available_;
+                    if (slab != nullptr)
+                        unlink(c, slab);
+                    else
+                        slab = new_slab();
+
+                    c.current_ = slab;
+                    p = take_block(slab, block_size);
+                }
+
+                add(allocated_bytes_, static_cast<std::int64_t>(block_size));
+                return p;
+            }
+
+            void deallocate(void* p, std::size_t size_class)
+            {
+                release_block(
+                    classes_[size_class], static_cast<free_block*>(p));
+
+                add(freed_bytes_,
+                    static_cast<std::int64_t>(size_classes[size_class]));
+            }
+
+            void remote_deallocate(void* p, std::size_t size_class)
+            {
+                free_block* b = static_cast<free_block*>(p);
+                size_class_data& c = classes_[size_class];
+
+                b->next_ = c.remote_free_.load(std::memory_order_relaxed);
+                while (!c.remote_free_.compare_exchange_weak(b->next_, b,
+                    std::memory_order_release, std::memory_order_relaxed))
+                {
+                    /**/;
+                }
+
+                remote_freed_bytes_.fetch_add(
+                    static_cast<std::int64_t>(size_classes[size_class]),
+                    std::memory_order_relaxed);
+                remote_frees_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::int64_t in_use() const
+            {
+                return allocated_bytes_.load(std::memory_order_relaxed) -
+                    freed_bytes_.load(std::memory_order_relaxed) -
+                    remote_freed_bytes_.load(std::memory_order_relaxed);
+            }
+
+            size_class_data classes_[num_size_classes];
+
+            std::atomic<std::int64_t> slab_count_;
+            std::atomic<std::int64_t> allocated_bytes_;
+            std::atomic<std::int64_t> freed_bytes_;
+            std::atomic<std::int64_t> remote_freed_bytes_;
+            std::atomic<std::int64_t> remote_frees_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Keeps track of all heaps. Heaps are never destroyed as other threads
+        // might still hold blocks allocated from them. The heap of an exited
+        // thread is handed to the next thread in need of a heap.
+        struct heap_registry
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            slab_heap* acquire()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!orphans_.empty())
+                {
+                    slab_heap* heap = orphans_.back();
+                    orphans_.pop_back();
+                    return heap;
+                }
+
+                heaps_.push_back(new slab_heap);
+                return heaps_.back();
+            }
+
+            void release(slab_heap* heap)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                orphans_.push_back(heap);
+            }
+
+            template <typename F>
+            std::int64_t accumulate(F && f)
+            {
+                std::int64_t result = 0;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                for (slab_heap* heap : heaps_)
+                    result += f(*heap);
+
+                return result;
+            }
+
+            mutex_type mtx_;
+            std::vector<slab_heap*> heaps_;
+            std::vector<slab_heap*> orphans_;
+        };
+
+        heap_registry& get_registry()
+        {
+            // intentionally leaked, blocks might be released during static
+            // destruction
+            static heap_registry* registry = new heap_registry;
+            return *registry;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        thread_local slab_heap* current_heap = nullptr;
+        thread_local bool heap_released = false;
+
+        struct heap_holder
+        {
+            ~heap_holder()
+            {
+                if (heap_ != nullptr)
+                {
+                    current_heap = nullptr;
+                    heap_released = true;
+                    get_registry().release(heap_);
+                }
+            }
+
+            slab_heap* heap_;
+        };
+
+        thread_local heap_holder holder = { nullptr };
+
+        slab_heap* get_heap()
+        {
+            slab_heap* heap = current_heap;
+            if (heap != nullptr)
+                return heap;
+
+            heap = get_registry().acquire();
+            current_heap = heap;
+
+            // a thread allocating while being torn down keeps its new heap
+            if (!heap_released)
+                holder.heap_ = heap;
+
+            return heap;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* slab_allocate(std::size_t size)
+    {
+        if (size > HPX_SLAB_ALLOCATOR_MAX_SIZE)
+            return ::operator new(size);
+
+        return get_heap()->allocate(get_size_class(size));
+    }
+
+    void slab_deallocate(void* p, std::size_t size) noexcept
+    {
+        if (p == nullptr)
+            return;
+
+        if (size > HPX_SLAB_ALLOCATOR_MAX_SIZE)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        slab_heap* owner = get_slab(p)->owner_;
+        if (owner == current_heap)
+            owner->deallocate(p, get_size_class(size));
+        else
+            owner->remote_deallocate(p, get_size_class(size));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t get_slab_count(bool)
+    {
+        return get_registry().accumulate(
+            [](slab_heap const& heap)
+            {
+                return heap.slab_count_.load(std::memory_order_relaxed);
+            });
+    }
+
+    std::int64_t get_slab_allocated_bytes(bool)
+    {
+        return get_registry().accumulate(
+            [](slab_heap const& heap)
+            {
+                return heap.in_use();
+            });
+    }
+
+    std::int64_t get_slab_occupancy(bool)
+    {
+        std::int64_t capacity = get_slab_count(false) *
+            static_cast<std::int64_t>(slab_size - slab_header_size);
+        if (capacity == 0)
+            return 0;
+
+        return (get_slab_allocated_bytes(false) * 10000) / capacity;
+    }
+
+    std::int64_t get_slab_remote_free_count(bool reset)
+    {
+        return get_registry().accumulate(
+            [reset](slab_heap& heap) -> std::int64_t
+            {
+                if (reset)
+                {
+                    return heap.remote_frees_.exchange(
+                        0, std::memory_order_relaxed);
+                }
+                return heap.remote_frees_.load(std::memory_order_relaxed);
+            });
+    }
+}}
+
+#else
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    void* slab_allocate(std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    void slab_deallocate(void* p, std::size_t) noexcept
+    {
+        ::operator delete(p);
+    }
+
+    std::int64_t get_slab_count(bool)
+    {
+        return 0;
+    }
+
+    std::int64_t get_slab_allocated_bytes(bool)
+    {
+        return 0;
+    }
+
+    std::int64_t get_slab_occupancy(bool)
+    {
+        return 0;
+    }
+
+    std::int64_t get_slab_remote_free_count(bool)
+    {
+        return 0;
+    }
+}}
+
+#endif
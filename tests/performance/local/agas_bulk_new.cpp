@@ -0,0 +1,161 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the time needed to create components one by one and in bulk. Both
+// draw their global ids from the local id pool, the number of times the
+// pool had to wait for AGAS to allocate a new block is reported as well.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::init;
+using hpx::finalize;
+
+using hpx::find_here;
+using hpx::naming::id_type;
+
+using hpx::util::high_resolution_timer;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server : hpx::components::component_base<test_server>
+{
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+///////////////////////////////////////////////////////////////////////////////
+void report(char const* name, std::uint64_t count, double duration, bool csv)
+{
+    std::int64_t stalls =
+        hpx::get_runtime().get_id_pool().get_stall_count(true);
+
+    if (csv)
+        hpx::util::format_to(cout,
+            "%1%,%2%,%3%,%4%\n",
+            name,
+            count,
+            duration,
+            stalls) << flush;
+    else
+        hpx::util::format_to(cout,
+            "created %1% components (%2%) in %3% seconds, "
+            "id pool stalls: %4%\n",
+            count,
+            name,
+            duration,
+            stalls) << flush;
+}
+
+void measure_single_new(std::uint64_t count, bool csv)
+{
+    const id_type here = find_here();
+
+    std::vector<hpx::future<id_type> > ids;
+    ids.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+        ids.push_back(hpx::new_<test_server>(here));
+
+    hpx::wait_all(ids);
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    report("single", count, duration, csv);
+}
+
+void measure_bulk_new(std::uint64_t count, std::uint64_t batch, bool csv)
+{
+    const id_type here = find_here();
+
+    std::vector<hpx::future<std::vector<id_type> > > ids;
+    ids.reserve(count / batch + 1);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; i += batch)
+    {
+        std::uint64_t size = (count - i < batch) ? count - i : batch;
+        ids.push_back(hpx::new_<test_server[]>(here, size));
+    }
+
+    hpx::wait_all(ids);
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    report("bulk", count, duration, csv);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(
+    variables_map& vm
+    )
+{
+    {
+        const std::uint64_t count = vm["components"].as<std::uint64_t>();
+        const std::uint64_t batch = vm["batch-size"].as<std::uint64_t>();
+
+        if (HPX_UNLIKELY(0 == count))
+            throw std::logic_error("error: count of 0 components specified\n");
+        if (HPX_UNLIKELY(0 == batch))
+            throw std::logic_error("error: batch size of 0 specified\n");
+
+        // reset the stall counter
+        hpx::get_runtime().get_id_pool().get_stall_count(true);
+
+        measure_single_new(count, vm.count("csv") != 0);
+        measure_bulk_new(count, batch, vm.count("csv") != 0);
+    }
+
+    finalize();
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "components"
+        , value<std::uint64_t>()->default_value(100000)
+        , "number of components to create")
+
+        ( "batch-size"
+        , value<std::uint64_t>()->default_value(1000)
+        , "number of components created by a single bulk request")
+
+        ( "csv"
+        , "output results as csv (format: name,count,duration,stalls)")
+        ;
+
+    // Initialize and run HPX.
+    return init(cmdline, argc, argv);
+}
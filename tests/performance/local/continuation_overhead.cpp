@@ -0,0 +1,119 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time needed to run long chains of tiny
+// continuations attached with future::then, once using the default launch
+// policy and once using the adaptive continuation executor, which runs
+// continuations inline up to a recursion depth budget.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/continuation_statistics.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t increment(hpx::future<std::uint64_t> f)
+{
+    return f.get() + 1;
+}
+
+// the chain is attached to a future which becomes ready only after the
+// whole chain was built, all continuations are triggered by a single
+// set_value
+template <typename... Executor>
+double measure_deferred(std::uint64_t length, Executor&&... exec)
+{
+    hpx::util::high_resolution_timer walltime;
+
+    hpx::lcos::local::promise<std::uint64_t> p;
+    hpx::future<std::uint64_t> f = p.get_future();
+
+    for (std::uint64_t i = 0; i != length; ++i)
+        f = f.then(exec..., &increment);
+
+    p.set_value(0);
+    if (f.get() != length)
+        hpx::cout << "unexpected result of chain\n" << hpx::flush;
+
+    return walltime.elapsed();
+}
+
+// the continuations are attached to already ready futures
+template <typename... Executor>
+double measure_ready(std::uint64_t length, Executor&&... exec)
+{
+    hpx::util::high_resolution_timer walltime;
+
+    hpx::future<std::uint64_t> f = hpx::make_ready_future(std::uint64_t(0));
+    for (std::uint64_t i = 0; i != length; ++i)
+        f = f.then(exec..., &increment);
+
+    if (f.get() != length)
+        hpx::cout << "unexpected result of chain\n" << hpx::flush;
+
+    return walltime.elapsed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    std::uint64_t length = vm["length"].as<std::uint64_t>();
+    std::size_t max_depth = vm["max-depth"].as<std::size_t>();
+
+    hpx::parallel::execution::adaptive_continuation_executor exec(max_depth);
+
+    double t1 = measure_deferred(length);
+    double t2 = measure_ready(length);
+
+    hpx::util::get_inlined_continuation_count(true);
+    hpx::util::get_spawned_continuation_count(true);
+
+    double t3 = measure_deferred(length, exec);
+    double t4 = measure_ready(length, exec);
+
+    hpx::util::format_to(hpx::cout,
+        "threads: %1%, length: %2%, max-depth: %3%\n"
+        "then (deferred chain):                   %4% [s]\n"
+        "then (ready chain):                      %5% [s]\n"
+        "then(adaptive executor, deferred chain): %6% [s]\n"
+        "then(adaptive executor, ready chain):    %7% [s]\n"
+        "inlined continuations: %8%, spawned continuations: %9%\n",
+        hpx::get_os_thread_count(), length, max_depth, t1, t2, t3, t4,
+        hpx::util::get_inlined_continuation_count(false),
+        hpx::util::get_spawned_continuation_count(false)) << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "length"
+        , value<std::uint64_t>()->default_value(100000)
+        , "number of continuations in each chain")
+
+        ( "max-depth"
+        , value<std::size_t>()->default_value(
+            HPX_CONTINUATION_MAX_RECURSION_DEPTH)
+        , "recursion depth up to which continuations are run inline")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,138 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of the suspending mutex under
+// contention, similar to spinlock_overhead1/2. Each task updates one out of
+// N globals protected by a mutex, performing some work outside of the
+// critical section. The spinlock is included as a baseline.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the delay from being optimized away
+double global_scratch = 0;
+std::uint64_t num_iterations = 0;
+std::size_t num_mutexes = 1;
+
+std::unique_ptr<double[]> global_init;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+double null_function(Mutex* mtx, std::size_t i)
+{
+    double d = 0.;
+    std::size_t idx = i % num_mutexes;
+    {
+        std::lock_guard<Mutex> l(mtx[idx]);
+        d = global_init[idx];
+    }
+    for (double j = 0; j < num_iterations; ++j)
+    {
+        d += 1 / (2. * j + 1);
+    }
+    {
+        std::lock_guard<Mutex> l(mtx[idx]);
+        global_init[idx] = d;
+    }
+    return d;
+}
+
+template <typename Mutex>
+double measure(Mutex* mtx, std::uint64_t count)
+{
+    global_init.reset(new double[num_mutexes]());
+
+    std::vector<hpx::future<double> > futures;
+    futures.reserve(count);
+
+    hpx::util::high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+        futures.push_back(hpx::async(&null_function<Mutex>, mtx, i));
+
+    for (hpx::future<double>& f : futures)
+        global_scratch += f.get();
+
+    return walltime.elapsed();
+}
+
+struct fair_mutex : hpx::lcos::local::mutex
+{
+    fair_mutex()
+      : hpx::lcos::local::mutex("fair_mutex",
+            hpx::lcos::local::mutex_policy::fair)
+    {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        num_iterations = vm["delay-iterations"].as<std::uint64_t>();
+        num_mutexes = vm["mutexes"].as<std::size_t>();
+
+        std::uint64_t const count = vm["futures"].as<std::uint64_t>();
+
+        std::unique_ptr<hpx::lcos::local::spinlock[]> spinlocks(
+            new hpx::lcos::local::spinlock[num_mutexes]);
+        std::unique_ptr<hpx::lcos::local::mutex[]> mutexes(
+            new hpx::lcos::local::mutex[num_mutexes]);
+        std::unique_ptr<fair_mutex[]> fair_mutexes(
+            new fair_mutex[num_mutexes]);
+
+        double t1 = measure(spinlocks.get(), count);
+        double t2 = measure(mutexes.get(), count);
+        double t3 = measure(fair_mutexes.get(), count);
+
+        hpx::util::format_to(hpx::cout,
+            "threads: %1%, futures: %2%, mutexes: %3%, delay: %4%\n"
+            "spinlock:   %5% [s]\n"
+            "mutex:      %6% [s]\n"
+            "fair mutex: %7% [s]\n",
+            hpx::get_os_thread_count(), count, num_mutexes, num_iterations,
+            t1, t2, t3) << hpx::flush;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "futures"
+        , value<std::uint64_t>()->default_value(500000)
+        , "number of futures to invoke")
+
+        ( "mutexes"
+        , value<std::size_t>()->default_value(1)
+        , "number of mutexes the futures are distributed over")
+
+        ( "delay-iterations"
+        , value<std::uint64_t>()->default_value(0)
+        , "number of iterations in the delay loop")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,155 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/parallel_set_operations.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 10;
+
+std::vector<std::size_t> make_sorted(std::size_t size, std::size_t range)
+{
+    std::vector<std::size_t> v(size);
+    for (std::size_t& e : v)
+        e = std::rand() % range;
+    std::sort(std::begin(v), std::end(v));
+    return v;
+}
+
+template <typename ExPolicy, typename SetOp>
+double measure(ExPolicy policy, std::vector<std::size_t> const& c1,
+    std::vector<std::size_t> const& c2, std::vector<std::size_t>& dest,
+    SetOp && op)
+{
+    std::uint64_t elapsed = 0;
+    for (int i = 0; i != test_count; ++i)
+    {
+        std::uint64_t start = hpx::util::high_resolution_clock::now();
+        op(policy, std::begin(c1), std::end(c1), std::begin(c2), std::end(c2),
+            std::begin(dest));
+        elapsed += hpx::util::high_resolution_clock::now() - start;
+    }
+    return elapsed / (1e9 * test_count);
+}
+
+#define HPX_SET_OPERATION(name)                                               \
+    struct name##_op                                                          \
+    {                                                                         \
+        template <typename ExPolicy, typename Iter, typename OutIter>         \
+        void operator()(ExPolicy policy, Iter first1, Iter last1,             \
+            Iter first2, Iter last2, OutIter dest) const                      \
+        {                                                                     \
+            hpx::parallel::name(policy, first1, last1, first2, last2, dest);  \
+        }                                                                     \
+    };                                                                        \
+/**/
+
+HPX_SET_OPERATION(set_union)
+HPX_SET_OPERATION(set_intersection)
+HPX_SET_OPERATION(set_difference)
+HPX_SET_OPERATION(set_symmetric_difference)
+
+#undef HPX_SET_OPERATION
+
+template <typename SetOp>
+void measure_set_operation(std::string const& name,
+    std::vector<std::size_t> const& c1, std::vector<std::size_t> const& c2,
+    std::vector<std::size_t>& dest, bool csvoutput, SetOp && op)
+{
+    using namespace hpx::parallel;
+
+    double seq_time = measure(execution::seq, c1, c2, dest, op);
+    double par_time = measure(execution::par, c1, c2, dest, op);
+
+    if (csvoutput)
+    {
+        hpx::cout << name << "," << seq_time << "," << par_time << "\n"
+            << hpx::flush;
+    }
+    else
+    {
+        hpx::cout << std::left << std::setw(26) << name
+            << " seq: " << std::right << std::setw(12) << seq_time
+            << " par: " << std::setw(12) << par_time
+            << " speedup: " << std::setw(8) << seq_time / par_time << "\n"
+            << hpx::flush;
+    }
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    std::size_t range = vm["range"].as<std::size_t>();
+    bool csvoutput = vm["csv_output"].as<int>() ? true : false;
+    test_count = vm["test_count"].as<int>();
+
+    if (test_count <= 0)
+    {
+        hpx::cout << "test_count cannot be less than or equal to zero...\n"
+            << hpx::flush;
+        return hpx::finalize();
+    }
+
+    if (range == 0)
+        range = 2 * vector_size;
+
+    std::vector<std::size_t> c1 = make_sorted(vector_size, range);
+    std::vector<std::size_t> c2 = make_sorted(vector_size, range);
+    std::vector<std::size_t> dest(2 * vector_size);
+
+    measure_set_operation("set_union", c1, c2, dest, csvoutput,
+        set_union_op());
+    measure_set_operation("set_intersection", c1, c2, dest, csvoutput,
+        set_intersection_op());
+    measure_set_operation("set_difference", c1, c2, dest, csvoutput,
+        set_difference_op());
+    measure_set_operation("set_symmetric_difference", c1, c2, dest,
+        csvoutput, set_symmetric_difference_op());
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(1000000)
+        , "number of elements in each of the input sequences")
+
+        ("range"
+        , boost::program_options::value<std::size_t>()->default_value(0)
+        , "range of the element values, small values create many "
+          "equivalent elements (default: 2 * vector_size)")
+
+        ("csv_output"
+        , boost::program_options::value<int>()->default_value(0)
+        , "print results in csv format")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(10)
+        , "number of tests to take average from")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -0,0 +1,120 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the reader-biased shared mutex against the
+// default shared mutex for a read-mostly workload. Each task acquires the
+// mutex repeatedly, every write-ratio'th acquisition is exclusive.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/thread/locks.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the accesses from being optimized away
+std::uint64_t table[16] = { 0 };
+std::uint64_t global_scratch = 0;
+
+template <typename Mutex>
+double measure(std::uint64_t tasks, std::uint64_t iterations,
+    std::uint64_t write_ratio)
+{
+    Mutex mtx;
+
+    hpx::util::high_resolution_timer walltime;
+
+    std::vector<hpx::future<std::uint64_t> > futures;
+    futures.reserve(tasks);
+
+    for (std::uint64_t t = 0; t != tasks; ++t)
+    {
+        futures.push_back(hpx::async(
+            [&mtx, iterations, write_ratio]() -> std::uint64_t
+            {
+                std::uint64_t sum = 0;
+                for (std::uint64_t i = 0; i != iterations; ++i)
+                {
+                    if (write_ratio != 0 && i % write_ratio == 0)
+                    {
+                        std::lock_guard<Mutex> l(mtx);
+                        ++table[i % 16];
+                    }
+                    else
+                    {
+                        boost::shared_lock<Mutex> l(mtx);
+                        sum += table[i % 16];
+                    }
+                }
+                return sum;
+            }));
+    }
+
+    for (hpx::future<std::uint64_t>& f : futures)
+        global_scratch += f.get();
+
+    return walltime.elapsed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    std::uint64_t tasks = vm["tasks"].as<std::uint64_t>();
+    std::uint64_t iterations = vm["iterations"].as<std::uint64_t>();
+    std::uint64_t write_ratio = vm["write-ratio"].as<std::uint64_t>();
+
+    if (tasks == 0)
+        tasks = hpx::get_os_thread_count();
+
+    double t1 = measure<hpx::lcos::local::shared_mutex>(
+        tasks, iterations, write_ratio);
+    double t2 = measure<hpx::lcos::local::reader_biased_shared_mutex>(
+        tasks, iterations, write_ratio);
+
+    hpx::util::format_to(hpx::cout,
+        "threads: %1%, tasks: %2%, iterations: %3%, write-ratio: %4%\n"
+        "shared_mutex:               %5% [s]\n"
+        "reader_biased_shared_mutex: %6% [s]\n",
+        hpx::get_os_thread_count(), tasks, iterations, write_ratio,
+        t1, t2) << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "tasks"
+        , value<std::uint64_t>()->default_value(0)
+        , "number of concurrent tasks (default: number of cores)")
+
+        ( "iterations"
+        , value<std::uint64_t>()->default_value(1000000)
+        , "number of lock acquisitions per task")
+
+        ( "write-ratio"
+        , value<std::uint64_t>()->default_value(1000)
+        , "every n-th acquisition is exclusive (0: read only)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
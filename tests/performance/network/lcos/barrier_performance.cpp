@@ -6,8 +6,10 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 #include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/communicator.hpp>
 
 #include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -33,11 +35,44 @@ void global_barrier()
     }
 }
 
+// the communicator pre-resolves all of its peers, each operation takes
+// log(num_localities) steps
+void communicator_collectives()
+{
+    hpx::lcos::communicator comm("communicator_barrier");
+
+    hpx::util::high_resolution_timer t;
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        comm.barrier();
+    }
+    double elapsed_barrier = t.elapsed();
+
+    t.restart();
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        sum += comm.all_reduce(i, std::plus<std::size_t>());
+    }
+    double elapsed_all_reduce = t.elapsed();
+
+    if (hpx::get_locality_id() == 0)
+    {
+        std::cout
+            << "Communicator barrier: " << elapsed_barrier/iterations
+                << " (seconds)\n"
+            << "Communicator all_reduce: " << elapsed_all_reduce/iterations
+                << " (seconds)\n";
+    }
+    HPX_ASSERT(sum == comm.size() * iterations * (iterations - 1) / 2);
+}
+
 int hpx_main()
 {
     if (hpx::get_locality_id() == 0)
         startup_end = hpx::util::high_resolution_timer::now();
     global_barrier();
+    communicator_collectives();
 
     if (hpx::get_locality_id() == 0)
         shutdown_start = hpx::util::high_resolution_timer::now();
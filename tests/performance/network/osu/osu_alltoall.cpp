@@ -0,0 +1,105 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// All-to-all latency test, window-size operations are kept in flight
+// concurrently
+
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/communicator.hpp>
+
+#include <cstddef>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+#define SKIP 10
+
+std::vector<double> run_alltoall(std::size_t min_size, std::size_t max_size,
+    std::size_t loop, std::size_t window_size)
+{
+    hpx::lcos::communicator comm("/osu/alltoall");
+
+    std::vector<double> latencies;
+    for (std::size_t size = min_size; size <= max_size; size *= 2)
+    {
+        // every participant sends size bytes to every other one
+        std::vector<std::vector<char> > send_buffer(
+            comm.size(), std::vector<char>(size));
+
+        hpx::util::high_resolution_timer t;
+        for (std::size_t i = 0; i != loop + SKIP; ++i)
+        {
+            // do not measure warm up phase
+            if (i == SKIP)
+            {
+                comm.barrier();
+                t.restart();
+            }
+
+            std::vector<hpx::future<std::vector<std::vector<char> > > > ops;
+            ops.reserve(window_size);
+            for (std::size_t j = 0; j != window_size; ++j)
+            {
+                ops.push_back(
+                    comm.all_to_all(hpx::launch::async, send_buffer));
+            }
+            hpx::wait_all(ops);
+        }
+
+        double elapsed = t.elapsed();
+        latencies.push_back((elapsed * 1e6) / (loop * window_size));
+    }
+    return latencies;
+}
+HPX_PLAIN_ACTION(run_alltoall);
+
+///////////////////////////////////////////////////////////////////////////////
+void print_header()
+{
+    hpx::cout << "# OSU HPX All-to-All Latency Test\n"
+              << "# Size    Avg Latency (microsec)"
+              << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void run_benchmark(boost::program_options::variables_map & vm)
+{
+    std::size_t window_size = vm["window-size"].as<std::size_t>();
+    std::size_t loop = vm["loop"].as<std::size_t>();
+    std::size_t min_size = vm["min-size"].as<std::size_t>();
+    std::size_t max_size = vm["max-size"].as<std::size_t>();
+
+    if(max_size < min_size) std::swap(max_size, min_size);
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::vector<hpx::future<std::vector<double> > > results;
+    results.reserve(localities.size());
+    for (hpx::id_type const& id : localities)
+    {
+        results.push_back(hpx::async(run_alltoall_action(), id,
+            min_size, max_size, loop, window_size));
+    }
+
+    // report the latency averaged over all localities
+    std::vector<double> latencies;
+    for (hpx::future<std::vector<double> >& f : results)
+    {
+        std::vector<double> l = f.get();
+        latencies.resize(l.size(), 0.0);
+        for (std::size_t i = 0; i != l.size(); ++i)
+            latencies[i] += l[i] / localities.size();
+    }
+
+    std::size_t size = min_size;
+    for (double latency : latencies)
+    {
+        hpx::cout << std::left << std::setw(10) << size
+                  << latency << hpx::endl << hpx::flush;
+        size *= 2;
+    }
+}
@@ -0,0 +1,108 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Reduce-scatter latency test, window-size operations are kept in flight
+// concurrently
+
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/communicator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+#define SKIP 10
+
+std::vector<double> run_reduce_scatter(std::size_t min_size,
+    std::size_t max_size, std::size_t loop, std::size_t window_size)
+{
+    hpx::lcos::communicator comm("/osu/reduce_scatter");
+
+    std::vector<double> latencies;
+    for (std::size_t size = min_size; size <= max_size; size *= 2)
+    {
+        // every participant contributes size bytes, the combined values
+        // are pipelined around the ring in chunks
+        std::vector<double> send_buffer(
+            (std::max)(size / sizeof(double), std::size_t(1)), 1.0);
+
+        hpx::util::high_resolution_timer t;
+        for (std::size_t i = 0; i != loop + SKIP; ++i)
+        {
+            // do not measure warm up phase
+            if (i == SKIP)
+            {
+                comm.barrier();
+                t.restart();
+            }
+
+            std::vector<hpx::future<std::vector<double> > > ops;
+            ops.reserve(window_size);
+            for (std::size_t j = 0; j != window_size; ++j)
+            {
+                ops.push_back(comm.reduce_scatter(hpx::launch::async,
+                    send_buffer, std::plus<double>()));
+            }
+            hpx::wait_all(ops);
+        }
+
+        double elapsed = t.elapsed();
+        latencies.push_back((elapsed * 1e6) / (loop * window_size));
+    }
+    return latencies;
+}
+HPX_PLAIN_ACTION(run_reduce_scatter);
+
+///////////////////////////////////////////////////////////////////////////////
+void print_header()
+{
+    hpx::cout << "# OSU HPX Reduce-Scatter Latency Test\n"
+              << "# Size    Avg Latency (microsec)"
+              << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void run_benchmark(boost::program_options::variables_map & vm)
+{
+    std::size_t window_size = vm["window-size"].as<std::size_t>();
+    std::size_t loop = vm["loop"].as<std::size_t>();
+    std::size_t min_size = vm["min-size"].as<std::size_t>();
+    std::size_t max_size = vm["max-size"].as<std::size_t>();
+
+    if(max_size < min_size) std::swap(max_size, min_size);
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::vector<hpx::future<std::vector<double> > > results;
+    results.reserve(localities.size());
+    for (hpx::id_type const& id : localities)
+    {
+        results.push_back(hpx::async(run_reduce_scatter_action(), id,
+            min_size, max_size, loop, window_size));
+    }
+
+    // report the latency averaged over all localities
+    std::vector<double> latencies;
+    for (hpx::future<std::vector<double> >& f : results)
+    {
+        std::vector<double> l = f.get();
+        latencies.resize(l.size(), 0.0);
+        for (std::size_t i = 0; i != l.size(); ++i)
+            latencies[i] += l[i] / localities.size();
+    }
+
+    std::size_t size = min_size;
+    for (double latency : latencies)
+    {
+        hpx::cout << std::left << std::setw(10) << size
+                  << latency << hpx::endl << hpx::flush;
+        size *= 2;
+    }
+}
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_generate.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct random_fill
+{
+    random_fill()
+      : gen(std::rand()),
+        dist(0, 1000)
+    {}
+
+    std::uint64_t operator()()
+    {
+        return dist(gen);
+    }
+
+    std::mt19937 gen;
+    std::uniform_int_distribution<std::uint64_t> dist;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename InIter, typename OutIter>
+double run_inclusive_scan_benchmark_std(int test_count,
+    InIter first, InIter last, OutIter dest)
+{
+    std::uint64_t time = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i < test_count; ++i)
+    {
+        std::partial_sum(first, last, dest);
+    }
+
+    time = hpx::util::high_resolution_clock::now() - time;
+
+    return (time * 1e-9) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename FwdIter1, typename FwdIter2>
+double run_inclusive_scan_benchmark_hpx(int test_count, ExPolicy policy,
+    FwdIter1 first, FwdIter1 last, FwdIter2 dest)
+{
+    std::uint64_t time = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i < test_count; ++i)
+    {
+        hpx::parallel::inclusive_scan(policy, first, last, dest,
+            std::plus<std::uint64_t>());
+    }
+
+    time = hpx::util::high_resolution_clock::now() - time;
+
+    return (time * 1e-9) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename FwdIter1, typename FwdIter2>
+double run_exclusive_scan_benchmark_hpx(int test_count, ExPolicy policy,
+    FwdIter1 first, FwdIter1 last, FwdIter2 dest)
+{
+    std::uint64_t time = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i < test_count; ++i)
+    {
+        hpx::parallel::exclusive_scan(policy, first, last, dest,
+            std::uint64_t(0), std::plus<std::uint64_t>());
+    }
+
+    time = hpx::util::high_resolution_clock::now() - time;
+
+    return (time * 1e-9) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void run_benchmark(std::size_t vector_size, int test_count)
+{
+    std::cout << "* Preparing Benchmark..." << std::endl;
+
+    std::vector<std::uint64_t> v(vector_size);
+    std::vector<std::uint64_t> result(vector_size);
+
+    // initialize data
+    using namespace hpx::parallel;
+    generate(execution::par, std::begin(v), std::end(v), random_fill());
+
+    auto first = std::begin(v);
+    auto last = std::end(v);
+    auto dest = std::begin(result);
+
+    std::cout << "* Running Benchmark..." << std::endl;
+
+    std::cout << "--- run_inclusive_scan_benchmark_std ---" << std::endl;
+    double time_std =
+        run_inclusive_scan_benchmark_std(test_count, first, last, dest);
+
+    std::cout << "--- run_inclusive_scan_benchmark_seq ---" << std::endl;
+    double time_seq =
+        run_inclusive_scan_benchmark_hpx(test_count, execution::seq,
+            first, last, dest);
+
+    std::cout << "--- run_inclusive_scan_benchmark_par ---" << std::endl;
+    double time_par =
+        run_inclusive_scan_benchmark_hpx(test_count, execution::par,
+            first, last, dest);
+
+    std::cout << "--- run_exclusive_scan_benchmark_par ---" << std::endl;
+    double time_exclusive_par =
+        run_exclusive_scan_benchmark_hpx(test_count, execution::par,
+            first, last, dest);
+
+    std::cout << "\n-------------- Benchmark Result --------------" << std::endl;
+    auto fmt = "%1% (%2%) : %3%(sec)";
+    hpx::util::format_to(std::cout, fmt, "inclusive_scan", "std", time_std)
+        << std::endl;
+    hpx::util::format_to(std::cout, fmt, "inclusive_scan", "seq", time_seq)
+        << std::endl;
+    hpx::util::format_to(std::cout, fmt, "inclusive_scan", "par", time_par)
+        << std::endl;
+    hpx::util::format_to(std::cout, fmt, "exclusive_scan", "par",
+        time_exclusive_par) << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+}
+///////////////////////////////////////////////////////////////////////////////
+// Robert Jenkins' 32 bit integer hash function.
+std::uint32_t hash(std::uint32_t n)
+{
+    n = (n + 0x7ed55d16) + (n << 12);
+    n = (n ^ 0xc761c23c) ^ (n >> 19);
+    n = (n + 0x165667b1) + (n << 5);
+    n = (n + 0xd3a2646c) ^ (n << 9);
+    n = (n + 0xfd7046c5) + (n << 3);
+    n = (n ^ 0xb55a4f09) ^ (n >> 16);
+    return n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    // If simply using current time as seed, random numbers are closer
+    //     when time is closer.
+    std::uint32_t seed = hash(std::uint32_t(std::time(nullptr)));
+    if (vm.count("seed"))
+        seed = vm["seed"].as<std::uint32_t>();
+
+    std::srand(static_cast<unsigned int>(seed));
+
+    // pull values from cmd
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    int test_count = vm["test_count"].as<int>();
+
+    std::size_t const os_threads = hpx::get_os_thread_count();
+
+    std::cout << "-------------- Benchmark Config --------------" << std::endl;
+    std::cout << "seed            : " << seed << std::endl;
+    std::cout << "vector_size     : " << vector_size << std::endl;
+    std::cout << "test_count      : " << test_count << std::endl;
+    std::cout << "os threads      : " << os_threads << std::endl;
+    std::cout << "----------------------------------------------\n" << std::endl;
+
+    run_benchmark(vector_size, test_count);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("vector_size",
+            boost::program_options::value<std::size_t>()->default_value(10000000),
+            "size of vector (default: 10000000)")
+        ("test_count",
+            boost::program_options::value<int>()->default_value(10),
+            "number of tests to be averaged (default: 10)")
+        ("seed,s", boost::program_options::value<std::uint32_t>(),
+            "the random number generator seed to use for this run")
+        ;
+
+    // initialize program
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_generate.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct random_fill
+{
+    random_fill()
+        : gen(std::rand()),
+        dist(0, (std::numeric_limits<int>::max)())
+    {}
+
+    int operator()()
+    {
+        return dist(gen);
+    }
+
+    std::mt19937 gen;
+    std::uniform_int_distribution<> dist;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename OrgIter, typename RandomIt>
+double run_stable_sort_benchmark_std(int test_count,
+    OrgIter org_first, OrgIter org_last, RandomIt first, RandomIt last,
+    std::size_t num_keys)
+{
+    std::uint64_t time = std::uint64_t(0);
+
+    for (int i = 0; i < test_count; ++i)
+    {
+        // Restore [first, last) with original data.
+        hpx::parallel::copy(hpx::parallel::execution::par,
+            org_first, org_last, first);
+
+        std::uint64_t elapsed = hpx::util::high_resolution_clock::now();
+        std::stable_sort(first, last,
+            [num_keys](int lhs, int rhs)
+            {
+                return lhs % num_keys < rhs % num_keys;
+            });
+        time += hpx::util::high_resolution_clock::now() - elapsed;
+    }
+
+    return (time * 1e-9) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename OrgIter, typename RandomIt>
+double run_stable_sort_benchmark_hpx(int test_count, ExPolicy policy,
+    OrgIter org_first, OrgIter org_last, RandomIt first, RandomIt last,
+    std::size_t num_keys)
+{
+    std::uint64_t time = std::uint64_t(0);
+
+    for (int i = 0; i < test_count; ++i)
+    {
+        // Restore [first, last) with original data.
+        hpx::parallel::copy(hpx::parallel::execution::par,
+            org_first, org_last, first);
+
+        std::uint64_t elapsed = hpx::util::high_resolution_clock::now();
+        hpx::parallel::stable_sort(policy, first, last,
+            [num_keys](int lhs, int rhs)
+            {
+                return lhs % num_keys < rhs % num_keys;
+            });
+        time += hpx::util::high_resolution_clock::now() - elapsed;
+    }
+
+    return (time * 1e-9) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void run_benchmark(std::size_t vector_size, int test_count,
+    std::size_t num_keys)
+{
+    std::cout << "* Preparing Benchmark..." << std::endl;
+
+    std::vector<int> v(vector_size);
+    // initialize data
+    using namespace hpx::parallel;
+    generate(execution::par, std::begin(v), std::end(v), random_fill());
+    std::vector<int> org_v = v;
+
+    auto first = std::begin(v);
+    auto last = std::end(v);
+    auto org_first = std::begin(org_v);
+    auto org_last = std::end(org_v);
+
+    std::cout << "* Running Benchmark..." << std::endl;
+
+    std::cout << "--- run_stable_sort_benchmark_std ---" << std::endl;
+    double time_std =
+        run_stable_sort_benchmark_std(test_count, org_first, org_last,
+            first, last, num_keys);
+
+    std::cout << "--- run_stable_sort_benchmark_seq ---" << std::endl;
+    double time_seq =
+        run_stable_sort_benchmark_hpx(test_count, execution::seq,
+            org_first, org_last, first, last, num_keys);
+
+    std::cout << "--- run_stable_sort_benchmark_par ---" << std::endl;
+    double time_par =
+        run_stable_sort_benchmark_hpx(test_count, execution::par,
+            org_first, org_last, first, last, num_keys);
+
+    std::cout << "--- run_stable_sort_benchmark_par_unseq ---" << std::endl;
+    double time_par_unseq =
+        run_stable_sort_benchmark_hpx(test_count, execution::par_unseq,
+            org_first, org_last, first, last, num_keys);
+
+    std::cout << "\n-------------- Benchmark Result --------------" << std::endl;
+    auto fmt = "stable_sort (%1%) : %2%(sec)";
+    hpx::util::format_to(std::cout, fmt, "std", time_std) << std::endl;
+    hpx::util::format_to(std::cout, fmt, "seq", time_seq) << std::endl;
+    hpx::util::format_to(std::cout, fmt, "par", time_par) << std::endl;
+    hpx::util::format_to(std::cout, fmt, "par_unseq", time_par_unseq) << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Robert Jenkins' 32 bit integer hash function.
+std::uint32_t hash(std::uint32_t n)
+{
+    n = (n + 0x7ed55d16) + (n << 12);
+    n = (n ^ 0xc761c23c) ^ (n >> 19);
+    n = (n + 0x165667b1) + (n << 5);
+    n = (n + 0xd3a2646c) ^ (n << 9);
+    n = (n + 0xfd7046c5) + (n << 3);
+    n = (n ^ 0xb55a4f09) ^ (n >> 16);
+    return n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    // If simply using current time as seed, random numbers are closer
+    //     when time is closer.
+    std::uint32_t seed = hash(std::uint32_t(std::time(nullptr)));
+    if (vm.count("seed"))
+        seed = vm["seed"].as<std::uint32_t>();
+
+    std::srand(static_cast<unsigned int>(seed));
+
+    // pull values from cmd
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    std::size_t num_keys = vm["num_keys"].as<std::size_t>();
+    int test_count = vm["test_count"].as<int>();
+
+    std::size_t const os_threads = hpx::get_os_thread_count();
+
+    std::cout << "-------------- Benchmark Config --------------" << std::endl;
+    std::cout << "seed            : " << seed << std::endl;
+    std::cout << "vector_size     : " << vector_size << std::endl;
+    std::cout << "num_keys        : " << num_keys << std::endl;
+    std::cout << "test_count      : " << test_count << std::endl;
+    std::cout << "os threads      : " << os_threads << std::endl;
+    std::cout << "----------------------------------------------\n" << std::endl;
+
+    run_benchmark(vector_size, test_count, num_keys);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("vector_size",
+            boost::program_options::value<std::size_t>()->default_value(1000000),
+            "size of vector (default: 1000000)")
+        ("num_keys",
+            boost::program_options::value<std::size_t>()->default_value(1000),
+            "number of distinct sort keys (default: 1000)")
+        ("test_count",
+            boost::program_options::value<int>()->default_value(10),
+            "number of tests to be averaged (default: 10)")
+        ("seed,s", boost::program_options::value<std::uint32_t>(),
+            "the random number generator seed to use for this run")
+        ;
+
+    // initialize program
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
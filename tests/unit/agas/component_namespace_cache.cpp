@@ -0,0 +1,113 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::simple_component_base<test_server>
+{
+    test_server() {}
+};
+
+typedef hpx::components::simple_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+///////////////////////////////////////////////////////////////////////////////
+// Look up the localities supporting the given component type name, executed
+// on a locality other than the root, where the results may be cached.
+std::size_t count_supporting_localities(std::string const& name)
+{
+    hpx::agas::addressing_service& agas = hpx::naming::get_agas_client();
+
+    hpx::components::component_type type = agas.get_component_id(name);
+    HPX_TEST_NEQ(type, hpx::components::component_invalid);
+    HPX_TEST_EQ(hpx::components::get_component_type_name(type), name);
+
+    std::vector<hpx::naming::gid_type> localities;
+    agas.get_localities(localities, type);
+    return localities.size();
+}
+HPX_PLAIN_ACTION(count_supporting_localities, count_supporting_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_component_namespace_lookups()
+{
+    hpx::components::component_type type =
+        hpx::components::get_component_type<test_server>();
+    HPX_TEST_NEQ(type, hpx::components::component_invalid);
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    std::string name = hpx::components::get_component_type_name(type);
+
+    // repeated lookups (which may be served from the local cache) have to
+    // be consistent with the initial ones
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::vector<hpx::id_type> supporting =
+            hpx::find_all_localities(type);
+        HPX_TEST_EQ(supporting.size(), localities.size());
+
+        HPX_TEST_EQ(hpx::components::get_component_type_name(type), name);
+    }
+}
+
+// A type registered by other localities after it was looked up on this
+// locality has to be reported as supported by these.
+void test_late_registration()
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    hpx::id_type const remote = localities[0];
+    std::string const name = "component_namespace_cache_late_type";
+
+    // the type is known, but not supported by any locality yet
+    count_supporting_action lookup;
+    HPX_TEST_EQ(lookup(remote, name), std::size_t(0));
+
+    hpx::agas::addressing_service& agas = hpx::naming::get_agas_client();
+    std::uint32_t here = hpx::get_locality_id();
+    std::uint32_t there = hpx::naming::get_locality_id_from_id(remote);
+
+    agas.register_factory(here, name);
+    HPX_TEST_EQ(lookup(remote, name), std::size_t(1));
+
+    agas.register_factory(there, name);
+    for (std::size_t i = 0; i != 10; ++i)
+        HPX_TEST_EQ(lookup(remote, name), std::size_t(2));
+}
+
+int hpx_main()
+{
+    test_component_namespace_lookups();
+
+    if (hpx::get_locality_id() == 0)
+        test_late_registration();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
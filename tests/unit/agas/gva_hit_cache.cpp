@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/agas/detail/gva_hit_cache.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using hpx::naming::gid_type;
+using hpx::agas::gva;
+using hpx::agas::detail::gva_hit_cache;
+
+///////////////////////////////////////////////////////////////////////////////
+gva make_gva(std::uint64_t i)
+{
+    // encode the key into all fields to be able to detect torn reads
+    return gva(gid_type(i, i), static_cast<gva::component_type>(i % 1024),
+        i, static_cast<gva::lva_type>(i), i);
+}
+
+bool is_consistent(gid_type const& gid, gid_type const& idbase, gva const& g)
+{
+    std::uint64_t i = gid.get_lsb();
+    return idbase == gid && g == make_gva(i);
+}
+
+void test_basic()
+{
+    gva_hit_cache cache(16);
+    HPX_TEST_EQ(cache.capacity(), std::size_t(16));
+
+    gid_type idbase;
+    gva g;
+
+    HPX_TEST(!cache.get_entry(gid_type(1, 1), idbase, g));
+
+    cache.insert(gid_type(1, 1), gid_type(1, 1), make_gva(1));
+    HPX_TEST(cache.get_entry(gid_type(1, 1), idbase, g));
+    HPX_TEST(is_consistent(gid_type(1, 1), idbase, g));
+    HPX_TEST_EQ(cache.hits(false), 1);
+    HPX_TEST_EQ(cache.get_get_entry_count(true), 1);
+    HPX_TEST_EQ(cache.get_get_entry_count(false), 0);
+
+    // invalidation makes all entries stale
+    cache.invalidate();
+    HPX_TEST(!cache.get_entry(gid_type(1, 1), idbase, g));
+
+    // re-inserting after invalidation works
+    cache.insert(gid_type(1, 1), gid_type(1, 1), make_gva(1));
+    HPX_TEST(cache.get_entry(gid_type(1, 1), idbase, g));
+    HPX_TEST_EQ(cache.hits(true), 2);
+    HPX_TEST_EQ(cache.hits(false), 0);
+}
+
+void test_concurrent()
+{
+    gva_hit_cache cache(64);
+
+    std::size_t const num_tasks = 2 * hpx::get_os_thread_count();
+    std::uint64_t const iterations = 10000;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+
+    for (std::size_t t = 0; t != num_tasks; ++t)
+    {
+        tasks.push_back(hpx::async(
+            [&cache, t, iterations]()
+            {
+                gid_type idbase;
+                gva g;
+
+                for (std::uint64_t i = 0; i != iterations; ++i)
+                {
+                    std::uint64_t key = (i * (t + 1)) % 256 + 1;
+                    gid_type gid(key, key);
+
+                    if (t % 2)
+                    {
+                        cache.insert(gid, gid, make_gva(key));
+                    }
+                    else if (cache.get_entry(gid, idbase, g))
+                    {
+                        HPX_TEST(is_consistent(gid, idbase, g));
+                    }
+                }
+            }));
+    }
+
+    hpx::wait_all(tasks);
+}
+
+int main()
+{
+    test_basic();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/util/generate_unique_ids.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using hpx::naming::gid_type;
+
+typedef std::pair<gid_type, gid_type> range_type;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 8;
+std::size_t const num_requests = 200;
+std::size_t const request_size = 0x10000;
+
+std::vector<range_type> allocate_ranges()
+{
+    hpx::util::unique_id_ranges& id_pool = hpx::get_runtime().get_id_pool();
+
+    std::vector<range_type> ranges;
+    ranges.reserve(num_requests);
+    for (std::size_t i = 0; i != num_requests; ++i)
+    {
+        gid_type lower = id_pool.get_id(request_size);
+        ranges.push_back(std::make_pair(lower, lower + request_size));
+    }
+    return ranges;
+}
+
+void test_concurrent_allocation()
+{
+    hpx::util::unique_id_ranges& id_pool = hpx::get_runtime().get_id_pool();
+    id_pool.get_refill_count(true);
+
+    std::vector<hpx::future<std::vector<range_type> > > futures;
+    futures.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+        futures.push_back(hpx::async(&allocate_ranges));
+
+    std::vector<range_type> ranges;
+    for (auto && f : futures)
+    {
+        std::vector<range_type> r = f.get();
+        ranges.insert(ranges.end(), r.begin(), r.end());
+    }
+    HPX_TEST_EQ(ranges.size(), num_tasks * num_requests);
+
+    // no two of the allocated ranges may overlap
+    std::sort(ranges.begin(), ranges.end());
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+    {
+        HPX_TEST(ranges[i - 1].second <= ranges[i].first);
+    }
+
+    // the requests above exceed the initial block size, thus at least one
+    // block must have been reserved in the background
+    HPX_TEST_LT(std::int64_t(0), id_pool.get_refill_count(false));
+    HPX_TEST_LT(std::int64_t(0), id_pool.get_block_size(false));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_concurrent_allocation();
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,126 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that buffered decref requests are sent by the refcnt flush timer
+// without any explicit garbage collection, also after the timer went idle.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tests/unit/agas/components/simple_refcnt_checker.hpp>
+#include <tests/unit/agas/components/managed_refcnt_checker.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::init;
+using hpx::finalize;
+using hpx::find_here;
+
+using std::chrono::milliseconds;
+
+using hpx::naming::id_type;
+using hpx::naming::get_management_type_name;
+
+using hpx::test::simple_refcnt_monitor;
+using hpx::test::managed_refcnt_monitor;
+
+using hpx::util::report_errors;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+template <
+    typename Client
+>
+void hpx_test_main(
+    variables_map& vm
+    )
+{
+    std::uint64_t const delay = vm["delay"].as<std::uint64_t>();
+
+    // The second iteration runs after the timer has found nothing left to
+    // flush, its decref request has to re-arm the timer.
+    for (int i = 0; i != 2; ++i)
+    {
+        Client monitor(find_here());
+
+        cout << "id: " << monitor.get_id() << " "
+             << get_management_type_name
+                    (monitor.get_id().get_management_type()) << "\n"
+             << flush;
+
+        {
+            // Detach the reference.
+            id_type id = monitor.detach().get();
+
+            // The component should still be alive.
+            HPX_TEST_EQ(false, monitor.is_ready(milliseconds(delay)));
+        }
+
+        // The decref request is buffered (the maximum number of pending
+        // requests is never reached), the timer has to send it.
+        HPX_TEST_EQ(true, monitor.is_ready(milliseconds(delay)));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(
+    variables_map& vm
+    )
+{
+    {
+        cout << std::string(80, '#') << "\n"
+             << "simple component test\n"
+             << std::string(80, '#') << "\n" << flush;
+
+        hpx_test_main<simple_refcnt_monitor>(vm);
+
+        cout << std::string(80, '#') << "\n"
+             << "managed component test\n"
+             << std::string(80, '#') << "\n" << flush;
+
+        hpx_test_main<managed_refcnt_monitor>(vm);
+    }
+
+    finalize();
+    return report_errors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "delay"
+        , value<std::uint64_t>()->default_value(500)
+        , "number of milliseconds to wait for object destruction")
+        ;
+
+    // We need to explicitly enable the test components used by this test,
+    // decref requests are sent only by the flush timer.
+    std::vector<std::string> const cfg = {
+        "hpx.components.simple_refcnt_checker.enabled! = 1",
+        "hpx.components.managed_refcnt_checker.enabled! = 1",
+        "hpx.agas.max_pending_refcnt_requests! = 1000000",
+        "hpx.agas.refcnt_flush_interval! = 10"
+    };
+
+    // Initialize and run HPX.
+    return init(cmdline, argc, argv, cfg);
+}
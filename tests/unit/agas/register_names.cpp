@@ -0,0 +1,102 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::simple_component_base<test_server>
+{
+    test_server() {}
+};
+
+typedef hpx::components::simple_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_names = 100;
+
+std::vector<std::string> generate_names(char const* basename)
+{
+    std::string prefix = basename +
+        std::to_string(hpx::get_locality_id()) + "/";
+
+    std::vector<std::string> names;
+    names.reserve(num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+        names.push_back(prefix + std::to_string(i));
+
+    return names;
+}
+
+void test_register_names()
+{
+    std::vector<std::string> names = generate_names("/register_names_test/");
+
+    std::vector<hpx::id_type> ids;
+    ids.reserve(num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+        ids.push_back(hpx::new_<test_server>(hpx::find_here()).get());
+
+    // register all names using a single batched request
+    std::vector<bool> registered =
+        hpx::agas::register_names(names, ids).get();
+    HPX_TEST_EQ(registered.size(), num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+        HPX_TEST(registered[i]);
+
+    // registering the same names again has to fail
+    registered = hpx::agas::register_names(names, ids).get();
+    HPX_TEST_EQ(registered.size(), num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+        HPX_TEST(!registered[i]);
+
+    // resolve all names, adding one name which was never registered
+    names.push_back("/register_names_test/unknown");
+
+    std::vector<hpx::id_type> resolved =
+        hpx::agas::resolve_names(names).get();
+    HPX_TEST_EQ(resolved.size(), num_names + 1);
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST_EQ(resolved[i], ids[i]);
+        HPX_TEST_EQ(resolved[i], hpx::agas::resolve_name(names[i]).get());
+    }
+    HPX_TEST_EQ(resolved[num_names], hpx::naming::invalid_id);
+
+    // clean up
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST_EQ(
+            hpx::agas::unregister_name(hpx::launch::sync, names[i]), ids[i]);
+    }
+}
+
+int hpx_main()
+{
+    test_register_names();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
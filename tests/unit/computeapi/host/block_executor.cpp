@@ -0,0 +1,153 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/compute.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::compute::host::block_executor<> executor_type;
+typedef hpx::compute::host::block_allocator<int> allocator_type;
+typedef hpx::compute::vector<int, allocator_type> vector_type;
+
+void test_numa_domain(vector_type const& v)
+{
+    std::size_t num_domains =
+        hpx::threads::get_topology().get_number_of_numa_nodes();
+
+    // the location of the pages may not be known, but if it is it has to
+    // refer to an existing domain
+    std::size_t domain = hpx::compute::host::get_numa_domain(v.data());
+    HPX_TEST(domain == std::size_t(-1) || domain < (std::max)(num_domains,
+        std::size_t(1)));
+}
+
+template <typename ExPolicy>
+void test_for_each(ExPolicy policy, vector_type& v)
+{
+    int expected = v[0] + 1;
+
+    std::atomic<std::size_t> count(0);
+    hpx::parallel::for_each(policy, v.begin(), v.end(),
+        [&count](int& val)
+        {
+            ++val;
+            ++count;
+        });
+
+    HPX_TEST_EQ(count.load(), v.size());
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        HPX_TEST_EQ(v[i], expected);
+    }
+}
+
+template <typename ExPolicy>
+void test_transform(ExPolicy policy, vector_type& v, vector_type& d)
+{
+    hpx::parallel::transform(policy, v.begin(), v.end(), d.begin(),
+        [](int val) { return 2 * val; });
+
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        HPX_TEST_EQ(d[i], 2 * v[i]);
+    }
+}
+
+// exceptions thrown by the function are reported as an exception_list, as
+// for all other executors
+void test_bulk_sync_execute_exception(executor_type& exec, std::size_t count)
+{
+    std::vector<int> shape(count);
+    std::iota(shape.begin(), shape.end(), 0);
+
+    std::atomic<std::size_t> invoked(0);
+    hpx::parallel::execution::bulk_sync_execute(exec,
+        [&invoked](int) { ++invoked; }, shape);
+    HPX_TEST_EQ(invoked.load(), count);
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::execution::bulk_sync_execute(exec,
+            [](int i)
+            {
+                if (i == 0)
+                    throw std::runtime_error("test");
+            },
+            shape);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST_EQ(e.size(), std::size_t(1));
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_block_executor(std::size_t count)
+{
+    auto numa_nodes = hpx::compute::host::numa_domains();
+
+    allocator_type alloc(numa_nodes);
+    executor_type exec(numa_nodes);
+
+    vector_type v(count, 42, alloc);
+    vector_type d(count, 0, alloc);
+
+    test_numa_domain(v);
+
+    // the number of chunks is not necessarily divisible by the number of
+    // targets, all of them have to be executed nevertheless
+    using namespace hpx::parallel::execution;
+
+    test_for_each(par.on(exec), v);
+    test_transform(par.on(exec), v, d);
+
+    test_for_each(par.on(exec).with(static_chunk_size(7)), v);
+    test_transform(par.on(exec).with(static_chunk_size(7)), v, d);
+
+    test_bulk_sync_execute_exception(exec, count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    test_block_executor(1);
+    test_block_executor(1001);
+    test_block_executor(100003);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,170 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/bounded_channel.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void set_get()
+{
+    hpx::lcos::local::bounded_channel<int> c(4);
+    HPX_TEST_EQ(c.capacity(), std::size_t(4));
+
+    for (int i = 0; i != 4; ++i)
+        HPX_TEST(c.try_set(i));
+    HPX_TEST(!c.try_set(4));            // the channel is full
+    HPX_TEST_EQ(c.size(), std::size_t(4));
+
+    for (int i = 0; i != 4; ++i)
+        HPX_TEST_EQ(c.get(hpx::launch::sync), i);
+
+    int val = 0;
+    HPX_TEST(!c.try_get(val));          // the channel is empty
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the sender is suspended whenever the channel is full
+void backpressure()
+{
+    std::size_t const count = 1000;
+    hpx::lcos::local::bounded_channel<std::size_t> c(2);
+
+    hpx::future<void> producer = hpx::async(
+        [c, count]() mutable
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                c.set(i);
+                HPX_TEST(c.size() <= c.capacity());
+            }
+            c.close();
+        });
+
+    std::size_t expected = 0;
+    for (std::size_t i : c)
+    {
+        HPX_TEST_EQ(i, expected);
+        ++expected;
+    }
+    HPX_TEST_EQ(expected, count);
+
+    producer.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void batches()
+{
+    std::size_t const count = 10000;
+    std::size_t const num_producers = 4;
+
+    hpx::lcos::local::bounded_channel<int> c(64);
+
+    std::vector<hpx::future<std::size_t> > producers;
+    for (std::size_t p = 0; p != num_producers; ++p)
+    {
+        producers.push_back(hpx::async(
+            [c, count]() mutable -> std::size_t
+            {
+                std::vector<int> values(count, 1);
+                return c.send_n(values.begin(), values.size());
+            }));
+    }
+
+    hpx::future<void> closer = hpx::when_all(producers).then(
+        [c, count](hpx::future<std::vector<hpx::future<std::size_t> > > f)
+            mutable
+        {
+            for (hpx::future<std::size_t>& sent : f.get())
+                HPX_TEST_EQ(sent.get(), count);
+            c.close();
+        });
+
+    std::vector<int> received;
+    std::size_t n = 0;
+    while ((n = c.receive_n(std::back_inserter(received), 100)) != 0)
+    {
+        HPX_TEST(n <= 100);
+    }
+
+    HPX_TEST_EQ(received.size(), count * num_producers);
+    HPX_TEST_EQ(std::accumulate(received.begin(), received.end(), 0),
+        static_cast<int>(count * num_producers));
+
+    closer.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_operations()
+{
+    hpx::lcos::local::bounded_channel<std::string> c(2);
+
+    hpx::future<std::string> f = c.get(hpx::launch::async);
+
+    c.set(hpx::launch::async, "1").get();
+    c.set(hpx::launch::async, "2").get();
+    hpx::future<void> s = c.set(hpx::launch::async, "3");
+
+    HPX_TEST_EQ(f.get(), std::string("1"));
+    HPX_TEST_EQ(c.get(hpx::launch::sync), std::string("2"));
+    HPX_TEST_EQ(c.get(hpx::launch::async).get(), std::string("3"));
+
+    s.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void close_channel()
+{
+    hpx::lcos::local::bounded_channel<int> c(4);
+    c.set(42);
+    c.close();
+
+    // remaining values can still be received
+    HPX_TEST_EQ(c.get(hpx::launch::sync), 42);
+
+    bool caught_exception = false;
+    try {
+        c.get(hpx::launch::sync);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    hpx::error_code ec(hpx::lightweight);
+    c.set(hpx::launch::sync, 43, ec);
+    HPX_TEST(ec);
+
+    caught_exception = false;
+    try {
+        c.close();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    set_get();
+    backpressure();
+    batches();
+    async_operations();
+    close_channel();
+
+    return hpx::util::report_errors();
+}
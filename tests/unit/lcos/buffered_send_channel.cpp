@@ -0,0 +1,202 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef std::string string_type;
+
+HPX_REGISTER_CHANNEL(int);
+HPX_REGISTER_CHANNEL(string_type);
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t produce(hpx::lcos::channel<int> c, int count,
+    std::size_t batch_size, std::size_t credits)
+{
+    hpx::lcos::buffered_send_channel<int> s(c, batch_size, credits);
+    for (int i = 0; i != count; ++i)
+        s.set(i);
+    s.close();
+
+    HPX_TEST_EQ(s.get_sent_count(false), std::int64_t(count));
+    return static_cast<std::size_t>(s.get_batch_count(false));
+}
+HPX_PLAIN_ACTION(produce);
+
+// values are received in the order they were sent, batching them into
+// parcels of batch_size values each
+void ordered(hpx::id_type const& producer, hpx::id_type const& consumer,
+    std::size_t batch_size, std::size_t credits)
+{
+    int const count = 1000;
+    hpx::lcos::channel<int> c(consumer);
+
+    hpx::future<std::size_t> batches =
+        hpx::async(produce_action(), producer, c, count, batch_size, credits);
+
+    int expected = 0;
+    for (int i : c)
+    {
+        HPX_TEST_EQ(i, expected);
+        ++expected;
+    }
+    HPX_TEST_EQ(expected, count);
+
+    // one additional (empty) batch closes the channel
+    HPX_TEST_EQ(batches.get(),
+        (count + batch_size - 1) / batch_size + (count % batch_size == 0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the sender can't send more values than granted by the channel
+void flow_control(hpx::id_type const& loc)
+{
+    hpx::lcos::channel<string_type> c(loc);
+    hpx::lcos::buffered_send_channel<string_type> s(c, 4, 8);
+
+    HPX_TEST_EQ(s.batch_size(), std::size_t(4));
+    HPX_TEST_EQ(s.credits(), std::size_t(8));
+
+    for (int i = 0; i != 8; ++i)
+        s.set(std::to_string(i));
+    HPX_TEST_EQ(s.credits(), std::size_t(0));
+
+    // the next batch has to wait for the receiver to request values
+    hpx::future<void> sender = hpx::async(
+        [&s]()
+        {
+            for (int i = 8; i != 100; ++i)
+                s.set(std::to_string(i));
+            s.flush();
+        });
+
+    for (int i = 0; i != 100; ++i)
+        HPX_TEST_EQ(c.get(hpx::launch::sync), std::to_string(i));
+
+    sender.get();
+
+    HPX_TEST_EQ(s.get_sent_count(true), std::int64_t(100));
+    HPX_TEST_EQ(s.get_batch_count(true), std::int64_t(25));
+    HPX_TEST(s.get_average_latency(true) >= 0);
+    HPX_TEST_EQ(s.get_sent_count(false), std::int64_t(0));
+
+    s.close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// values still buffered are sent when the sender goes out of scope
+void flush_on_destruction(hpx::id_type const& loc)
+{
+    hpx::lcos::channel<int> c(loc);
+
+    {
+        hpx::lcos::buffered_send_channel<int> s(c, 16);
+        s.set(1);
+        s.set(2);
+    }
+
+    HPX_TEST_EQ(c.get(hpx::launch::sync), 1);
+    HPX_TEST_EQ(c.get(hpx::launch::sync), 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void closed_channel(hpx::id_type const& loc)
+{
+    hpx::lcos::channel<int> c(loc);
+    c.close();
+
+    hpx::lcos::buffered_send_channel<int> s(c, 4);
+    s.set(42);
+
+    bool caught_exception = false;
+    try {
+        s.close();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try {
+        s.set(43);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the statistics of all senders are exposed as performance counters
+std::int64_t get_counter_value(std::string const& name)
+{
+    hpx::performance_counters::performance_counter counter(
+        name + "{locality#" + std::to_string(hpx::get_locality_id()) +
+            "/total}");
+    return counter.get_counter_value(hpx::launch::sync)
+        .get_value<std::int64_t>();
+}
+
+void counters(hpx::id_type const& loc)
+{
+    std::int64_t sent =
+        get_counter_value("/lcos/buffered_send_channel/count/sent");
+    std::int64_t batches =
+        get_counter_value("/lcos/buffered_send_channel/count/batches");
+
+    hpx::lcos::channel<int> c(loc);
+    hpx::lcos::buffered_send_channel<int> s(c, 5);
+    for (int i = 0; i != 10; ++i)
+        s.set(i);
+
+    HPX_TEST_EQ(
+        get_counter_value("/lcos/buffered_send_channel/count/sent"),
+        sent + 10);
+    HPX_TEST_EQ(
+        get_counter_value("/lcos/buffered_send_channel/count/batches"),
+        batches + 2);
+
+    s.close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    hpx::id_type here = hpx::find_here();
+
+    ordered(here, here, 64, 0);
+    ordered(here, here, 10, 10);
+    flow_control(here);
+    flush_on_destruction(here);
+    closed_channel(here);
+    counters(here);
+
+    std::vector<hpx::id_type> remote_localities = hpx::find_remote_localities();
+    for (hpx::id_type id : remote_localities)
+    {
+        ordered(id, here, 64, 0);
+        ordered(here, id, 64, 0);
+        ordered(id, here, 1, 1);
+
+        flow_control(id);
+        flush_on_destruction(id);
+        closed_channel(id);
+    }
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,217 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void participant(std::string const& name, std::size_t num, std::size_t rank,
+    std::atomic<std::size_t>& entered)
+{
+    hpx::lcos::communicator comm(name, num, rank);
+
+    HPX_TEST_EQ(comm.size(), num);
+    HPX_TEST_EQ(comm.rank(), rank);
+
+    // nobody leaves the barrier before everybody has entered it
+    for (std::size_t i = 1; i != 4; ++i)
+    {
+        ++entered;
+        comm.barrier();
+        HPX_TEST(entered.load() >= i * num);
+        comm.barrier();
+    }
+
+    // all participants receive the same reduced value
+    std::size_t sum = comm.all_reduce(rank, std::plus<std::size_t>());
+    HPX_TEST_EQ(sum, num * (num - 1) / 2);
+
+    // the operation is applied in rank order
+    std::string concatenated = comm.all_reduce(std::to_string(rank) + ",",
+        [](std::string const& lhs, std::string const& rhs)
+        {
+            return lhs + rhs;
+        });
+
+    std::string expected;
+    for (std::size_t i = 0; i != num; ++i)
+        expected += std::to_string(i) + ",";
+    HPX_TEST_EQ(concatenated, expected);
+
+    // the value contributed by participant i ends up at position i
+    std::vector<std::string> gathered = comm.all_gather(std::to_string(rank));
+    HPX_TEST_EQ(gathered.size(), num);
+    for (std::size_t i = 0; i != gathered.size(); ++i)
+        HPX_TEST_EQ(gathered[i], std::to_string(i));
+
+    // several operations can be in flight at the same time
+    hpx::future<void> f1 = comm.barrier(hpx::launch::async);
+    hpx::future<std::size_t> f2 = comm.all_reduce(hpx::launch::async,
+        std::size_t(1), std::plus<std::size_t>());
+    hpx::future<std::vector<std::size_t> > f3 =
+        comm.all_gather(hpx::launch::async, rank * rank);
+
+    f1.get();
+    HPX_TEST_EQ(f2.get(), num);
+
+    std::vector<std::size_t> squares = f3.get();
+    HPX_TEST_EQ(squares.size(), num);
+    for (std::size_t i = 0; i != squares.size(); ++i)
+        HPX_TEST_EQ(squares[i], i * i);
+
+    // participant i receives the value sent to it by participant j at j
+    std::vector<std::string> outgoing;
+    for (std::size_t i = 0; i != num; ++i)
+        outgoing.push_back(std::to_string(rank) + "->" + std::to_string(i));
+
+    std::vector<std::string> incoming = comm.all_to_all(outgoing);
+    HPX_TEST_EQ(incoming.size(), num);
+    for (std::size_t i = 0; i != incoming.size(); ++i)
+    {
+        HPX_TEST_EQ(incoming[i],
+            std::to_string(i) + "->" + std::to_string(rank));
+    }
+
+    // scatter and gather work for any root
+    for (std::size_t root = 0; root != num; ++root)
+    {
+        std::vector<std::size_t> values;
+        if (rank == root)
+        {
+            for (std::size_t i = 0; i != num; ++i)
+                values.push_back(root * 100 + i);
+        }
+        HPX_TEST_EQ(comm.scatter(root, values), root * 100 + rank);
+
+        std::vector<std::size_t> gathered_ranks = comm.gather(root, rank);
+        if (rank == root)
+        {
+            HPX_TEST_EQ(gathered_ranks.size(), num);
+            for (std::size_t i = 0; i != gathered_ranks.size(); ++i)
+                HPX_TEST_EQ(gathered_ranks[i], i);
+        }
+        else
+        {
+            HPX_TEST(gathered_ranks.empty());
+        }
+    }
+
+    // every participant receives its block of the element-wise sum, the
+    // small chunk size forces the blocks to be pipelined
+    for (std::size_t size : { std::size_t(0), num - 1, 10 * num + 3 })
+    {
+        std::vector<std::size_t> contribution(size);
+        for (std::size_t i = 0; i != size; ++i)
+            contribution[i] = i + rank;
+
+        hpx::future<std::vector<std::size_t> > f = comm.reduce_scatter(
+            hpx::launch::async, contribution, std::plus<std::size_t>(), 3);
+        std::vector<std::size_t> block = f.get();
+
+        std::size_t const first = rank * size / num;
+        std::size_t const last = (rank + 1) * size / num;
+        HPX_TEST_EQ(block.size(), last - first);
+        for (std::size_t i = 0; i != block.size(); ++i)
+        {
+            HPX_TEST_EQ(block[i],
+                num * (first + i) + num * (num - 1) / 2);
+        }
+    }
+}
+
+void local_tests()
+{
+    // cover powers of two as well as all other sizes
+    for (std::size_t num : { 1, 2, 3, 4, 5, 7, 8, 13 })
+    {
+        std::string name = "/test/communicator/local/" + std::to_string(num);
+        std::atomic<std::size_t> entered(0);
+
+        std::vector<hpx::future<void> > participants;
+        for (std::size_t rank = 0; rank != num; ++rank)
+        {
+            participants.push_back(hpx::async(&participant,
+                name, num, rank, std::ref(entered)));
+        }
+        hpx::wait_all(participants);
+
+        for (hpx::future<void>& f : participants)
+            f.get();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void remote_test()
+{
+    hpx::lcos::communicator comm("/test/communicator/remote");
+
+    std::size_t num = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t rank = hpx::get_locality_id();
+
+    HPX_TEST_EQ(comm.size(), num);
+    HPX_TEST_EQ(comm.rank(), rank);
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        comm.barrier();
+
+        HPX_TEST_EQ(comm.all_reduce(i + rank, std::plus<std::size_t>()),
+            num * i + num * (num - 1) / 2);
+
+        std::vector<std::size_t> ids = comm.all_gather(rank + i);
+        HPX_TEST_EQ(ids.size(), num);
+        for (std::size_t j = 0; j != ids.size(); ++j)
+            HPX_TEST_EQ(ids[j], j + i);
+
+        std::vector<std::size_t> outgoing(num, rank);
+        std::vector<std::size_t> incoming =
+            comm.all_to_all(hpx::launch::async, outgoing).get();
+        for (std::size_t j = 0; j != incoming.size(); ++j)
+            HPX_TEST_EQ(incoming[j], j);
+
+        std::vector<double> contribution(100000, 1.0);
+        std::vector<double> block = comm.reduce_scatter(
+            contribution, std::plus<double>());
+        HPX_TEST_EQ(block.size(),
+            (rank + 1) * 100000 / num - rank * 100000 / num);
+        for (double d : block)
+            HPX_TEST_EQ(d, double(num));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    if (hpx::get_locality_id() == 0)
+        local_tests();
+
+    remote_test();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // We force this test to use several threads by default.
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all",
+        "hpx.run_hpx_main!=1"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
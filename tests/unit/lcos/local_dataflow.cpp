@@ -383,6 +383,52 @@ void plain_arguments_lazy()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// many frames waiting for the same (not yet ready) shared futures
+void shared_inputs()
+{
+    std::size_t const num_frames = 64;
+
+    hpx::lcos::local::promise<int> p1;
+    hpx::lcos::local::promise<int> p2;
+    shared_future<int> sf1 = p1.get_future();
+    shared_future<int> sf2 = p2.get_future();
+
+    std::vector<future<int> > results;
+    results.reserve(num_frames);
+    for (std::size_t i = 0; i != num_frames; ++i)
+    {
+        results.push_back(dataflow(
+            [](shared_future<int> f1, shared_future<int> f2)
+            {
+                return f1.get() + f2.get();
+            },
+            sf1, sf2));
+    }
+
+    std::vector<future<void> > all;
+    all.reserve(num_frames);
+    for (std::size_t i = 0; i != num_frames; ++i)
+    {
+        all.push_back(hpx::when_all(sf1, sf2).then(
+            [](future<hpx::util::tuple<shared_future<int>, shared_future<int> > >
+                f)
+            {
+                auto t = f.get();
+                HPX_TEST_EQ(hpx::util::get<0>(t).get(), 1);
+                HPX_TEST_EQ(hpx::util::get<1>(t).get(), 2);
+            }));
+    }
+
+    p1.set_value(1);
+    p2.set_value(2);
+
+    for (future<int>& f : results)
+        HPX_TEST_EQ(f.get(), 3);
+
+    hpx::wait_all(all);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(variables_map&)
 {
@@ -391,6 +437,7 @@ int hpx_main(variables_map&)
     plain_arguments();
     plain_deferred_arguments();
     plain_arguments_lazy();
+    shared_inputs();
 
     return hpx::finalize();
 }
@@ -16,6 +16,7 @@
 
 
 #include <chrono>
+#include <cstddef>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -276,10 +277,99 @@ struct test_recursive_lock
     }
 };
 
+struct fair_mutex : hpx::lcos::local::mutex
+{
+    fair_mutex()
+      : hpx::lcos::local::mutex("fair_mutex",
+            hpx::lcos::local::mutex_policy::fair)
+    {}
+};
+
+template <typename M>
+struct test_contention
+{
+    typedef M mutex_type;
+
+    void operator()()
+    {
+        std::size_t const num_threads = 16;
+        std::size_t const iterations = 1000;
+
+        mutex_type mutex;
+        std::size_t first = 0, second = 0;
+
+        std::vector<hpx::thread> threads;
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            threads.push_back(hpx::thread(
+                [&]()
+                {
+                    for (std::size_t j = 0; j != iterations; ++j)
+                    {
+                        std::lock_guard<mutex_type> l(mutex);
+                        HPX_TEST_EQ(first, second);
+                        ++first;
+                        if (j % 10 == 0)
+                            hpx::this_thread::yield();
+                        ++second;
+                    }
+                }));
+        }
+
+        for (hpx::thread& t : threads)
+            t.join();
+
+        HPX_TEST_EQ(first, num_threads * iterations);
+        HPX_TEST_EQ(second, num_threads * iterations);
+    }
+};
+
+// a fair mutex is acquired by the suspended threads in the order they
+// started waiting
+void test_fair_handoff()
+{
+    std::size_t const num_threads = 8;
+
+    fair_mutex mutex;
+    hpx::lcos::local::mutex order_mutex;
+    std::vector<std::size_t> order;
+
+    std::unique_lock<fair_mutex> lock(mutex);
+
+    std::vector<hpx::thread> threads;
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        threads.push_back(hpx::thread(
+            [&, i]()
+            {
+                std::lock_guard<fair_mutex> l(mutex);
+                std::lock_guard<hpx::lcos::local::mutex> ol(order_mutex);
+                order.push_back(i);
+            }));
+
+        // give the thread time to get suspended
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    lock.unlock();
+    for (hpx::thread& t : threads)
+        t.join();
+
+    HPX_TEST_EQ(order.size(), num_threads);
+    for (std::size_t i = 0; i != order.size(); ++i)
+        HPX_TEST_EQ(order[i], i);
+}
+
 void test_mutex()
 {
     test_lock<hpx::lcos::local::mutex>()();
     test_trylock<hpx::lcos::local::mutex>()();
+    test_contention<hpx::lcos::local::mutex>()();
+
+    test_lock<fair_mutex>()();
+    test_trylock<fair_mutex>()();
+    test_contention<fair_mutex>()();
+    test_fair_handoff();
 }
 
 void test_timed_mutex()
@@ -287,6 +377,7 @@ void test_timed_mutex()
     test_lock<hpx::lcos::local::timed_mutex>()();
     test_trylock<hpx::lcos::local::timed_mutex>()();
     test_timedlock<hpx::lcos::local::timed_mutex>()();
+    test_contention<hpx::lcos::local::timed_mutex>()();
 }
 
 //void test_recursive_mutex()
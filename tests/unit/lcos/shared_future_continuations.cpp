@@ -0,0 +1,135 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// continuations attached to a shared state have to be invoked in the order
+// they were attached
+void test_continuation_order()
+{
+    hpx::lcos::local::promise<int> p;
+    hpx::shared_future<int> f = p.get_future();
+
+    std::vector<std::size_t> order;
+    std::vector<hpx::future<void> > results;
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        results.push_back(f.then(hpx::launch::sync,
+            [&order, i](hpx::shared_future<int> && f)
+            {
+                HPX_TEST_EQ(f.get(), 42);
+                order.push_back(i);
+            }));
+    }
+
+    HPX_TEST(!f.is_ready());
+    p.set_value(42);
+    hpx::wait_all(results);
+
+    HPX_TEST_EQ(order.size(), std::size_t(10));
+    for (std::size_t i = 0; i != order.size(); ++i)
+        HPX_TEST_EQ(order[i], i);
+
+    // continuations attached after the shared state became ready are run
+    // immediately
+    bool executed = false;
+    f.then(hpx::launch::sync,
+        [&executed](hpx::shared_future<int> &&)
+        {
+            executed = true;
+        });
+    HPX_TEST(executed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// attach continuations and wait concurrently with the shared state becoming
+// ready
+void test_concurrent_attach()
+{
+    std::size_t const num_iterations = 1000;
+    std::size_t const num_tasks = 4;
+
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        hpx::lcos::local::promise<int> p;
+        hpx::shared_future<int> f = p.get_future();
+
+        std::atomic<std::size_t> count(0);
+
+        std::vector<hpx::future<void> > tasks;
+        for (std::size_t j = 0; j != num_tasks; ++j)
+        {
+            tasks.push_back(hpx::async(
+                [f, &count]()
+                {
+                    f.then(hpx::launch::sync,
+                        [&count](hpx::shared_future<int> &&)
+                        {
+                            ++count;
+                        });
+                    HPX_TEST_EQ(f.get(), 42);
+                }));
+        }
+
+        p.set_value(42);
+        hpx::wait_all(tasks);
+
+        HPX_TEST_EQ(count.load(), num_tasks);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_exception_wakes_waiters()
+{
+    hpx::lcos::local::promise<int> p;
+    hpx::shared_future<int> f = p.get_future();
+
+    hpx::future<void> waiter = hpx::async(
+        [f]()
+        {
+            f.wait();
+            HPX_TEST(f.has_exception());
+        });
+
+    p.set_exception(std::make_exception_ptr(std::runtime_error("error")));
+    waiter.get();
+
+    // the shared state can be set only once
+    bool caught_exception = false;
+    try {
+        p.set_value(42);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::promise_already_satisfied);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int hpx_main()
+{
+    test_continuation_order();
+    test_concurrent_attach();
+    test_exception_wakes_waiters();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,200 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/thread/locks.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef hpx::lcos::local::reader_biased_shared_mutex shared_mutex_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// all readers have to hold the lock at the same time to pass the latch
+void test_multiple_readers()
+{
+    std::size_t const num_readers = 10;
+
+    shared_mutex_type mtx;
+    hpx::lcos::local::latch l(num_readers);
+
+    std::vector<hpx::future<void> > readers;
+    for (std::size_t i = 0; i != num_readers; ++i)
+    {
+        readers.push_back(hpx::async(
+            [&]()
+            {
+                boost::shared_lock<shared_mutex_type> sl(mtx);
+                l.count_down_and_wait();
+            }));
+    }
+    hpx::wait_all(readers);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// readers never observe a partial update
+void test_readers_and_writers()
+{
+    std::size_t const num_tasks = 100;
+    std::size_t const iterations = 1000;
+
+    shared_mutex_type mtx;
+    std::size_t first = 0, second = 0;
+    std::atomic<std::size_t> failures(0);
+
+    std::vector<hpx::future<void> > tasks;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            tasks.push_back(hpx::async(
+                [&]()
+                {
+                    for (std::size_t j = 0; j != iterations; ++j)
+                    {
+                        std::lock_guard<shared_mutex_type> l(mtx);
+                        ++first;
+                        hpx::this_thread::yield();
+                        ++second;
+                    }
+                }));
+        }
+        else
+        {
+            tasks.push_back(hpx::async(
+                [&]()
+                {
+                    for (std::size_t j = 0; j != iterations; ++j)
+                    {
+                        boost::shared_lock<shared_mutex_type> l(mtx);
+                        if (first != second)
+                            ++failures;
+                    }
+                }));
+        }
+    }
+    hpx::wait_all(tasks);
+
+    HPX_TEST_EQ(failures.load(), std::size_t(0));
+    HPX_TEST_EQ(first, (num_tasks / 10) * iterations);
+    HPX_TEST_EQ(second, (num_tasks / 10) * iterations);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_try_lock()
+{
+    shared_mutex_type mtx;
+
+    {
+        boost::shared_lock<shared_mutex_type> sl(mtx);
+        HPX_TEST(!mtx.try_lock());
+
+        // other readers are still admitted
+        HPX_TEST(mtx.try_lock_shared());
+        mtx.unlock_shared();
+    }
+
+    {
+        std::unique_lock<shared_mutex_type> ul(mtx);
+        HPX_TEST(!mtx.try_lock_shared());
+        HPX_TEST(!mtx.try_lock());
+    }
+
+    HPX_TEST(mtx.try_lock());
+    mtx.unlock();
+
+    HPX_TEST(mtx.try_lock_shared());
+    mtx.unlock_shared();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a writer waits for a reader to release its lock
+void test_reader_blocks_writer()
+{
+    shared_mutex_type mtx;
+    std::atomic<bool> writer_done(false);
+
+    boost::shared_lock<shared_mutex_type> sl(mtx);
+
+    hpx::future<void> writer = hpx::async(
+        [&]()
+        {
+            std::lock_guard<shared_mutex_type> l(mtx);
+            writer_done = true;
+        });
+
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+    HPX_TEST(!writer_done.load());
+
+    sl.unlock();
+    writer.get();
+    HPX_TEST(writer_done.load());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_condition_variable_any()
+{
+    shared_mutex_type mtx;
+    hpx::lcos::local::condition_variable_any cond;
+    bool ready = false;
+
+    hpx::future<void> reader = hpx::async(
+        [&]()
+        {
+            boost::shared_lock<shared_mutex_type> l(mtx);
+            cond.wait(l, [&]() { return ready; });
+        });
+
+    hpx::future<void> writer = hpx::async(
+        [&]()
+        {
+            std::unique_lock<shared_mutex_type> l(mtx);
+            cond.wait(l, [&]() { return ready; });
+        });
+
+    {
+        std::lock_guard<shared_mutex_type> l(mtx);
+        ready = true;
+    }
+    cond.notify_all();
+
+    reader.get();
+    writer.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_multiple_readers();
+    test_readers_and_writers();
+    test_try_lock();
+    test_reader_blocks_writer();
+    test_condition_variable_any();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,264 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_keys(std::size_t size, int distinct)
+{
+    std::vector<int> keys(size);
+    for (int& k : keys)
+        k = std::rand() % distinct;
+    return keys;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_hash_reduce_by_key(ExPolicy policy, IteratorTag, std::size_t size,
+    int distinct)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> keys = make_keys(size, distinct);
+    std::vector<int> values(size);
+    for (int& v : values)
+        v = std::rand() % 1000;
+
+    std::vector<int> keys_out(size);
+    std::vector<int> values_out(size);
+
+    auto result = hpx::parallel::hash_reduce_by_key(policy,
+        iterator(std::begin(keys)), iterator(std::end(keys)),
+        iterator(std::begin(values)), std::begin(keys_out),
+        std::begin(values_out));
+
+    std::map<int, int> expected;
+    for (std::size_t i = 0; i != size; ++i)
+        expected[keys[i]] += values[i];
+
+    std::size_t count = std::distance(std::begin(keys_out), result.first);
+    HPX_TEST_EQ(count, expected.size());
+    HPX_TEST(std::distance(std::begin(values_out), result.second) ==
+        std::distance(std::begin(keys_out), result.first));
+
+    std::map<int, int> actual;
+    for (std::size_t i = 0; i != count; ++i)
+        actual[keys_out[i]] = values_out[i];
+    HPX_TEST(actual == expected);
+}
+
+// The values of each key have to be combined in the order of the input
+// sequence, string concatenation is not commutative.
+template <typename ExPolicy>
+void test_hash_reduce_by_key_order(ExPolicy policy, std::size_t size)
+{
+    std::vector<int> keys = make_keys(size, 17);
+    std::vector<std::string> values(size);
+    for (std::size_t i = 0; i != size; ++i)
+        values[i] = std::string(1, char('a' + std::rand() % 26));
+
+    std::vector<int> keys_out(size);
+    std::vector<std::string> values_out(size);
+
+    auto result = hpx::parallel::hash_reduce_by_key(policy,
+        std::begin(keys), std::end(keys), std::begin(values),
+        std::begin(keys_out), std::begin(values_out));
+
+    std::map<int, std::string> expected;
+    for (std::size_t i = 0; i != size; ++i)
+        expected[keys[i]] += values[i];
+
+    std::map<int, std::string> actual;
+    std::size_t count = std::distance(std::begin(keys_out), result.first);
+    for (std::size_t i = 0; i != count; ++i)
+        actual[keys_out[i]] = values_out[i];
+    HPX_TEST(actual == expected);
+}
+
+template <typename ExPolicy, typename IteratorTag>
+void test_histogram(ExPolicy policy, IteratorTag, std::size_t size,
+    int distinct)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> keys = make_keys(size, distinct);
+
+    std::vector<int> keys_out(size);
+    std::vector<std::size_t> counts_out(size);
+
+    auto result = hpx::parallel::histogram(policy,
+        iterator(std::begin(keys)), iterator(std::end(keys)),
+        std::begin(keys_out), std::begin(counts_out));
+
+    std::map<int, std::size_t> expected;
+    for (int k : keys)
+        ++expected[k];
+
+    std::map<int, std::size_t> actual;
+    std::size_t count = std::distance(std::begin(keys_out), result.first);
+    for (std::size_t i = 0; i != count; ++i)
+        actual[keys_out[i]] = counts_out[i];
+    HPX_TEST(actual == expected);
+}
+
+template <typename ExPolicy>
+void test_group_by(ExPolicy policy, std::size_t size, int distinct)
+{
+    std::vector<int> keys = make_keys(size, distinct);
+    std::vector<std::size_t> values(size);
+    for (std::size_t i = 0; i != size; ++i)
+        values[i] = i;
+
+    std::vector<int> keys_out(size);
+    std::vector<std::size_t> counts_out(size);
+    std::vector<std::size_t> values_out(size);
+
+    auto result = hpx::parallel::group_by(policy,
+        std::begin(keys), std::end(keys), std::begin(values),
+        std::begin(keys_out), std::begin(counts_out),
+        std::begin(values_out));
+
+    HPX_TEST(hpx::util::get<2>(result) == std::end(values_out));
+
+    std::map<int, std::vector<std::size_t> > expected;
+    for (std::size_t i = 0; i != size; ++i)
+        expected[keys[i]].push_back(values[i]);
+
+    std::map<int, std::vector<std::size_t> > actual;
+    std::size_t count =
+        std::distance(std::begin(keys_out), hpx::util::get<0>(result));
+    auto it = std::begin(values_out);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        actual[keys_out[i]].assign(it, it + counts_out[i]);
+        it += counts_out[i];
+    }
+    HPX_TEST(it == std::end(values_out));
+    HPX_TEST(actual == expected);
+}
+
+template <typename ExPolicy>
+void test_hash_aggregation_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> keys = make_keys(size, 101);
+    std::vector<int> values(size, 1);
+
+    std::vector<int> keys_out(size);
+    std::vector<int> values_out(size);
+    std::vector<std::size_t> counts_out(size);
+
+    auto f1 = hpx::parallel::hash_reduce_by_key(p,
+        std::begin(keys), std::end(keys), std::begin(values),
+        std::begin(keys_out), std::begin(values_out));
+    std::size_t count = std::distance(std::begin(keys_out), f1.get().first);
+
+    auto f2 = hpx::parallel::histogram(p, std::begin(keys), std::end(keys),
+        std::begin(keys_out), std::begin(counts_out));
+    HPX_TEST(std::distance(std::begin(keys_out), f2.get().first) ==
+        std::ptrdiff_t(count));
+
+    for (std::size_t i = 0; i != count; ++i)
+        HPX_TEST_EQ(counts_out[i], std::size_t(values_out[i]));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename IteratorTag>
+void test_hash_reduce_by_key()
+{
+    using namespace hpx::parallel;
+
+    for (std::size_t size : {std::size_t(1), std::size_t(1007),
+        std::size_t(100007)})
+    {
+        for (int distinct : {1, 13, 10007})
+        {
+            test_hash_reduce_by_key(execution::seq, IteratorTag(), size,
+                distinct);
+            test_hash_reduce_by_key(execution::par, IteratorTag(), size,
+                distinct);
+            test_hash_reduce_by_key(execution::par_unseq, IteratorTag(),
+                size, distinct);
+
+            test_histogram(execution::seq, IteratorTag(), size, distinct);
+            test_histogram(execution::par, IteratorTag(), size, distinct);
+        }
+    }
+}
+
+void hash_reduce_by_key_test()
+{
+    using namespace hpx::parallel;
+
+    test_hash_reduce_by_key<std::random_access_iterator_tag>();
+    test_hash_reduce_by_key<std::forward_iterator_tag>();
+
+    test_hash_reduce_by_key_order(execution::seq, 10007);
+    test_hash_reduce_by_key_order(execution::par, 10007);
+
+    for (int distinct : {1, 13, 10007})
+    {
+        test_group_by(execution::seq, 100007, distinct);
+        test_group_by(execution::par, 100007, distinct);
+    }
+
+    test_hash_aggregation_async(execution::seq(execution::task), 10007);
+    test_hash_aggregation_async(execution::par(execution::task), 10007);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    hash_reduce_by_key_test();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,161 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Compare>
+void verify_nth_element(std::vector<std::size_t> const& c,
+    std::vector<std::size_t> sorted, std::size_t nth, Compare comp)
+{
+    if (nth == c.size())
+        return;
+
+    std::sort(std::begin(sorted), std::end(sorted), comp);
+    HPX_TEST_EQ(c[nth], sorted[nth]);
+
+    for (std::size_t i = 0; i != nth; ++i)
+        HPX_TEST(!comp(c[nth], c[i]));
+    for (std::size_t i = nth + 1; i < c.size(); ++i)
+        HPX_TEST(!comp(c[i], c[nth]));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_nth_element(ExPolicy policy, IteratorTag, std::size_t size,
+    std::size_t nth, std::size_t range, Compare comp)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c(size);
+    std::generate(std::begin(c), std::end(c),
+        [range]() { return std::rand() % range; });
+    std::vector<std::size_t> d(c);
+
+    iterator result = hpx::parallel::nth_element(policy,
+        iterator(std::begin(c)), iterator(std::begin(c) + nth),
+        iterator(std::end(c)), comp);
+
+    HPX_TEST(result == iterator(std::end(c)));
+    verify_nth_element(c, d, nth, comp);
+}
+
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_nth_element_async(ExPolicy p, IteratorTag, std::size_t size,
+    std::size_t nth, std::size_t range, Compare comp)
+{
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c(size);
+    std::generate(std::begin(c), std::end(c),
+        [range]() { return std::rand() % range; });
+    std::vector<std::size_t> d(c);
+
+    auto f = hpx::parallel::nth_element(p,
+        iterator(std::begin(c)), iterator(std::begin(c) + nth),
+        iterator(std::end(c)), comp);
+
+    HPX_TEST(f.get() == iterator(std::end(c)));
+    verify_nth_element(c, d, nth, comp);
+}
+
+template <typename IteratorTag, typename Compare>
+void test_nth_element(std::size_t size, std::size_t nth, std::size_t range,
+    Compare comp)
+{
+    using namespace hpx::parallel;
+
+    test_nth_element(execution::seq, IteratorTag(), size, nth, range, comp);
+    test_nth_element(execution::par, IteratorTag(), size, nth, range, comp);
+    test_nth_element(execution::par_unseq, IteratorTag(), size, nth, range,
+        comp);
+
+    test_nth_element_async(execution::seq(execution::task), IteratorTag(),
+        size, nth, range, comp);
+    test_nth_element_async(execution::par(execution::task), IteratorTag(),
+        size, nth, range, comp);
+}
+
+void nth_element_test()
+{
+    std::size_t const sizes[] = { 0, 1, 1007, 1000007 };
+    for (std::size_t size : sizes)
+    {
+        std::size_t const positions[] = { 0, size / 3, size / 2, size };
+        for (std::size_t nth : positions)
+        {
+            if (nth == size && size != 0)
+                --nth;
+
+            // many distinct values
+            test_nth_element<std::random_access_iterator_tag>(
+                size, nth, std::size_t(-1), std::less<std::size_t>());
+            test_nth_element<std::random_access_iterator_tag>(
+                size, nth, std::size_t(-1), std::greater<std::size_t>());
+
+            // many equivalent values
+            test_nth_element<std::random_access_iterator_tag>(
+                size, nth, 3, std::less<std::size_t>());
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    nth_element_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
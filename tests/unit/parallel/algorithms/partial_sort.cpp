@@ -0,0 +1,253 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::size_t> make_values(std::size_t size, std::size_t range)
+{
+    std::vector<std::size_t> c(size);
+    std::generate(std::begin(c), std::end(c),
+        [range]() { return std::rand() % range; });
+    return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_partial_sort(ExPolicy policy, IteratorTag, std::size_t size,
+    std::size_t middle, std::size_t range, Compare comp)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c = make_values(size, range);
+    std::vector<std::size_t> d(c);
+
+    iterator result = hpx::parallel::partial_sort(policy,
+        iterator(std::begin(c)), iterator(std::begin(c) + middle),
+        iterator(std::end(c)), comp);
+
+    HPX_TEST(result == iterator(std::end(c)));
+
+    std::sort(std::begin(d), std::end(d), comp);
+    HPX_TEST(std::equal(std::begin(c), std::begin(c) + middle,
+        std::begin(d)));
+
+    std::sort(std::begin(c) + middle, std::end(c), comp);
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_partial_sort_async(ExPolicy p, IteratorTag, std::size_t size,
+    std::size_t middle, std::size_t range, Compare comp)
+{
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c = make_values(size, range);
+    std::vector<std::size_t> d(c);
+
+    auto f = hpx::parallel::partial_sort(p,
+        iterator(std::begin(c)), iterator(std::begin(c) + middle),
+        iterator(std::end(c)), comp);
+
+    HPX_TEST(f.get() == iterator(std::end(c)));
+
+    std::sort(std::begin(d), std::end(d), comp);
+    HPX_TEST(std::equal(std::begin(c), std::begin(c) + middle,
+        std::begin(d)));
+}
+
+template <typename IteratorTag, typename Compare>
+void test_partial_sort(std::size_t size, std::size_t middle,
+    std::size_t range, Compare comp)
+{
+    using namespace hpx::parallel;
+
+    test_partial_sort(execution::seq, IteratorTag(), size, middle, range,
+        comp);
+    test_partial_sort(execution::par, IteratorTag(), size, middle, range,
+        comp);
+    test_partial_sort(execution::par_unseq, IteratorTag(), size, middle,
+        range, comp);
+
+    test_partial_sort_async(execution::seq(execution::task), IteratorTag(),
+        size, middle, range, comp);
+    test_partial_sort_async(execution::par(execution::task), IteratorTag(),
+        size, middle, range, comp);
+}
+
+void partial_sort_test()
+{
+    std::size_t const sizes[] = { 0, 1, 1007, 1000007 };
+    for (std::size_t size : sizes)
+    {
+        std::size_t const positions[] = { 0, 10, size / 2, size };
+        for (std::size_t middle : positions)
+        {
+            middle = (std::min)(middle, size);
+
+            test_partial_sort<std::random_access_iterator_tag>(
+                size, middle, std::size_t(-1), std::less<std::size_t>());
+            test_partial_sort<std::random_access_iterator_tag>(
+                size, middle, std::size_t(-1), std::greater<std::size_t>());
+            test_partial_sort<std::random_access_iterator_tag>(
+                size, middle, 3, std::less<std::size_t>());
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_partial_sort_copy(ExPolicy policy, IteratorTag, std::size_t size,
+    std::size_t dest_size, std::size_t range, Compare comp)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c = make_values(size, range);
+    std::vector<std::size_t> d(dest_size);
+    std::vector<std::size_t> expected(dest_size);
+
+    auto result = hpx::parallel::partial_sort_copy(policy,
+        iterator(std::begin(c)), iterator(std::end(c)),
+        std::begin(d), std::end(d), comp);
+
+    auto expected_result = std::partial_sort_copy(std::begin(c),
+        std::end(c), std::begin(expected), std::end(expected), comp);
+
+    HPX_TEST(std::distance(std::begin(d), result) ==
+        std::distance(std::begin(expected), expected_result));
+    HPX_TEST(d == expected);
+}
+
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_partial_sort_copy_async(ExPolicy p, IteratorTag, std::size_t size,
+    std::size_t dest_size, std::size_t range, Compare comp)
+{
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c = make_values(size, range);
+    std::vector<std::size_t> d(dest_size);
+    std::vector<std::size_t> expected(dest_size);
+
+    auto f = hpx::parallel::partial_sort_copy(p,
+        iterator(std::begin(c)), iterator(std::end(c)),
+        std::begin(d), std::end(d), comp);
+
+    auto expected_result = std::partial_sort_copy(std::begin(c),
+        std::end(c), std::begin(expected), std::end(expected), comp);
+
+    HPX_TEST(std::distance(std::begin(d), f.get()) ==
+        std::distance(std::begin(expected), expected_result));
+    HPX_TEST(d == expected);
+}
+
+template <typename IteratorTag, typename Compare>
+void test_partial_sort_copy(std::size_t size, std::size_t dest_size,
+    std::size_t range, Compare comp)
+{
+    using namespace hpx::parallel;
+
+    test_partial_sort_copy(execution::seq, IteratorTag(), size, dest_size,
+        range, comp);
+    test_partial_sort_copy(execution::par, IteratorTag(), size, dest_size,
+        range, comp);
+    test_partial_sort_copy(execution::par_unseq, IteratorTag(), size,
+        dest_size, range, comp);
+
+    test_partial_sort_copy_async(execution::seq(execution::task),
+        IteratorTag(), size, dest_size, range, comp);
+    test_partial_sort_copy_async(execution::par(execution::task),
+        IteratorTag(), size, dest_size, range, comp);
+
+    // a small chunk size forces many merge rounds
+    test_partial_sort_copy(
+        execution::par.with(execution::static_chunk_size(100)),
+        IteratorTag(), size, dest_size, range, comp);
+}
+
+template <typename IteratorTag>
+void partial_sort_copy_test()
+{
+    std::size_t const sizes[] = { 0, 1, 1007, 1000007 };
+    for (std::size_t size : sizes)
+    {
+        std::size_t const dest_sizes[] = { 0, 10, size / 2, size + 10 };
+        for (std::size_t dest_size : dest_sizes)
+        {
+            test_partial_sort_copy<IteratorTag>(
+                size, dest_size, std::size_t(-1), std::less<std::size_t>());
+            test_partial_sort_copy<IteratorTag>(
+                size, dest_size, std::size_t(-1),
+                std::greater<std::size_t>());
+            test_partial_sort_copy<IteratorTag>(
+                size, dest_size, 3, std::less<std::size_t>());
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    partial_sort_test();
+    partial_sort_copy_test<std::random_access_iterator_tag>();
+    partial_sort_copy_test<std::forward_iterator_tag>();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -8,7 +8,9 @@
 #include <hpx/include/parallel_set_operations.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <iostream>
 #include <iterator>
 #include <string>
@@ -464,6 +466,54 @@ void set_difference_bad_alloc_test()
 #endif
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Both sequences contain long runs of equivalent elements which have to be
+// matched across the boundaries of the partitions.
+template <typename ExPolicy>
+void test_set_difference_duplicates(ExPolicy policy, std::size_t distinct)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<std::size_t> c1(10007);
+    std::vector<std::size_t> c2(5003);
+    for (std::size_t& v : c1)
+        v = std::rand() % distinct;
+    for (std::size_t& v : c2)
+        v = std::rand() % distinct;
+
+    std::sort(std::begin(c1), std::end(c1));
+    std::sort(std::begin(c2), std::end(c2));
+
+    std::vector<std::size_t> c3(c1.size() + c2.size()), c4(c3.size()); //-V656
+
+    auto result = hpx::parallel::set_difference(policy,
+        std::begin(c1), std::end(c1), std::begin(c2), std::end(c2),
+        std::begin(c3));
+
+    auto expected = std::set_difference(std::begin(c1), std::end(c1),
+        std::begin(c2), std::end(c2), std::begin(c4));
+
+    // verify values
+    HPX_TEST(std::distance(std::begin(c3), result) ==
+        std::distance(std::begin(c4), expected));
+    HPX_TEST(std::equal(std::begin(c3), result, std::begin(c4)));
+}
+
+void set_difference_duplicates_test()
+{
+    using namespace hpx::parallel;
+
+    for (std::size_t distinct : {std::size_t(1), std::size_t(3),
+        std::size_t(101)})
+    {
+        test_set_difference_duplicates(execution::seq, distinct);
+        test_set_difference_duplicates(execution::par, distinct);
+        test_set_difference_duplicates(execution::par_unseq, distinct);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -478,6 +528,7 @@ int hpx_main(boost::program_options::variables_map& vm)
     set_difference_test2();
     set_difference_exception_test();
     set_difference_bad_alloc_test();
+    set_difference_duplicates_test();
     return hpx::finalize();
 }
 
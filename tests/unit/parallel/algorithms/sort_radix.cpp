@@ -0,0 +1,243 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// large enough for the radix sort to kick in
+std::size_t const radix_test_size = 1000007;
+
+static_assert(
+    hpx::parallel::v1::detail::use_radix_sort<
+        hpx::parallel::v1::detail::less,
+        hpx::parallel::util::projection_identity,
+        std::vector<double>::iterator
+    >::value,
+    "doubles compared using operator< should be radix sorted");
+static_assert(
+    !hpx::parallel::v1::detail::use_radix_sort<
+        std::greater<double>,
+        hpx::parallel::util::projection_identity,
+        std::vector<double>::iterator
+    >::value,
+    "doubles compared using operator> should not be radix sorted");
+static_assert(
+    !hpx::parallel::v1::detail::use_radix_sort<
+        hpx::parallel::v1::detail::less,
+        hpx::parallel::util::projection_identity,
+        std::vector<std::string>::iterator
+    >::value,
+    "strings should not be radix sorted");
+
+// elements which can't be default constructed can't be moved through the
+// temporary buffer of the radix sort
+struct keyed_value
+{
+    explicit keyed_value(std::int64_t key)
+      : key_(key)
+    {}
+
+    std::int64_t key_;
+};
+
+struct get_key
+{
+    std::int64_t operator()(keyed_value const& v) const
+    {
+        return v.key_;
+    }
+};
+
+static_assert(
+    !hpx::parallel::v1::detail::use_radix_sort<
+        hpx::parallel::v1::detail::less, get_key,
+        std::vector<keyed_value>::iterator
+    >::value,
+    "elements without default constructor should not be radix sorted");
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename Distribution>
+std::vector<T> make_keys(Distribution dist)
+{
+    std::mt19937 gen(std::rand());
+
+    std::vector<T> c(radix_test_size);
+    for (T& key : c)
+        key = static_cast<T>(dist(gen));
+    return c;
+}
+
+template <typename ExPolicy, typename T, typename Compare>
+void test_sort_radix(ExPolicy policy, std::vector<T> c, Compare comp)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef typename std::vector<T>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, std::random_access_iterator_tag>
+        iterator;
+
+    std::vector<T> d(c);
+
+    iterator result = hpx::parallel::sort(policy,
+        iterator(std::begin(c)), iterator(std::end(c)), comp);
+    HPX_TEST(result == iterator(std::end(c)));
+
+    std::sort(std::begin(d), std::end(d));
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_radix_async(ExPolicy p, std::vector<T> c)
+{
+    std::vector<T> d(c);
+
+    auto f = hpx::parallel::sort(p, std::begin(c), std::end(c));
+    HPX_TEST(f.get() == std::end(c));
+
+    std::sort(std::begin(d), std::end(d));
+    HPX_TEST(c == d);
+}
+
+template <typename T, typename Distribution>
+void test_sort_radix(Distribution dist)
+{
+    using namespace hpx::parallel;
+    typedef hpx::parallel::v1::detail::less less;
+
+    std::vector<T> c = make_keys<T>(dist);
+
+    test_sort_radix(execution::par, c, less());
+    test_sort_radix(execution::par, c, std::less<T>());
+    test_sort_radix(execution::par_unseq, c, less());
+    test_sort_radix(execution::par.with(execution::static_chunk_size(100)),
+        c, less());
+
+    test_sort_radix_async(execution::par(execution::task), c);
+}
+
+void sort_radix_test()
+{
+    typedef std::uniform_int_distribution<std::int64_t> int_distribution;
+    typedef std::uniform_int_distribution<std::uint64_t> uint_distribution;
+    typedef std::uniform_real_distribution<double> real_distribution;
+
+    test_sort_radix<std::uint64_t>(uint_distribution());
+    test_sort_radix<std::int64_t>(int_distribution(
+        (std::numeric_limits<std::int64_t>::min)(),
+        (std::numeric_limits<std::int64_t>::max)()));
+    test_sort_radix<std::int32_t>(int_distribution(-1000000, 1000000));
+    test_sort_radix<std::uint16_t>(uint_distribution(0, 65535));
+    test_sort_radix<std::int8_t>(int_distribution(-128, 127));
+    test_sort_radix<double>(real_distribution(-1e9, 1e9));
+    test_sort_radix<float>(real_distribution(-1e3, 1e3));
+
+    // few distinct digits, most of the passes are skipped
+    test_sort_radix<std::uint64_t>(uint_distribution(0, 100));
+    test_sort_radix<std::uint64_t>(uint_distribution(42, 42));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sort_by_key_radix()
+{
+    using namespace hpx::parallel;
+
+    std::vector<std::uint64_t> keys = make_keys<std::uint64_t>(
+        std::uniform_int_distribution<std::uint64_t>(0, 10000));
+
+    // the values record the key they belong to
+    std::vector<double> values(keys.size());
+    std::transform(std::begin(keys), std::end(keys), std::begin(values),
+        [](std::uint64_t key) { return double(key) + 0.5; });
+
+    sort_by_key(execution::par, std::begin(keys), std::end(keys),
+        std::begin(values));
+
+    HPX_TEST(std::is_sorted(std::begin(keys), std::end(keys)));
+    for (std::size_t i = 0; i != keys.size(); ++i)
+    {
+        HPX_TEST_EQ(values[i], double(keys[i]) + 0.5);
+    }
+}
+
+void test_sort_radix_not_default_constructible()
+{
+    using namespace hpx::parallel;
+
+    std::vector<std::int64_t> keys = make_keys<std::int64_t>(
+        std::uniform_int_distribution<std::int64_t>(-10000, 10000));
+
+    std::vector<keyed_value> c;
+    c.reserve(keys.size());
+    for (std::int64_t key : keys)
+        c.push_back(keyed_value(key));
+
+    sort(execution::par, std::begin(c), std::end(c),
+        v1::detail::less(), get_key());
+
+    std::sort(std::begin(keys), std::end(keys));
+    for (std::size_t i = 0; i != keys.size(); ++i)
+    {
+        HPX_TEST_EQ(c[i].key_, keys[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    sort_radix_test();
+    test_sort_by_key_radix();
+    test_sort_radix_not_default_constructible();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
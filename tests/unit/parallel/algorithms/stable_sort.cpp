@@ -0,0 +1,196 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// the second member of each element records its original position, the keys
+// are drawn from a small range to create many equivalent elements
+typedef std::pair<std::size_t, std::size_t> element_type;
+
+std::vector<element_type> make_elements(std::size_t size)
+{
+    std::vector<element_type> c(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c[i] = element_type(std::rand() % 1000, i);
+    return c;
+}
+
+template <typename Compare>
+void verify_stable_sort(std::vector<element_type> const& c, Compare comp)
+{
+    std::vector<element_type> d(c);
+    std::sort(std::begin(d), std::end(d),
+        [](element_type const& lhs, element_type const& rhs)
+        {
+            return lhs.second < rhs.second;
+        });
+    std::stable_sort(std::begin(d), std::end(d),
+        [&comp](element_type const& lhs, element_type const& rhs)
+        {
+            return comp(lhs.first, rhs.first);
+        });
+
+    HPX_TEST(c == d);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_stable_sort(ExPolicy policy, IteratorTag, std::size_t size,
+    Compare comp)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<element_type>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<element_type> c = make_elements(size);
+
+    iterator result = hpx::parallel::stable_sort(policy,
+        iterator(std::begin(c)), iterator(std::end(c)), comp,
+        [](element_type const& e) { return e.first; });
+
+    HPX_TEST(result == iterator(std::end(c)));
+    verify_stable_sort(c, comp);
+}
+
+template <typename ExPolicy, typename IteratorTag, typename Compare>
+void test_stable_sort_async(ExPolicy p, IteratorTag, std::size_t size,
+    Compare comp)
+{
+    typedef std::vector<element_type>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<element_type> c = make_elements(size);
+
+    auto f = hpx::parallel::stable_sort(p,
+        iterator(std::begin(c)), iterator(std::end(c)), comp,
+        [](element_type const& e) { return e.first; });
+
+    HPX_TEST(f.get() == iterator(std::end(c)));
+    verify_stable_sort(c, comp);
+}
+
+template <typename IteratorTag, typename Compare>
+void test_stable_sort(std::size_t size, Compare comp)
+{
+    using namespace hpx::parallel;
+
+    test_stable_sort(execution::seq, IteratorTag(), size, comp);
+    test_stable_sort(execution::par, IteratorTag(), size, comp);
+    test_stable_sort(execution::par_unseq, IteratorTag(), size, comp);
+
+    test_stable_sort_async(execution::seq(execution::task), IteratorTag(),
+        size, comp);
+    test_stable_sort_async(execution::par(execution::task), IteratorTag(),
+        size, comp);
+
+    // a small chunk size forces many merge rounds
+    test_stable_sort(execution::par.with(execution::static_chunk_size(100)),
+        IteratorTag(), size, comp);
+}
+
+void stable_sort_test()
+{
+    std::size_t const sizes[] = { 0, 1, 2, 1007, 100007, 1000007 };
+    for (std::size_t size : sizes)
+    {
+        test_stable_sort<std::random_access_iterator_tag>(
+            size, std::less<std::size_t>());
+        test_stable_sort<std::random_access_iterator_tag>(
+            size, std::greater<std::size_t>());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_stable_sort_exception(ExPolicy policy)
+{
+    std::vector<element_type> c = make_elements(100007);
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::stable_sort(policy, std::begin(c), std::end(c),
+            [](std::size_t, std::size_t) -> bool
+            {
+                throw std::runtime_error("test");
+                return false;
+            },
+            [](element_type const& e) { return e.first; });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+void stable_sort_exception_test()
+{
+    using namespace hpx::parallel;
+
+    test_stable_sort_exception(execution::seq);
+    test_stable_sort_exception(execution::par);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    stable_sort_test();
+    stable_sort_exception_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
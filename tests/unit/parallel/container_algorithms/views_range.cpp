@@ -0,0 +1,256 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_views.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_input(std::size_t size)
+{
+    std::vector<int> c(size);
+    for (int& v : c)
+        v = std::rand() % 1000 - 500;
+    return c;
+}
+
+struct square
+{
+    long operator()(int v) const
+    {
+        return long(v) * v;
+    }
+};
+
+struct is_odd
+{
+    bool operator()(long v) const
+    {
+        return (v % 2) != 0;
+    }
+};
+
+struct is_positive
+{
+    bool operator()(int v) const
+    {
+        return v > 0;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_views_random_access(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c = make_input(10007);
+
+    // iota
+    long sum = reduce(policy, view::transform(view::iota(0, 10007), square()),
+        0l);
+    long expected = 0;
+    for (int i = 0; i != 10007; ++i)
+        expected += square()(i);
+    HPX_TEST_EQ(sum, expected);
+
+    // zip and enumerate
+    std::vector<int> d = make_input(c.size());
+    sum = reduce(policy,
+        view::transform(view::zip(c, d),
+            [](hpx::util::tuple<int&, int&> t) -> long
+            {
+                return long(hpx::util::get<0>(t)) * hpx::util::get<1>(t);
+            }),
+        0l);
+    HPX_TEST_EQ(sum, std::inner_product(std::begin(c), std::end(c),
+        std::begin(d), 0l));
+
+    std::vector<long> e(c.size());
+    for_each(policy, view::enumerate(c),
+        [&e](hpx::util::tuple<std::size_t, int&> t)
+        {
+            e[hpx::util::get<0>(t)] = hpx::util::get<1>(t);
+        });
+    HPX_TEST(std::equal(std::begin(c), std::end(c), std::begin(e)));
+
+    // transform, copy and scan
+    copy(policy, view::transform(c, square()), std::begin(e));
+    for (std::size_t i = 0; i != c.size(); ++i)
+        HPX_TEST_EQ(e[i], square()(c[i]));
+
+    std::vector<long> s(c.size());
+    inclusive_scan(policy, view::transform(c, square()), std::begin(s));
+
+    std::vector<long> expected_s(c.size());
+    std::partial_sum(std::begin(e), std::end(e), std::begin(expected_s));
+    HPX_TEST(std::equal(std::begin(s), std::end(s), std::begin(expected_s)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_views_filtered(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c = make_input(10007);
+
+    // the result of filtering, transforming and filtering again
+    std::vector<long> expected;
+    for (int v : c)
+    {
+        if (is_positive()(v) && is_odd()(square()(v)))
+            expected.push_back(square()(v) + 1);
+    }
+
+    auto v = view::transform(
+        view::filter(
+            view::transform(view::filter(c, is_positive()), square()),
+            is_odd()),
+        [](long v) { return v + 1; });
+
+    // reduce
+    long sum = reduce(policy, v, 42l);
+    HPX_TEST_EQ(sum,
+        std::accumulate(std::begin(expected), std::end(expected), 42l));
+
+    // for_each
+    std::atomic<long> count(0);
+    for_each(policy, v, [&count](long) { ++count; });
+    HPX_TEST_EQ(count.load(), long(expected.size()));
+
+    // copy
+    std::vector<long> d(c.size());
+    auto result = copy(policy, v, std::begin(d));
+    HPX_TEST(result.in() == std::end(c));
+    HPX_TEST(result.out() == std::begin(d) + expected.size());
+    HPX_TEST(std::equal(std::begin(expected), std::end(expected),
+        std::begin(d)));
+
+    // inclusive_scan
+    std::vector<long> expected_s(expected.size());
+    std::partial_sum(std::begin(expected), std::end(expected),
+        std::begin(expected_s));
+
+    std::vector<long> s(c.size());
+    auto end = inclusive_scan(policy, v, std::begin(s));
+    HPX_TEST(end == std::begin(s) + expected.size());
+    HPX_TEST(std::equal(std::begin(expected_s), std::end(expected_s),
+        std::begin(s)));
+
+    std::fill(std::begin(expected_s), std::end(expected_s), 0l);
+    std::partial_sum(std::begin(expected), std::end(expected),
+        std::begin(expected_s));
+    for (long& e : expected_s)
+        e += 42;
+
+    inclusive_scan(policy, v, std::begin(s), std::plus<long>(), 42l);
+    HPX_TEST(std::equal(std::begin(expected_s), std::end(expected_s),
+        std::begin(s)));
+
+    // an empty view
+    auto empty = view::filter(c, [](int) { return false; });
+    HPX_TEST_EQ(reduce(policy, empty, 42), 42);
+    HPX_TEST(copy(policy, empty, std::begin(d)).out() == std::begin(d));
+}
+
+template <typename ExPolicy>
+void test_views_filtered_async(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c = make_input(10007);
+
+    long expected = 0;
+    std::size_t count = 0;
+    for (int v : c)
+    {
+        if (is_positive()(v))
+        {
+            expected += square()(v);
+            ++count;
+        }
+    }
+
+    auto v = view::transform(view::filter(c, is_positive()), square());
+
+    hpx::future<long> f = reduce(policy, v, 0l);
+    HPX_TEST_EQ(f.get(), expected);
+
+    std::vector<long> d(c.size());
+    auto result = copy(policy, v, std::begin(d)).get();
+    HPX_TEST(result.out() == std::begin(d) + count);
+
+    std::vector<long> s(c.size());
+    auto end = inclusive_scan(policy, v, std::begin(s)).get();
+    HPX_TEST(end == std::begin(s) + count);
+    HPX_TEST_EQ(s[count - 1], expected);
+}
+
+void test_views()
+{
+    using namespace hpx::parallel;
+
+    test_views_random_access(execution::seq);
+    test_views_random_access(execution::par);
+
+    test_views_filtered(execution::seq);
+    test_views_filtered(execution::par);
+
+    test_views_filtered_async(execution::seq(execution::task));
+    test_views_filtered_async(execution::par(execution::task));
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    test_views();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,190 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/util/continuation_statistics.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef hpx::parallel::execution::adaptive_continuation_executor executor;
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::thread::id test(int passed_through)
+{
+    HPX_TEST_EQ(passed_through, 42);
+    return hpx::this_thread::get_id();
+}
+
+// functions are run inline as long as the budget is not exhausted
+void test_inline()
+{
+    executor exec(8);
+
+    std::int64_t inlined = hpx::util::get_inlined_continuation_count(false);
+
+    HPX_TEST(hpx::parallel::execution::sync_execute(exec, &test, 42) ==
+        hpx::this_thread::get_id());
+    HPX_TEST(
+        hpx::parallel::execution::async_execute(exec, &test, 42).get() ==
+        hpx::this_thread::get_id());
+
+    HPX_TEST(hpx::util::get_inlined_continuation_count(false) >=
+        inlined + 2);
+}
+
+// a new thread is created once the budget is exhausted
+void test_spawn()
+{
+    executor exec(0);
+
+    std::int64_t spawned = hpx::util::get_spawned_continuation_count(false);
+
+    HPX_TEST(
+        hpx::parallel::execution::async_execute(exec, &test, 42).get() !=
+        hpx::this_thread::get_id());
+
+    HPX_TEST(hpx::util::get_spawned_continuation_count(false) >=
+        spawned + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::thread::id test_f(hpx::future<void> f, int passed_through)
+{
+    HPX_ASSERT(f.is_ready());   // make sure, future is ready
+
+    f.get();                    // propagate exceptions
+
+    HPX_TEST_EQ(passed_through, 42);
+    return hpx::this_thread::get_id();
+}
+
+// continuations attached to a ready future run on the attaching thread
+void test_then()
+{
+    hpx::future<void> f = hpx::make_ready_future();
+
+    executor exec;
+    HPX_TEST(
+        hpx::parallel::execution::then_execute(exec, &test_f, f, 42).get() ==
+        hpx::this_thread::get_id());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a long chain of continuations is triggered by a single set_value, the
+// recursion depth stays bounded
+void test_then_chain()
+{
+    std::size_t const chain_length = 10000;
+
+    hpx::lcos::local::promise<std::size_t> p;
+    hpx::future<std::size_t> f = p.get_future();
+
+    executor exec;
+    for (std::size_t i = 0; i != chain_length; ++i)
+    {
+        f = f.then(exec,
+            [](hpx::future<std::size_t> f)
+            {
+                return f.get() + 1;
+            });
+    }
+
+    std::int64_t inlined = hpx::util::get_inlined_continuation_count(false);
+    std::int64_t spawned = hpx::util::get_spawned_continuation_count(false);
+
+    p.set_value(0);
+    HPX_TEST_EQ(f.get(), chain_length);
+
+    std::int64_t num_inlined =
+        hpx::util::get_inlined_continuation_count(false) - inlined;
+    std::int64_t num_spawned =
+        hpx::util::get_spawned_continuation_count(false) - spawned;
+
+    HPX_TEST(num_inlined > 0);
+    HPX_TEST(num_spawned > 0);
+    HPX_TEST(num_inlined + num_spawned >= std::int64_t(chain_length));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// exceptions thrown by inlined continuations are propagated to the future
+void test_exception()
+{
+    executor exec;
+
+    hpx::future<int> f = hpx::make_ready_future(42).then(exec,
+        [](hpx::future<int> f) -> int
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "test_exception", "test");
+            return f.get();
+        });
+
+    bool caught_exception = false;
+    try {
+        f.get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void static_check_executor()
+{
+    using namespace hpx::traits;
+
+    static_assert(
+        !has_sync_execute_member<executor>::value,
+        "!has_sync_execute_member<executor>::value");
+    static_assert(
+        has_async_execute_member<executor>::value,
+        "has_async_execute_member<executor>::value");
+    static_assert(
+        !has_then_execute_member<executor>::value,
+        "!has_then_execute_member<executor>::value");
+    static_assert(
+        has_post_member<executor>::value,
+        "check has_post_member<executor>::value");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    static_check_executor();
+
+    test_inline();
+    test_spawn();
+    test_then();
+    test_then_chain();
+    test_exception();
+
+    HPX_TEST(hpx::util::get_inlined_continuation_count(true) > 0);
+    HPX_TEST_EQ(hpx::util::get_inlined_continuation_count(false),
+        std::int64_t(0));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
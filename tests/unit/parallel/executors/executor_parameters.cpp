@@ -10,15 +10,20 @@
 #include <hpx/hpx.hpp>
 #include <hpx/include/parallel_executors.hpp>
 #include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/util/adaptive_chunk_size_statistics.hpp>
 #include <hpx/util/lightweight_test.hpp>
 #include <hpx/util/iterator_range.hpp>
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <numeric>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -131,6 +136,82 @@ void test_persistent_auto_chunk_size()
     }
 }
 
+void test_adaptive_chunk_size()
+{
+    {
+        hpx::parallel::execution::adaptive_chunk_size acs;
+        parameters_test(acs);
+    }
+
+    {
+        hpx::parallel::execution::adaptive_chunk_size acs("for_each", 2);
+        parameters_test(acs);
+
+        std::shared_ptr<hpx::util::adaptive_chunk_size_statistics> stats =
+            hpx::util::get_adaptive_chunk_size_statistics("for_each");
+        HPX_TEST_NEQ(stats->invocations_.load(), std::int64_t(0));
+    }
+
+    // the same algorithm invoked through differently named objects keeps
+    // separate histories
+    for (char const* name : {"for_each_first", "for_each_second"})
+    {
+        hpx::parallel::execution::adaptive_chunk_size acs(name);
+
+        std::vector<int> c(10007);
+        hpx::parallel::for_each(hpx::parallel::execution::par.with(acs),
+            std::begin(c), std::end(c), [](int& v) { ++v; });
+
+        std::shared_ptr<hpx::util::adaptive_chunk_size_statistics> stats =
+            hpx::util::get_adaptive_chunk_size_statistics(name);
+        HPX_TEST_EQ(stats->invocations_.load(), std::int64_t(1));
+    }
+}
+
+// Feed measurements of a synthetic workload with a fixed optimal chunk size
+// to a call site, the measured time per element grows with the distance of
+// the chosen chunk size from the optimum.
+void run_adaptive_chunk_size_site(
+    hpx::parallel::execution::detail::adaptive_chunk_size_site& site,
+    int optimum, int invocations, std::set<int>& candidates)
+{
+    std::size_t const cores = 4;
+    std::size_t const count = std::size_t(1) << 20;
+
+    for (int i = 0; i != invocations; ++i)
+    {
+        int candidate = site.select(cores, count, 16);
+        candidates.insert(candidate);
+
+        std::uint64_t distance = std::abs(candidate - optimum);
+        site.record(candidate, count, count * (distance + 1) * 100);
+    }
+}
+
+void test_adaptive_chunk_size_convergence()
+{
+    hpx::parallel::execution::detail::adaptive_chunk_size_site site(
+        "convergence");
+    std::shared_ptr<hpx::util::adaptive_chunk_size_statistics> stats =
+        hpx::util::get_adaptive_chunk_size_statistics("convergence");
+
+    // the chunk size converges to the optimum of the workload
+    std::set<int> candidates;
+    run_adaptive_chunk_size_site(site, 6, 1000, candidates);
+    HPX_TEST_EQ(stats->chunk_size_.load(), std::int64_t(1) << 6);
+    HPX_TEST_EQ(stats->invocations_.load(), std::int64_t(1000));
+
+    // the neighbours of the optimum are explored periodically, which lets
+    // the call site follow changes of the workload
+    HPX_TEST(candidates.count(5) != 0 && candidates.count(7) != 0);
+    HPX_TEST_NEQ(stats->explorations_.load(), std::int64_t(0));
+
+    candidates.clear();
+    run_adaptive_chunk_size_site(site, 10, 1000, candidates);
+    HPX_TEST_EQ(stats->chunk_size_.load(), std::int64_t(1) << 10);
+    HPX_TEST(candidates.count(11) != 0);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 struct timer_hooks_parameters
 {
@@ -183,6 +264,8 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_guided_chunk_size();
     test_auto_chunk_size();
     test_persistent_auto_chunk_size();
+    test_adaptive_chunk_size();
+    test_adaptive_chunk_size_convergence();
 
     test_combined_hooks();
 
@@ -0,0 +1,141 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_copy.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void iota_vector(hpx::partitioned_vector<T>& v, T val)
+{
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for(/**/; it != end; ++it)
+        *it = val++;
+}
+
+template <typename T, typename InIter>
+void verify_values(InIter first, InIter last, std::vector<T> const& expected)
+{
+    std::size_t size = 0;
+    for (InIter it = first; it != last; ++it, ++size)
+    {
+        HPX_TEST_EQ(*it, expected[size]);
+    }
+    HPX_TEST_EQ(size, expected.size());
+}
+
+struct is_even
+{
+    template <typename T>
+    bool operator()(T const& val) const
+    {
+        return static_cast<int>(val) % 2 == 0;
+    }
+
+    template <typename Archive>
+    void serialize(Archive&, unsigned) {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename DistPolicy, typename ExPolicy>
+void copy_if_algo_tests_with_policy(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& copy_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+    iota_vector(c, T(1234));
+
+    hpx::partitioned_vector<T> d(size, policy);
+    iota_vector(d, T(0));
+
+    std::vector<T> expected;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i % 2 == 0)
+            expected.push_back(T(1234 + i));
+    }
+
+    auto result = hpx::parallel::copy_if(copy_policy, c.begin(), c.end(),
+        d.begin(), is_even());
+    HPX_TEST(result.in() == c.end());
+    HPX_TEST(result.out() == d.begin() + expected.size());
+    verify_values(d.begin(), result.out(), expected);
+
+    // the remaining elements of the destination are untouched
+    std::vector<T> rest;
+    for (std::size_t i = expected.size(); i != size; ++i)
+        rest.push_back(T(i));
+    verify_values(result.out(), d.end(), rest);
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void copy_if_algo_tests_with_policy_async(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& copy_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+    iota_vector(c, T(1234));
+
+    hpx::partitioned_vector<T> d(size, policy);
+
+    std::vector<T> expected;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i % 2 == 0)
+            expected.push_back(T(1234 + i));
+    }
+
+    auto f = hpx::parallel::copy_if(copy_policy, c.begin(), c.end(),
+        d.begin(), is_even());
+    auto result = f.get();
+    HPX_TEST(result.in() == c.end());
+    verify_values(d.begin(), result.out(), expected);
+}
+
+template <typename T, typename DistPolicy>
+void copy_if_tests_with_policy(std::size_t size, std::size_t localities,
+    DistPolicy const& policy)
+{
+    using namespace hpx::parallel::execution;
+
+    copy_if_algo_tests_with_policy<T>(size, policy, seq);
+    copy_if_algo_tests_with_policy<T>(size, policy, par);
+
+    //async
+    copy_if_algo_tests_with_policy_async<T>(size, policy, seq(task));
+    copy_if_algo_tests_with_policy_async<T>(size, policy, par(task));
+}
+
+template <typename T>
+void copy_if_tests()
+{
+    std::size_t const length = 12;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    copy_if_tests_with_policy<T>(length, 1, hpx::container_layout);
+    copy_if_tests_with_policy<T>(length, 3, hpx::container_layout(3));
+    copy_if_tests_with_policy<T>(length, 3,
+        hpx::container_layout(3, localities));
+    copy_if_tests_with_policy<T>(length, localities.size(),
+        hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    copy_if_tests<double>();
+    copy_if_tests<int>();
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_merge.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+// fill the vector with a sorted sequence starting at val, advancing by step
+template <typename T>
+std::vector<T> fill_sorted(hpx::partitioned_vector<T>& v, T val, T step)
+{
+    std::vector<T> values;
+    values.reserve(v.size());
+
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for(/**/; it != end; ++it, val += step)
+    {
+        *it = val;
+        values.push_back(val);
+    }
+    return values;
+}
+
+template <typename T, typename InIter>
+void verify_values(InIter first, InIter last, std::vector<T> const& expected)
+{
+    std::size_t size = 0;
+    for (InIter it = first; it != last; ++it, ++size)
+    {
+        HPX_TEST_EQ(*it, expected[size]);
+    }
+    HPX_TEST_EQ(size, expected.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename DistPolicy, typename ExPolicy>
+void merge_algo_tests_with_policy(std::size_t size1, std::size_t size2,
+    DistPolicy const& policy, ExPolicy const& merge_policy)
+{
+    hpx::partitioned_vector<T> c1(size1, policy);
+    hpx::partitioned_vector<T> c2(size2, policy);
+    hpx::partitioned_vector<T> d(size1 + size2, policy);
+
+    std::vector<T> values1 = fill_sorted(c1, T(0), T(3));
+    std::vector<T> values2 = fill_sorted(c2, T(0), T(2));
+
+    std::vector<T> expected(size1 + size2);
+    std::merge(values1.begin(), values1.end(), values2.begin(), values2.end(),
+        expected.begin());
+
+    auto result = hpx::parallel::merge(merge_policy,
+        c1.begin(), c1.end(), c2.begin(), c2.end(), d.begin());
+    HPX_TEST(result.in1() == c1.end());
+    HPX_TEST(result.in2() == c2.end());
+    HPX_TEST(result.out() == d.end());
+    verify_values(d.begin(), d.end(), expected);
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void merge_algo_tests_with_policy_async(std::size_t size1, std::size_t size2,
+    DistPolicy const& policy, ExPolicy const& merge_policy)
+{
+    hpx::partitioned_vector<T> c1(size1, policy);
+    hpx::partitioned_vector<T> c2(size2, policy);
+    hpx::partitioned_vector<T> d(size1 + size2, policy);
+
+    std::vector<T> values1 = fill_sorted(c1, T(0), T(3));
+    std::vector<T> values2 = fill_sorted(c2, T(0), T(2));
+
+    std::vector<T> expected(size1 + size2);
+    std::merge(values1.begin(), values1.end(), values2.begin(), values2.end(),
+        expected.begin());
+
+    auto f = hpx::parallel::merge(merge_policy,
+        c1.begin(), c1.end(), c2.begin(), c2.end(), d.begin());
+    auto result = f.get();
+    HPX_TEST(result.out() == d.end());
+    verify_values(d.begin(), d.end(), expected);
+}
+
+template <typename T, typename DistPolicy>
+void merge_tests_with_policy(std::size_t size1, std::size_t size2,
+    std::size_t localities, DistPolicy const& policy)
+{
+    using namespace hpx::parallel::execution;
+
+    merge_algo_tests_with_policy<T>(size1, size2, policy, seq);
+    merge_algo_tests_with_policy<T>(size1, size2, policy, par);
+
+    //async
+    merge_algo_tests_with_policy_async<T>(size1, size2, policy, seq(task));
+    merge_algo_tests_with_policy_async<T>(size1, size2, policy, par(task));
+}
+
+template <typename T>
+void merge_tests()
+{
+    std::size_t const length1 = 12;
+    std::size_t const length2 = 17;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    merge_tests_with_policy<T>(length1, length2, 1, hpx::container_layout);
+    merge_tests_with_policy<T>(length1, length2, 3,
+        hpx::container_layout(3));
+    merge_tests_with_policy<T>(length1, length2, 3,
+        hpx::container_layout(3, localities));
+    merge_tests_with_policy<T>(length1, length2, localities.size(),
+        hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    merge_tests<double>();
+    merge_tests<int>();
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_remove.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void iota_vector(hpx::partitioned_vector<T>& v, T val)
+{
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for(/**/; it != end; ++it)
+        *it = val++;
+}
+
+template <typename T, typename InIter>
+void verify_values(InIter first, InIter last, std::vector<T> const& expected)
+{
+    std::size_t size = 0;
+    for (InIter it = first; it != last; ++it, ++size)
+    {
+        HPX_TEST_EQ(*it, expected[size]);
+    }
+    HPX_TEST_EQ(size, expected.size());
+}
+
+struct is_even
+{
+    template <typename T>
+    bool operator()(T const& val) const
+    {
+        return static_cast<int>(val) % 2 == 0;
+    }
+
+    template <typename Archive>
+    void serialize(Archive&, unsigned) {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename DistPolicy, typename ExPolicy>
+void remove_if_algo_tests_with_policy(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& remove_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+    iota_vector(c, T(1234));
+
+    std::vector<T> expected;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i % 2 != 0)
+            expected.push_back(T(1234 + i));
+    }
+
+    auto result = hpx::parallel::remove_if(remove_policy,
+        c.begin(), c.end(), is_even());
+    HPX_TEST(result == c.begin() + expected.size());
+    verify_values(c.begin(), result, expected);
+
+    expected.erase(expected.begin() + 1);
+    result = hpx::parallel::remove(remove_policy,
+        c.begin(), result, T(1234 + 3));
+    verify_values(c.begin(), result, expected);
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void remove_if_algo_tests_with_policy_async(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& remove_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+    iota_vector(c, T(1234));
+
+    std::vector<T> expected;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i % 2 != 0)
+            expected.push_back(T(1234 + i));
+    }
+
+    auto f = hpx::parallel::remove_if(remove_policy,
+        c.begin(), c.end(), is_even());
+    auto result = f.get();
+    verify_values(c.begin(), result, expected);
+}
+
+template <typename T, typename DistPolicy>
+void remove_if_tests_with_policy(std::size_t size, std::size_t localities,
+    DistPolicy const& policy)
+{
+    using namespace hpx::parallel::execution;
+
+    remove_if_algo_tests_with_policy<T>(size, policy, seq);
+    remove_if_algo_tests_with_policy<T>(size, policy, par);
+
+    //async
+    remove_if_algo_tests_with_policy_async<T>(size, policy, seq(task));
+    remove_if_algo_tests_with_policy_async<T>(size, policy, par(task));
+}
+
+template <typename T>
+void remove_if_tests()
+{
+    std::size_t const length = 12;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    remove_if_tests_with_policy<T>(length, 1, hpx::container_layout);
+    remove_if_tests_with_policy<T>(length, 3, hpx::container_layout(3));
+    remove_if_tests_with_policy<T>(length, 3,
+        hpx::container_layout(3, localities));
+    remove_if_tests_with_policy<T>(length, localities.size(),
+        hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    remove_if_tests<double>();
+    remove_if_tests<int>();
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+// fill the vector with a scrambled sequence containing duplicates
+template <typename T>
+std::vector<T> scramble_vector(hpx::partitioned_vector<T>& v)
+{
+    std::vector<T> expected;
+    expected.reserve(v.size());
+
+    std::size_t i = 0;
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for (/**/; it != end; ++it, ++i)
+    {
+        T val = T((i * 7919) % 13);
+        *it = val;
+        expected.push_back(val);
+    }
+    return expected;
+}
+
+template <typename T, typename InIter>
+void verify_values(InIter first, InIter last, std::vector<T> const& expected)
+{
+    std::size_t size = 0;
+    for (InIter it = first; it != last; ++it, ++size)
+    {
+        HPX_TEST_EQ(*it, expected[size]);
+    }
+    HPX_TEST_EQ(size, expected.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename DistPolicy, typename ExPolicy>
+void sort_algo_tests_with_policy(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& sort_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+
+    std::vector<T> expected = scramble_vector(c);
+    std::sort(expected.begin(), expected.end());
+
+    auto result = hpx::parallel::sort(sort_policy, c.begin(), c.end());
+    HPX_TEST(result == c.end());
+    verify_values(c.begin(), c.end(), expected);
+
+    std::sort(expected.begin() + 1, expected.end() - 1, std::greater<T>());
+    hpx::parallel::sort(sort_policy, c.begin() + 1, c.end() - 1,
+        std::greater<T>());
+    verify_values(c.begin(), c.end(), expected);
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void sort_algo_tests_with_policy_async(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& sort_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+
+    std::vector<T> expected = scramble_vector(c);
+    std::sort(expected.begin(), expected.end());
+
+    auto f = hpx::parallel::sort(sort_policy, c.begin(), c.end());
+    HPX_TEST(f.get() == c.end());
+    verify_values(c.begin(), c.end(), expected);
+
+    std::sort(expected.begin() + 1, expected.end() - 1, std::greater<T>());
+    auto f1 = hpx::parallel::sort(sort_policy, c.begin() + 1, c.end() - 1,
+        std::greater<T>());
+    f1.wait();
+    verify_values(c.begin(), c.end(), expected);
+}
+
+template <typename T, typename DistPolicy>
+void sort_tests_with_policy(std::size_t size, std::size_t localities,
+    DistPolicy const& policy)
+{
+    using namespace hpx::parallel::execution;
+
+    sort_algo_tests_with_policy<T>(size, policy, seq);
+    sort_algo_tests_with_policy<T>(size, policy, par);
+
+    //async
+    sort_algo_tests_with_policy_async<T>(size, policy, seq(task));
+    sort_algo_tests_with_policy_async<T>(size, policy, par(task));
+}
+
+template <typename T>
+void sort_tests()
+{
+    std::size_t const length = 1000;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    sort_tests_with_policy<T>(length, 1, hpx::container_layout);
+    sort_tests_with_policy<T>(length, 3, hpx::container_layout(3));
+    sort_tests_with_policy<T>(length, 3, hpx::container_layout(3, localities));
+    sort_tests_with_policy<T>(length, localities.size(),
+        hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Runs of equivalent keys are spread over several buckets, regular sampling
+// bounds the size of every bucket by twice the average size even if there
+// are only a few distinct keys.
+void bucket_size_test(std::size_t segments, std::size_t size, int distinct)
+{
+    using namespace hpx::parallel::v1::detail;
+    typedef hpx::parallel::util::projection_identity proj;
+
+    std::vector<std::vector<int> > data(segments);
+    std::vector<std::vector<int> > samples;
+    std::vector<std::size_t> sizes(segments, size);
+
+    for (std::size_t i = 0; i != segments; ++i)
+    {
+        data[i].reserve(size);
+        for (std::size_t k = 0; k != size; ++k)
+            data[i].push_back(int(((i * size + k) * 7919) % distinct));
+
+        std::sort(data[i].begin(), data[i].end());
+        samples.push_back(regular_samples<int>(
+            data[i].begin(), data[i].end(), segments - 1));
+    }
+
+    sort_splitters<int> splitters =
+        select_splitters(samples, sizes, less(), proj());
+
+    std::vector<std::size_t> buckets(segments, 0);
+    for (std::size_t i = 0; i != segments; ++i)
+    {
+        std::vector<std::size_t> bounds = split_segment<int>::sequential(
+            hpx::parallel::execution::seq, data[i].begin(), data[i].end(),
+            i, splitters.values_, splitters.segments_, splitters.positions_,
+            less(), proj());
+
+        std::size_t b = 0;
+        for (std::size_t j = 0; j != segments; ++j)
+        {
+            std::size_t e = (j == segments - 1) ? size : bounds[j];
+            HPX_TEST_LTE(b, e);
+            buckets[j] += e - b;
+            b = e;
+        }
+    }
+
+    for (std::size_t bucket : buckets)
+        HPX_TEST_LTE(bucket, 2 * size);
+}
+
+template <typename T>
+void sort_equal_keys_test()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    hpx::partitioned_vector<T> c(1000, T(42),
+        hpx::container_layout(3, localities));
+
+    hpx::parallel::sort(hpx::parallel::execution::par, c.begin(), c.end());
+    verify_values(c.begin(), c.end(), std::vector<T>(1000, T(42)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    sort_tests<double>();
+    sort_tests<int>();
+
+    for (std::size_t segments : {2, 3, 4, 8})
+    {
+        for (int distinct : {1, 2, 3, 13})
+            bucket_size_test(segments, 1000, distinct);
+    }
+    sort_equal_keys_test<int>();
+
+    return 0;
+}
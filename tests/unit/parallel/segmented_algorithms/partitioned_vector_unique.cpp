@@ -0,0 +1,115 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_unique.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+// fill the vector with runs of equal elements, the runs cross the segment
+// boundaries
+template <typename T>
+void fill_runs(hpx::partitioned_vector<T>& v, std::vector<T>& expected)
+{
+    expected.clear();
+
+    std::size_t i = 0;
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for(/**/; it != end; ++it, ++i)
+    {
+        T val = T(i / 3);
+        *it = val;
+        if (expected.empty() || expected.back() != val)
+            expected.push_back(val);
+    }
+}
+
+template <typename T, typename InIter>
+void verify_values(InIter first, InIter last, std::vector<T> const& expected)
+{
+    std::size_t size = 0;
+    for (InIter it = first; it != last; ++it, ++size)
+    {
+        HPX_TEST_EQ(*it, expected[size]);
+    }
+    HPX_TEST_EQ(size, expected.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename DistPolicy, typename ExPolicy>
+void unique_algo_tests_with_policy(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& unique_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+
+    std::vector<T> expected;
+    fill_runs(c, expected);
+
+    auto result = hpx::parallel::unique(unique_policy, c.begin(), c.end());
+    HPX_TEST(result == c.begin() + expected.size());
+    verify_values(c.begin(), result, expected);
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void unique_algo_tests_with_policy_async(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& unique_policy)
+{
+    hpx::partitioned_vector<T> c(size, policy);
+
+    std::vector<T> expected;
+    fill_runs(c, expected);
+
+    auto f = hpx::parallel::unique(unique_policy, c.begin(), c.end());
+    auto result = f.get();
+    HPX_TEST(result == c.begin() + expected.size());
+    verify_values(c.begin(), result, expected);
+}
+
+template <typename T, typename DistPolicy>
+void unique_tests_with_policy(std::size_t size, std::size_t localities,
+    DistPolicy const& policy)
+{
+    using namespace hpx::parallel::execution;
+
+    unique_algo_tests_with_policy<T>(size, policy, seq);
+    unique_algo_tests_with_policy<T>(size, policy, par);
+
+    //async
+    unique_algo_tests_with_policy_async<T>(size, policy, seq(task));
+    unique_algo_tests_with_policy_async<T>(size, policy, par(task));
+}
+
+template <typename T>
+void unique_tests()
+{
+    std::size_t const length = 13;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    unique_tests_with_policy<T>(length, 1, hpx::container_layout);
+    unique_tests_with_policy<T>(length, 3, hpx::container_layout(3));
+    unique_tests_with_policy<T>(length, 3,
+        hpx::container_layout(3, localities));
+    unique_tests_with_policy<T>(length, localities.size(),
+        hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    unique_tests<double>();
+    unique_tests<int>();
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/slab_allocator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void allocate_deallocate()
+{
+    std::size_t const sizes[] = { 1, 8, 16, 17, 48, 100, 256, 512, 513, 4096 };
+
+    std::vector<void*> blocks;
+    for (int i = 0; i != 1000; ++i)
+    {
+        for (std::size_t size : sizes)
+        {
+            void* p = hpx::util::slab_allocate(size);
+            HPX_TEST(p != nullptr);
+            HPX_TEST_EQ(reinterpret_cast<std::uintptr_t>(p) %
+                hpx::util::slab_allocator_alignment, std::uintptr_t(0));
+
+            std::memset(p, 0xcd, size);
+            blocks.push_back(p);
+        }
+    }
+
+    std::size_t i = 0;
+    for (void* p : blocks)
+    {
+        std::size_t size = sizes[i++ % (sizeof(sizes) / sizeof(sizes[0]))];
+        hpx::util::slab_deallocate(p, size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// blocks released by another (kernel) thread go to the remote-free list of
+// the owning heap
+void remote_deallocate()
+{
+    std::vector<void*> blocks;
+    for (int i = 0; i != 100; ++i)
+        blocks.push_back(hpx::util::slab_allocate(64));
+
+    std::int64_t remote_frees =
+        hpx::util::get_slab_remote_free_count(false);
+
+    std::thread t(
+        [&blocks]()
+        {
+            for (void* p : blocks)
+                hpx::util::slab_deallocate(p, 64);
+        });
+    t.join();
+
+#if defined(HPX_HAVE_SLAB_ALLOCATOR)
+    HPX_TEST(hpx::util::get_slab_remote_free_count(false) >=
+        remote_frees + 100);
+    HPX_TEST(hpx::util::get_slab_count(false) != 0);
+#endif
+
+    // the blocks released remotely are reused by the owning thread
+    for (int i = 0; i != 100; ++i)
+        blocks[i] = hpx::util::slab_allocate(64);
+    for (void* p : blocks)
+        hpx::util::slab_deallocate(p, 64);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// slabs which have no blocks in use anymore are released
+void release_empty_slabs()
+{
+    std::int64_t slabs = hpx::util::get_slab_count(false);
+
+    // enough blocks to fill a couple of slabs
+    std::vector<void*> blocks;
+    for (int i = 0; i != 10000; ++i)
+        blocks.push_back(hpx::util::slab_allocate(96));
+
+#if defined(HPX_HAVE_SLAB_ALLOCATOR)
+    HPX_TEST(hpx::util::get_slab_count(false) > slabs + 2);
+#endif
+
+    for (void* p : blocks)
+        hpx::util::slab_deallocate(p, 96);
+
+    // only the slab blocks are currently taken from is kept
+#if defined(HPX_HAVE_SLAB_ALLOCATOR)
+    HPX_TEST(hpx::util::get_slab_count(false) <= slabs + 1);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct big_function
+{
+    char data_[128];
+
+    int operator()(int i) const
+    {
+        return i + data_[0];
+    }
+};
+
+void shared_states_and_functions()
+{
+    std::vector<hpx::future<int> > futures;
+    for (int i = 0; i != 1000; ++i)
+    {
+        big_function f;
+        f.data_[0] = 1;
+
+        hpx::util::function_nonser<int(int)> func = f;
+        futures.push_back(hpx::async(func, i));
+    }
+
+    int i = 0;
+    for (hpx::future<int>& f : futures)
+    {
+        HPX_TEST_EQ(f.get(), i + 1);
+        ++i;
+    }
+}
+
+int main()
+{
+    allocate_deallocate();
+    remote_deallocate();
+    release_empty_slabs();
+    shared_states_and_functions();
+
+    return hpx::util::report_errors();
+}